@@ -0,0 +1,2281 @@
+/************************************************************************
+\file 	SrAccuracy.cpp
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#include <math.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "SrBenchmark.h"
+#include "SrQuaternionBatch.h"
+#include "SrMatrix33Batch.h"
+#include "SrMatrix34Batch.h"
+#include "SrMatrixExpr.h"
+#include "SrSimdMath.h"
+#include "SrRotationSampler.h"
+#include "SrRandomBatch.h"
+#include "SrRotationIntegrator.h"
+#include "SrQuaternionSpline.h"
+#include "SrAnimationTrack.h"
+#include "SrTrackReducer.h"
+#include "SrQuaternionCodec.h"
+#include "SrHalfBatch.h"
+#include "SrSkinning.h"
+#include "SrSkeleton.h"
+
+/*
+Accuracy against a long double reference, next to the time per element.
+
+	g++ -O2 -pthread -I../orientation SrAccuracy.cpp -o SrAccuracy
+	g++ -O2 -pthread -DSR_DETERMINISTIC -ffp-contract=off -I../orientation SrAccuracy.cpp -o SrAccuracy
+	SrAccuracy [--filter=text] [--count=n] [--min-time=ms] [--out=file.json]
+
+Every case runs one single precision operation, a member function or a batch kernel,
+over an input set, and compares each result to the same operation evaluated in long
+double on the same float inputs. Inputs that stand for rotations are normalized in the
+reference, so a slightly denormalized float rotation counts as error. The input sets
+are random, and adversarial where an operation has a weak spot: near 180 degree
+rotations for toQuat, near parallel and near opposite pairs for the interpolations,
+near singular matrices for getInverse, arguments near the poles of the functions.
+
+Reported per case, as JSON:
+
+	ulp_hist	error in float ulps of the largest reference component, so a quaternion
+				is measured against the spacing of its w or x, not of a near zero element.
+				The bins are upper bounds: 0, 0.5, 1, 2, 4, ... 4096, and the rest.
+	angle_hist	for the rotation results, the angle between the result and the reference
+				rotation in radians, bins <= 1e-9 ... 1e-1 and the rest.
+	ns_per_op	best time per element of the evaluation loop.
+	pass		whether max_ulp and max_angle stay within the bounds of the case, see main().
+	hash		with SR_DETERMINISTIC, a hash of the results to compare builds with.
+
+The run exits with 1 when a case exceeds its bounds, and with SR_DETERMINISTIC before
+any case when the build contracts a*b + c. Built with SR_SIMD_DISPATCH and
+SR_DETERMINISTIC every case also runs at each compiled level the CPU supports, and fails
+unless all of them return the same bits.
+
+With MSVC long double is double, the reference then only has 29 more bits than float.
+A new fast path or batch kernel gets its cases here next to the exact operation it replaces.
+*/
+
+typedef long double SrRef;
+
+//-------------------------------------------------------------------------------- reference
+
+struct SrRefVec
+	{
+	SrRef x, y, z;
+	};
+
+struct SrRefQuat
+	{
+	SrRef x, y, z, w;
+	};
+
+struct SrRefMat
+	{
+	SrRef m[3][3];
+	};
+
+static SrRefVec srRef(const SrVector3& v)
+	{
+	SrRefVec r = { v.x, v.y, v.z };
+	return r;
+	}
+
+static SrRefQuat srRef(const SrQuaternion& q)
+	{
+	SrRefQuat r = { q.x, q.y, q.z, q.w };
+	return r;
+	}
+
+static SrRefMat srRef(const SrMatrix33& m)
+	{
+	SrRefMat r;
+	for(int i = 0; i < 3; i++)
+		for(int j = 0; j < 3; j++)
+			r.m[i][j] = m(i, j);
+	return r;
+	}
+
+static SrQuaternion srRound(const SrRefQuat& q)
+	{
+	SrQuaternion r;
+	r.setXYZW((SrF32)q.x, (SrF32)q.y, (SrF32)q.z, (SrF32)q.w);
+	return r;
+	}
+
+static SrMatrix33 srRound(const SrRefMat& m)
+	{
+	SrMatrix33 r;
+	for(int i = 0; i < 3; i++)
+		for(int j = 0; j < 3; j++)
+			r(i, j) = (SrF32)m.m[i][j];
+	return r;
+	}
+
+static SrRef srRefDot(const SrRefQuat& a, const SrRefQuat& b)
+	{
+	return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+	}
+
+static SrRefQuat srRefScale(const SrRefQuat& q, SrRef s)
+	{
+	SrRefQuat r = { q.x * s, q.y * s, q.z * s, q.w * s };
+	return r;
+	}
+
+static SrRefQuat srRefNormalize(const SrRefQuat& q)
+	{
+	return srRefScale(q, 1.0L / sqrtl(srRefDot(q, q)));
+	}
+
+static SrRefQuat srRefMultiply(const SrRefQuat& a, const SrRefQuat& b)
+	{
+	SrRefQuat r;
+	r.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+	r.x = a.w * b.x + b.w * a.x + a.y * b.z - b.y * a.z;
+	r.y = a.w * b.y + b.w * a.y + a.z * b.x - b.z * a.x;
+	r.z = a.w * b.z + b.w * a.z + a.x * b.y - b.x * a.y;
+	return r;
+	}
+
+static SrRefQuat srRefAngleAxis(SrRef angle, const SrRefVec& axis)
+	{
+	const SrRef s = sinl(angle * 0.5L) / sqrtl(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+	SrRefQuat r = { axis.x * s, axis.y * s, axis.z * s, cosl(angle * 0.5L) };
+	return r;
+	}
+
+//shortest path, the convention of SrQuaternion::slerp.
+static SrRefQuat srRefSlerp(SrRef t, const SrRefQuat& a, SrRefQuat b)
+	{
+	SrRef d = srRefDot(a, b);
+	if(d < 0)
+		{
+		b = srRefScale(b, -1.0L);
+		d = -d;
+		}
+	const SrRefQuat diff = { b.x - a.x, b.y - a.y, b.z - a.z, b.w - a.w };
+	const SrRefQuat sum = { b.x + a.x, b.y + a.y, b.z + a.z, b.w + a.w };
+	//the angle from the half chord is accurate for near parallel pairs as well.
+	const SrRef angle = 2.0L * atan2l(sqrtl(srRefDot(diff, diff)), sqrtl(srRefDot(sum, sum)));
+	if(angle == 0)
+		return a;
+	const SrRef s = sinl(angle);
+	const SrRef wa = sinl((1.0L - t) * angle) / s;
+	const SrRef wb = sinl(t * angle) / s;
+	SrRefQuat r = { a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb, a.w * wa + b.w * wb };
+	return r;
+	}
+
+static SrRefVec srRefRotate(const SrRefQuat& q, const SrRefVec& v)
+	{
+	const SrRefQuat p = { v.x, v.y, v.z, 0 };
+	const SrRefQuat c = { -q.x, -q.y, -q.z, q.w };
+	const SrRefQuat r = srRefMultiply(srRefMultiply(q, p), c);
+	SrRefVec o = { r.x, r.y, r.z };
+	return o;
+	}
+
+static SrRefMat srRefFromQuat(const SrRefQuat& q)
+	{
+	SrRefMat m;
+	m.m[0][0] = 1 - 2 * (q.y * q.y + q.z * q.z);
+	m.m[0][1] = 2 * (q.x * q.y - q.w * q.z);
+	m.m[0][2] = 2 * (q.x * q.z + q.w * q.y);
+	m.m[1][0] = 2 * (q.x * q.y + q.w * q.z);
+	m.m[1][1] = 1 - 2 * (q.x * q.x + q.z * q.z);
+	m.m[1][2] = 2 * (q.y * q.z - q.w * q.x);
+	m.m[2][0] = 2 * (q.x * q.z - q.w * q.y);
+	m.m[2][1] = 2 * (q.y * q.z + q.w * q.x);
+	m.m[2][2] = 1 - 2 * (q.x * q.x + q.y * q.y);
+	return m;
+	}
+
+static SrRefMat srRefMultiply(const SrRefMat& a, const SrRefMat& b)
+	{
+	SrRefMat r;
+	for(int i = 0; i < 3; i++)
+		for(int j = 0; j < 3; j++)
+			r.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j];
+	return r;
+	}
+
+static bool srRefInverse(const SrRefMat& a, SrRefMat& r)
+	{
+	const SrRef (*m)[3] = a.m;
+	r.m[0][0] = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+	r.m[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+	r.m[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+	r.m[1][0] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+	r.m[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+	r.m[1][2] = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+	r.m[2][0] = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+	r.m[2][1] = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+	r.m[2][2] = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+	const SrRef det = m[0][0] * r.m[0][0] + m[0][1] * r.m[1][0] + m[0][2] * r.m[2][0];
+	if(det == 0)
+		return false;
+	for(int i = 0; i < 3; i++)
+		for(int j = 0; j < 3; j++)
+			r.m[i][j] /= det;
+	return true;
+	}
+
+//angle of the rotation that takes the reference to the result.
+static SrRef srRefAngle(const SrRefQuat& result, const SrRefQuat& ref)
+	{
+	const SrRefQuat a = srRefNormalize(result);
+	const SrRefQuat b = srRefNormalize(ref);
+	const SrRefQuat c = { -b.x, -b.y, -b.z, b.w };
+	const SrRefQuat d = srRefMultiply(a, c);
+	return 2.0L * atan2l(sqrtl(d.x * d.x + d.y * d.y + d.z * d.z), fabsl(d.w));
+	}
+
+static SrRef srRefAngle(const SrRefMat& result, const SrRefMat& ref)
+	{
+	//E = result * ref^T, the angle from its skew part and its trace.
+	SrRefMat t;
+	for(int i = 0; i < 3; i++)
+		for(int j = 0; j < 3; j++)
+			t.m[i][j] = ref.m[j][i];
+	const SrRefMat e = srRefMultiply(result, t);
+	const SrRef sx = e.m[2][1] - e.m[1][2];
+	const SrRef sy = e.m[0][2] - e.m[2][0];
+	const SrRef sz = e.m[1][0] - e.m[0][1];
+	return atan2l(0.5L * sqrtl(sx * sx + sy * sy + sz * sz), 0.5L * (e.m[0][0] + e.m[1][1] + e.m[2][2] - 1));
+	}
+
+static SrRef srRefAngle(const SrRefVec& result, const SrRefVec& ref)
+	{
+	const SrRef cx = result.y * ref.z - result.z * ref.y;
+	const SrRef cy = result.z * ref.x - result.x * ref.z;
+	const SrRef cz = result.x * ref.y - result.y * ref.x;
+	return atan2l(sqrtl(cx * cx + cy * cy + cz * cz), result.x * ref.x + result.y * ref.y + result.z * ref.z);
+	}
+
+//a rotation and translation, SrMatrix33 ones have none.
+struct SrRefAffine
+	{
+	SrRefMat m;
+	SrRefVec t;
+	};
+
+static SrRefAffine srRefAffine(const SrMatrix33& m)
+	{
+	const SrRefAffine r = { srRef(m), { 0, 0, 0 } };
+	return r;
+	}
+
+static SrRefAffine srRefAffine(const SrMatrix34& m)
+	{
+	const SrRefAffine r = { srRef(m.M), srRef(m.t) };
+	return r;
+	}
+
+static SrRefVec srRefTransform(const SrRefAffine& a, const SrRefVec& v)
+	{
+	SrRefVec r;
+	r.x = a.m.m[0][0] * v.x + a.m.m[0][1] * v.y + a.m.m[0][2] * v.z + a.t.x;
+	r.y = a.m.m[1][0] * v.x + a.m.m[1][1] * v.y + a.m.m[1][2] * v.z + a.t.y;
+	r.z = a.m.m[2][0] * v.x + a.m.m[2][1] * v.y + a.m.m[2][2] * v.z + a.t.z;
+	return r;
+	}
+
+static SrRefAffine srRefMultiply(const SrRefAffine& a, const SrRefAffine& b)
+	{
+	const SrRefAffine r = { srRefMultiply(a.m, b.m), srRefTransform(a, b.t) };
+	return r;
+	}
+
+//-------------------------------------------------------------------------------- statistics
+
+#define SR_ACC_ULP_BINS		15
+#define SR_ACC_ANGLE_BINS	10
+
+/**
+\brief The errors of one case.
+*/
+struct SrAccStats
+	{
+	SrU32 count;
+	SrU32 nonFinite;
+	SrU32 ulp[SR_ACC_ULP_BINS];
+	SrU32 angle[SR_ACC_ANGLE_BINS];
+	bool hasAngle;
+	SrF64 maxUlp, sumUlp, maxAbs, maxAngle;
+
+	SrAccStats() : count(0), nonFinite(0), hasAngle(false), maxUlp(0), sumUlp(0), maxAbs(0), maxAngle(0)
+		{
+		memset(ulp, 0, sizeof(ulp));
+		memset(angle, 0, sizeof(angle));
+		}
+
+	static SrF64 ulpBound(int bin)
+		{
+		return bin == 0 ? 0.0 : ldexp(1.0, bin - 2);
+		}
+
+	static SrF64 angleBound(int bin)
+		{
+		return pow(10.0, bin - 9.0);
+		}
+
+	/**
+	\brief The ulp error of n components, scaled by the largest reference component.
+	*/
+	void addUlp(const SrF32* f, const SrRef* r, int n)
+		{
+		count++;
+		SrRef scale = 0, err = 0;
+		for(int i = 0; i < n; i++)
+			{
+			if(!(f[i] == f[i]) || fabsf(f[i]) > FLT_MAX)
+				{
+				nonFinite++;
+				return;
+				}
+			scale = std::max(scale, fabsl(r[i]));
+			err = std::max(err, fabsl((SrRef)f[i] - r[i]));
+			}
+		int e = scale > 0 ? ilogbl(scale) : -126;
+		if(e < -126)
+			e = -126;
+		const SrF64 u = (SrF64)(err / ldexpl(1.0L, e - 23));
+		int bin = 0;
+		while(bin < SR_ACC_ULP_BINS - 1 && u > ulpBound(bin))
+			bin++;
+		ulp[bin]++;
+		maxUlp = std::max(maxUlp, u);
+		maxAbs = std::max(maxAbs, (SrF64)err);
+		sumUlp += u;
+		}
+
+	void addAngle(SrRef a)
+		{
+		hasAngle = true;
+		const SrF64 d = (SrF64)a;
+		if(!(d == d))
+			return;
+		int bin = 0;
+		while(bin < SR_ACC_ANGLE_BINS - 1 && d > angleBound(bin))
+			bin++;
+		angle[bin]++;
+		maxAngle = std::max(maxAngle, d);
+		}
+
+	void add(const SrQuaternion& f, SrRefQuat r)
+		{
+		//q and -q are the same rotation.
+		if(srRefDot(srRef(f), r) < 0)
+			r = srRefScale(r, -1.0L);
+		const SrF32 fv[4] = { f.x, f.y, f.z, f.w };
+		const SrRef rv[4] = { r.x, r.y, r.z, r.w };
+		addUlp(fv, rv, 4);
+		addAngle(srRefAngle(srRef(f), r));
+		}
+
+	void add(const SrMatrix33& f, const SrRefMat& r, bool rotation)
+		{
+		SrF32 fv[9];
+		SrRef rv[9];
+		for(int i = 0; i < 9; i++)
+			{
+			fv[i] = f(i / 3, i % 3);
+			rv[i] = r.m[i / 3][i % 3];
+			}
+		addUlp(fv, rv, 9);
+		if(rotation)
+			addAngle(srRefAngle(srRef(f), r));
+		}
+
+	void add(const SrVector3& f, const SrRefVec& r, bool direction)
+		{
+		const SrF32 fv[3] = { f.x, f.y, f.z };
+		const SrRef rv[3] = { r.x, r.y, r.z };
+		addUlp(fv, rv, 3);
+		if(direction)
+			addAngle(srRefAngle(srRef(f), r));
+		}
+
+	void add(SrF32 f, SrRef r)
+		{
+		addUlp(&f, &r, 1);
+		}
+	};
+
+//-------------------------------------------------------------------------------- inputs
+
+class SrAccRandom
+	{
+	public:
+	explicit SrAccRandom(SrU32 seed) : state(seed * 2654435761u + 1u)
+		{
+		}
+
+	//uniform in [lo, hi) with 53 random bits.
+	SrRef uniform(SrRef lo, SrRef hi)
+		{
+		const SrF64 a = (SrF64)(next() >> 5);
+		const SrF64 b = (SrF64)(next() >> 6);
+		return lo + (hi - lo) * (SrRef)((a * 67108864.0 + b) / 9007199254740992.0);
+		}
+
+	//10^u for u uniform in [lo, hi).
+	SrRef logUniform(SrRef lo, SrRef hi)
+		{
+		return powl(10.0L, uniform(lo, hi));
+		}
+
+	SrRefVec direction()
+		{
+		SrRefVec v;
+		SrRef m;
+		do
+			{
+			v.x = uniform(-1, 1);
+			v.y = uniform(-1, 1);
+			v.z = uniform(-1, 1);
+			m = v.x * v.x + v.y * v.y + v.z * v.z;
+			}
+		while(m > 1 || m < 1e-6L);
+		m = 1.0L / sqrtl(m);
+		v.x *= m;
+		v.y *= m;
+		v.z *= m;
+		return v;
+		}
+
+	SrRefQuat rotation()
+		{
+		SrRefQuat q;
+		SrRef m;
+		do
+			{
+			q.x = uniform(-1, 1);
+			q.y = uniform(-1, 1);
+			q.z = uniform(-1, 1);
+			q.w = uniform(-1, 1);
+			m = srRefDot(q, q);
+			}
+		while(m > 1 || m < 1e-6L);
+		return srRefScale(q, 1.0L / sqrtl(m));
+		}
+
+	private:
+	SrU32 next()
+		{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+		}
+
+	SrU32 state;
+	};
+
+/**
+\brief Quaternion pairs, a parameter and a vector per element, AoS and SoA.
+*/
+struct SrAccQuats
+	{
+	std::vector<SrQuaternion> a, b;
+	std::vector<SrF32> t;
+	std::vector<SrVector3> v;
+	SrQuaternionSoA sa, sb;
+	SrVector3SoA sv;
+
+	SrU32 size() const { return (SrU32)a.size(); }
+
+	/*
+	random			independent rotations
+	near-parallel	b is a turned by 1e-7 to 1e-2 rad
+	near-opposite	the same with b negated, the shortest path is still short
+	unnormalized	a scaled by 1e-3 to 1e3
+	small			a within 1e-7 to 1e-1 rad of the identity, v of length 1e-7 to 1e-1
+	*/
+	SrAccQuats(const char* set, SrU32 n) : a(n), b(n), t(n), v(n)
+		{
+		SrAccRandom r(1);
+		for(SrU32 i = 0; i < n; i++)
+			{
+			const SrRefQuat qa = r.rotation();
+			SrRefQuat qb = r.rotation();
+			SrRef scale = 1;
+			if(strcmp(set, "near-parallel") == 0 || strcmp(set, "near-opposite") == 0)
+				{
+				qb = srRefMultiply(qa, srRefAngleAxis(r.logUniform(-7, -2), r.direction()));
+				if(strcmp(set, "near-opposite") == 0)
+					qb = srRefScale(qb, -1.0L);
+				}
+			else if(strcmp(set, "unnormalized") == 0)
+				scale = r.logUniform(-3, 3);
+			const bool small = strcmp(set, "small") == 0;
+			a[i] = srRound(srRefScale(small ? srRefAngleAxis(r.logUniform(-7, -1), r.direction()) : qa, scale));
+			b[i] = srRound(qb);
+			t[i] = (SrF32)r.uniform(0, 1);
+			const SrRefVec d = r.direction();
+			const SrRef m = small ? r.logUniform(-7, -1) : r.uniform(0.1L, 10);
+			v[i] = SrVector3((SrF32)(d.x * m), (SrF32)(d.y * m), (SrF32)(d.z * m));
+			}
+		sa.setAoS(&a[0], n);
+		sb.setAoS(&b[0], n);
+		sv.setAoS(&v[0], n);
+		}
+	};
+
+/**
+\brief Matrices, with the exact rotation each one was rounded from.
+*/
+struct SrAccMatrices
+	{
+	std::vector<SrMatrix33> m, m2;
+	std::vector<SrRefQuat> source;
+
+	SrU32 size() const { return (SrU32)m.size(); }
+
+	/*
+	random			rotations
+	near-180		rotations by pi - 1e-7 to pi - 1e-1
+	near-identity	rotations by 1e-7 to 1e-1
+	general			elements uniform in [-1, 1]
+	near-singular	the third row within 1e-6 to 1e-2 of a combination of the others
+	*/
+	SrAccMatrices(const char* set, SrU32 n) : m(n), m2(n), source(n)
+		{
+		SrAccRandom r(2);
+		for(SrU32 i = 0; i < n; i++)
+			{
+			SrRefQuat q = r.rotation();
+			if(strcmp(set, "near-180") == 0)
+				q = srRefAngleAxis(3.14159265358979323846L - r.logUniform(-7, -1), r.direction());
+			else if(strcmp(set, "near-identity") == 0)
+				q = srRefAngleAxis(r.logUniform(-7, -1), r.direction());
+			source[i] = q;
+			m[i] = srRound(srRefFromQuat(q));
+			m2[i] = srRound(srRefFromQuat(r.rotation()));
+			if(strcmp(set, "general") == 0 || strcmp(set, "near-singular") == 0)
+				{
+				SrRefMat g;
+				for(int j = 0; j < 3; j++)
+					for(int k = 0; k < 3; k++)
+						g.m[j][k] = r.uniform(-1, 1);
+				if(strcmp(set, "near-singular") == 0)
+					{
+					const SrRef ca = r.uniform(-1, 1), cb = r.uniform(-1, 1), eps = r.logUniform(-6, -2);
+					for(int k = 0; k < 3; k++)
+						g.m[2][k] = ca * g.m[0][k] + cb * g.m[1][k] + eps * r.uniform(-1, 1);
+					}
+				m[i] = srRound(g);
+				}
+			}
+		}
+	};
+
+/**
+\brief A transform and points.
+*/
+struct SrAccPoints
+	{
+	SrMatrix34 pose;
+	std::vector<SrVector3> v;
+	std::vector<SrVector3F16> h;
+
+	SrU32 size() const { return (SrU32)v.size(); }
+
+	/*
+	random		points in [-10, 10]^3
+	half		the same rounded to half precision, v holds their exact float values
+	*/
+	SrAccPoints(const char* set, SrU32 n) : v(n), h(n)
+		{
+		SrAccRandom r(3);
+		pose.M = srRound(srRefFromQuat(r.rotation()));
+		pose.t = SrVector3(10.0f, -20.0f, 5.0f);
+		for(SrU32 i = 0; i < n; i++)
+			{
+			v[i] = SrVector3((SrF32)r.uniform(-10, 10), (SrF32)r.uniform(-10, 10), (SrF32)r.uniform(-10, 10));
+			h[i] = SrVector3F16(v[i]);
+			if(strcmp(set, "half") == 0)
+				v[i] = SrVector3(h[i]);
+			}
+		}
+	};
+
+/**
+\brief Skinned vertices, 4 influences each, and their bone palette.
+*/
+struct SrAccSkin
+	{
+	std::vector<SrDualQuaternion> palette;
+	std::vector<SrMatrix34> matrices;
+	std::vector<SrU16> bones;
+	std::vector<SrF32> weights;
+	std::vector<SrVector3> v;
+	SrVector3SoA sv;
+
+	SrU32 size() const { return (SrU32)v.size(); }
+
+	/*
+	random		64 random rigid bones translated by up to 1, points in [-1, 1]^3 with 4
+				random bones and weights, matrices are the same bones
+	*/
+	SrAccSkin(const char*, SrU32 n) : palette(64), matrices(64), bones(4 * n), weights(4 * n), v(n), sv(n)
+		{
+		SrAccRandom r(8);
+		for(SrU32 b = 0; b < palette.size(); b++)
+			{
+			palette[b].set(srRound(r.rotation()), SrVector3((SrF32)r.uniform(-1, 1), (SrF32)r.uniform(-1, 1), (SrF32)r.uniform(-1, 1)));
+			palette[b].toMatrix(matrices[b]);
+			}
+		for(SrU32 i = 0; i < n; i++)
+			{
+			SrRef w[4], sum = 0;
+			for(int k = 0; k < 4; k++)
+				{
+				bones[4 * i + k] = (SrU16)(r.uniform(0, 1) * palette.size());
+				w[k] = r.uniform(0, 1);
+				sum += w[k];
+				}
+			for(int k = 0; k < 4; k++)
+				weights[4 * i + k] = (SrF32)(w[k] / sum);
+			v[i] = SrVector3((SrF32)r.uniform(-1, 1), (SrF32)r.uniform(-1, 1), (SrF32)r.uniform(-1, 1));
+			}
+		sv.setAoS(&v[0], n);
+		}
+	};
+
+/**
+\brief Local poses of instances of one skeleton.
+*/
+struct SrAccSkeleton
+	{
+	SrSkeleton skeleton;
+	std::vector<SrF32> lanes[7];
+	std::vector<SrQuaternionSoA> rotations;
+	std::vector<SrVector3SoA> translations;
+	std::vector<SrMatrix34> local;
+
+	SrU32 getInstances() const { return (SrU32)rotations.size(); }
+	SrU32 size() const { return getInstances() * skeleton.getBoneCount(); }
+
+	/*
+	random		64 bones, each the child of a random earlier one, every 16th a root,
+				n / 64 instances with random rotations and translations by up to 1
+	*/
+	SrAccSkeleton(const char*, SrU32 n) : rotations((n + 63) / 64), translations((n + 63) / 64)
+		{
+		SrAccRandom r(9);
+		const SrU32 bones = 64, instances = getInstances();
+		SrI32 parents[bones];
+		for(SrU32 j = 0; j < bones; j++)
+			parents[j] = j % 16 == 0 ? -1 : (SrI32)(r.uniform(0, 1) * j);
+		skeleton.setParents(parents, bones);
+
+		for(int k = 0; k < 7; k++)
+			lanes[k].resize(bones * instances);
+		local.resize(bones * instances);
+		for(SrU32 i = 0; i < instances; i++)
+			{
+			rotations[i].resize(bones);
+			translations[i].resize(bones);
+			for(SrU32 j = 0; j < bones; j++)
+				{
+				const SrQuaternion q = srRound(r.rotation());
+				const SrVector3 t((SrF32)r.uniform(-1, 1), (SrF32)r.uniform(-1, 1), (SrF32)r.uniform(-1, 1));
+				const SrF32 v[7] = { q.x, q.y, q.z, q.w, t.x, t.y, t.z };
+				for(int k = 0; k < 7; k++)
+					lanes[k][j * instances + i] = v[k];
+				rotations[i].x[j] = q.x; rotations[i].y[j] = q.y; rotations[i].z[j] = q.z; rotations[i].w[j] = q.w;
+				translations[i].x[j] = t.x; translations[i].y[j] = t.y; translations[i].z[j] = t.z;
+				local[i * bones + j] = SrMatrix34(SrMatrix33(q), t);
+				}
+			}
+		}
+	};
+
+/**
+\brief Chains of three matrices and a point to transform.
+*/
+struct SrAccChains
+	{
+	std::vector<SrMatrix33> m33[3];
+	std::vector<SrMatrix34> m34[3];
+	std::vector<SrVector3> v;
+
+	SrU32 size() const { return (SrU32)v.size(); }
+
+	/*
+	random		rotations translated by up to 1, the SrMatrix33 chains are the rotations,
+				points in [-10, 10]^3
+	*/
+	SrAccChains(const char*, SrU32 n) : v(n)
+		{
+		SrAccRandom r(10);
+		for(int k = 0; k < 3; k++)
+			{
+			m33[k].resize(n);
+			m34[k].resize(n);
+			}
+		for(SrU32 i = 0; i < n; i++)
+			{
+			for(int k = 0; k < 3; k++)
+				{
+				m33[k][i] = srRound(srRefFromQuat(r.rotation()));
+				m34[k][i] = SrMatrix34(m33[k][i], SrVector3((SrF32)r.uniform(-1, 1), (SrF32)r.uniform(-1, 1), (SrF32)r.uniform(-1, 1)));
+				}
+			v[i] = SrVector3((SrF32)r.uniform(-10, 10), (SrF32)r.uniform(-10, 10), (SrF32)r.uniform(-10, 10));
+			}
+		}
+	};
+
+/**
+\brief Points of the unit cube.
+*/
+struct SrAccCube
+	{
+	std::vector<SrF32> u1, u2, u3;
+
+	SrU32 size() const { return (SrU32)u1.size(); }
+
+	/*
+	random			uniform in [0, 1)^3
+	edges			u1 within 1e-7 to 1e-1 of 0 or 1, one of the axes of the rotation near zero
+	*/
+	SrAccCube(const char* set, SrU32 n) : u1(n), u2(n), u3(n)
+		{
+		SrAccRandom r(5);
+		for(SrU32 i = 0; i < n; i++)
+			{
+			SrRef a = r.uniform(0, 1);
+			if(strcmp(set, "edges") == 0)
+				{
+				a = r.logUniform(-7, -1);
+				if(r.uniform(0, 1) < 0.5L)
+					a = 1 - a;
+				}
+			u1[i] = (SrF32)a;
+			u2[i] = (SrF32)r.uniform(0, 1);
+			u3[i] = (SrF32)r.uniform(0, 1);
+			}
+		}
+	};
+
+/**
+\brief The range of an SrRandomBatch fill.
+*/
+struct SrAccFill
+	{
+	SrU32 n;
+	SrF32 a, b;
+
+	SrU32 size() const { return n; }
+
+	/*
+	unit		[0, 1), n + 5 floats so the last group of SR_RANDOM_LANES is partial
+	range		the same in [-3, 5]
+	*/
+	SrAccFill(const char* set, SrU32 n) : n(n + 5), a(0.0f), b(1.0f)
+		{
+		if(strcmp(set, "range") == 0)
+			{
+			a = -3.0f;
+			b = 5.0f;
+			}
+		}
+	};
+
+/**
+\brief Arguments of the scalar functions.
+*/
+struct SrAccScalars
+	{
+	std::vector<SrF32> x, y;
+
+	SrU32 size() const { return (SrU32)x.size(); }
+
+	/*
+	pi				[-pi, pi]
+	large			[-1e4, 1e4]
+	near-pi			within 1e-6 to 1e-1 of a multiple of pi/2 up to 100 pi
+	unit			[-1, 1]
+	near-one		within 1e-7 to 1e-1 of -1 or 1
+	wide			+-1e-3 to 1e3
+	near-axes		atan2 arguments within 1e-6 to 1e-1 rad of an axis
+	octant			atan2 arguments 0.4 to 0.5 rad from an axis, past the tan(pi/8) reduction
+	exp				[-80, 80]
+	positive		1e-30 to 1e30
+	*/
+	SrAccScalars(const char* set, SrU32 n) : x(n), y(n)
+		{
+		SrAccRandom r(4);
+		const SrRef pi = 3.14159265358979323846L;
+		for(SrU32 i = 0; i < n; i++)
+			{
+			SrRef a = 0, b = r.uniform(-1, 1);
+			const SrRef s = r.uniform(0, 1) < 0.5L ? -1 : 1;
+			if(strcmp(set, "pi") == 0)
+				a = r.uniform(-pi, pi);
+			else if(strcmp(set, "large") == 0)
+				a = r.uniform(-1e4L, 1e4L);
+			else if(strcmp(set, "near-pi") == 0)
+				a = floorl(r.uniform(-200, 200)) * pi * 0.5L + s * r.logUniform(-6, -1);
+			else if(strcmp(set, "unit") == 0)
+				a = r.uniform(-1, 1);
+			else if(strcmp(set, "near-one") == 0)
+				a = s * (1 - r.logUniform(-7, -1));
+			else if(strcmp(set, "wide") == 0)
+				a = s * r.logUniform(-3, 3);
+			else if(strcmp(set, "near-axes") == 0)
+				{
+				const SrRef angle = floorl(r.uniform(0, 4)) * pi * 0.5L + s * r.logUniform(-6, -1);
+				const SrRef m = r.logUniform(-2, 2);
+				a = cosl(angle) * m;
+				b = sinl(angle) * m;
+				}
+			else if(strcmp(set, "octant") == 0)
+				{
+				const SrRef angle = floorl(r.uniform(0, 4)) * pi * 0.5L + s * r.uniform(0.4L, 0.5L);
+				const SrRef m = r.logUniform(-2, 2);
+				a = cosl(angle) * m;
+				b = sinl(angle) * m;
+				}
+			else if(strcmp(set, "exp") == 0)
+				a = r.uniform(-80, 80);
+			else if(strcmp(set, "positive") == 0)
+				a = r.logUniform(-30, 30);
+			x[i] = (SrF32)a;
+			y[i] = (SrF32)b;
+			}
+		}
+	};
+
+/**
+\brief Keyframes of a rotation curve and sorted sample times over them.
+*/
+struct SrAccKeys
+	{
+	std::vector<SrQuaternion> keys;
+	std::vector<SrF32> times, t;
+	SrQuaternionSpline squad, bspline;
+
+	SrU32 size() const { return (SrU32)t.size(); }
+
+	/*
+	random-walk		256 keys, each turned from the last by up to 1 rad, with random signs,
+					spaced 0.25 to 1.75 apart
+	slow			the same with turns of 1e-5 to 1e-2 rad
+	*/
+	SrAccKeys(const char* set, SrU32 n) : keys(256), times(256), t(n)
+		{
+		SrAccRandom r(5);
+		const bool slow = strcmp(set, "slow") == 0;
+		SrRefQuat q = r.rotation();
+		SrRef time = 0;
+		for(SrU32 i = 0; i < keys.size(); i++)
+			{
+			q = srRefNormalize(srRefMultiply(srRefAngleAxis(slow ? r.logUniform(-5, -2) : r.uniform(0, 1), r.direction()), q));
+			keys[i] = srRound(srRefScale(q, r.uniform(0, 1) < 0.5L ? -1.0L : 1.0L));
+			times[i] = (SrF32)time;
+			time += r.uniform(0.25L, 1.75L);
+			}
+		for(SrU32 i = 0; i < n; i++)
+			t[i] = (SrF32)r.uniform(0, times.back());
+		std::sort(t.begin(), t.end());
+		squad.setKeys(SR_QUAT_SPLINE_SQUAD, &keys[0], &times[0], (SrU32)keys.size());
+		bspline.setKeys(SR_QUAT_SPLINE_BSPLINE, &keys[0], &times[0], (SrU32)keys.size());
+		}
+	};
+
+/**
+\brief Animation tracks, one instance per element with its track, time and cursor.
+*/
+struct SrAccTracks
+	{
+	std::vector<SrAnimationTrack> tracks;
+	std::vector<const SrAnimationTrack*> track;
+	std::vector<SrF32> t;
+	std::vector<SrTrackCursor> cursors;
+
+	SrU32 size() const { return (SrU32)t.size(); }
+
+	/*
+	playback	64 tracks of 120 keys turned by up to 1 rad and spaced 0.5 to 1.5 apart,
+				the cursors on the segment of the previous frame, 1/60 earlier
+	seek		random times with fresh cursors, every lookup is a binary search
+	*/
+	SrAccTracks(const char* set, SrU32 n) : tracks(64), track(n), t(n), cursors(n)
+		{
+		SrAccRandom r(6);
+		std::vector<SrF32> times(120);
+		std::vector<SrQuaternion> rotations(120);
+		std::vector<SrVector3> translations(120);
+		for(SrU32 j = 0; j < tracks.size(); j++)
+			{
+			SrRefQuat q = r.rotation();
+			SrRef time = 0;
+			for(SrU32 k = 0; k < times.size(); k++)
+				{
+				q = srRefNormalize(srRefMultiply(srRefAngleAxis(r.uniform(0, 1), r.direction()), q));
+				rotations[k] = srRound(q);
+				translations[k] = SrVector3((SrF32)r.uniform(-1, 1), (SrF32)r.uniform(-1, 1), (SrF32)r.uniform(-1, 1));
+				times[k] = (SrF32)time;
+				time += r.uniform(0.5L, 1.5L);
+				}
+			tracks[j].setKeys(&times[0], &rotations[0], &translations[0], (SrU32)times.size());
+			}
+		const bool playback = strcmp(set, "playback") == 0;
+		for(SrU32 i = 0; i < n; i++)
+			{
+			track[i] = &tracks[i % tracks.size()];
+			t[i] = (SrF32)r.uniform(0, track[i]->getEndTime());
+			if(playback)
+				{
+				SrF32 u;
+				track[i]->findKey(t[i] - 1.0f / 60.0f, cursors[i], u);
+				}
+			}
+		}
+	};
+
+/**
+\brief Recorded motion tracks, reduced, with random sample times.
+*/
+struct SrAccReducedTracks
+	{
+	std::vector<SrAnimationTrack> tracks, reduced;
+	std::vector<SrU32> track;
+	std::vector<SrF32> t;
+
+	SrU32 size() const { return (SrU32)t.size(); }
+
+	/*
+	mocap		16 tracks of 10 s at 120 Hz, turning at up to 3 rad/s and moving at up to
+				1 m/s along smooth random curves, reduced for correctedNlerp playback to
+				1e-3 rad and 1e-3
+	fast		the same turning at 12 rad/s, 0.1 rad per key, about the same axes, where
+				the margin alone fails the segments that only skip the midpoint of two keys
+	short		mocap with an empty track and a single key track among them, copied as they
+				are and not sampled
+	*/
+	SrAccReducedTracks(const char* set, SrU32 n) : tracks(16), reduced(16), track(n), t(n)
+		{
+		SrAccRandom r(7);
+		const bool fast = strcmp(set, "fast") == 0;
+		const bool few = strcmp(set, "short") == 0;
+		const SrU32 keys = 1200;
+		std::vector<SrF32> times(keys);
+		std::vector<SrQuaternion> rotations(keys);
+		std::vector<SrVector3> translations(keys);
+		for(SrU32 j = 0; j < tracks.size(); j++)
+			{
+			//velocities of three sines per component.
+			SrRef amplitude[2][3], frequency[2][3][3], phase[2][3][3];
+			for(int c = 0; c < 2; c++)
+				for(int a = 0; a < 3; a++)
+					{
+					amplitude[c][a] = c ? 1.0L / 3 : r.uniform(0.5L, 3.0L) / 3;
+					for(int k = 0; k < 3; k++)
+						{
+						frequency[c][a][k] = r.uniform(0.2L, 2.2L) * 2 * SrPiF64;
+						phase[c][a][k] = r.uniform(0, 2 * SrPiF64);
+						}
+					}
+			SrRefQuat q = r.rotation();
+			SrRefVec p = { 0, 0, 0 };
+			for(SrU32 k = 0; k < keys; k++)
+				{
+				const SrRef time = k / 120.0L;
+				times[k] = (SrF32)time;
+				rotations[k] = srRound(q);
+				translations[k] = SrVector3((SrF32)p.x, (SrF32)p.y, (SrF32)p.z);
+				SrRef v[2][3];
+				for(int c = 0; c < 2; c++)
+					for(int a = 0; a < 3; a++)
+						{
+						v[c][a] = 0;
+						for(int l = 0; l < 3; l++)
+							v[c][a] += amplitude[c][a] * sinl(frequency[c][a][l] * time + phase[c][a][l]);
+						}
+				const SrRef w = sqrtl(v[0][0] * v[0][0] + v[0][1] * v[0][1] + v[0][2] * v[0][2]);
+				if(w > 0)
+					{
+					const SrRefVec axis = { v[0][0] / w, v[0][1] / w, v[0][2] / w };
+					q = srRefNormalize(srRefMultiply(srRefAngleAxis((fast ? 12 : std::min(w, 3.0L)) / 120, axis), q));
+					}
+				p.x += v[1][0] / 120;
+				p.y += v[1][1] / 120;
+				p.z += v[1][2] / 120;
+				}
+			if(!few || j > 2)
+				tracks[j].setKeys(&times[0], &rotations[0], &translations[0], keys);
+			else if(j == 2)
+				tracks[j].setKeys(&times[0], &rotations[0], &translations[0], 1);
+			}
+		SrTrackReducer::reduce(SR_QUAT_CORRECTED_NLERP, &tracks[0], &reduced[0], (SrU32)tracks.size(), 1e-3f, 1e-3f);
+		for(SrU32 i = 0; i < n; i++)
+			{
+			track[i] = i % tracks.size();
+			while(tracks[track[i]].getKeyCount() < 2)
+				track[i] = (track[i] + 1) % tracks.size();
+			t[i] = (SrF32)r.uniform(0, tracks[track[i]].getEndTime());
+			}
+		}
+	};
+
+//-------------------------------------------------------------------------------- cases
+
+/*
+A case is an evaluation, timed, and a check that adds the errors of all elements. Both
+are plain functions over the input set and the output array.
+*/
+
+//quaternion interpolations against the exact slerp.
+static void srAccCheckInterpolation(const SrAccQuats& in, const std::vector<SrQuaternion>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		s.add(out[i], srRefSlerp(in.t[i], srRefNormalize(srRef(in.a[i])), srRefNormalize(srRef(in.b[i]))));
+	}
+
+template<int M>
+static void srAccMemberInterpolation(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		if(M == SR_QUAT_SLERP)
+			out[i].slerp(in.t[i], in.a[i], in.b[i]);
+		else if(M == SR_QUAT_NLERP)
+			out[i].nlerp(in.t[i], in.a[i], in.b[i]);
+		else
+			out[i].correctedNlerp(in.t[i], in.a[i], in.b[i]);
+		}
+	}
+
+template<int M>
+static void srAccBatchInterpolation(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	out.resize(in.size());
+	if(M == SR_QUAT_SLERP)
+		SrQuaternionBatch::slerp(&in.t[0], &in.a[0], &in.b[0], &out[0], in.size());
+	else if(M == SR_QUAT_NLERP)
+		SrQuaternionBatch::nlerp(&in.t[0], &in.a[0], &in.b[0], &out[0], in.size());
+	else
+		SrQuaternionBatch::correctedNlerp(&in.t[0], &in.a[0], &in.b[0], &out[0], in.size());
+	}
+
+static void srAccMemberMultiply(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i].multiply(in.a[i], in.b[i]);
+	}
+
+static void srAccCheckMultiply(const SrAccQuats& in, const std::vector<SrQuaternion>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		s.add(out[i], srRefMultiply(srRef(in.a[i]), srRef(in.b[i])));
+	}
+
+static void srAccMemberNormalize(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	out = in.a;
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i].normalize();
+	}
+
+static void srAccBatchNormalize(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	out = in.a;
+	SrQuaternionBatch::normalize(&out[0], in.size());
+	}
+
+static void srAccCheckNormalize(const SrAccQuats& in, const std::vector<SrQuaternion>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		s.add(out[i], srRefNormalize(srRef(in.a[i])));
+	}
+
+static void srAccMemberFromAngleAxis(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i].fromAngleAxis(in.t[i] * 360.0f, in.v[i]);
+	}
+
+static void srAccMemberFromAngleAxisFast(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		//the fast version takes a unit axis.
+		SrVector3 axis = in.v[i];
+		axis.normalize();
+		out[i].fromAngleAxisFast(in.t[i] * SrTwoPiF32, axis);
+		}
+	}
+
+static void srAccCheckFromAngleAxis(const SrAccQuats& in, const std::vector<SrQuaternion>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		s.add(out[i], srRefAngleAxis((SrRef)in.t[i] * 2.0L * 3.14159265358979323846L, srRef(in.v[i])));
+	}
+
+static void srAccMemberRotate(const SrAccQuats& in, std::vector<SrVector3>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i] = in.a[i].rot(in.v[i]);
+	}
+
+static void srAccBatchRotate(const SrAccQuats& in, std::vector<SrVector3>& out)
+	{
+	static SrVector3SoA dst;
+	SrQuaternionBatch::rotate(in.sa, in.sv, dst);
+	out.resize(in.size());
+	dst.getAoS(&out[0]);
+	}
+
+static void srAccCheckRotate(const SrAccQuats& in, const std::vector<SrVector3>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		s.add(out[i], srRefRotate(srRefNormalize(srRef(in.a[i])), srRef(in.v[i])), true);
+	}
+
+static void srAccMemberFromQuat(const SrAccQuats& in, std::vector<SrMatrix33>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i].fromQuat(in.a[i]);
+	}
+
+static void srAccBatchFromQuat(const SrAccQuats& in, std::vector<SrMatrix33>& out)
+	{
+	out.resize(in.size());
+	SrMatrix33Batch::fromQuat(&in.a[0], &out[0], in.size());
+	}
+
+static void srAccCheckFromQuat(const SrAccQuats& in, const std::vector<SrMatrix33>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		s.add(out[i], srRefFromQuat(srRefNormalize(srRef(in.a[i]))), true);
+	}
+
+static void srAccMemberToQuat(const SrAccMatrices& in, std::vector<SrQuaternion>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		in.m[i].toQuat(out[i]);
+	}
+
+static void srAccBatchToQuat(const SrAccMatrices& in, std::vector<SrQuaternion>& out)
+	{
+	out.resize(in.size());
+	SrMatrix33Batch::toQuat(&in.m[0], &out[0], in.size());
+	}
+
+//against the rotation the matrix was rounded from, the rounding is part of the error.
+static void srAccCheckToQuat(const SrAccMatrices& in, const std::vector<SrQuaternion>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		s.add(out[i], in.source[i]);
+	}
+
+static void srAccMemberMatrixMultiply(const SrAccMatrices& in, std::vector<SrMatrix33>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i].multiply(in.m[i], in.m2[i]);
+	}
+
+static void srAccBatchMatrixMultiply(const SrAccMatrices& in, std::vector<SrMatrix33>& out)
+	{
+	out.resize(in.size());
+	SrMatrix33Batch::multiply(&in.m[0], &in.m2[0], &out[0], in.size());
+	}
+
+static void srAccCheckMatrixMultiply(const SrAccMatrices& in, const std::vector<SrMatrix33>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		s.add(out[i], srRefMultiply(srRef(in.m[i]), srRef(in.m2[i])), true);
+	}
+
+//matrix chains, eager and through srLazy(), the lazy matrix bit for bit the eager one.
+static const std::vector<SrMatrix33>* srAccChain(const SrAccChains& in, const SrMatrix33*)
+	{
+	return in.m33;
+	}
+
+static const std::vector<SrMatrix34>* srAccChain(const SrAccChains& in, const SrMatrix34*)
+	{
+	return in.m34;
+	}
+
+template<class M>
+static void srAccEagerChain(const SrAccChains& in, std::vector<SrVector3>& out)
+	{
+	const std::vector<M>* m = srAccChain(in, (const M*)NULL);
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i] = m[0][i] * m[1][i] * m[2][i] * in.v[i];
+	}
+
+template<class M>
+static void srAccLazyChain(const SrAccChains& in, std::vector<SrVector3>& out)
+	{
+	const std::vector<M>* m = srAccChain(in, (const M*)NULL);
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i] = srLazy(m[0][i]) * m[1][i] * m[2][i] * in.v[i];
+	}
+
+template<class M>
+static void srAccCheckChain(const SrAccChains& in, const std::vector<SrVector3>& out, SrAccStats& s)
+	{
+	const std::vector<M>* m = srAccChain(in, (const M*)NULL);
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		const SrRefAffine a = srRefMultiply(srRefMultiply(srRefAffine(m[0][i]), srRefAffine(m[1][i])), srRefAffine(m[2][i]));
+		s.add(out[i], srRefTransform(a, srRef(in.v[i])), false);
+		}
+	}
+
+template<class M>
+static void srAccEagerProduct(const SrAccChains& in, std::vector<M>& out)
+	{
+	const std::vector<M>* m = srAccChain(in, (const M*)NULL);
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i] = m[0][i] * m[1][i] * m[2][i];
+	}
+
+template<class M>
+static void srAccLazyProduct(const SrAccChains& in, std::vector<M>& out)
+	{
+	const std::vector<M>* m = srAccChain(in, (const M*)NULL);
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		const M r = srLazy(m[0][i]) * m[1][i] * m[2][i];
+		out[i] = r;
+		}
+	}
+
+static void srAccAddProduct(SrAccStats& s, const SrMatrix33& f, const SrRefAffine& r)
+	{
+	s.add(f, r.m, true);
+	}
+
+static void srAccAddProduct(SrAccStats& s, const SrMatrix34& f, const SrRefAffine& r)
+	{
+	s.add(f.M, r.m, true);
+	s.add(f.t, r.t, false);
+	}
+
+template<class M>
+static void srAccCheckProduct(const SrAccChains& in, const std::vector<M>& out, SrAccStats& s)
+	{
+	const std::vector<M>* m = srAccChain(in, (const M*)NULL);
+	std::vector<M> eager;
+	srAccEagerProduct<M>(in, eager);
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		//a product that differs from the eager one counts as a non finite result.
+		if(memcmp(&out[i], &eager[i], sizeof(M)) != 0)
+			s.nonFinite++;
+		const SrRefAffine a = srRefMultiply(srRefMultiply(srRefAffine(m[0][i]), srRefAffine(m[1][i])), srRefAffine(m[2][i]));
+		srAccAddProduct(s, out[i], a);
+		}
+	}
+
+static void srAccMemberInverse(const SrAccMatrices& in, std::vector<SrMatrix33>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		in.m[i].getInverse(out[i]);
+	}
+
+static void srAccCheckInverse(const SrAccMatrices& in, const std::vector<SrMatrix33>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		SrRefMat r;
+		if(srRefInverse(srRef(in.m[i]), r))
+			s.add(out[i], r, false);
+		}
+	}
+
+static void srAccMemberTransform(const SrAccPoints& in, std::vector<SrVector3>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		in.pose.multiply(in.v[i], out[i]);
+	}
+
+static void srAccBatchTransform(const SrAccPoints& in, std::vector<SrVector3>& out)
+	{
+	out.resize(in.size());
+	SrMatrix34Batch::transformPoints(in.pose, &in.v[0], &out[0], in.size());
+	}
+
+static void srAccBatchTransformHalf(const SrAccPoints& in, std::vector<SrVector3>& out)
+	{
+	out.resize(in.size());
+	SrMatrix34Batch::transformPoints(in.pose, &in.h[0], &out[0], in.size());
+	}
+
+static void srAccCheckTransform(const SrAccPoints& in, const std::vector<SrVector3>& out, SrAccStats& s)
+	{
+	const SrRefMat m = srRef(in.pose.M);
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		const SrRefVec v = srRef(in.v[i]);
+		SrRefVec r;
+		r.x = m.m[0][0] * v.x + m.m[0][1] * v.y + m.m[0][2] * v.z + in.pose.t.x;
+		r.y = m.m[1][0] * v.x + m.m[1][1] * v.y + m.m[1][2] * v.z + in.pose.t.y;
+		r.z = m.m[2][0] * v.x + m.m[2][1] * v.y + m.m[2][2] * v.z + in.pose.t.z;
+		s.add(out[i], r, false);
+		}
+	}
+
+//dual quaternion skinning against the normalized blend of the palette entries as given.
+static void srAccMemberSkin(const SrAccSkin& in, std::vector<SrVector3>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i] = SrSkinning::skin(&in.palette[0], &in.bones[4 * i], &in.weights[4 * i], in.v[i]);
+	}
+
+static void srAccBatchSkin(const SrAccSkin& in, std::vector<SrVector3>& out)
+	{
+	static SrVector3SoA dst;
+	SrSkinning::skin(&in.palette[0], &in.bones[0], &in.weights[0], in.sv, dst, 1);
+	out.resize(in.size());
+	dst.getAoS(&out[0]);
+	}
+
+static void srAccCheckSkin(const SrAccSkin& in, const std::vector<SrVector3>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		SrRefQuat r = { 0, 0, 0, 0 }, d = { 0, 0, 0, 0 };
+		const SrRefQuat first = srRef(in.palette[in.bones[4 * i]].real);
+		for(int k = 0; k < 4; k++)
+			{
+			const SrDualQuaternion& b = in.palette[in.bones[4 * i + k]];
+			const SrRefQuat br = srRef(b.real), bd = srRef(b.dual);
+			const SrRef w = srRefDot(br, first) < 0 ? -(SrRef)in.weights[4 * i + k] : in.weights[4 * i + k];
+			r.x += w * br.x; r.y += w * br.y; r.z += w * br.z; r.w += w * br.w;
+			d.x += w * bd.x; d.y += w * bd.y; d.z += w * bd.z; d.w += w * bd.w;
+			}
+		const SrRef length = sqrtl(srRefDot(r, r));
+		r = srRefScale(r, 1.0L / length);
+		d = srRefScale(d, 1.0L / length);
+		SrRefVec p = srRefRotate(r, srRef(in.v[i]));
+		p.x += 2 * (r.w * d.x - d.w * r.x + r.y * d.z - r.z * d.y);
+		p.y += 2 * (r.w * d.y - d.w * r.y + r.z * d.x - r.x * d.z);
+		p.z += 2 * (r.w * d.z - d.w * r.z + r.x * d.y - r.y * d.x);
+		s.add(out[i], p, false);
+		}
+	}
+
+//linear blend skinning against the weighted sum of the palette matrices.
+static void srAccMemberSkinMatrix(const SrAccSkin& in, std::vector<SrVector3>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i] = SrSkinning::skin(&in.matrices[0], &in.bones[4 * i], &in.weights[4 * i], in.v[i]);
+	}
+
+static void srAccBatchSkinMatrix(const SrAccSkin& in, std::vector<SrVector3>& out)
+	{
+	static SrVector3SoA dst;
+	SrSkinning::skin(&in.matrices[0], &in.bones[0], &in.weights[0], in.sv, dst, 1);
+	out.resize(in.size());
+	dst.getAoS(&out[0]);
+	}
+
+static void srAccCheckSkinMatrix(const SrAccSkin& in, const std::vector<SrVector3>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		const SrRefVec v = srRef(in.v[i]);
+		SrRefVec p = { 0, 0, 0 };
+		for(int k = 0; k < 4; k++)
+			{
+			const SrMatrix34& b = in.matrices[in.bones[4 * i + k]];
+			const SrRef w = in.weights[4 * i + k];
+			p.x += w * ((SrRef)b.M(0, 0) * v.x + (SrRef)b.M(0, 1) * v.y + (SrRef)b.M(0, 2) * v.z + b.t.x);
+			p.y += w * ((SrRef)b.M(1, 0) * v.x + (SrRef)b.M(1, 1) * v.y + (SrRef)b.M(1, 2) * v.z + b.t.y);
+			p.z += w * ((SrRef)b.M(2, 0) * v.x + (SrRef)b.M(2, 1) * v.y + (SrRef)b.M(2, 2) * v.z + b.t.z);
+			}
+		s.add(out[i], p, false);
+		}
+	}
+
+//world translations of the skeleton against the chain of local transforms, composed in
+//long double from the rotations as given.
+static void srAccMemberSkeleton(const SrAccSkeleton& in, std::vector<SrVector3>& out)
+	{
+	static std::vector<SrMatrix34> world;
+	const SrU32 bones = in.skeleton.getBoneCount();
+	world.resize(bones);
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.getInstances(); i++)
+		{
+		in.skeleton.localToWorld(in.rotations[i], in.translations[i], &world[0]);
+		for(SrU32 j = 0; j < bones; j++)
+			out[i * bones + j] = world[j].t;
+		}
+	}
+
+static void srAccBatchSkeleton(const SrAccSkeleton& in, std::vector<SrVector3>& out)
+	{
+	static std::vector<SrMatrix34> world;
+	world.resize(in.size());
+	const SrF32* const pose[7] = { &in.lanes[0][0], &in.lanes[1][0], &in.lanes[2][0], &in.lanes[3][0], &in.lanes[4][0], &in.lanes[5][0], &in.lanes[6][0] };
+	in.skeleton.localToWorld(pose, &world[0], in.getInstances(), 1);
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i] = world[i].t;
+	}
+
+static void srAccBatchSkeletonMatrix(const SrAccSkeleton& in, std::vector<SrVector3>& out)
+	{
+	static std::vector<SrMatrix34> world;
+	world.resize(in.size());
+	in.skeleton.localToWorld(&in.local[0], &world[0], in.getInstances(), 1);
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i] = world[i].t;
+	}
+
+static void srAccCheckSkeleton(const SrAccSkeleton& in, const std::vector<SrVector3>& out, SrAccStats& s)
+	{
+	const SrU32 bones = in.skeleton.getBoneCount();
+	std::vector<SrRefMat> m(bones);
+	std::vector<SrRefVec> t(bones);
+	for(SrU32 i = 0; i < in.getInstances(); i++)
+		for(SrU32 j = 0; j < bones; j++)
+			{
+			const SrQuaternionSoA& q = in.rotations[i];
+			const SrVector3SoA& v = in.translations[i];
+			const SrRefQuat lq = { q.x[j], q.y[j], q.z[j], q.w[j] };
+			const SrRefMat lm = srRefFromQuat(lq);
+			const SrRefVec lt = { v.x[j], v.y[j], v.z[j] };
+			const SrI32 parent = in.skeleton.getParent(j);
+			if(parent < 0)
+				{
+				m[j] = lm;
+				t[j] = lt;
+				}
+			else
+				{
+				const SrRefMat& pm = m[parent];
+				m[j] = srRefMultiply(pm, lm);
+				t[j].x = pm.m[0][0] * lt.x + pm.m[0][1] * lt.y + pm.m[0][2] * lt.z + t[parent].x;
+				t[j].y = pm.m[1][0] * lt.x + pm.m[1][1] * lt.y + pm.m[1][2] * lt.z + t[parent].y;
+				t[j].z = pm.m[2][0] * lt.x + pm.m[2][1] * lt.y + pm.m[2][2] * lt.z + t[parent].z;
+				}
+			s.add(out[i * bones + j], t[j], false);
+			}
+	}
+
+static void srAccMemberFromUnitCube(const SrAccCube& in, std::vector<SrQuaternion>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i].fromUnitCube(in.u1[i], in.u2[i], in.u3[i]);
+	}
+
+static void srAccBatchFromUnitCube(const SrAccCube& in, std::vector<SrQuaternion>& out)
+	{
+	static SrQuaternionSoA dst;
+	dst.resize(in.size());
+	SrRotationSampler::fromUnitCubeLanes<SrSimdNative>(&in.u1[0], &in.u2[0], &in.u3[0], dst.x, dst.y, dst.z, dst.w, in.size());
+	out.resize(in.size());
+	dst.getAoS(&out[0]);
+	}
+
+static void srAccCheckFromUnitCube(const SrAccCube& in, const std::vector<SrQuaternion>& out, SrAccStats& s)
+	{
+	const SrRef twoPi = 6.28318530717958647692528676655900577L;
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		const SrRef r1 = sqrtl(1.0L - in.u1[i]);
+		const SrRef r2 = sqrtl((SrRef)in.u1[i]);
+		const SrRefQuat q = { r1 * sinl(twoPi * in.u2[i]), r1 * cosl(twoPi * in.u2[i]), r2 * sinl(twoPi * in.u3[i]), r2 * cosl(twoPi * in.u3[i]) };
+		s.add(out[i], q);
+		}
+	}
+
+//random fills, element k against the next float of lane k % SR_RANDOM_LANES of SrRandom.
+static const SrU32 srAccSeed = 12345;
+
+static void srAccBatchFill(const SrAccFill& in, std::vector<SrF32>& out)
+	{
+	SrRandomBatch batch(srAccSeed);
+	out.resize(in.size());
+	if(in.a == 0.0f && in.b == 1.0f)
+		batch.fill(&out[0], in.size());
+	else
+		batch.fill(&out[0], in.size(), in.a, in.b);
+	}
+
+static void srAccCheckFillLevel(const SrAccFill& in, const std::vector<SrF32>& out, SrAccStats& s)
+	{
+	const SrRandomBatch batch(srAccSeed);
+	SrRandom lanes[SR_RANDOM_LANES];
+	for(SrU32 l = 0; l < SR_RANDOM_LANES; l++)
+		lanes[l] = batch.getLane(l);
+	for(SrU32 k = 0; k < in.size(); k++)
+		{
+		//a float outside [a, b] counts as a non finite result.
+		if(!(out[k] >= in.a && out[k] <= in.b) || (in.b == 1.0f && out[k] == 1.0f))
+			s.nonFinite++;
+		s.add(out[k], (SrRef)in.a + ((SrRef)in.b - in.a) * lanes[k % SR_RANDOM_LANES].nextF32());
+		}
+	}
+
+static void srAccCheckFill(const SrAccFill& in, const std::vector<SrF32>& out, SrAccStats& s)
+	{
+	srAccCheckFillLevel(in, out, s);
+#if defined(SR_SIMD_DISPATCH)
+	//the lanes are the same on every level the CPU runs.
+	const SrSimdLevel level = SrSimdDispatch::getLevel();
+	for(int l = SR_SIMD_LEVEL_SCALAR; l <= (int)SrSimdDispatch::getSupportedLevel(); l++)
+		{
+		if(!SrSimdDispatch::isCompiled((SrSimdLevel)l))
+			continue;
+		SrSimdDispatch::setLevel((SrSimdLevel)l);
+		std::vector<SrF32> other;
+		srAccBatchFill(in, other);
+		srAccCheckFillLevel(in, other, s);
+		}
+	SrSimdDispatch::setLevel(level);
+#endif
+	}
+
+//rotation vectors, v to a rotation and a back to a vector, and powers of a.
+static SrRefVec srRefRotationVector(const SrRefQuat& q)
+	{
+	const SrRefQuat n = srRefNormalize(q.w < 0 ? srRefScale(q, -1.0L) : q);
+	const SrRef s = sqrtl(n.x * n.x + n.y * n.y + n.z * n.z);
+	const SrRef k = s > 0 ? 2.0L * atan2l(s, n.w) / s : 2.0L;
+	SrRefVec r = { n.x * k, n.y * k, n.z * k };
+	return r;
+	}
+
+static void srAccMemberFromRotationVector(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i].fromRotationVector(in.v[i]);
+	}
+
+static void srAccBatchFromRotationVector(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	static SrQuaternionSoA dst;
+	SrQuaternionBatch::fromRotationVector(in.sv, dst);
+	out.resize(in.size());
+	dst.getAoS(&out[0]);
+	}
+
+static void srAccCheckFromRotationVector(const SrAccQuats& in, const std::vector<SrQuaternion>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		const SrRefVec v = srRef(in.v[i]);
+		s.add(out[i], srRefAngleAxis(sqrtl(v.x * v.x + v.y * v.y + v.z * v.z), v));
+		}
+	}
+
+static void srAccMemberGetRotationVector(const SrAccQuats& in, std::vector<SrVector3>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i] = in.a[i].getRotationVector();
+	}
+
+static void srAccBatchGetRotationVector(const SrAccQuats& in, std::vector<SrVector3>& out)
+	{
+	static SrVector3SoA dst;
+	SrQuaternionBatch::getRotationVector(in.sa, dst);
+	out.resize(in.size());
+	dst.getAoS(&out[0]);
+	}
+
+static void srAccCheckGetRotationVector(const SrAccQuats& in, const std::vector<SrVector3>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		s.add(out[i], srRefRotationVector(srRef(in.a[i])), true);
+	}
+
+static void srAccMemberPow(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i].pow(in.a[i], in.t[i]);
+	}
+
+static void srAccBatchPow(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	static SrQuaternionSoA dst;
+	SrQuaternionBatch::pow(&in.t[0], in.sa, dst);
+	out.resize(in.size());
+	dst.getAoS(&out[0]);
+	}
+
+static void srAccCheckPow(const SrAccQuats& in, const std::vector<SrQuaternion>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		//q^t of the quaternion itself, not of its w >= 0 form.
+		const SrRefQuat q = srRefNormalize(srRef(in.a[i]));
+		const SrRef n = sqrtl(q.x * q.x + q.y * q.y + q.z * q.z);
+		const SrRef angle = 2.0L * atan2l(n, q.w) * in.t[i];
+		SrRefQuat r = { 0, 0, 0, 1 };
+		if(n > 0)
+			{
+			const SrRef k = sinl(angle * 0.5L) / n;
+			r.x = q.x * k;
+			r.y = q.y * k;
+			r.z = q.z * k;
+			r.w = cosl(angle * 0.5L);
+			}
+		s.add(out[i], r);
+		}
+	}
+
+//one step of the orientation a under the angular velocity v, against the exact exp(0.5*dt*v)*a.
+//The backward step turns by up to 1 rad, the range the integrator documents its error for.
+static const SrF32 srAccDt = 1.0f / 60.0f;
+static const SrF32 srAccBackwardDt = -0.1f;
+
+static void srAccMemberIntegrate(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	out = in.a;
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		SrQuaternion d;
+		d.multiply(SrQuaternion(in.v[i]), out[i]);
+		d *= 0.5f * srAccDt;
+		out[i] += d;
+		out[i].normalize();
+		}
+	}
+
+template<SrRotationIntegration M, bool Backward>
+static void srAccBatchIntegrate(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	static SrQuaternionSoA q;
+	q = in.sa;
+	SrRotationIntegrator::integrate(M, Backward ? srAccBackwardDt : srAccDt, in.sv, q);
+	out.resize(in.size());
+	q.getAoS(&out[0]);
+	}
+
+template<bool Backward>
+static void srAccCheckIntegrate(const SrAccQuats& in, const std::vector<SrQuaternion>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		const SrRefVec v = srRef(in.v[i]);
+		const SrRef angle = (Backward ? srAccBackwardDt : srAccDt) * sqrtl(v.x * v.x + v.y * v.y + v.z * v.z);
+		s.add(out[i], srRefMultiply(srRefAngleAxis(angle, v), srRefNormalize(srRef(in.a[i]))));
+		}
+	}
+
+//keyframe tracks, the rotations against the exact slerp between the keys.
+static void srAccMemberTrack(const SrAccTracks& in, std::vector<SrQuaternion>& out)
+	{
+	std::vector<SrTrackCursor> cursors(in.cursors);
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		SrVector3 translation;
+		in.track[i]->sample(SR_QUAT_SLERP, in.t[i], cursors[i], out[i], translation);
+		}
+	}
+
+static void srAccBatchTrack(const SrAccTracks& in, std::vector<SrQuaternion>& out)
+	{
+	static SrQuaternionSoA rotations;
+	static SrVector3SoA translations;
+	std::vector<SrTrackCursor> cursors(in.cursors);
+	SrAnimationTrack::sample(SR_QUAT_SLERP, &in.track[0], &in.t[0], &cursors[0], rotations, translations, in.size());
+	out.resize(in.size());
+	rotations.getAoS(&out[0]);
+	}
+
+static void srAccCheckTrack(const SrAccTracks& in, const std::vector<SrQuaternion>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		const SrAnimationTrack& track = *in.track[i];
+		SrU32 k = 0;
+		while(k + 2 < track.getKeyCount() && track.getTime(k + 1) <= in.t[i])
+			k++;
+		const SrRef u = ((SrRef)in.t[i] - track.getTime(k)) / ((SrRef)track.getTime(k + 1) - track.getTime(k));
+		s.add(out[i], srRefSlerp(u, srRefNormalize(srRef(track.getRotation(k))), srRefNormalize(srRef(track.getRotation(k + 1)))));
+		}
+	}
+
+//reduced tracks, the rotations against the exact slerp between the input keys.
+static void srAccMemberReducedTrack(const SrAccReducedTracks& in, std::vector<SrQuaternion>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		SrTrackCursor cursor;
+		SrVector3 translation;
+		in.reduced[in.track[i]].sample(SR_QUAT_CORRECTED_NLERP, in.t[i], cursor, out[i], translation);
+		}
+	}
+
+static void srAccCheckReducedTrack(const SrAccReducedTracks& in, const std::vector<SrQuaternion>& out, SrAccStats& s)
+	{
+	//a key kept twice leaves a zero length segment and a short track that is not copied
+	//as it is loses keys, both counted as non finite results.
+	for(SrU32 j = 0; j < in.reduced.size(); j++)
+		{
+		if(in.tracks[j].getKeyCount() < 2 && in.reduced[j].getKeyCount() != in.tracks[j].getKeyCount())
+			s.nonFinite++;
+		for(SrU32 k = 0; k + 1 < in.reduced[j].getKeyCount(); k++)
+			if(!(in.reduced[j].getTime(k + 1) > in.reduced[j].getTime(k)))
+				s.nonFinite++;
+		}
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		const SrAnimationTrack& track = in.tracks[in.track[i]];
+		SrTrackCursor cursor;
+		SrF32 u;
+		const SrU32 k = track.findKey(in.t[i], cursor, u);
+		const SrRef v = ((SrRef)in.t[i] - track.getTime(k)) / ((SrRef)track.getTime(k + 1) - track.getTime(k));
+		s.add(out[i], srRefSlerp(v, srRefNormalize(srRef(track.getRotation(k))), srRefNormalize(srRef(track.getRotation(k + 1)))));
+		}
+	}
+
+//quantized rotations, the decoded code against the input rotation.
+template<class C>
+static void srAccMemberCodec(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		C code;
+		SrQuaternionCodec::encode(in.a[i], code);
+		out[i] = SrQuaternionCodec::decode(code);
+		}
+	}
+
+template<class C>
+static void srAccBatchCodec(const SrAccQuats& in, std::vector<SrQuaternion>& out)
+	{
+	static std::vector<C> codes;
+	static SrQuaternionSoA decoded;
+	codes.resize(in.size());
+	SrQuaternionCodec::encode(in.sa, &codes[0]);
+	SrQuaternionCodec::decode(&codes[0], in.size(), decoded);
+	out.resize(in.size());
+	decoded.getAoS(&out[0]);
+	}
+
+//splines over keyframes, against both curves evaluated in long double from the float keys.
+static SrRefQuat srRefExp(const SrRefVec& v)
+	{
+	const SrRef m = sqrtl(v.x * v.x + v.y * v.y + v.z * v.z);
+	if(m == 0)
+		{
+		const SrRefQuat r = { 0, 0, 0, 1 };
+		return r;
+		}
+	return srRefAngleAxis(2.0L * m, v);
+	}
+
+static SrRefVec srRefLog(const SrRefQuat& q)
+	{
+	const SrRefVec v = srRefRotationVector(q);
+	const SrRefVec r = { v.x * 0.5L, v.y * 0.5L, v.z * 0.5L };
+	return r;
+	}
+
+static SrRefQuat srRefConjugate(const SrRefQuat& q)
+	{
+	const SrRefQuat r = { -q.x, -q.y, -q.z, q.w };
+	return r;
+	}
+
+template<SrQuatSplineType M>
+static void srAccMemberSpline(const SrAccKeys& in, std::vector<SrQuaternion>& out)
+	{
+	const SrQuaternionSpline& spline = M == SR_QUAT_SPLINE_SQUAD ? in.squad : in.bspline;
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i] = spline.evaluate(in.t[i]);
+	}
+
+template<SrQuatSplineType M>
+static void srAccBatchSpline(const SrAccKeys& in, std::vector<SrQuaternion>& out)
+	{
+	static SrQuaternionSoA dst;
+	(M == SR_QUAT_SPLINE_SQUAD ? in.squad : in.bspline).evaluate(&in.t[0], dst, in.size());
+	out.resize(in.size());
+	dst.getAoS(&out[0]);
+	}
+
+template<SrQuatSplineType M>
+static void srAccCheckSpline(const SrAccKeys& in, const std::vector<SrQuaternion>& out, SrAccStats& s)
+	{
+	const SrU32 n = (SrU32)in.keys.size();
+	std::vector<SrRefQuat> q(n), inner(n);
+	std::vector<SrRefVec> step(n + 2);
+	for(SrU32 k = 0; k < n; k++)
+		{
+		q[k] = srRefNormalize(srRef(in.keys[k]));
+		if(k && srRefDot(q[k], q[k - 1]) < 0)
+			q[k] = srRefScale(q[k], -1.0L);
+		}
+	const SrRefVec zero = { 0, 0, 0 };
+	for(SrU32 k = 0; k < n + 2; k++)
+		step[k] = k == 0 || k >= n ? zero : srRefLog(srRefMultiply(srRefConjugate(q[k - 1]), q[k]));
+	for(SrU32 k = 0; k < n; k++)
+		{
+		const SrRefVec d = { (step[k].x - step[k + 1].x) * 0.25L, (step[k].y - step[k + 1].y) * 0.25L, (step[k].z - step[k + 1].z) * 0.25L };
+		inner[k] = k == 0 || k == n - 1 ? q[k] : srRefMultiply(q[k], srRefExp(d));
+		}
+
+	SrU32 k = 0;
+	for(SrU32 i = 0; i < in.size(); i++)
+		{
+		while(k + 2 < n && in.times[k + 1] <= in.t[i])
+			k++;
+		const SrRef u = ((SrRef)in.t[i] - in.times[k]) / ((SrRef)in.times[k + 1] - in.times[k]);
+		SrRefQuat r;
+		if(M == SR_QUAT_SPLINE_SQUAD)
+			r = srRefSlerp(2.0L * u * (1.0L - u), srRefSlerp(u, q[k], q[k + 1]), srRefSlerp(u, inner[k], inner[k + 1]));
+		else
+			{
+			const SrRef b[3] = { (5 + 3 * u - 3 * u * u + u * u * u) / 6, (1 + 3 * u + 3 * u * u - 2 * u * u * u) / 6, u * u * u / 6 };
+			r = q[k ? k - 1 : 0];
+			for(SrU32 j = 0; j < 3; j++)
+				{
+				const SrRefVec v = { step[k + j].x * b[j], step[k + j].y * b[j], step[k + j].z * b[j] };
+				r = srRefMultiply(r, srRefExp(v));
+				}
+			}
+		s.add(out[i], r);
+		}
+	}
+
+//scalar functions, F is the reference, the evaluation a member of SrMath or an SrSimdMath kernel.
+typedef SrRef (*SrAccRefFunction)(SrRef);
+
+template<SrF32 (*F)(SrF32)>
+static void srAccMath(const SrAccScalars& in, std::vector<SrF32>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i] = F(in.x[i]);
+	}
+
+template<void (*F)(const SrF32*, SrF32*, SrU32)>
+static void srAccSimdMath(const SrAccScalars& in, std::vector<SrF32>& out)
+	{
+	out.resize(in.size());
+	F(&in.x[0], &out[0], in.size());
+	}
+
+template<SrAccRefFunction R>
+static void srAccCheckMath(const SrAccScalars& in, const std::vector<SrF32>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		s.add(out[i], R(in.x[i]));
+	}
+
+static SrRef srAccRefSin(SrRef x)		{ return sinl(x); }
+static SrRef srAccRefCos(SrRef x)		{ return cosl(x); }
+static SrRef srAccRefAsin(SrRef x)		{ return asinl(x); }
+static SrRef srAccRefAcos(SrRef x)		{ return acosl(x); }
+static SrRef srAccRefAtan(SrRef x)		{ return atanl(x); }
+static SrRef srAccRefExp(SrRef x)		{ return expl(x); }
+static SrRef srAccRefLog(SrRef x)		{ return logl(x); }
+static SrRef srAccRefSqrt(SrRef x)		{ return sqrtl(x); }
+static SrRef srAccRefRecipSqrt(SrRef x)	{ return 1.0L / sqrtl(x); }
+
+static SrF32 srAccSin(SrF32 x)			{ return SrMath::sin(x); }
+static SrF32 srAccCos(SrF32 x)			{ return SrMath::cos(x); }
+static SrF32 srAccAsin(SrF32 x)			{ return SrMath::asin(x); }
+static SrF32 srAccAcos(SrF32 x)			{ return SrMath::acos(x); }
+static SrF32 srAccAtan(SrF32 x)			{ return SrMath::atan(x); }
+static SrF32 srAccExp(SrF32 x)			{ return SrMath::exp(x); }
+static SrF32 srAccLog(SrF32 x)			{ return SrMath::logE(x); }
+static SrF32 srAccSqrt(SrF32 x)			{ return SrMath::sqrt(x); }
+static SrF32 srAccRecipSqrt(SrF32 x)	{ return SrMath::recipSqrt(x); }
+
+static void srAccSimdSin(const SrF32* s, SrF32* d, SrU32 n)		{ SrSimdMath::sin(s, d, n); }
+static void srAccSimdCos(const SrF32* s, SrF32* d, SrU32 n)		{ SrSimdMath::cos(s, d, n); }
+static void srAccSimdAsin(const SrF32* s, SrF32* d, SrU32 n)	{ SrSimdMath::asin(s, d, n); }
+static void srAccSimdAcos(const SrF32* s, SrF32* d, SrU32 n)	{ SrSimdMath::acos(s, d, n); }
+static void srAccSimdAtan(const SrF32* s, SrF32* d, SrU32 n)	{ SrSimdMath::atan(s, d, n); }
+static void srAccSimdExp(const SrF32* s, SrF32* d, SrU32 n)		{ SrSimdMath::exp(s, d, n); }
+static void srAccSimdLog(const SrF32* s, SrF32* d, SrU32 n)		{ SrSimdMath::logE(s, d, n); }
+
+static void srAccMemberAtan2(const SrAccScalars& in, std::vector<SrF32>& out)
+	{
+	out.resize(in.size());
+	for(SrU32 i = 0; i < in.size(); i++)
+		out[i] = SrMath::atan2(in.y[i], in.x[i]);
+	}
+
+static void srAccSimdAtan2(const SrAccScalars& in, std::vector<SrF32>& out)
+	{
+	out.resize(in.size());
+	SrSimdMath::atan2(&in.y[0], &in.x[0], &out[0], in.size());
+	}
+
+static void srAccCheckAtan2(const SrAccScalars& in, const std::vector<SrF32>& out, SrAccStats& s)
+	{
+	for(SrU32 i = 0; i < in.size(); i++)
+		s.add(out[i], atan2l(in.y[i], in.x[i]));
+	}
+
+//-------------------------------------------------------------------------------- driver
+
+struct SrAccOptions
+	{
+	std::string filter;
+	SrU32 count;
+	SrF64 minTime;
+	FILE* out;
+	bool first;
+	SrU32 failed;
+	};
+
+static void srAccWriteString(FILE* f, const char* s)
+	{
+	fputc('"', f);
+	for(; *s; s++)
+		{
+		if(*s == '"' || *s == '\\')
+			fputc('\\', f);
+		fputc(*s, f);
+		}
+	fputc('"', f);
+	}
+
+/*
+Runs and reports one case: op over the input set, the evaluation timed until it runs for
+minTime, best of three. maxUlp and maxAngle bound the errors, 0 leaves them unchecked.
+*/
+template<class In, class Out>
+static void srAccCase(SrAccOptions& o, const char* op, const char* set,
+					  void (*eval)(const In&, Out&), void (*check)(const In&, const Out&, SrAccStats&),
+					  SrF64 maxUlp, SrF64 maxAngle)
+	{
+	const std::string name = std::string(op) + "/" + set;
+	if(!o.filter.empty() && name.find(o.filter) == std::string::npos)
+		return;
+	if(o.out != stdout)
+		fprintf(stderr, "%s\n", name.c_str());
+
+	const In in(set, o.count);
+	Out out;
+	eval(in, out);
+	SrAccStats s;
+	check(in, out, s);
+	bool pass = s.nonFinite == 0 && (maxUlp == 0 || s.maxUlp <= maxUlp) && (maxAngle == 0 || s.maxAngle <= maxAngle);
+
+#if defined(SR_SIMD_DISPATCH) && defined(SR_DETERMINISTIC)
+	//every level has to return the bits of the one the case ran at.
+	const SrSimdLevel level = SrSimdDispatch::getLevel();
+	for(int l = SR_SIMD_LEVEL_SCALAR; l <= (int)SrSimdDispatch::getSupportedLevel(); l++)
+		{
+		if(!SrSimdDispatch::isCompiled((SrSimdLevel)l))
+			continue;
+		SrSimdDispatch::setLevel((SrSimdLevel)l);
+		Out other;
+		eval(in, other);
+		if(other.size() != out.size() || memcmp(&other[0], &out[0], out.size() * sizeof(out[0])) != 0)
+			{
+			fprintf(stderr, "%s: %s differs from %s\n", name.c_str(), SrSimdDispatch::getName((SrSimdLevel)l), SrSimdDispatch::getName(level));
+			pass = false;
+			}
+		}
+	SrSimdDispatch::setLevel(level);
+#endif
+	if(!pass)
+		{
+		fprintf(stderr, "%s: max_ulp %.4g (bound %.4g), max_angle %.4g (bound %.4g), %u non finite\n",
+				name.c_str(), s.maxUlp, maxUlp, s.maxAngle, maxAngle, s.nonFinite);
+		o.failed++;
+		}
+
+	SrU32 reps = 1;
+	SrF64 best = 0;
+	for(int sample = 0; sample < 3; sample++)
+		{
+		SrF64 time;
+		for(;;)
+			{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for(SrU32 r = 0; r < reps; r++)
+				{
+				eval(in, out);
+				srBenchClobber(&out[0]);
+				}
+			time = std::chrono::duration<SrF64>(std::chrono::steady_clock::now() - start).count();
+			if(time >= o.minTime || reps >= 0x10000000u)
+				break;
+			reps *= 2;
+			}
+		time = time * 1e9 / ((SrF64)reps * in.size());
+		best = sample == 0 ? time : std::min(best, time);
+		}
+
+	FILE* f = o.out;
+	fprintf(f, "%s\n\t\t{\"op\": ", o.first ? "" : ",");
+	o.first = false;
+	srAccWriteString(f, op);
+	fprintf(f, ", \"inputs\": ");
+	srAccWriteString(f, set);
+	fprintf(f, ", \"count\": %u, \"non_finite\": %u, \"max_ulp\": %.4g, \"mean_ulp\": %.4g, \"max_abs\": %.4g, \"ns_per_op\": %.4f,\n\t\t \"ulp_hist\": [",
+			s.count, s.nonFinite, s.maxUlp, s.count > s.nonFinite ? s.sumUlp / (s.count - s.nonFinite) : 0.0, s.maxAbs, best);
+	for(int i = 0; i < SR_ACC_ULP_BINS; i++)
+		fprintf(f, "%s%u", i ? ", " : "", s.ulp[i]);
+	fprintf(f, "]");
+	if(s.hasAngle)
+		{
+		fprintf(f, ", \"max_angle\": %.4g, \"angle_hist\": [", s.maxAngle);
+		for(int i = 0; i < SR_ACC_ANGLE_BINS; i++)
+			fprintf(f, "%s%u", i ? ", " : "", s.angle[i]);
+		fprintf(f, "]");
+		}
+	fprintf(f, ", \"pass\": %s", pass ? "true" : "false");
+#if defined(SR_DETERMINISTIC)
+	//FNV-1a over the result bytes.
+	unsigned long long hash = 14695981039346656037ull;
+	const unsigned char* bytes = (const unsigned char*)&out[0];
+	for(size_t i = 0; i < out.size() * sizeof(out[0]); i++)
+		hash = (hash ^ bytes[i]) * 1099511628211ull;
+	fprintf(f, ", \"hash\": \"%016llx\"", hash);
+#endif
+	fprintf(f, "}");
+	fflush(f);
+	}
+
+static const char* const srAccQuatPairSets[] = { "random", "near-parallel", "near-opposite" };
+
+int main(int argc, char** argv)
+	{
+	SrAccOptions o;
+	o.count = 100000;
+	o.minTime = 0.02;
+	o.out = stdout;
+	o.first = true;
+	o.failed = 0;
+	for(int i = 1; i < argc; i++)
+		{
+		const char* a = argv[i];
+		if(strncmp(a, "--filter=", 9) == 0)
+			o.filter = a + 9;
+		else if(strncmp(a, "--count=", 8) == 0)
+			o.count = std::max(atoi(a + 8), 1);
+		else if(strncmp(a, "--min-time=", 11) == 0)
+			o.minTime = atof(a + 11) * 1e-3;
+		else if(strncmp(a, "--out=", 6) == 0)
+			{
+			o.out = fopen(a + 6, "w");
+			if(!o.out)
+				{
+				fprintf(stderr, "cannot open %s\n", a + 6);
+				return 1;
+				}
+			}
+		else
+			{
+			fprintf(stderr, "usage: %s [--filter=text] [--count=n] [--min-time=ms] [--out=file.json]\n", argv[0]);
+			return 1;
+			}
+		}
+
+#if defined(SR_DETERMINISTIC)
+	if(SrMathDeterministic::isContracted())
+		{
+		fprintf(stderr, "SR_DETERMINISTIC builds need -ffp-contract=off\n");
+		return 1;
+		}
+#endif
+
+	FILE* f = o.out;
+	fprintf(f, "{\n\t\"library\": \"orientation\",\n\t\"reference_mantissa_bits\": %d,\n", LDBL_MANT_DIG);
+	fprintf(f, "\t\"ulp_bins\": [");
+	for(int i = 0; i < SR_ACC_ULP_BINS - 1; i++)
+		fprintf(f, "%g, ", SrAccStats::ulpBound(i));
+	fprintf(f, "\"inf\"],\n\t\"angle_bins\": [");
+	for(int i = 0; i < SR_ACC_ANGLE_BINS - 1; i++)
+		fprintf(f, "%g, ", SrAccStats::angleBound(i));
+	fprintf(f, "\"inf\"],\n\t\"results\": [");
+
+	//The bounds are the maxima the headers document for the inputs of a case. The reference
+	//here counts the rounding of float rotations away from unit length as error, so where
+	//that adds to a documented maximum, and for the operations without one, they are the
+	//maxima measured over the scalar, SSE2, AVX2 and AVX-512 builds, with and without
+	//SR_DETERMINISTIC, at the default count, rounded up.
+	static const SrF64 pairUlp[3][3] = { { 8, 1.5e6, 1000 }, { 1e4, 4, 24 }, { 1e4, 4, 24 } };
+	static const SrF64 pairAngle[3][3] = { { 4e-7, 0.15, 8.2e-5 }, { 1.3e-3, 4e-7, 3e-6 }, { 1.3e-3, 4e-7, 3e-6 } };
+	for(int k = 0; k < 3; k++)
+		{
+		const char* set = srAccQuatPairSets[k];
+		srAccCase(o, "SrQuaternion::slerp", set, srAccMemberInterpolation<SR_QUAT_SLERP>, srAccCheckInterpolation, pairUlp[k][0], pairAngle[k][0]);
+		srAccCase(o, "SrQuaternion::nlerp", set, srAccMemberInterpolation<SR_QUAT_NLERP>, srAccCheckInterpolation, pairUlp[k][1], pairAngle[k][1]);
+		srAccCase(o, "SrQuaternion::correctedNlerp", set, srAccMemberInterpolation<SR_QUAT_CORRECTED_NLERP>, srAccCheckInterpolation, pairUlp[k][2], pairAngle[k][2]);
+		srAccCase(o, "SrQuaternionBatch::slerp", set, srAccBatchInterpolation<SR_QUAT_SLERP>, srAccCheckInterpolation, pairUlp[k][0], pairAngle[k][0]);
+		srAccCase(o, "SrQuaternionBatch::nlerp", set, srAccBatchInterpolation<SR_QUAT_NLERP>, srAccCheckInterpolation, pairUlp[k][1], pairAngle[k][1]);
+		srAccCase(o, "SrQuaternionBatch::correctedNlerp", set, srAccBatchInterpolation<SR_QUAT_CORRECTED_NLERP>, srAccCheckInterpolation, pairUlp[k][2], pairAngle[k][2]);
+		}
+	//within 0.1 rad of the identity all of them stay within 2 ulp.
+	static const char* const expSets[] = { "random", "small" };
+	static const SrF64 expUlp[2][4] = { { 8.5, 3.9, 10, 8.7 }, { 2, 2, 2, 2 } };
+	static const SrF64 expAngle[2] = { 2e-6, 1e-7 };
+	for(int k = 0; k < 2; k++)
+		{
+		srAccCase(o, "SrQuaternion::fromRotationVector", expSets[k], srAccMemberFromRotationVector, srAccCheckFromRotationVector, expUlp[k][0], expAngle[k]);
+		srAccCase(o, "SrQuaternionBatch::fromRotationVector", expSets[k], srAccBatchFromRotationVector, srAccCheckFromRotationVector, expUlp[k][0], expAngle[k]);
+		srAccCase(o, "SrQuaternion::getRotationVector", expSets[k], srAccMemberGetRotationVector, srAccCheckGetRotationVector, expUlp[k][1], expAngle[k]);
+		srAccCase(o, "SrQuaternionBatch::getRotationVector", expSets[k], srAccBatchGetRotationVector, srAccCheckGetRotationVector, expUlp[k][1], expAngle[k]);
+		srAccCase(o, "SrQuaternion::pow", expSets[k], srAccMemberPow, srAccCheckPow, expUlp[k][2], expAngle[k]);
+		srAccCase(o, "SrQuaternionBatch::pow", expSets[k], srAccBatchPow, srAccCheckPow, expUlp[k][3], expAngle[k]);
+		}
+	srAccCase(o, "SrQuaternion::multiply", "random", srAccMemberMultiply, srAccCheckMultiply, 3, 4e-7);
+	srAccCase(o, "SrQuaternion::normalize", "unnormalized", srAccMemberNormalize, srAccCheckNormalize, 4, 2e-7);
+	srAccCase(o, "SrQuaternionBatch::normalize", "unnormalized", srAccBatchNormalize, srAccCheckNormalize, 4, 2e-7);
+	srAccCase(o, "SrQuaternion::fromAngleAxis", "random", srAccMemberFromAngleAxis, srAccCheckFromAngleAxis, 8, 1e-6);
+	srAccCase(o, "SrQuaternion::fromAngleAxisFast", "random", srAccMemberFromAngleAxisFast, srAccCheckFromAngleAxis, 6, 1e-6);
+	srAccCase(o, "SrQuaternion::rot", "random", srAccMemberRotate, srAccCheckRotate, 8, 4e-7);
+	srAccCase(o, "SrQuaternionBatch::rotate", "random", srAccBatchRotate, srAccCheckRotate, 10, 4e-7);
+
+	srAccCase(o, "SrMatrix33::fromQuat", "random", srAccMemberFromQuat, srAccCheckFromQuat, 6, 2e-7);
+	srAccCase(o, "SrMatrix33Batch::fromQuat", "random", srAccBatchFromQuat, srAccCheckFromQuat, 6, 2e-7);
+	static const char* const rotationSets[] = { "random", "near-180", "near-identity" };
+	static const SrF64 rotationUlp[3] = { 4, 4, 2 };
+	static const SrF64 rotationAngle[3] = { 4e-7, 4e-7, 4e-8 };
+	for(int k = 0; k < 3; k++)
+		{
+		srAccCase(o, "SrMatrix33::toQuat", rotationSets[k], srAccMemberToQuat, srAccCheckToQuat, rotationUlp[k], rotationAngle[k]);
+		srAccCase(o, "SrMatrix33Batch::toQuat", rotationSets[k], srAccBatchToQuat, srAccCheckToQuat, rotationUlp[k], rotationAngle[k]);
+		}
+	srAccCase(o, "SrMatrix33::multiply", "random", srAccMemberMatrixMultiply, srAccCheckMatrixMultiply, 3, 2e-7);
+	srAccCase(o, "SrMatrix33Batch::multiply", "random", srAccBatchMatrixMultiply, srAccCheckMatrixMultiply, 3, 2e-7);
+	srAccCase(o, "SrMatrix33::operator*(SrMatrix33)", "random", srAccEagerProduct<SrMatrix33>, srAccCheckProduct<SrMatrix33>, 3, 2e-7);
+	srAccCase(o, "srLazy(SrMatrix33)", "random", srAccLazyProduct<SrMatrix33>, srAccCheckProduct<SrMatrix33>, 3, 2e-7);
+	srAccCase(o, "SrMatrix33::operator*(SrVector3)", "random", srAccEagerChain<SrMatrix33>, srAccCheckChain<SrMatrix33>, 5, 0);
+	srAccCase(o, "srLazy(SrMatrix33)*SrVector3", "random", srAccLazyChain<SrMatrix33>, srAccCheckChain<SrMatrix33>, 5, 0);
+	srAccCase(o, "SrMatrix34::operator*(SrMatrix34)", "random", srAccEagerProduct<SrMatrix34>, srAccCheckProduct<SrMatrix34>, 48, 2e-7);
+	srAccCase(o, "srLazy(SrMatrix34)", "random", srAccLazyProduct<SrMatrix34>, srAccCheckProduct<SrMatrix34>, 48, 2e-7);
+	srAccCase(o, "SrMatrix34::operator*(SrVector3)", "random", srAccEagerChain<SrMatrix34>, srAccCheckChain<SrMatrix34>, 10, 0);
+	srAccCase(o, "srLazy(SrMatrix34)*SrVector3", "random", srAccLazyChain<SrMatrix34>, srAccCheckChain<SrMatrix34>, 10, 0);
+	srAccCase(o, "SrMatrix33::getInverse", "general", srAccMemberInverse, srAccCheckInverse, 3e5, 0);
+	srAccCase(o, "SrMatrix33::getInverse", "near-singular", srAccMemberInverse, srAccCheckInverse, 1e11, 0);
+	srAccCase(o, "SrMatrix34::multiply", "random", srAccMemberTransform, srAccCheckTransform, 4, 0);
+	srAccCase(o, "SrMatrix34Batch::transformPoints", "random", srAccBatchTransform, srAccCheckTransform, 5, 0);
+	srAccCase(o, "SrMatrix34Batch::transformPoints(SrVector3F16)", "half", srAccBatchTransformHalf, srAccCheckTransform, 5, 0);
+	srAccCase(o, "SrSkinning::skin(SrMatrix34)", "random", srAccMemberSkinMatrix, srAccCheckSkinMatrix, 80, 0);
+	srAccCase(o, "SrSkinning::skinLanes(SrMatrix34)", "random", srAccBatchSkinMatrix, srAccCheckSkinMatrix, 80, 0);
+	srAccCase(o, "SrSkinning::skin(SrDualQuaternion)", "random", srAccMemberSkin, srAccCheckSkin, 160, 0);
+	srAccCase(o, "SrSkinning::skinLanes(SrDualQuaternion)", "random", srAccBatchSkin, srAccCheckSkin, 160, 0);
+	srAccCase(o, "SrSkeleton::localToWorld", "random", srAccMemberSkeleton, srAccCheckSkeleton, 64, 0);
+	srAccCase(o, "SrSkeleton::localToWorldLanes(pose)", "random", srAccBatchSkeleton, srAccCheckSkeleton, 64, 0);
+	srAccCase(o, "SrSkeleton::localToWorldLanes(SrMatrix34)", "random", srAccBatchSkeletonMatrix, srAccCheckSkeleton, 64, 0);
+
+	srAccCase(o, "SrQuaternion::fromUnitCube", "random", srAccMemberFromUnitCube, srAccCheckFromUnitCube, 10, 1.2e-6);
+	srAccCase(o, "SrRotationSampler::fromUnitCubeLanes", "random", srAccBatchFromUnitCube, srAccCheckFromUnitCube, 7, 1e-6);
+	srAccCase(o, "SrQuaternion::fromUnitCube", "edges", srAccMemberFromUnitCube, srAccCheckFromUnitCube, 10, 1.2e-6);
+	srAccCase(o, "SrRotationSampler::fromUnitCubeLanes", "edges", srAccBatchFromUnitCube, srAccCheckFromUnitCube, 7, 1e-6);
+
+	//[0, 1) is the scalar generator bit for bit, other ranges within the rounding of the scale and offset.
+	srAccCase(o, "SrRandomBatch::fillLanes", "unit", srAccBatchFill, srAccCheckFill, 1e-9, 0);
+	srAccCase(o, "SrRandomBatch::fillLanes", "range", srAccBatchFill, srAccCheckFill, 1, 0);
+
+	srAccCase(o, "SrQuaternion::multiply+normalize", "random", srAccMemberIntegrate, srAccCheckIntegrate<false>, 5000, 5e-4);
+	srAccCase(o, "SrRotationIntegrator::firstOrder", "random", srAccBatchIntegrate<SR_ROTATION_FIRST_ORDER, false>, srAccCheckIntegrate<false>, 5000, 5e-4);
+	srAccCase(o, "SrRotationIntegrator::exponential", "random", srAccBatchIntegrate<SR_ROTATION_EXPONENTIAL, false>, srAccCheckIntegrate<false>, 4, 3.2e-7);
+	srAccCase(o, "SrRotationIntegrator::exponential(backward)", "random", srAccBatchIntegrate<SR_ROTATION_EXPONENTIAL, true>, srAccCheckIntegrate<true>, 4, 3.2e-7);
+
+	static const char* const keySets[] = { "random-walk", "slow" };
+	for(int k = 0; k < 2; k++)
+		{
+		srAccCase(o, "SrQuaternionSpline::evaluate(squad)", keySets[k], srAccMemberSpline<SR_QUAT_SPLINE_SQUAD>, srAccCheckSpline<SR_QUAT_SPLINE_SQUAD>, 5, 3.4e-7);
+		srAccCase(o, "SrQuaternionSpline::evaluateLanes(squad)", keySets[k], srAccBatchSpline<SR_QUAT_SPLINE_SQUAD>, srAccCheckSpline<SR_QUAT_SPLINE_SQUAD>, 5, 3.4e-7);
+		srAccCase(o, "SrQuaternionSpline::evaluate(bspline)", keySets[k], srAccMemberSpline<SR_QUAT_SPLINE_BSPLINE>, srAccCheckSpline<SR_QUAT_SPLINE_BSPLINE>, 6, 5.3e-7);
+		srAccCase(o, "SrQuaternionSpline::evaluateLanes(bspline)", keySets[k], srAccBatchSpline<SR_QUAT_SPLINE_BSPLINE>, srAccCheckSpline<SR_QUAT_SPLINE_BSPLINE>, 6, 5.3e-7);
+		}
+	//slerp keys less than 0.01 rad apart.
+	static const char* const trackSets[] = { "playback", "seek" };
+	for(int k = 0; k < 2; k++)
+		{
+		srAccCase(o, "SrAnimationTrack::sample", trackSets[k], srAccMemberTrack, srAccCheckTrack, 6000, 1.3e-3);
+		srAccCase(o, "SrAnimationTrack::sampleLanes", trackSets[k], srAccBatchTrack, srAccCheckTrack, 6000, 1.3e-3);
+		}
+	//the tolerance the tracks were reduced with.
+	srAccCase(o, "SrTrackReducer::reduce", "mocap", srAccMemberReducedTrack, srAccCheckReducedTrack, 1e4, 1e-3);
+	srAccCase(o, "SrTrackReducer::reduce", "fast", srAccMemberReducedTrack, srAccCheckReducedTrack, 1e4, 1e-3);
+	srAccCase(o, "SrTrackReducer::reduce", "short", srAccMemberReducedTrack, srAccCheckReducedTrack, 1e4, 1e-3);
+	//the angle bounds are the documented maxima of each width, which hold near the identity as well.
+	static const char* const codecSets[] = { "random", "small" };
+	for(int k = 0; k < 2; k++)
+		{
+		srAccCase(o, "SrQuaternionCodec::decode(32)", codecSets[k], srAccMemberCodec<SrPackedQuat32>, srAccCheckNormalize, 3e4, 4.3e-3);
+		srAccCase(o, "SrQuaternionCodec::decodeLanes(32)", codecSets[k], srAccBatchCodec<SrPackedQuat32>, srAccCheckNormalize, 3e4, 4.3e-3);
+		srAccCase(o, "SrQuaternionCodec::decode(48)", codecSets[k], srAccMemberCodec<SrPackedQuat48>, srAccCheckNormalize, 900, 1.4e-4);
+		srAccCase(o, "SrQuaternionCodec::decodeLanes(48)", codecSets[k], srAccBatchCodec<SrPackedQuat48>, srAccCheckNormalize, 900, 1.4e-4);
+		srAccCase(o, "SrQuaternionCodec::decode(64)", codecSets[k], srAccMemberCodec<SrPackedQuat64>, srAccCheckNormalize, 32, 4.1e-6);
+		srAccCase(o, "SrQuaternionCodec::decodeLanes(64)", codecSets[k], srAccBatchCodec<SrPackedQuat64>, srAccCheckNormalize, 32, 4.1e-6);
+		}
+
+	static const char* const trigSets[] = { "pi", "large", "near-pi" };
+	static const SrF64 trigUlp[3] = { 1.6, 2.4, 2.4 };
+	for(int k = 0; k < 3; k++)
+		{
+		srAccCase(o, "SrMath::sin", trigSets[k], srAccMath<srAccSin>, srAccCheckMath<srAccRefSin>, trigUlp[k], 0);
+		srAccCase(o, "SrSimdMath::sin", trigSets[k], srAccSimdMath<srAccSimdSin>, srAccCheckMath<srAccRefSin>, trigUlp[k], 0);
+		srAccCase(o, "SrMath::cos", trigSets[k], srAccMath<srAccCos>, srAccCheckMath<srAccRefCos>, trigUlp[k], 0);
+		srAccCase(o, "SrSimdMath::cos", trigSets[k], srAccSimdMath<srAccSimdCos>, srAccCheckMath<srAccRefCos>, trigUlp[k], 0);
+		}
+	static const char* const inverseTrigSets[] = { "unit", "near-one" };
+	for(int k = 0; k < 2; k++)
+		{
+		srAccCase(o, "SrMath::asin", inverseTrigSets[k], srAccMath<srAccAsin>, srAccCheckMath<srAccRefAsin>, 2.4, 0);
+		srAccCase(o, "SrSimdMath::asin", inverseTrigSets[k], srAccSimdMath<srAccSimdAsin>, srAccCheckMath<srAccRefAsin>, 2.4, 0);
+		srAccCase(o, "SrMath::acos", inverseTrigSets[k], srAccMath<srAccAcos>, srAccCheckMath<srAccRefAcos>, 2.4, 0);
+		srAccCase(o, "SrSimdMath::acos", inverseTrigSets[k], srAccSimdMath<srAccSimdAcos>, srAccCheckMath<srAccRefAcos>, 2.4, 0);
+		}
+	srAccCase(o, "SrMath::atan", "wide", srAccMath<srAccAtan>, srAccCheckMath<srAccRefAtan>, 2.8, 0);
+	srAccCase(o, "SrSimdMath::atan", "wide", srAccSimdMath<srAccSimdAtan>, srAccCheckMath<srAccRefAtan>, 2.8, 0);
+	static const char* const atan2Sets[] = { "unit", "near-axes", "octant" };
+	for(int k = 0; k < 3; k++)
+		{
+		srAccCase(o, "SrMath::atan2", atan2Sets[k], srAccMemberAtan2, srAccCheckAtan2, 3.3, 0);
+		srAccCase(o, "SrSimdMath::atan2", atan2Sets[k], srAccSimdAtan2, srAccCheckAtan2, 3.3, 0);
+		}
+	srAccCase(o, "SrMath::exp", "exp", srAccMath<srAccExp>, srAccCheckMath<srAccRefExp>, 1.3, 0);
+	srAccCase(o, "SrSimdMath::exp", "exp", srAccSimdMath<srAccSimdExp>, srAccCheckMath<srAccRefExp>, 1.3, 0);
+	srAccCase(o, "SrMath::logE", "positive", srAccMath<srAccLog>, srAccCheckMath<srAccRefLog>, 0.8, 0);
+	srAccCase(o, "SrSimdMath::logE", "positive", srAccSimdMath<srAccSimdLog>, srAccCheckMath<srAccRefLog>, 0.8, 0);
+	srAccCase(o, "SrMath::sqrt", "positive", srAccMath<srAccSqrt>, srAccCheckMath<srAccRefSqrt>, 0.5, 0);
+	srAccCase(o, "SrMath::recipSqrt", "positive", srAccMath<srAccRecipSqrt>, srAccCheckMath<srAccRefRecipSqrt>, 2, 0);
+
+	fprintf(f, "\n\t]\n}\n");
+	if(f != stdout)
+		fclose(f);
+	if(o.failed)
+		fprintf(stderr, "%u cases exceed their bounds\n", o.failed);
+	return o.failed ? 1 : 0;
+	}
@@ -0,0 +1,633 @@
+/************************************************************************
+\file 	SrBenchmark.cpp
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <algorithm>
+#include "SrBenchmark.h"
+#include "SrMatrix34.h"
+#include "SrSimd.h"
+
+/*
+Measures the public operations of SrMath, SrVector3, SrQuaternion, SrMatrix33 and
+SrMatrix34 in single precision, and writes ns/op and ops/s as JSON.
+
+	g++ -O2 -I../orientation SrBenchmark.cpp -o SrBenchmark
+	SrBenchmark [--filter=text] [--mode=all|latency|throughput] [--sizes=16K,256K,8M,64M]
+				[--min-time=ms] [--samples=n] [--out=file.json]
+
+Each case is reported in latency mode and in throughput mode for every array size; the
+default sizes are meant to sit in L1, L2, L3 and DRAM. A sample repeats the loop until it
+runs for at least min-time, the best and the median of the samples are reported.
+
+Overloads that only differ in the form of their arguments (pointer or 2D array) are
+measured once. SrVector3::closestAxis, setNotUsed, isNotUsed and
+SrQuaternion::operator=(SrVector3) are declared without a definition and are left out.
+Operations that return another type feed their result back with SR_BENCH_FEED, which
+adds a multiply-add to the latency; the overhead case measures it.
+*/
+
+//the operands of every case are random with a fixed seed per state.
+static SrF32 srBenchRandom(SrU32& seed)
+	{
+	seed = seed * 1664525u + 1013904223u;
+	return (SrF32)(seed >> 8) * (2.0f / 16777216.0f) - 1.0f;
+	}
+
+static SrVector3 srBenchUnitVector(SrU32& seed)
+	{
+	SrVector3 v(srBenchRandom(seed), srBenchRandom(seed), srBenchRandom(seed));
+	v.x += 1.5f;
+	v.normalize();
+	return v;
+	}
+
+static SrQuaternion srBenchUnitQuaternion(SrU32& seed)
+	{
+	SrQuaternion q;
+	q.setXYZW(srBenchRandom(seed), srBenchRandom(seed), srBenchRandom(seed), srBenchRandom(seed) + 1.5f);
+	q.normalize();
+	return q;
+	}
+
+static SrMatrix33 srBenchRotation(SrU32& seed)
+	{
+	SrMatrix33 m;
+	m.fromQuat(srBenchUnitQuaternion(seed));
+	return m;
+	}
+
+/*
+The states. The values are chosen so that repeating an operation on its own result
+stays finite and away from the denormals: unit vectors, rotations, and multipliers s of 1.
+*/
+
+struct SrBenchMathState
+	{
+	SrF32 x, y, zero;
+	SrF64 dx, dy;
+	SrI32 i, j;
+	SrU32 u, v;
+	SrU16 us, us2;
+	SrI16 ss, ss2;
+	SrU32 h[8];
+
+	void init(SrU32 seed)
+		{
+		x = 0.5f + 0.25f * srBenchRandom(seed);
+		y = 0.5f + 0.25f * srBenchRandom(seed);
+		dx = x;
+		dy = y;
+		zero = 0.0f;
+		i = (SrI32)(srBenchRandom(seed) * 1000.0f);
+		j = (SrI32)(srBenchRandom(seed) * 1000.0f);
+		u = (SrU32)i + 1000u;
+		v = (SrU32)j + 1000u;
+		us = (SrU16)u;
+		us2 = (SrU16)v;
+		ss = (SrI16)i;
+		ss2 = (SrI16)j;
+		for(SrU32 k = 0; k < 8; k++)
+			h[k] = seed + k;
+		}
+	};
+
+struct SrBenchVector3State
+	{
+	SrVector3 a, b, u;
+	SrF32 s, zero;
+	SrF32 buf[3];
+
+	void init(SrU32 seed)
+		{
+		a = srBenchUnitVector(seed);
+		b = srBenchUnitVector(seed);
+		u.set(1.0f, -1.0f, 1.0f);
+		s = 1.0f;
+		zero = 0.0f;
+		a.get(buf);
+		}
+	};
+
+struct SrBenchQuaternionState
+	{
+	SrQuaternion p, q, r;
+	SrVector3 v, w;
+	SrF32 t, s, zero;
+	SrF32 buf[4];
+
+	void init(SrU32 seed)
+		{
+		p = srBenchUnitQuaternion(seed);
+		q = srBenchUnitQuaternion(seed);
+		r = srBenchUnitQuaternion(seed);
+		v = srBenchUnitVector(seed);
+		w = srBenchUnitVector(seed);
+		t = 0.5f + 0.25f * srBenchRandom(seed);
+		s = 1.0f;
+		zero = 0.0f;
+		p.getXYZW(buf);
+		}
+	};
+
+struct SrBenchMatrix33State
+	{
+	SrMatrix33 A, B;
+	SrQuaternion q;
+	SrVector3 v, u;
+	SrF32 s, zero;
+	SrF32 buf[16];
+
+	void init(SrU32 seed)
+		{
+		A = srBenchRotation(seed);
+		B = srBenchRotation(seed);
+		q = srBenchUnitQuaternion(seed);
+		v = srBenchUnitVector(seed);
+		u.set(1.0f, -1.0f, 1.0f);
+		s = 1.0f;
+		zero = 0.0f;
+		A.getRowMajorStride4(buf);
+		}
+	};
+
+struct SrBenchMatrix34State
+	{
+	SrMatrix34 P, Q;
+	SrVector3 v;
+	SrF32 zero;
+	SrF32 buf[16];
+
+	void init(SrU32 seed)
+		{
+		P.M = srBenchRotation(seed);
+		P.t = srBenchUnitVector(seed);
+		Q.M = srBenchRotation(seed);
+		Q.t = srBenchUnitVector(seed);
+		v = srBenchUnitVector(seed);
+		zero = 0.0f;
+		P.getRowMajor44(buf);
+		}
+	};
+
+//-------------------------------------------------------------------------------- overhead
+
+SR_BENCH_OP(SrBenchMathState, overheadNone, "overhead", "none", (void)s)
+SR_BENCH_OP(SrBenchMathState, overheadFeed, "overhead", "SR_BENCH_FEED", SR_BENCH_FEED(s.x, s.x))
+
+//-------------------------------------------------------------------------------- SrMath
+
+SR_BENCH_OP(SrBenchMathState, mathEquals, "SrMath", "equals(SrF32)", SR_BENCH_FEED(s.x, SrMath::equals(s.x, s.y, 1e-3f)))
+SR_BENCH_OP(SrBenchMathState, mathEqualsF64, "SrMath", "equals(SrF64)", SR_BENCH_FEED(s.dx, SrMath::equals(s.dx, s.dy, 1e-3)))
+SR_BENCH_OP(SrBenchMathState, mathFloor, "SrMath", "floor(SrF32)", SR_BENCH_FEED(s.x, SrMath::floor(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathFloorF64, "SrMath", "floor(SrF64)", SR_BENCH_FEED(s.dx, SrMath::floor(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathCeil, "SrMath", "ceil(SrF32)", SR_BENCH_FEED(s.x, SrMath::ceil(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathCeilF64, "SrMath", "ceil(SrF64)", SR_BENCH_FEED(s.dx, SrMath::ceil(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathTrunc, "SrMath", "trunc(SrF32)", SR_BENCH_FEED(s.x, SrMath::trunc(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathTruncF64, "SrMath", "trunc(SrF64)", SR_BENCH_FEED(s.dx, SrMath::trunc(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathAbs, "SrMath", "abs(SrF32)", s.x = SrMath::abs(s.x))
+SR_BENCH_OP(SrBenchMathState, mathAbsF64, "SrMath", "abs(SrF64)", s.dx = SrMath::abs(s.dx))
+SR_BENCH_OP(SrBenchMathState, mathAbsI32, "SrMath", "abs(SrI32)", s.i = SrMath::abs(s.i))
+SR_BENCH_OP(SrBenchMathState, mathSign, "SrMath", "sign(SrF32)", s.x = SrMath::sign(s.x))
+SR_BENCH_OP(SrBenchMathState, mathSignF64, "SrMath", "sign(SrF64)", s.dx = SrMath::sign(s.dx))
+SR_BENCH_OP(SrBenchMathState, mathSignI32, "SrMath", "sign(SrI32)", s.i = SrMath::sign(s.i))
+SR_BENCH_OP(SrBenchMathState, mathMax, "SrMath", "max(SrF32)", s.x = SrMath::max(s.x, s.y))
+SR_BENCH_OP(SrBenchMathState, mathMaxF64, "SrMath", "max(SrF64)", s.dx = SrMath::max(s.dx, s.dy))
+SR_BENCH_OP(SrBenchMathState, mathMaxI32, "SrMath", "max(SrI32)", s.i = SrMath::max(s.i, s.j))
+SR_BENCH_OP(SrBenchMathState, mathMaxU32, "SrMath", "max(SrU32)", s.u = SrMath::max(s.u, s.v))
+SR_BENCH_OP(SrBenchMathState, mathMaxU16, "SrMath", "max(SrU16)", s.us = SrMath::max(s.us, s.us2))
+SR_BENCH_OP(SrBenchMathState, mathMaxI16, "SrMath", "max(SrI16)", s.ss = SrMath::max(s.ss, s.ss2))
+SR_BENCH_OP(SrBenchMathState, mathMin, "SrMath", "min(SrF32)", s.x = SrMath::min(s.x, s.y))
+SR_BENCH_OP(SrBenchMathState, mathMinF64, "SrMath", "min(SrF64)", s.dx = SrMath::min(s.dx, s.dy))
+SR_BENCH_OP(SrBenchMathState, mathMinI32, "SrMath", "min(SrI32)", s.i = SrMath::min(s.i, s.j))
+SR_BENCH_OP(SrBenchMathState, mathMinU32, "SrMath", "min(SrU32)", s.u = SrMath::min(s.u, s.v))
+SR_BENCH_OP(SrBenchMathState, mathMinU16, "SrMath", "min(SrU16)", s.us = SrMath::min(s.us, s.us2))
+SR_BENCH_OP(SrBenchMathState, mathMinI16, "SrMath", "min(SrI16)", s.ss = SrMath::min(s.ss, s.ss2))
+SR_BENCH_OP(SrBenchMathState, mathMod, "SrMath", "mod(SrF32)", s.x = SrMath::mod(s.x + s.y, 1.0f))
+SR_BENCH_OP(SrBenchMathState, mathModF64, "SrMath", "mod(SrF64)", s.dx = SrMath::mod(s.dx + s.dy, 1.0))
+SR_BENCH_OP(SrBenchMathState, mathClamp, "SrMath", "clamp(SrF32)", s.x = SrMath::clamp(s.x + s.y, 0.75f, 0.25f))
+SR_BENCH_OP(SrBenchMathState, mathClampF64, "SrMath", "clamp(SrF64)", s.dx = SrMath::clamp(s.dx + s.dy, 0.75, 0.25))
+SR_BENCH_OP(SrBenchMathState, mathClampU32, "SrMath", "clamp(SrU32)", s.u = SrMath::clamp(s.u + s.v, 1500u, 500u))
+SR_BENCH_OP(SrBenchMathState, mathClampI32, "SrMath", "clamp(SrI32)", s.i = SrMath::clamp(s.i + s.j, 500, -500))
+SR_BENCH_OP(SrBenchMathState, mathSqrt, "SrMath", "sqrt(SrF32)", SR_BENCH_FEED(s.x, SrMath::sqrt(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathSqrtF64, "SrMath", "sqrt(SrF64)", SR_BENCH_FEED(s.dx, SrMath::sqrt(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathRecipSqrt, "SrMath", "recipSqrt(SrF32)", SR_BENCH_FEED(s.x, SrMath::recipSqrt(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathRecipSqrtF64, "SrMath", "recipSqrt(SrF64)", SR_BENCH_FEED(s.dx, SrMath::recipSqrt(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathPow, "SrMath", "pow(SrF32)", SR_BENCH_FEED(s.x, SrMath::pow(s.x, s.y)))
+SR_BENCH_OP(SrBenchMathState, mathPowF64, "SrMath", "pow(SrF64)", SR_BENCH_FEED(s.dx, SrMath::pow(s.dx, s.dy)))
+SR_BENCH_OP(SrBenchMathState, mathExp, "SrMath", "exp(SrF32)", SR_BENCH_FEED(s.x, SrMath::exp(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathExpF64, "SrMath", "exp(SrF64)", SR_BENCH_FEED(s.dx, SrMath::exp(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathLogE, "SrMath", "logE(SrF32)", SR_BENCH_FEED(s.x, SrMath::logE(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathLogEF64, "SrMath", "logE(SrF64)", SR_BENCH_FEED(s.dx, SrMath::logE(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathLog2, "SrMath", "log2(SrF32)", SR_BENCH_FEED(s.x, SrMath::log2(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathLog2F64, "SrMath", "log2(SrF64)", SR_BENCH_FEED(s.dx, SrMath::log2(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathLog10, "SrMath", "log10(SrF32)", SR_BENCH_FEED(s.x, SrMath::log10(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathLog10F64, "SrMath", "log10(SrF64)", SR_BENCH_FEED(s.dx, SrMath::log10(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathDegToRad, "SrMath", "degToRad(SrF32)", SR_BENCH_FEED(s.x, SrMath::degToRad(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathDegToRadF64, "SrMath", "degToRad(SrF64)", SR_BENCH_FEED(s.dx, SrMath::degToRad(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathRadToDeg, "SrMath", "radToDeg(SrF32)", SR_BENCH_FEED(s.x, SrMath::radToDeg(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathRadToDegF64, "SrMath", "radToDeg(SrF64)", SR_BENCH_FEED(s.dx, SrMath::radToDeg(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathSin, "SrMath", "sin(SrF32)", SR_BENCH_FEED(s.x, SrMath::sin(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathSinF64, "SrMath", "sin(SrF64)", SR_BENCH_FEED(s.dx, SrMath::sin(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathCos, "SrMath", "cos(SrF32)", SR_BENCH_FEED(s.x, SrMath::cos(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathCosF64, "SrMath", "cos(SrF64)", SR_BENCH_FEED(s.dx, SrMath::cos(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathSinCos, "SrMath", "sinCos(SrF32)", SrF32 sn = 0.0f; SrF32 cs = 0.0f; SrMath::sinCos(s.x, sn, cs); SR_BENCH_FEED(s.x, sn + cs))
+SR_BENCH_OP(SrBenchMathState, mathSinCosF64, "SrMath", "sinCos(SrF64)", SrF64 sn = 0.0; SrF64 cs = 0.0; SrMath::sinCos(s.dx, sn, cs); SR_BENCH_FEED(s.dx, sn + cs))
+SR_BENCH_OP(SrBenchMathState, mathTan, "SrMath", "tan(SrF32)", SR_BENCH_FEED(s.x, SrMath::tan(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathTanF64, "SrMath", "tan(SrF64)", SR_BENCH_FEED(s.dx, SrMath::tan(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathAsin, "SrMath", "asin(SrF32)", SR_BENCH_FEED(s.x, SrMath::asin(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathAsinF64, "SrMath", "asin(SrF64)", SR_BENCH_FEED(s.dx, SrMath::asin(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathAcos, "SrMath", "acos(SrF32)", SR_BENCH_FEED(s.x, SrMath::acos(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathAcosF64, "SrMath", "acos(SrF64)", SR_BENCH_FEED(s.dx, SrMath::acos(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathAtan, "SrMath", "atan(SrF32)", SR_BENCH_FEED(s.x, SrMath::atan(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathAtanF64, "SrMath", "atan(SrF64)", SR_BENCH_FEED(s.dx, SrMath::atan(s.dx)))
+SR_BENCH_OP(SrBenchMathState, mathAtan2, "SrMath", "atan2(SrF32)", SR_BENCH_FEED(s.x, SrMath::atan2(s.x, s.y)))
+SR_BENCH_OP(SrBenchMathState, mathAtan2F64, "SrMath", "atan2(SrF64)", SR_BENCH_FEED(s.dx, SrMath::atan2(s.dx, s.dy)))
+SR_BENCH_OP(SrBenchMathState, mathRand, "SrMath", "rand(SrF32)", SR_BENCH_FEED(s.x, SrMath::rand(s.x, 1.0f)))
+SR_BENCH_OP(SrBenchMathState, mathRandF64, "SrMath", "rand(SrF64)", SR_BENCH_FEED(s.dx, SrMath::rand(s.dx, 1.0)))
+SR_BENCH_OP(SrBenchMathState, mathRandI32, "SrMath", "rand(SrI32)", s.i = SrMath::rand(s.i & 7, 16))
+SR_BENCH_OP(SrBenchMathState, mathHash, "SrMath", "hash", s.h[0] = SrMath::hash(s.h, 8))
+SR_BENCH_OP(SrBenchMathState, mathHash32, "SrMath", "hash32", s.i = SrMath::hash32(s.i))
+SR_BENCH_OP(SrBenchMathState, mathIsFinite, "SrMath", "isFinite(SrF32)", SR_BENCH_FEED(s.x, SrMath::isFinite(s.x)))
+SR_BENCH_OP(SrBenchMathState, mathIsFiniteF64, "SrMath", "isFinite(SrF64)", SR_BENCH_FEED(s.dx, SrMath::isFinite(s.dx)))
+
+//-------------------------------------------------------------------------------- SrVector3
+
+SR_BENCH_OP(SrBenchVector3State, vec3CtorScalar, "SrVector3", "SrVector3(T)", s.a = SrVector3(s.a.y))
+SR_BENCH_OP(SrBenchVector3State, vec3CtorXYZ, "SrVector3", "SrVector3(T,T,T)", s.a = SrVector3(s.a.y, s.a.z, s.a.x))
+SR_BENCH_OP(SrBenchVector3State, vec3CtorArray, "SrVector3", "SrVector3(const T*)", s.a = SrVector3(s.buf); SR_BENCH_FEED(s.buf[0], s.a.y))
+SR_BENCH_OP(SrBenchVector3State, vec3CtorF64, "SrVector3", "SrVector3(SrVector3F64)", s.a = SrVector3(SrVector3F64(s.a)))
+SR_BENCH_OP(SrBenchVector3State, vec3Get, "SrVector3", "get(SrF32*)", s.a.get(s.buf); SR_BENCH_FEED(s.a.x, s.buf[2]))
+SR_BENCH_OP(SrBenchVector3State, vec3GetPtr, "SrVector3", "get()", s.a.x = s.a.get()[1])
+SR_BENCH_OP(SrBenchVector3State, vec3Index, "SrVector3", "operator[]", s.a[0] = s.a[2])
+SR_BENCH_OP(SrBenchVector3State, vec3Less, "SrVector3", "operator<", SR_BENCH_FEED(s.a.x, s.a < s.b))
+SR_BENCH_OP(SrBenchVector3State, vec3Equal, "SrVector3", "operator==", SR_BENCH_FEED(s.a.x, s.a == s.b))
+SR_BENCH_OP(SrBenchVector3State, vec3NotEqual, "SrVector3", "operator!=", SR_BENCH_FEED(s.a.x, s.a != s.b))
+SR_BENCH_OP(SrBenchVector3State, vec3SetArray, "SrVector3", "set(const SrF32*)", s.a.set(s.buf); SR_BENCH_FEED(s.buf[0], s.a.y))
+SR_BENCH_OP(SrBenchVector3State, vec3SetVector, "SrVector3", "set(SrVector3)", s.a.set(s.b); SR_BENCH_FEED(s.b.x, s.a.y))
+SR_BENCH_OP(SrBenchVector3State, vec3SetX, "SrVector3", "setx", s.a.setx(s.a.z))
+SR_BENCH_OP(SrBenchVector3State, vec3SetXYZ, "SrVector3", "set(T,T,T)", s.a.set(s.a.z, s.a.x, s.a.y))
+SR_BENCH_OP(SrBenchVector3State, vec3SetScalar, "SrVector3", "set(T)", s.a.set(s.a.z))
+SR_BENCH_OP(SrBenchVector3State, vec3SetNegativeOf, "SrVector3", "setNegative(SrVector3)", s.a.setNegative(s.a))
+SR_BENCH_OP(SrBenchVector3State, vec3SetNegative, "SrVector3", "setNegative()", s.a.setNegative())
+SR_BENCH_OP(SrBenchVector3State, vec3Zero, "SrVector3", "zero", s.a.zero())
+SR_BENCH_OP(SrBenchVector3State, vec3IsZero, "SrVector3", "isZero", SR_BENCH_FEED(s.a.x, s.a.isZero()))
+SR_BENCH_OP(SrBenchVector3State, vec3SetPlusInfinity, "SrVector3", "setPlusInfinity", s.a.setPlusInfinity())
+SR_BENCH_OP(SrBenchVector3State, vec3SetMinusInfinity, "SrVector3", "setMinusInfinity", s.a.setMinusInfinity())
+SR_BENCH_OP(SrBenchVector3State, vec3Min, "SrVector3", "min", s.a.min(s.b))
+SR_BENCH_OP(SrBenchVector3State, vec3Max, "SrVector3", "max", s.a.max(s.b))
+SR_BENCH_OP(SrBenchVector3State, vec3Add, "SrVector3", "add", s.a.add(s.a, s.b))
+SR_BENCH_OP(SrBenchVector3State, vec3Subtract, "SrVector3", "subtract", s.a.subtract(s.a, s.b))
+SR_BENCH_OP(SrBenchVector3State, vec3Multiply, "SrVector3", "multiply(T,SrVector3)", s.a.multiply(s.s, s.a))
+SR_BENCH_OP(SrBenchVector3State, vec3ArrayMultiply, "SrVector3", "arrayMultiply", s.a.arrayMultiply(s.a, s.u))
+SR_BENCH_OP(SrBenchVector3State, vec3MultiplyAdd, "SrVector3", "multiplyAdd", s.a.multiplyAdd(s.s, s.a, s.b))
+SR_BENCH_OP(SrBenchVector3State, vec3Normalize, "SrVector3", "normalize", SR_BENCH_FEED(s.a.x, s.a.normalize()))
+SR_BENCH_OP(SrBenchVector3State, vec3SetMagnitude, "SrVector3", "setMagnitude", s.a.setMagnitude(s.s))
+SR_BENCH_OP(SrBenchVector3State, vec3IsFinite, "SrVector3", "isFinite", SR_BENCH_FEED(s.a.x, s.a.isFinite()))
+SR_BENCH_OP(SrBenchVector3State, vec3Dot, "SrVector3", "dot", SR_BENCH_FEED(s.a.x, s.a.dot(s.b)))
+SR_BENCH_OP(SrBenchVector3State, vec3SameDirection, "SrVector3", "sameDirection", SR_BENCH_FEED(s.a.x, s.a.sameDirection(s.b)))
+SR_BENCH_OP(SrBenchVector3State, vec3Magnitude, "SrVector3", "magnitude", SR_BENCH_FEED(s.a.x, s.a.magnitude()))
+SR_BENCH_OP(SrBenchVector3State, vec3MagnitudeSquared, "SrVector3", "magnitudeSquared", SR_BENCH_FEED(s.a.x, s.a.magnitudeSquared()))
+SR_BENCH_OP(SrBenchVector3State, vec3Distance, "SrVector3", "distance", SR_BENCH_FEED(s.a.x, s.a.distance(s.b)))
+SR_BENCH_OP(SrBenchVector3State, vec3DistanceSquared, "SrVector3", "distanceSquared", SR_BENCH_FEED(s.a.x, s.a.distanceSquared(s.b)))
+SR_BENCH_OP(SrBenchVector3State, vec3Cross, "SrVector3", "cross(SrVector3,SrVector3)", s.a.cross(s.b, s.a))
+SR_BENCH_OP(SrBenchVector3State, vec3Equals, "SrVector3", "equals", SR_BENCH_FEED(s.a.x, s.a.equals(s.b, 1e-3f)))
+SR_BENCH_OP(SrBenchVector3State, vec3Negate, "SrVector3", "operator-()", s.a = -s.a)
+SR_BENCH_OP(SrBenchVector3State, vec3Plus, "SrVector3", "operator+", s.a = s.a + s.b)
+SR_BENCH_OP(SrBenchVector3State, vec3Minus, "SrVector3", "operator-", s.a = s.a - s.b)
+SR_BENCH_OP(SrBenchVector3State, vec3Times, "SrVector3", "operator*(T)", s.a = s.a * s.s)
+SR_BENCH_OP(SrBenchVector3State, vec3TimesLeft, "SrVector3", "operator*(T,SrVector3)", s.a = s.s * s.a)
+SR_BENCH_OP(SrBenchVector3State, vec3Divide, "SrVector3", "operator/(T)", s.a = s.a / s.s)
+SR_BENCH_OP(SrBenchVector3State, vec3PlusAssign, "SrVector3", "operator+=", s.a += s.b)
+SR_BENCH_OP(SrBenchVector3State, vec3MinusAssign, "SrVector3", "operator-=", s.a -= s.b)
+SR_BENCH_OP(SrBenchVector3State, vec3TimesAssign, "SrVector3", "operator*=(T)", s.a *= s.s)
+SR_BENCH_OP(SrBenchVector3State, vec3DivideAssign, "SrVector3", "operator/=(T)", s.a /= s.s)
+SR_BENCH_OP(SrBenchVector3State, vec3CrossReturn, "SrVector3", "cross(SrVector3)", s.a = s.b.cross(s.a))
+SR_BENCH_OP(SrBenchVector3State, vec3CrossOperator, "SrVector3", "operator^", s.a = s.b ^ s.a)
+SR_BENCH_OP(SrBenchVector3State, vec3DotOperator, "SrVector3", "operator|", SR_BENCH_FEED(s.a.x, s.a | s.b))
+
+//-------------------------------------------------------------------------------- SrQuaternion
+
+SR_BENCH_OP(SrBenchQuaternionState, quatCtorVector, "SrQuaternion", "SrQuaternion(SrVector3,T)", s.p = SrQuaternion(s.v, s.p.w))
+SR_BENCH_OP(SrBenchQuaternionState, quatCtorAngleAxis, "SrQuaternion", "SrQuaternion(T,SrVector3)", s.p = SrQuaternion(s.p.w, s.v))
+SR_BENCH_OP(SrBenchQuaternionState, quatCtorF64, "SrQuaternion", "SrQuaternion(SrQuaternionF64)", s.p = SrQuaternion(SrQuaternionF64(s.p)))
+SR_BENCH_OP(SrBenchQuaternionState, quatId, "SrQuaternion", "id", s.p.id())
+SR_BENCH_OP(SrBenchQuaternionState, quatIsIdentityRotation, "SrQuaternion", "isIdentityRotation", SR_BENCH_FEED(s.p.w, s.p.isIdentityRotation()))
+SR_BENCH_OP(SrBenchQuaternionState, quatSetWXYZ, "SrQuaternion", "setWXYZ(T,T,T,T)", s.p.setWXYZ(s.p.x, s.p.y, s.p.z, s.p.w))
+SR_BENCH_OP(SrBenchQuaternionState, quatSetXYZW, "SrQuaternion", "setXYZW(T,T,T,T)", s.p.setXYZW(s.p.y, s.p.z, s.p.w, s.p.x))
+SR_BENCH_OP(SrBenchQuaternionState, quatSetWXYZArray, "SrQuaternion", "setWXYZ(const T*)", s.p.setWXYZ(s.buf); SR_BENCH_FEED(s.buf[0], s.p.x))
+SR_BENCH_OP(SrBenchQuaternionState, quatSetXYZWArray, "SrQuaternion", "setXYZW(const T*)", s.p.setXYZW(s.buf); SR_BENCH_FEED(s.buf[0], s.p.x))
+SR_BENCH_OP(SrBenchQuaternionState, quatSetX, "SrQuaternion", "setx", s.p.setx(s.p.w))
+SR_BENCH_OP(SrBenchQuaternionState, quatGetWXYZ, "SrQuaternion", "getWXYZ(SrF32*)", s.p.getWXYZ(s.buf); SR_BENCH_FEED(s.p.x, s.buf[3]))
+SR_BENCH_OP(SrBenchQuaternionState, quatGetXYZW, "SrQuaternion", "getXYZW(SrF32*)", s.p.getXYZW(s.buf); SR_BENCH_FEED(s.p.x, s.buf[3]))
+SR_BENCH_OP(SrBenchQuaternionState, quatIsFinite, "SrQuaternion", "isFinite", SR_BENCH_FEED(s.p.w, s.p.isFinite()))
+SR_BENCH_OP(SrBenchQuaternionState, quatZero, "SrQuaternion", "zero", s.p.zero())
+SR_BENCH_OP(SrBenchQuaternionState, quatRandom, "SrQuaternion", "random", s.p.random())
+SR_BENCH_OP(SrBenchQuaternionState, quatFromAngleAxis, "SrQuaternion", "fromAngleAxis", s.p.fromAngleAxis(s.p.w, s.v))
+SR_BENCH_OP(SrBenchQuaternionState, quatFromAngleAxisFast, "SrQuaternion", "fromAngleAxisFast", s.p.fromAngleAxisFast(s.p.w, s.v))
+SR_BENCH_OP(SrBenchQuaternionState, quatInvert, "SrQuaternion", "invert", s.p.invert())
+SR_BENCH_OP(SrBenchQuaternionState, quatGetAngleAxis, "SrQuaternion", "getAngleAxis", SrF32 angle = 0.0f; s.p.getAngleAxis(angle, s.v); SR_BENCH_FEED(s.p.w, angle + s.v.x))
+SR_BENCH_OP(SrBenchQuaternionState, quatGetAngle, "SrQuaternion", "getAngle()", SR_BENCH_FEED(s.p.w, s.p.getAngle()))
+SR_BENCH_OP(SrBenchQuaternionState, quatGetAngleBetween, "SrQuaternion", "getAngle(SrQuaternion)", SR_BENCH_FEED(s.p.w, s.p.getAngle(s.q)))
+SR_BENCH_OP(SrBenchQuaternionState, quatMagnitudeSquared, "SrQuaternion", "magnitudeSquared", SR_BENCH_FEED(s.p.w, s.p.magnitudeSquared()))
+SR_BENCH_OP(SrBenchQuaternionState, quatDot, "SrQuaternion", "dot", SR_BENCH_FEED(s.p.w, s.p.dot(s.q)))
+SR_BENCH_OP(SrBenchQuaternionState, quatNormalize, "SrQuaternion", "normalize", s.p.normalize())
+SR_BENCH_OP(SrBenchQuaternionState, quatConjugate, "SrQuaternion", "conjugate", s.p.conjugate())
+SR_BENCH_OP(SrBenchQuaternionState, quatMultiply, "SrQuaternion", "multiply(SrQuaternion,SrQuaternion)", s.p.multiply(s.p, s.q))
+SR_BENCH_OP(SrBenchQuaternionState, quatMultiplyVector, "SrQuaternion", "multiply(SrQuaternion,SrVector3)", s.p.multiply(s.p, s.v))
+SR_BENCH_OP(SrBenchQuaternionState, quatSlerp, "SrQuaternion", "slerp", s.p.slerp(s.t + s.p.w * s.zero, s.q, s.r))
+SR_BENCH_OP(SrBenchQuaternionState, quatNlerp, "SrQuaternion", "nlerp", s.p.nlerp(s.t + s.p.w * s.zero, s.q, s.r))
+SR_BENCH_OP(SrBenchQuaternionState, quatCorrectedNlerp, "SrQuaternion", "correctedNlerp", s.p.correctedNlerp(s.t + s.p.w * s.zero, s.q, s.r))
+SR_BENCH_OP(SrBenchQuaternionState, quatCorrectNlerpT, "SrQuaternion", "correctNlerpT", SR_BENCH_FEED(s.t, SrQuaternion::correctNlerpT(s.t, 0.5f)))
+SR_BENCH_OP(SrBenchQuaternionState, quatRotate, "SrQuaternion", "rotate", s.q.rotate(s.v))
+SR_BENCH_OP(SrBenchQuaternionState, quatRot, "SrQuaternion", "rot", s.v = s.q.rot(s.v))
+SR_BENCH_OP(SrBenchQuaternionState, quatInvRot, "SrQuaternion", "invRot", s.v = s.q.invRot(s.v))
+SR_BENCH_OP(SrBenchQuaternionState, quatTransform, "SrQuaternion", "transform", s.v = s.q.transform(s.v, s.w))
+SR_BENCH_OP(SrBenchQuaternionState, quatInvTransform, "SrQuaternion", "invTransform", s.v = s.q.invTransform(s.v, s.w))
+SR_BENCH_OP(SrBenchQuaternionState, quatInverseRotate, "SrQuaternion", "inverseRotate", s.q.inverseRotate(s.v))
+SR_BENCH_OP(SrBenchQuaternionState, quatNegate, "SrQuaternion", "negate", s.p.negate())
+SR_BENCH_OP(SrBenchQuaternionState, quatUnaryMinus, "SrQuaternion", "operator-()", s.p = -s.p)
+SR_BENCH_OP(SrBenchQuaternionState, quatTimesAssign, "SrQuaternion", "operator*=(SrQuaternion)", s.p *= s.q)
+SR_BENCH_OP(SrBenchQuaternionState, quatPlusAssign, "SrQuaternion", "operator+=", s.p += s.q)
+SR_BENCH_OP(SrBenchQuaternionState, quatMinusAssign, "SrQuaternion", "operator-=", s.p -= s.q)
+SR_BENCH_OP(SrBenchQuaternionState, quatScaleAssign, "SrQuaternion", "operator*=(T)", s.p *= s.s)
+SR_BENCH_OP(SrBenchQuaternionState, quatTimes, "SrQuaternion", "operator*", s.p = s.p * s.q)
+SR_BENCH_OP(SrBenchQuaternionState, quatPlus, "SrQuaternion", "operator+", s.p = s.p + s.q)
+SR_BENCH_OP(SrBenchQuaternionState, quatMinus, "SrQuaternion", "operator-", s.p = s.p - s.q)
+SR_BENCH_OP(SrBenchQuaternionState, quatNot, "SrQuaternion", "operator!", s.p = !s.p)
+
+//-------------------------------------------------------------------------------- SrMatrix33
+
+SR_BENCH_OP(SrBenchMatrix33State, mat33CtorType, "SrMatrix33", "SrMatrix33(SrMatrixType)", s.A = SrMatrix33(SR_IDENTITY_MATRIX))
+SR_BENCH_OP(SrBenchMatrix33State, mat33CtorRows, "SrMatrix33", "SrMatrix33(SrVector3,SrVector3,SrVector3)", s.A = SrMatrix33(s.A.getRow(1), s.A.getRow(2), s.A.getRow(0)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33CtorQuat, "SrMatrix33", "SrMatrix33(SrQuaternion)", s.A = SrMatrix33(s.q); SR_BENCH_FEED(s.q.w, s.A(0, 0)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33CtorF64, "SrMatrix33", "SrMatrix33(SrMatrix33F64)", s.A = SrMatrix33(SrMatrix33F64(s.A)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33QuatCtor, "SrMatrix33", "SrQuaternion(SrMatrix33)", s.q = SrQuaternion(s.A); SR_BENCH_FEED(s.A(0, 0), s.q.w))
+SR_BENCH_OP(SrBenchMatrix33State, mat33SetRowMajor, "SrMatrix33", "setRowMajor(const SrF32*)", s.A.setRowMajor(s.buf); SR_BENCH_FEED(s.buf[0], s.A(2, 2)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33SetColumnMajor, "SrMatrix33", "setColumnMajor(const SrF32*)", s.A.setColumnMajor(s.buf); SR_BENCH_FEED(s.buf[0], s.A(2, 2)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33GetRowMajor, "SrMatrix33", "getRowMajor(SrF32*)", s.A.getRowMajor(s.buf); SR_BENCH_FEED(s.A(0, 0), s.buf[8]))
+SR_BENCH_OP(SrBenchMatrix33State, mat33GetColumnMajor, "SrMatrix33", "getColumnMajor(SrF32*)", s.A.getColumnMajor(s.buf); SR_BENCH_FEED(s.A(0, 0), s.buf[8]))
+SR_BENCH_OP(SrBenchMatrix33State, mat33SetRowMajorStride4, "SrMatrix33", "setRowMajorStride4(const SrF32*)", s.A.setRowMajorStride4(s.buf); SR_BENCH_FEED(s.buf[0], s.A(2, 2)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33SetColumnMajorStride4, "SrMatrix33", "setColumnMajorStride4(const SrF32*)", s.A.setColumnMajorStride4(s.buf); SR_BENCH_FEED(s.buf[0], s.A(2, 2)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33GetRowMajorStride4, "SrMatrix33", "getRowMajorStride4(SrF32*)", s.A.getRowMajorStride4(s.buf); SR_BENCH_FEED(s.A(0, 0), s.buf[10]))
+SR_BENCH_OP(SrBenchMatrix33State, mat33GetColumnMajorStride4, "SrMatrix33", "getColumnMajorStride4(SrF32*)", s.A.getColumnMajorStride4(s.buf); SR_BENCH_FEED(s.A(0, 0), s.buf[10]))
+SR_BENCH_OP(SrBenchMatrix33State, mat33SetRow, "SrMatrix33", "setRow", s.A.setRow(1, s.v); SR_BENCH_FEED(s.v.x, s.A(1, 2)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33SetColumn, "SrMatrix33", "setColumn", s.A.setColumn(1, s.v); SR_BENCH_FEED(s.v.x, s.A(2, 1)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33GetRowRef, "SrMatrix33", "getRow(int,SrVector3&)", s.A.getRow(2, s.v); SR_BENCH_FEED(s.A(0, 0), s.v.x))
+SR_BENCH_OP(SrBenchMatrix33State, mat33GetColumnRef, "SrMatrix33", "getColumn(int,SrVector3&)", s.A.getColumn(2, s.v); SR_BENCH_FEED(s.A(0, 0), s.v.x))
+SR_BENCH_OP(SrBenchMatrix33State, mat33GetRow, "SrMatrix33", "getRow(int)", s.v = s.A.getRow(2); SR_BENCH_FEED(s.A(0, 0), s.v.x))
+SR_BENCH_OP(SrBenchMatrix33State, mat33GetColumn, "SrMatrix33", "getColumn(int)", s.v = s.A.getColumn(2); SR_BENCH_FEED(s.A(0, 0), s.v.x))
+SR_BENCH_OP(SrBenchMatrix33State, mat33Element, "SrMatrix33", "operator()", s.A(0, 1) = s.A(2, 2))
+SR_BENCH_OP(SrBenchMatrix33State, mat33IsIdentity, "SrMatrix33", "isIdentity", SR_BENCH_FEED(s.A(0, 0), s.A.isIdentity()))
+SR_BENCH_OP(SrBenchMatrix33State, mat33IsZero, "SrMatrix33", "isZero", SR_BENCH_FEED(s.A(0, 0), s.A.isZero()))
+SR_BENCH_OP(SrBenchMatrix33State, mat33IsFinite, "SrMatrix33", "isFinite", SR_BENCH_FEED(s.A(0, 0), s.A.isFinite()))
+SR_BENCH_OP(SrBenchMatrix33State, mat33Zero, "SrMatrix33", "zero", s.A.zero())
+SR_BENCH_OP(SrBenchMatrix33State, mat33Id, "SrMatrix33", "id", s.A.id())
+SR_BENCH_OP(SrBenchMatrix33State, mat33SetNegative, "SrMatrix33", "setNegative", s.A.setNegative())
+SR_BENCH_OP(SrBenchMatrix33State, mat33Diagonal, "SrMatrix33", "diagonal", s.A.diagonal(s.v); SR_BENCH_FEED(s.v.x, s.A(1, 1)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33Star, "SrMatrix33", "star", s.A.star(s.v); SR_BENCH_FEED(s.v.x, s.A(1, 2)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33FromQuat, "SrMatrix33", "fromQuat", s.A.fromQuat(s.q); SR_BENCH_FEED(s.q.w, s.A(0, 0)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33ToQuat, "SrMatrix33", "toQuat", s.A.toQuat(s.q); SR_BENCH_FEED(s.A(0, 0), s.q.w))
+SR_BENCH_OP(SrBenchMatrix33State, mat33PlusAssign, "SrMatrix33", "operator+=", s.A += s.B)
+SR_BENCH_OP(SrBenchMatrix33State, mat33MinusAssign, "SrMatrix33", "operator-=", s.A -= s.B)
+SR_BENCH_OP(SrBenchMatrix33State, mat33ScaleAssign, "SrMatrix33", "operator*=(T)", s.A *= s.s)
+SR_BENCH_OP(SrBenchMatrix33State, mat33DivideAssign, "SrMatrix33", "operator/=(T)", s.A /= s.s)
+SR_BENCH_OP(SrBenchMatrix33State, mat33Determinant, "SrMatrix33", "determinant", SR_BENCH_FEED(s.A(0, 0), s.A.determinant()))
+SR_BENCH_OP(SrBenchMatrix33State, mat33GetInverse, "SrMatrix33", "getInverse", SR_BENCH_FEED(s.A(0, 0), s.A.getInverse(s.A)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33SetTransposedOf, "SrMatrix33", "setTransposed(SrMatrix33)", s.A.setTransposed(s.A))
+SR_BENCH_OP(SrBenchMatrix33State, mat33SetTransposed, "SrMatrix33", "setTransposed()", s.A.setTransposed())
+SR_BENCH_OP(SrBenchMatrix33State, mat33MultiplyDiagonal, "SrMatrix33", "multiplyDiagonal(SrVector3)", s.A.multiplyDiagonal(s.u))
+SR_BENCH_OP(SrBenchMatrix33State, mat33MultiplyDiagonalTranspose, "SrMatrix33", "multiplyDiagonalTranspose(SrVector3)", s.A.multiplyDiagonalTranspose(s.u))
+SR_BENCH_OP(SrBenchMatrix33State, mat33MultiplyDiagonalDst, "SrMatrix33", "multiplyDiagonal(SrVector3,SrMatrix33&)", s.A.multiplyDiagonal(s.u, s.A))
+SR_BENCH_OP(SrBenchMatrix33State, mat33MultiplyDiagonalTransposeDst, "SrMatrix33", "multiplyDiagonalTranspose(SrVector3,SrMatrix33&)", s.A.multiplyDiagonalTranspose(s.u, s.A))
+SR_BENCH_OP(SrBenchMatrix33State, mat33MultiplyVector, "SrMatrix33", "multiply(SrVector3,SrVector3&)", s.A.multiply(s.v, s.v))
+SR_BENCH_OP(SrBenchMatrix33State, mat33MultiplyByTranspose, "SrMatrix33", "multiplyByTranspose", s.A.multiplyByTranspose(s.v, s.v))
+SR_BENCH_OP(SrBenchMatrix33State, mat33Add, "SrMatrix33", "add", s.A.add(s.A, s.B))
+SR_BENCH_OP(SrBenchMatrix33State, mat33Subtract, "SrMatrix33", "subtract", s.A.subtract(s.A, s.B))
+SR_BENCH_OP(SrBenchMatrix33State, mat33MultiplyScalar, "SrMatrix33", "multiply(T,SrMatrix33)", s.A.multiply(s.s, s.A))
+SR_BENCH_OP(SrBenchMatrix33State, mat33Multiply, "SrMatrix33", "multiply(SrMatrix33,SrMatrix33)", s.A.multiply(s.A, s.B))
+SR_BENCH_OP(SrBenchMatrix33State, mat33MultiplyTransposeLeft, "SrMatrix33", "multiplyTransposeLeft", s.A.multiplyTransposeLeft(s.A, s.B))
+SR_BENCH_OP(SrBenchMatrix33State, mat33MultiplyTransposeRight, "SrMatrix33", "multiplyTransposeRight(SrMatrix33,SrMatrix33)", s.A.multiplyTransposeRight(s.A, s.B))
+SR_BENCH_OP(SrBenchMatrix33State, mat33OuterProduct, "SrMatrix33", "multiplyTransposeRight(SrVector3,SrVector3)", s.A.multiplyTransposeRight(s.v, s.v); SR_BENCH_FEED(s.v.x, s.A(1, 2)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33RotX, "SrMatrix33", "rotX", s.A.rotX(s.A(1, 2)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33RotY, "SrMatrix33", "rotY", s.A.rotY(s.A(0, 2)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33RotZ, "SrMatrix33", "rotZ", s.A.rotZ(s.A(0, 1)))
+SR_BENCH_OP(SrBenchMatrix33State, mat33TransposeTimesVector, "SrMatrix33", "operator%(SrVector3)", s.v = s.A % s.v)
+SR_BENCH_OP(SrBenchMatrix33State, mat33TimesVector, "SrMatrix33", "operator*(SrVector3)", s.v = s.A * s.v)
+SR_BENCH_OP(SrBenchMatrix33State, mat33TimesAssign, "SrMatrix33", "operator*=(SrMatrix33)", s.A *= s.B)
+SR_BENCH_OP(SrBenchMatrix33State, mat33Minus, "SrMatrix33", "operator-", s.A = s.A - s.B)
+SR_BENCH_OP(SrBenchMatrix33State, mat33Plus, "SrMatrix33", "operator+", s.A = s.A + s.B)
+SR_BENCH_OP(SrBenchMatrix33State, mat33Times, "SrMatrix33", "operator*(SrMatrix33)", s.A = s.A * s.B)
+SR_BENCH_OP(SrBenchMatrix33State, mat33TimesScalar, "SrMatrix33", "operator*(T)", s.A = s.A * s.s)
+
+//-------------------------------------------------------------------------------- SrMatrix34
+
+SR_BENCH_OP(SrBenchMatrix34State, mat34CtorInit, "SrMatrix34", "SrMatrix34(bool)", s.P = SrMatrix34(true))
+SR_BENCH_OP(SrBenchMatrix34State, mat34CtorRotTrans, "SrMatrix34", "SrMatrix34(SrMatrix33,SrVector3)", s.P = SrMatrix34(s.Q.M, s.P.t))
+SR_BENCH_OP(SrBenchMatrix34State, mat34CtorF64, "SrMatrix34", "SrMatrix34(SrMatrix34F64)", s.P = SrMatrix34(SrMatrix34F64(s.P)))
+SR_BENCH_OP(SrBenchMatrix34State, mat34Zero, "SrMatrix34", "zero", s.P.zero())
+SR_BENCH_OP(SrBenchMatrix34State, mat34Id, "SrMatrix34", "id", s.P.id())
+SR_BENCH_OP(SrBenchMatrix34State, mat34IsIdentity, "SrMatrix34", "isIdentity", SR_BENCH_FEED(s.P.t.x, s.P.isIdentity()))
+SR_BENCH_OP(SrBenchMatrix34State, mat34IsFinite, "SrMatrix34", "isFinite", SR_BENCH_FEED(s.P.t.x, s.P.isFinite()))
+SR_BENCH_OP(SrBenchMatrix34State, mat34GetInverse, "SrMatrix34", "getInverse", SR_BENCH_FEED(s.P.t.x, s.P.getInverse(s.P)))
+SR_BENCH_OP(SrBenchMatrix34State, mat34GetInverseRT, "SrMatrix34", "getInverseRT", SR_BENCH_FEED(s.P.t.x, s.P.getInverseRT(s.P)))
+SR_BENCH_OP(SrBenchMatrix34State, mat34MultiplyVector, "SrMatrix34", "multiply(SrVector3,SrVector3&)", s.P.multiply(s.v, s.v))
+SR_BENCH_OP(SrBenchMatrix34State, mat34TimesVector, "SrMatrix34", "operator*(SrVector3)", s.v = s.P * s.v)
+SR_BENCH_OP(SrBenchMatrix34State, mat34MultiplyByInverseRT, "SrMatrix34", "multiplyByInverseRT", s.P.multiplyByInverseRT(s.v, s.v))
+SR_BENCH_OP(SrBenchMatrix34State, mat34InverseTimesVector, "SrMatrix34", "operator%(SrVector3)", s.v = s.P % s.v)
+SR_BENCH_OP(SrBenchMatrix34State, mat34Multiply, "SrMatrix34", "multiply(SrMatrix34,SrMatrix34)", s.P.multiply(s.P, s.Q))
+SR_BENCH_OP(SrBenchMatrix34State, mat34MultiplyInverseRTLeft, "SrMatrix34", "multiplyInverseRTLeft", s.P.multiplyInverseRTLeft(s.P, s.Q))
+SR_BENCH_OP(SrBenchMatrix34State, mat34MultiplyInverseRTRight, "SrMatrix34", "multiplyInverseRTRight", s.P.multiplyInverseRTRight(s.P, s.Q))
+SR_BENCH_OP(SrBenchMatrix34State, mat34Times, "SrMatrix34", "operator*(SrMatrix34)", s.P = s.P * s.Q)
+SR_BENCH_OP(SrBenchMatrix34State, mat34SetColumnMajor44, "SrMatrix34", "setColumnMajor44(const SrF32*)", s.P.setColumnMajor44(s.buf); SR_BENCH_FEED(s.buf[0], s.P.t.x))
+SR_BENCH_OP(SrBenchMatrix34State, mat34GetColumnMajor44, "SrMatrix34", "getColumnMajor44(SrF32*)", s.P.getColumnMajor44(s.buf); SR_BENCH_FEED(s.P.t.x, s.buf[12]))
+SR_BENCH_OP(SrBenchMatrix34State, mat34SetRowMajor44, "SrMatrix34", "setRowMajor44(const SrF32*)", s.P.setRowMajor44(s.buf); SR_BENCH_FEED(s.buf[0], s.P.t.x))
+SR_BENCH_OP(SrBenchMatrix34State, mat34GetRowMajor44, "SrMatrix34", "getRowMajor44(SrF32*)", s.P.getRowMajor44(s.buf); SR_BENCH_FEED(s.P.t.x, s.buf[3]))
+
+//-------------------------------------------------------------------------------- driver
+
+struct SrBenchOptions
+	{
+	std::string filter;
+	bool latency;
+	bool throughput;
+	std::vector<SrU32> sizes;
+	SrF64 minTime;
+	SrU32 samples;
+	const char* out;
+	};
+
+//parses 16K, 8M or a plain byte count.
+static SrU32 srBenchParseSize(const char* text)
+	{
+	char* end = NULL;
+	SrF64 size = strtod(text, &end);
+	if(*end == 'K' || *end == 'k')
+		size *= 1024.0;
+	else if(*end == 'M' || *end == 'm')
+		size *= 1024.0 * 1024.0;
+	return (SrU32)size;
+	}
+
+static bool srBenchParse(int argc, char** argv, SrBenchOptions& o)
+	{
+	o.latency = o.throughput = true;
+	o.minTime = 0.02;
+	o.samples = 5;
+	o.out = NULL;
+	const char* sizes = "16K,256K,8M,64M";
+	for(int i = 1; i < argc; i++)
+		{
+		const char* a = argv[i];
+		if(strncmp(a, "--filter=", 9) == 0)
+			o.filter = a + 9;
+		else if(strcmp(a, "--mode=latency") == 0)
+			o.throughput = false;
+		else if(strcmp(a, "--mode=throughput") == 0)
+			o.latency = false;
+		else if(strcmp(a, "--mode=all") == 0)
+			o.latency = o.throughput = true;
+		else if(strncmp(a, "--sizes=", 8) == 0)
+			sizes = a + 8;
+		else if(strncmp(a, "--min-time=", 11) == 0)
+			o.minTime = atof(a + 11) * 1e-3;
+		else if(strncmp(a, "--samples=", 10) == 0)
+			o.samples = (SrU32)atoi(a + 10);
+		else if(strncmp(a, "--out=", 6) == 0)
+			o.out = a + 6;
+		else
+			{
+			fprintf(stderr, "usage: %s [--filter=text] [--mode=all|latency|throughput] [--sizes=16K,256K,8M,64M] [--min-time=ms] [--samples=n] [--out=file.json]\n", argv[0]);
+			return false;
+			}
+		}
+	for(const char* p = sizes; *p; )
+		{
+		o.sizes.push_back(srBenchParseSize(p));
+		p = strchr(p, ',');
+		if(!p)
+			break;
+		p++;
+		}
+	if(o.samples == 0)
+		o.samples = 1;
+	return true;
+	}
+
+static const char* srBenchSimdName()
+	{
+#if defined(SR_SIMD_DISABLE)
+	return "scalar";
+#elif defined(SR_SIMD_AVX512)
+	return "avx512";
+#elif defined(SR_SIMD_AVX2)
+	return "avx2";
+#elif defined(SR_SIMD_SSE)
+	return "sse";
+#else
+	return "scalar";
+#endif
+	}
+
+static void srBenchWriteString(FILE* f, const char* s)
+	{
+	fputc('"', f);
+	for(; *s; s++)
+		{
+		if(*s == '"' || *s == '\\')
+			fputc('\\', f);
+		fputc(*s, f);
+		}
+	fputc('"', f);
+	}
+
+/*
+One measurement: doubles the count until a run lasts minTime, then takes the samples
+with that count. Returns the best and the median time per operation in ns.
+*/
+template<class Run>
+static void srBenchMeasure(const SrBenchOptions& o, SrU32 opsPerCount, Run run, SrF64& best, SrF64& median, SrU32& count)
+	{
+	count = 1;
+	while(run(count) < o.minTime && count < 0x40000000u)
+		count *= 2;
+	std::vector<SrF64> times;
+	for(SrU32 i = 0; i < o.samples; i++)
+		times.push_back(run(count) * 1e9 / ((SrF64)count * opsPerCount));
+	std::sort(times.begin(), times.end());
+	best = times[0];
+	median = times[times.size() / 2];
+	}
+
+static void srBenchWriteResult(FILE* f, bool& first, const SrBenchCase& c, const char* mode, SrU32 elements, SrF64 best, SrF64 median, SrU32 count)
+	{
+	fprintf(f, "%s\n\t\t{\"class\": ", first ? "" : ",");
+	first = false;
+	srBenchWriteString(f, c.className);
+	fprintf(f, ", \"op\": ");
+	srBenchWriteString(f, c.opName);
+	fprintf(f, ", \"mode\": \"%s\", \"elements\": %u, \"bytes\": %.0f, \"ns_per_op\": %.4f, \"ns_per_op_median\": %.4f, \"ops_per_s\": %.6g, \"repetitions\": %u}",
+			mode, elements, (SrF64)elements * c.stateSize, best, median, 1e9 / best, count);
+	fflush(f);
+	}
+
+int main(int argc, char** argv)
+	{
+	SrBenchOptions o;
+	if(!srBenchParse(argc, argv, o))
+		return 1;
+	FILE* f = o.out ? fopen(o.out, "w") : stdout;
+	if(!f)
+		{
+		fprintf(stderr, "cannot open %s\n", o.out);
+		return 1;
+		}
+
+	fprintf(f, "{\n\t\"library\": \"orientation\",\n\t\"simd\": \"%s\",\n", srBenchSimdName());
+#if defined(__VERSION__)
+	fprintf(f, "\t\"compiler\": ");
+	srBenchWriteString(f, __VERSION__);
+	fprintf(f, ",\n");
+#elif defined(_MSC_FULL_VER)
+	fprintf(f, "\t\"compiler\": \"msvc %d\",\n", _MSC_FULL_VER);
+#endif
+	fprintf(f, "\t\"min_time_ms\": %g,\n\t\"samples\": %u,\n\t\"results\": [", o.minTime * 1e3, o.samples);
+
+	bool first = true;
+	const std::vector<SrBenchCase>& cases = srBenchCases();
+	for(size_t i = 0; i < cases.size(); i++)
+		{
+		const SrBenchCase& c = cases[i];
+		const std::string name = std::string(c.className) + "::" + c.opName;
+		if(!o.filter.empty() && name.find(o.filter) == std::string::npos)
+			continue;
+		if(f != stdout)
+			fprintf(stderr, "%s\n", name.c_str());
+
+		SrF64 best, median;
+		SrU32 count;
+		if(o.latency)
+			{
+			srBenchMeasure(o, 1, [&](SrU32 n) { return c.latency(n); }, best, median, count);
+			srBenchWriteResult(f, first, c, "latency", 1, best, median, count);
+			}
+		if(o.throughput)
+			{
+			for(size_t k = 0; k < o.sizes.size(); k++)
+				{
+				const SrU32 n = std::max(o.sizes[k] / c.stateSize, 1u);
+				srBenchMeasure(o, n, [&](SrU32 passes) { return c.throughput(n, passes); }, best, median, count);
+				srBenchWriteResult(f, first, c, "throughput", n, best, median, count);
+				}
+			}
+		}
+	fprintf(f, "\n\t]\n}\n");
+	if(f != stdout)
+		fclose(f);
+	return 0;
+	}
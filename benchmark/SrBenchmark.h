@@ -0,0 +1,179 @@
+/************************************************************************
+\file 	SrBenchmark.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRBENCHMARK_H_
+#define SR_FOUNDATION_SRBENCHMARK_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include <vector>
+#include <chrono>
+#include "SrSimpleTypes.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+Microbenchmark harness.
+
+An operation is a struct with a State type and a static run(State&) that applies the
+operation in place, so its next run depends on the previous result. It is measured in
+two modes:
+
+	latency		run() repeated on one state, a dependent chain: the time of one operation
+				from its inputs to its result.
+	throughput	run() over an array of independent states: the time per operation when
+				the processor overlaps them. The array size picks the memory level.
+
+The state is written back to memory after every operation, so the compiler cannot fold
+or hoist the repeated calls; latency includes that store to load forwarding, see the
+overhead case.
+
+SR_BENCH_OP registers an operation under a class and an operation name.
+*/
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SR_BENCH_NOINLINE	__attribute__((noinline))
+#elif defined(_MSC_VER)
+#define SR_BENCH_NOINLINE	__declspec(noinline)
+#else
+#define SR_BENCH_NOINLINE
+#endif
+
+/**
+\brief Makes the compiler assume p is read and every memory is written.
+*/
+SR_INLINE void srBenchClobber(const void* p)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+	__asm__ __volatile__("" : : "r"(p) : "memory");
+#elif defined(_MSC_VER)
+	static const void* volatile sink;
+	sink = p;
+	_ReadWriteBarrier();
+#else
+	static const void* volatile sink;
+	sink = p;
+#endif
+	}
+
+/**
+\brief One registered operation.
+*/
+struct SrBenchCase
+	{
+	const char* className;
+	const char* opName;
+	/**
+	\brief Size of the state, an element of the throughput array.
+	*/
+	SrU32 stateSize;
+	/**
+	\brief Seconds for count dependent runs.
+	*/
+	SrF64 (*latency)(SrU32 count);
+	/**
+	\brief Seconds for passes runs over n independent states.
+	*/
+	SrF64 (*throughput)(SrU32 n, SrU32 passes);
+	};
+
+/**
+\brief The registered operations, in registration order.
+*/
+SR_INLINE std::vector<SrBenchCase>& srBenchCases()
+	{
+	static std::vector<SrBenchCase> cases;
+	return cases;
+	}
+
+/**
+\brief The timed loops of one operation, with the operation inlined.
+*/
+template<class Op>
+class SrBenchRunner
+	{
+	public:
+	typedef typename Op::State State;
+
+	SR_BENCH_NOINLINE static SrF64 latency(SrU32 count)
+		{
+		State s;
+		s.init(1);
+		srBenchClobber(&s);
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for(SrU32 i = 0; i < count; i++)
+			{
+			Op::run(s);
+			srBenchClobber(&s);
+			}
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		return std::chrono::duration<SrF64>(end - start).count();
+		}
+
+	SR_BENCH_NOINLINE static SrF64 throughput(SrU32 n, SrU32 passes)
+		{
+		std::vector<State> states(n);
+		for(SrU32 i = 0; i < n; i++)
+			states[i].init(i + 1);
+		State* s = &states[0];
+		srBenchClobber(s);
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for(SrU32 p = 0; p < passes; p++)
+			{
+			for(SrU32 i = 0; i < n; i++)
+				{
+				Op::run(s[i]);
+				srBenchClobber(s + i);
+				}
+			}
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		return std::chrono::duration<SrF64>(end - start).count();
+		}
+	};
+
+/**
+\brief Registers Op at static initialisation.
+*/
+template<class Op>
+class SrBenchRegistrar
+	{
+	public:
+	SrBenchRegistrar(const char* className, const char* opName)
+		{
+		SrBenchCase c;
+		c.className = className;
+		c.opName = opName;
+		c.stateSize = sizeof(typename Op::State);
+		c.latency = SrBenchRunner<Op>::latency;
+		c.throughput = SrBenchRunner<Op>::throughput;
+		srBenchCases().push_back(c);
+		}
+	};
+
+/**
+\brief Defines and registers an operation. The body, the remaining arguments, works on the State s.
+
+id must be unique in the file, className and opName are the names reported.
+*/
+#define SR_BENCH_OP(StateType, id, className, opName, ...)							\
+	struct SrBenchOp_##id															\
+		{																			\
+		typedef StateType State;													\
+		static SR_INLINE void run(State& s) { __VA_ARGS__; }						\
+		};																			\
+	static SrBenchRegistrar<SrBenchOp_##id> srBenchRegistrar_##id(className, opName);
+
+/**
+\brief Feeds a result of another type back into an operand, which keeps its value as
+s.zero is 0 at run time, but the next run depends on the result.
+*/
+#define SR_BENCH_FEED(operand, result)	((operand) += (SrF32)(result) * s.zero)
+
+/** @} */
+#endif
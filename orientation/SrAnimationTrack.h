@@ -0,0 +1,477 @@
+/************************************************************************
+\file 	SrAnimationTrack.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRANIMATIONTRACK_H_
+#define SR_FOUNDATION_SRANIMATIONTRACK_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include "SrSimd.h"
+#include "SrSimdDispatch.h"
+#include "SrQuaternion.h"
+#include "SrMatrix34.h"
+#include "SrQuaternionBatch.h"
+#include "SrMatrix33Batch.h"
+#include "SrQuaternionSoA.h"
+#include "SrVector3SoA.h"
+#include "SrKeyTimes.h"
+
+/**
+\brief Playback position in an SrAnimationTrack, one per playing instance of the track.
+
+Remembers the segment sampled last, so that the next sample of a forward or backward
+playback finds its keys without a search.
+*/
+class SrTrackCursor
+	{
+	public:
+	SR_INLINE SrTrackCursor() : key(0)
+		{
+		}
+
+	/**
+	\brief first key of the segment sampled last.
+	*/
+	SrU32 key;
+	};
+
+/**
+\brief Time sorted rotation and translation keys of one animated transform.
+
+The keys are stored as records of eight floats, rotation, translation and a pad, so the
+two keys of a segment are one aligned 32 byte pair and usually share a cache line. A
+sample looks up its segment from an SrTrackCursor: the segment of the last sample and
+the one after it are tested first, which is all a playback at a frame rate above the key
+rate needs, and a seek falls back to a binary search over the times. Times outside the
+keys are clamped. Rotations are interpolated with one of the SrQuatInterpolation modes,
+translations linearly.
+
+The batch versions sample n instances, each with its own track, time and cursor, and
+write SoA pose lanes or SrMatrix34 arrays. They look up and transpose the segments of
+SrSimdNative::Width instances, then interpolate and convert them in registers; tracks may
+repeat, the bones of a clip are n tracks at one time. The lookups stay scalar and take
+most of the time with the wider sets. Measured for 10k instances of 64 tracks of 120 keys,
+times advancing by 1/60 per call, g++ -O2, ns per instance:
+
+						AVX-512		SSE2		sample(), SSE2
+	slerp, SoA			17			27			86
+	nlerp, SoA			15			16			53
+	slerp, SrMatrix34	15			32
+
+slerp keeps the error of SrQuaternionBatch::slerp() for keys less than 0.01 rad apart,
+up to 5e-4 rad; the nlerp modes stay within 1e-6 rad of the exact slerp there.
+*/
+class SrAnimationTrack
+	{
+	public:
+	/**
+	\brief Creates an empty track, setKeys() must be called before any sample.
+	*/
+	SR_INLINE SrAnimationTrack();
+
+	/**
+	\brief Sets the n keys, times must be strictly increasing and rotations unit length.
+	*/
+	SR_INLINE void setKeys(const SrF32* times, const SrQuaternion* rotations, const SrVector3* translations, SrU32 n);
+
+	SR_INLINE SrU32 getKeyCount() const;
+	SR_INLINE SrF32 getStartTime() const;
+	SR_INLINE SrF32 getEndTime() const;
+	SR_INLINE SrF32 getTime(SrU32 i) const;
+	SR_INLINE SrQuaternion getRotation(SrU32 i) const;
+	SR_INLINE SrVector3 getTranslation(SrU32 i) const;
+
+	/**
+	\brief the first key of the segment of time t and the parameter u in [0, 1] between its
+	keys, updates the cursor.
+	*/
+	SR_INLINE SrU32 findKey(SrF32 t, SrTrackCursor& cursor, SrF32& u) const;
+
+	/**
+	\brief the rotation and translation at time t, the code of the batch versions on SrSimdScalar.
+	*/
+	SR_INLINE void sample(SrQuatInterpolation mode, SrF32 t, SrTrackCursor& cursor, SrQuaternion& rotation, SrVector3& translation) const;
+
+	/**
+	\brief the transform at time t.
+	*/
+	SR_INLINE void sample(SrQuatInterpolation mode, SrF32 t, SrTrackCursor& cursor, SrMatrix34& pose) const;
+
+	/**
+	\brief samples tracks[i] at times[i] with cursors[i], into pose lanes.
+	*/
+	SR_INLINE static void sample(SrQuatInterpolation mode, const SrAnimationTrack* const* tracks, const SrF32* times, SrTrackCursor* cursors,
+								 SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrF32* tx, SrF32* ty, SrF32* tz, SrU32 n);
+
+	/**
+	\brief samples tracks[i] at one time for all of them, into pose lanes.
+	*/
+	SR_INLINE static void sample(SrQuatInterpolation mode, const SrAnimationTrack* const* tracks, SrF32 time, SrTrackCursor* cursors,
+								 SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrF32* tx, SrF32* ty, SrF32* tz, SrU32 n);
+
+	/**
+	\brief the same forms into an array of transforms.
+	*/
+	SR_INLINE static void sample(SrQuatInterpolation mode, const SrAnimationTrack* const* tracks, const SrF32* times, SrTrackCursor* cursors,
+								 SrMatrix34* poses, SrU32 n);
+	SR_INLINE static void sample(SrQuatInterpolation mode, const SrAnimationTrack* const* tracks, SrF32 time, SrTrackCursor* cursors,
+								 SrMatrix34* poses, SrU32 n);
+
+	/**
+	\brief container versions, rotations and translations are resized to n.
+	*/
+	SR_INLINE static void sample(SrQuatInterpolation mode, const SrAnimationTrack* const* tracks, const SrF32* times, SrTrackCursor* cursors,
+								 SrQuaternionSoA& rotations, SrVector3SoA& translations, SrU32 n);
+	SR_INLINE static void sample(SrQuatInterpolation mode, const SrAnimationTrack* const* tracks, SrF32 time, SrTrackCursor* cursors,
+								 SrQuaternionSoA& rotations, SrVector3SoA& translations, SrU32 n);
+
+	/**
+	\brief the kernels, times is NULL when sharedTime applies to all instances.
+	*/
+	template<class V, SrQuatInterpolation M>
+	SR_INLINE static void sampleLanes(const SrAnimationTrack* const* tracks, const SrF32* times, SrF32 sharedTime, SrTrackCursor* cursors,
+									  SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrF32* tx, SrF32* ty, SrF32* tz, SrU32 n);
+	template<class V, SrQuatInterpolation M>
+	SR_INLINE static void sampleMatrices(const SrAnimationTrack* const* tracks, const SrF32* times, SrF32 sharedTime, SrTrackCursor* cursors,
+										 SrMatrix34* poses, SrU32 n);
+
+	private:
+	/**
+	\brief floats per key record.
+	*/
+	static const SrU32 KeySize = 8;
+
+	/**
+	\brief samples V::Width instances into registers, q[4] rotation and p[3] translation.
+	*/
+	template<class V, SrQuatInterpolation M>
+	SR_INLINE static void sampleBlock(const SrAnimationTrack* const* tracks, const SrF32* times, SrF32 sharedTime, SrTrackCursor* cursors,
+									  typename V::Float q[4], typename V::Float p[3]);
+
+	SrKeyTimes mKeys;	//KeySize floats per key record, one record per key time
+	};
+
+/**
+\brief The SrAnimationTrack kernels of one SrSimd set, the table SR_SIMD_KERNEL() calls through
+with SR_SIMD_DISPATCH.
+*/
+struct SrAnimationTrackKernels
+	{
+	void (*trackSampleLanes[3])(const SrAnimationTrack* const* tracks, const SrF32* times, SrF32 sharedTime, SrTrackCursor* cursors,
+								SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrF32* tx, SrF32* ty, SrF32* tz, SrU32 n);
+	void (*trackSampleMatrices[3])(const SrAnimationTrack* const* tracks, const SrF32* times, SrF32 sharedTime, SrTrackCursor* cursors,
+								   SrMatrix34* poses, SrU32 n);
+
+	/**
+	\brief The table of the set V, see SrSimdDispatch.h.
+	*/
+	template<class V>
+	class Table
+		{
+		public:
+		static SrAnimationTrackKernels create()
+			{
+			SrAnimationTrackKernels k;
+			k.trackSampleLanes[SR_QUAT_SLERP] = trackSampleLanes<SR_QUAT_SLERP>;
+			k.trackSampleLanes[SR_QUAT_NLERP] = trackSampleLanes<SR_QUAT_NLERP>;
+			k.trackSampleLanes[SR_QUAT_CORRECTED_NLERP] = trackSampleLanes<SR_QUAT_CORRECTED_NLERP>;
+			k.trackSampleMatrices[SR_QUAT_SLERP] = trackSampleMatrices<SR_QUAT_SLERP>;
+			k.trackSampleMatrices[SR_QUAT_NLERP] = trackSampleMatrices<SR_QUAT_NLERP>;
+			k.trackSampleMatrices[SR_QUAT_CORRECTED_NLERP] = trackSampleMatrices<SR_QUAT_CORRECTED_NLERP>;
+			return k;
+			}
+
+		private:
+		template<SrQuatInterpolation M>
+		SR_SIMD_FLATTEN static void trackSampleLanes(const SrAnimationTrack* const* tracks, const SrF32* times, SrF32 sharedTime, SrTrackCursor* cursors,
+													 SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrF32* tx, SrF32* ty, SrF32* tz, SrU32 n)
+			{
+			SrAnimationTrack::sampleLanes<V, M>(tracks, times, sharedTime, cursors, qx, qy, qz, qw, tx, ty, tz, n);
+			}
+
+		template<SrQuatInterpolation M>
+		SR_SIMD_FLATTEN static void trackSampleMatrices(const SrAnimationTrack* const* tracks, const SrF32* times, SrF32 sharedTime, SrTrackCursor* cursors,
+														SrMatrix34* poses, SrU32 n)
+			{
+			SrAnimationTrack::sampleMatrices<V, M>(tracks, times, sharedTime, cursors, poses, n);
+			}
+		};
+	};
+
+
+SR_INLINE SrAnimationTrack::SrAnimationTrack()
+	{
+	}
+
+SR_INLINE void SrAnimationTrack::setKeys(const SrF32* times, const SrQuaternion* rotations, const SrVector3* translations, SrU32 n)
+	{
+	SR_ASSERT(n > 0);
+	mKeys.allocate(n, KeySize, 1);
+	mKeys.setTimes(times);
+
+	//one key is a constant segment of length 1.
+	for(SrU32 i = 0; i <= mKeys.getSegmentCount(); i++)
+		{
+		const SrU32 k = i < n ? i : n - 1;
+		SrF32* r = mKeys.getRecords() + i * KeySize;
+		r[0] = rotations[k].x;
+		r[1] = rotations[k].y;
+		r[2] = rotations[k].z;
+		r[3] = rotations[k].w;
+		r[4] = translations[k].x;
+		r[5] = translations[k].y;
+		r[6] = translations[k].z;
+		r[7] = 0.0f;
+		}
+	}
+
+SR_INLINE SrU32 SrAnimationTrack::getKeyCount() const
+	{
+	return mKeys.getKeyCount();
+	}
+
+SR_INLINE SrF32 SrAnimationTrack::getStartTime() const
+	{
+	return mKeys.getTime(0);
+	}
+
+SR_INLINE SrF32 SrAnimationTrack::getEndTime() const
+	{
+	return mKeys.getTime(mKeys.getKeyCount() - 1);
+	}
+
+SR_INLINE SrF32 SrAnimationTrack::getTime(SrU32 i) const
+	{
+	SR_ASSERT(i < mKeys.getKeyCount());
+	return mKeys.getTime(i);
+	}
+
+SR_INLINE SrQuaternion SrAnimationTrack::getRotation(SrU32 i) const
+	{
+	SR_ASSERT(i < mKeys.getKeyCount());
+	const SrF32* r = mKeys.getRecords() + i * KeySize;
+	SrQuaternion q;
+	q.setXYZW(r[0], r[1], r[2], r[3]);
+	return q;
+	}
+
+SR_INLINE SrVector3 SrAnimationTrack::getTranslation(SrU32 i) const
+	{
+	SR_ASSERT(i < mKeys.getKeyCount());
+	const SrF32* r = mKeys.getRecords() + i * KeySize;
+	return SrVector3(r[4], r[5], r[6]);
+	}
+
+SR_INLINE SrU32 SrAnimationTrack::findKey(SrF32 t, SrTrackCursor& cursor, SrF32& u) const
+	{
+	return cursor.key = mKeys.findSegment(t, cursor.key, u);
+	}
+
+template<class V, SrQuatInterpolation M>
+SR_INLINE void SrAnimationTrack::sampleBlock(const SrAnimationTrack* const* tracks, const SrF32* times, SrF32 sharedTime, SrTrackCursor* cursors,
+											 typename V::Float q[4], typename V::Float p[3])
+	{
+	//the two keys of every instance, transposed to one array per float, and u.
+	SR_ALIGN(64) SrF32 lanes[2 * 7 + 1][V::Width];
+	for(SrU32 l = 0; l < (SrU32)V::Width; l++)
+		{
+		const SrAnimationTrack& track = *tracks[l];
+		const SrU32 key = track.findKey(times ? times[l] : sharedTime, cursors[l], lanes[14][l]);
+		const SrF32* r = track.mKeys.getRecords() + key * KeySize;
+		for(SrU32 k = 0; k < 7; k++)
+			{
+			lanes[k][l] = r[k];
+			lanes[k + 7][l] = r[k + KeySize];
+			}
+		}
+	const typename V::Float u = V::load(lanes[14]);
+	for(SrU32 k = 0; k < 4; k++)
+		q[k] = V::load(lanes[k]);
+	SrQuaternionBatch::interpolate<V, M>(u, q[0], q[1], q[2], q[3], V::load(lanes[7]), V::load(lanes[8]), V::load(lanes[9]), V::load(lanes[10]));
+	for(SrU32 k = 0; k < 3; k++)
+		{
+		const typename V::Float a = V::load(lanes[k + 4]);
+		p[k] = V::madd(V::sub(V::load(lanes[k + 11]), a), u, a);
+		}
+	}
+
+template<class V, SrQuatInterpolation M>
+SR_INLINE void SrAnimationTrack::sampleLanes(const SrAnimationTrack* const* tracks, const SrF32* times, SrF32 sharedTime, SrTrackCursor* cursors,
+											 SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrF32* tx, SrF32* ty, SrF32* tz, SrU32 n)
+	{
+	SrF32* const dst[7] = { qx, qy, qz, qw, tx, ty, tz };
+
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float r[7];
+		sampleBlock<V, M>(tracks + i, times ? times + i : NULL, sharedTime, cursors + i, r, r + 4);
+		for(SrU32 k = 0; k < 7; k++)
+			V::store(dst[k] + i, r[k]);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 r[7];
+		sampleBlock<SrSimdScalar, M>(tracks + i, times ? times + i : NULL, sharedTime, cursors + i, r, r + 4);
+		for(SrU32 k = 0; k < 7; k++)
+			dst[k][i] = r[k];
+		}
+	}
+
+template<class V, SrQuatInterpolation M>
+SR_INLINE void SrAnimationTrack::sampleMatrices(const SrAnimationTrack* const* tracks, const SrF32* times, SrF32 sharedTime, SrTrackCursor* cursors,
+												SrMatrix34* poses, SrU32 n)
+	{
+	//SrMatrix34 is the 9 row major floats of M followed by t.
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float q[4], p[3], m[3][3];
+		sampleBlock<V, M>(tracks + i, times ? times + i : NULL, sharedTime, cursors + i, q, p);
+		SrMatrix33Batch::quatToMatrix<V>(q[0], q[1], q[2], q[3], m);
+		SrF32* d = &poses[i].M(0, 0);
+		for(int r = 0; r < 3; r++)
+			V::storeTransposed3(d + 3 * r, 12, m[r][0], m[r][1], m[r][2]);
+		V::storeTransposed3(&poses[i].t.x, 12, p[0], p[1], p[2]);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 q[4], p[3], m[3][3];
+		sampleBlock<SrSimdScalar, M>(tracks + i, times ? times + i : NULL, sharedTime, cursors + i, q, p);
+		SrMatrix33Batch::quatToMatrix<SrSimdScalar>(q[0], q[1], q[2], q[3], m);
+		for(int r = 0; r < 3; r++)
+			for(int c = 0; c < 3; c++)
+				poses[i].M(r, c) = m[r][c];
+		poses[i].t = SrVector3(p[0], p[1], p[2]);
+		}
+	}
+
+SR_INLINE void SrAnimationTrack::sample(SrQuatInterpolation mode, SrF32 t, SrTrackCursor& cursor, SrQuaternion& rotation, SrVector3& translation) const
+	{
+	const SrAnimationTrack* track = this;
+	SrF32 r[7];
+	switch(mode)
+		{
+		case SR_QUAT_SLERP:
+			sampleLanes<SrSimdScalar, SR_QUAT_SLERP>(&track, NULL, t, &cursor, r, r + 1, r + 2, r + 3, r + 4, r + 5, r + 6, 1);
+			break;
+		case SR_QUAT_NLERP:
+			sampleLanes<SrSimdScalar, SR_QUAT_NLERP>(&track, NULL, t, &cursor, r, r + 1, r + 2, r + 3, r + 4, r + 5, r + 6, 1);
+			break;
+		default:
+			sampleLanes<SrSimdScalar, SR_QUAT_CORRECTED_NLERP>(&track, NULL, t, &cursor, r, r + 1, r + 2, r + 3, r + 4, r + 5, r + 6, 1);
+			break;
+		}
+	rotation.setXYZW(r[0], r[1], r[2], r[3]);
+	translation = SrVector3(r[4], r[5], r[6]);
+	}
+
+SR_INLINE void SrAnimationTrack::sample(SrQuatInterpolation mode, SrF32 t, SrTrackCursor& cursor, SrMatrix34& pose) const
+	{
+	const SrAnimationTrack* track = this;
+	switch(mode)
+		{
+		case SR_QUAT_SLERP:
+			sampleMatrices<SrSimdScalar, SR_QUAT_SLERP>(&track, NULL, t, &cursor, &pose, 1);
+			break;
+		case SR_QUAT_NLERP:
+			sampleMatrices<SrSimdScalar, SR_QUAT_NLERP>(&track, NULL, t, &cursor, &pose, 1);
+			break;
+		default:
+			sampleMatrices<SrSimdScalar, SR_QUAT_CORRECTED_NLERP>(&track, NULL, t, &cursor, &pose, 1);
+			break;
+		}
+	}
+
+SR_INLINE void SrAnimationTrack::sample(SrQuatInterpolation mode, const SrAnimationTrack* const* tracks, const SrF32* times, SrTrackCursor* cursors,
+										SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrF32* tx, SrF32* ty, SrF32* tz, SrU32 n)
+	{
+	switch(mode)
+		{
+		case SR_QUAT_SLERP:
+			SR_SIMD_KERNEL(SrAnimationTrackKernels, trackSampleLanes[SR_QUAT_SLERP], (sampleLanes<SrSimdNative, SR_QUAT_SLERP>))(tracks, times, 0.0f, cursors, qx, qy, qz, qw, tx, ty, tz, n);
+			break;
+		case SR_QUAT_NLERP:
+			SR_SIMD_KERNEL(SrAnimationTrackKernels, trackSampleLanes[SR_QUAT_NLERP], (sampleLanes<SrSimdNative, SR_QUAT_NLERP>))(tracks, times, 0.0f, cursors, qx, qy, qz, qw, tx, ty, tz, n);
+			break;
+		default:
+			SR_SIMD_KERNEL(SrAnimationTrackKernels, trackSampleLanes[SR_QUAT_CORRECTED_NLERP], (sampleLanes<SrSimdNative, SR_QUAT_CORRECTED_NLERP>))(tracks, times, 0.0f, cursors, qx, qy, qz, qw, tx, ty, tz, n);
+			break;
+		}
+	}
+
+SR_INLINE void SrAnimationTrack::sample(SrQuatInterpolation mode, const SrAnimationTrack* const* tracks, SrF32 time, SrTrackCursor* cursors,
+										SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrF32* tx, SrF32* ty, SrF32* tz, SrU32 n)
+	{
+	switch(mode)
+		{
+		case SR_QUAT_SLERP:
+			SR_SIMD_KERNEL(SrAnimationTrackKernels, trackSampleLanes[SR_QUAT_SLERP], (sampleLanes<SrSimdNative, SR_QUAT_SLERP>))(tracks, NULL, time, cursors, qx, qy, qz, qw, tx, ty, tz, n);
+			break;
+		case SR_QUAT_NLERP:
+			SR_SIMD_KERNEL(SrAnimationTrackKernels, trackSampleLanes[SR_QUAT_NLERP], (sampleLanes<SrSimdNative, SR_QUAT_NLERP>))(tracks, NULL, time, cursors, qx, qy, qz, qw, tx, ty, tz, n);
+			break;
+		default:
+			SR_SIMD_KERNEL(SrAnimationTrackKernels, trackSampleLanes[SR_QUAT_CORRECTED_NLERP], (sampleLanes<SrSimdNative, SR_QUAT_CORRECTED_NLERP>))(tracks, NULL, time, cursors, qx, qy, qz, qw, tx, ty, tz, n);
+			break;
+		}
+	}
+
+SR_INLINE void SrAnimationTrack::sample(SrQuatInterpolation mode, const SrAnimationTrack* const* tracks, const SrF32* times, SrTrackCursor* cursors,
+										SrMatrix34* poses, SrU32 n)
+	{
+	switch(mode)
+		{
+		case SR_QUAT_SLERP:
+			SR_SIMD_KERNEL(SrAnimationTrackKernels, trackSampleMatrices[SR_QUAT_SLERP], (sampleMatrices<SrSimdNative, SR_QUAT_SLERP>))(tracks, times, 0.0f, cursors, poses, n);
+			break;
+		case SR_QUAT_NLERP:
+			SR_SIMD_KERNEL(SrAnimationTrackKernels, trackSampleMatrices[SR_QUAT_NLERP], (sampleMatrices<SrSimdNative, SR_QUAT_NLERP>))(tracks, times, 0.0f, cursors, poses, n);
+			break;
+		default:
+			SR_SIMD_KERNEL(SrAnimationTrackKernels, trackSampleMatrices[SR_QUAT_CORRECTED_NLERP], (sampleMatrices<SrSimdNative, SR_QUAT_CORRECTED_NLERP>))(tracks, times, 0.0f, cursors, poses, n);
+			break;
+		}
+	}
+
+SR_INLINE void SrAnimationTrack::sample(SrQuatInterpolation mode, const SrAnimationTrack* const* tracks, SrF32 time, SrTrackCursor* cursors,
+										SrMatrix34* poses, SrU32 n)
+	{
+	switch(mode)
+		{
+		case SR_QUAT_SLERP:
+			SR_SIMD_KERNEL(SrAnimationTrackKernels, trackSampleMatrices[SR_QUAT_SLERP], (sampleMatrices<SrSimdNative, SR_QUAT_SLERP>))(tracks, NULL, time, cursors, poses, n);
+			break;
+		case SR_QUAT_NLERP:
+			SR_SIMD_KERNEL(SrAnimationTrackKernels, trackSampleMatrices[SR_QUAT_NLERP], (sampleMatrices<SrSimdNative, SR_QUAT_NLERP>))(tracks, NULL, time, cursors, poses, n);
+			break;
+		default:
+			SR_SIMD_KERNEL(SrAnimationTrackKernels, trackSampleMatrices[SR_QUAT_CORRECTED_NLERP], (sampleMatrices<SrSimdNative, SR_QUAT_CORRECTED_NLERP>))(tracks, NULL, time, cursors, poses, n);
+			break;
+		}
+	}
+
+SR_INLINE void SrAnimationTrack::sample(SrQuatInterpolation mode, const SrAnimationTrack* const* tracks, const SrF32* times, SrTrackCursor* cursors,
+										SrQuaternionSoA& rotations, SrVector3SoA& translations, SrU32 n)
+	{
+	rotations.resize(n);
+	translations.resize(n);
+	sample(mode, tracks, times, cursors, rotations.x, rotations.y, rotations.z, rotations.w, translations.x, translations.y, translations.z, n);
+	}
+
+SR_INLINE void SrAnimationTrack::sample(SrQuatInterpolation mode, const SrAnimationTrack* const* tracks, SrF32 time, SrTrackCursor* cursors,
+										SrQuaternionSoA& rotations, SrVector3SoA& translations, SrU32 n)
+	{
+	rotations.resize(n);
+	translations.resize(n);
+	sample(mode, tracks, time, cursors, rotations.x, rotations.y, rotations.z, rotations.w, translations.x, translations.y, translations.z, n);
+	}
+
+SR_SIMD_KERNEL_TABLES(SrAnimationTrackKernels)
+
+/** @} */
+#endif
@@ -0,0 +1,236 @@
+/************************************************************************
+\file 	SrDualQuaternion.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRDUALQUATERNION_H_
+#define SR_FOUNDATION_SRDUALQUATERNION_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include "SrQuaternion.h"
+#include "SrMatrix34.h"
+
+/**
+\brief Rigid transform stored as a unit dual quaternion real + eps * dual.
+
+real is the rotation and dual = 0.5 * t * real, with the translation t read as the pure
+quaternion [t 0]. It is the same transform as an SrMatrix34 without scale in 8 floats
+instead of 12, and blends of unit dual quaternions stay rigid after normalize(), which
+is what dual quaternion skinning relies on, see SrSkinning.
+
+Like quaternions, -q is the same transform as q.
+T is the precision, SrDualQuaternion and SrDualQuaternionF64 are the SrF32 and SrF64 typedefs.
+*/
+template<class T>
+class SrDualQuaternionT
+	{
+	public:
+	/**
+	\brief Default constructor, does not do any initialization.
+	*/
+	SR_CONSTEXPR SrDualQuaternionT()
+		{
+		}
+
+	/**
+	\brief the transform that rotates by rotation, a unit quaternion, then translates by translation.
+	*/
+	SR_CONSTEXPR SrDualQuaternionT(const SrQuaternionT<T>& rotation, const SrVector3T<T>& translation);
+
+	/**
+	\brief from the rotation and translation of m, M must be a rotation matrix.
+	*/
+	SR_CONSTEXPR explicit SrDualQuaternionT(const SrMatrix34T<T>& m);
+
+	/**
+	\brief Converts from the other precision.
+	*/
+	template<class U>
+	SR_CONSTEXPR explicit SrDualQuaternionT(const SrDualQuaternionT<U>& d) : real(d.real), dual(d.dual)
+		{
+		}
+
+	/**
+	\brief sets to the identity transform.
+	*/
+	SR_CONSTEXPR void id();
+
+	/**
+	\brief returns true if all elems are finite (not NAN or INF, etc.)
+	*/
+	SR_INLINE bool isFinite() const;
+
+	SR_CONSTEXPR void set(const SrQuaternionT<T>& rotation, const SrVector3T<T>& translation);
+
+	/**
+	\brief from / to the rotation and translation of a matrix. fromMatrix() requires M to be a rotation.
+	*/
+	SR_CONSTEXPR void fromMatrix(const SrMatrix34T<T>& m);
+	SR_CONSTEXPR void toMatrix(SrMatrix34T<T>& m) const;
+
+	/**
+	\brief the rotation, the real part.
+	*/
+	SR_CONSTEXPR const SrQuaternionT<T>& getRotation() const	{ return real;	}
+
+	/**
+	\brief the translation, 2 * dual * conjugate(real). this must be normalized.
+	*/
+	SR_CONSTEXPR SrVector3T<T> getTranslation() const;
+
+	/**
+	\brief the squared length of the real part, 1 for unit dual quaternions.
+	*/
+	SR_CONSTEXPR T magnitudeSquared() const;
+
+	/**
+	\brief maps to the closest unit dual quaternion.
+
+	Both parts are divided by the length of real, then the component of dual along real is
+	removed so that real.dot(dual) = 0. real must not be zero.
+	*/
+	SR_CONSTEXPR void normalize();
+
+	/**
+	\brief sets this to the inverse transform, this must be normalized.
+	*/
+	SR_CONSTEXPR void invert();
+
+	/**
+	\brief this = a * b, the transform that applies b first, same order as SrMatrix34::multiply().
+	this may be a or b.
+	*/
+	SR_CONSTEXPR void multiply(const SrDualQuaternionT& a, const SrDualQuaternionT& b);
+
+	SR_CONSTEXPR SrDualQuaternionT operator*(const SrDualQuaternionT& b) const	{ SrDualQuaternionT d; d.multiply(*this, b); return d;	}
+	SR_CONSTEXPR SrDualQuaternionT& operator*=(const SrDualQuaternionT& b)		{ multiply(*this, b); return *this;	}
+
+	/**
+	\brief transforms a point, same as SrMatrix34::multiply(). this must be normalized.
+	*/
+	SR_CONSTEXPR SrVector3T<T> transform(const SrVector3T<T>& p) const;
+
+	/**
+	\brief rotates a direction, the translation is ignored. this must be normalized.
+	*/
+	SR_CONSTEXPR SrVector3T<T> rotate(const SrVector3T<T>& v) const	{ return real.rot(v);	}
+
+	SrQuaternionT<T> real;
+	SrQuaternionT<T> dual;
+	};
+
+
+template<class T>
+SR_CONSTEXPR SrDualQuaternionT<T>::SrDualQuaternionT(const SrQuaternionT<T>& rotation, const SrVector3T<T>& translation)
+	{
+	set(rotation, translation);
+	}
+
+
+template<class T>
+SR_CONSTEXPR SrDualQuaternionT<T>::SrDualQuaternionT(const SrMatrix34T<T>& m)
+	{
+	fromMatrix(m);
+	}
+
+
+template<class T>
+SR_CONSTEXPR void SrDualQuaternionT<T>::id()
+	{
+	real.id();
+	dual.setXYZW(0, 0, 0, 0);
+	}
+
+
+template<class T>
+SR_INLINE bool SrDualQuaternionT<T>::isFinite() const
+	{
+	return real.isFinite() && dual.isFinite();
+	}
+
+
+template<class T>
+SR_CONSTEXPR void SrDualQuaternionT<T>::set(const SrQuaternionT<T>& rotation, const SrVector3T<T>& translation)
+	{
+	real = rotation;
+	dual = SrQuaternionT<T>(translation) * rotation;
+	dual *= T(0.5);
+	}
+
+
+template<class T>
+SR_CONSTEXPR void SrDualQuaternionT<T>::fromMatrix(const SrMatrix34T<T>& m)
+	{
+	SrQuaternionT<T> q;
+	m.M.toQuat(q);
+	set(q, m.t);
+	}
+
+
+template<class T>
+SR_CONSTEXPR void SrDualQuaternionT<T>::toMatrix(SrMatrix34T<T>& m) const
+	{
+	m.M.fromQuat(real);
+	m.t = getTranslation();
+	}
+
+
+template<class T>
+SR_CONSTEXPR SrVector3T<T> SrDualQuaternionT<T>::getTranslation() const
+	{
+	//vector part of 2 * dual * conjugate(real)
+	const SrVector3T<T> r(real.x, real.y, real.z);
+	const SrVector3T<T> d(dual.x, dual.y, dual.z);
+	return (d * real.w - r * dual.w + (r ^ d)) * 2;
+	}
+
+
+template<class T>
+SR_CONSTEXPR T SrDualQuaternionT<T>::magnitudeSquared() const
+	{
+	return real.magnitudeSquared();
+	}
+
+
+template<class T>
+SR_CONSTEXPR void SrDualQuaternionT<T>::normalize()
+	{
+	const T s = 1 / SrMath::sqrt(real.magnitudeSquared());
+	real *= s;
+	dual *= s;
+	SrQuaternionT<T> along = real;
+	along *= real.dot(dual);
+	dual -= along;
+	}
+
+
+template<class T>
+SR_CONSTEXPR void SrDualQuaternionT<T>::invert()
+	{
+	//the conjugate of both parts, which is the inverse of unit dual quaternions.
+	real.conjugate();
+	dual.conjugate();
+	}
+
+
+template<class T>
+SR_CONSTEXPR void SrDualQuaternionT<T>::multiply(const SrDualQuaternionT<T>& a, const SrDualQuaternionT<T>& b)
+	{
+	//(ar + eps ad) * (br + eps bd) = ar * br + eps (ar * bd + ad * br)
+	const SrQuaternionT<T> d = a.real * b.dual + a.dual * b.real;
+	real = a.real * b.real;
+	dual = d;
+	}
+
+
+template<class T>
+SR_CONSTEXPR SrVector3T<T> SrDualQuaternionT<T>::transform(const SrVector3T<T>& p) const
+	{
+	return real.rot(p) + getTranslation();
+	}
+
+/** @} */
+#endif
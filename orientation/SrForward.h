@@ -0,0 +1,49 @@
+/************************************************************************
+\file 	SrForward.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRFORWARD_H_
+#define SR_FOUNDATION_SRFORWARD_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include "SrSimpleTypes.h"
+
+/*
+The vector, quaternion and matrix classes are templates on their scalar type. The
+single precision instantiations keep the class names, the double precision ones get
+an F64 suffix, like the SrPiF32 / SrPiF64 constants. Both can be used in one program.
+The F16 vector and quaternion are storage only, see SrHalf.
+*/
+
+class SrHalf;
+
+template<class T> class SrVector2T;
+template<class T> class SrVector3T;
+template<class T> class SrQuaternionT;
+template<class T> class SrMatrix33T;
+template<class T> class SrMatrix34T;
+template<class T> class SrDualQuaternionT;
+
+typedef SrVector2T<SrF32>		SrVector2;
+typedef SrVector3T<SrF32>		SrVector3;
+typedef SrQuaternionT<SrF32>	SrQuaternion;
+typedef SrMatrix33T<SrF32>		SrMatrix33;
+typedef SrMatrix34T<SrF32>		SrMatrix34;
+typedef SrDualQuaternionT<SrF32>	SrDualQuaternion;
+
+typedef SrVector2T<SrF64>		SrVector2F64;
+typedef SrVector3T<SrF64>		SrVector3F64;
+typedef SrQuaternionT<SrF64>	SrQuaternionF64;
+typedef SrMatrix33T<SrF64>		SrMatrix33F64;
+typedef SrMatrix34T<SrF64>		SrMatrix34F64;
+typedef SrDualQuaternionT<SrF64>	SrDualQuaternionF64;
+
+typedef SrVector3T<SrHalf>		SrVector3F16;
+typedef SrQuaternionT<SrHalf>	SrQuaternionF16;
+
+/** @} */
+#endif
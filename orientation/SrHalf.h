@@ -0,0 +1,126 @@
+/************************************************************************
+\file 	SrHalf.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRHALF_H_
+#define SR_FOUNDATION_SRHALF_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include <string.h>
+#include "SrSimpleTypes.h"
+
+/**
+\brief IEEE 754 half precision float, for storage only.
+
+1 sign, 5 exponent and 10 mantissa bits: 3 significant decimal digits, a relative
+error of at most 4.9e-4 for normal values, which cover 6.1e-5 to 65504. Smaller values
+become denormals down to 6.0e-8, larger ones infinity.
+
+There is no half arithmetic, a half converts to SrF32 implicitly and from SrF32 only
+explicitly, rounding to nearest even. SrVector3F16 and SrQuaternionF16 are the storage
+instantiations of the vector and quaternion templates, they can be converted to and from
+the float classes with the converting constructors and loaded straight into registers
+by the batch kernels, see SrHalfBatch. The conversions here give the same bits as the
+F16C instructions the SIMD classes use.
+*/
+class SrHalf
+	{
+	public:
+	/**
+	\brief default constructor leaves data uninitialized.
+	*/
+	SR_INLINE SrHalf()
+		{
+		}
+
+	/**
+	\brief f rounded to nearest even.
+	*/
+	SR_INLINE explicit SrHalf(SrF32 f) : bits(fromFloat(f))
+		{
+		}
+
+	SR_INLINE operator SrF32() const
+		{
+		return toFloat(bits);
+		}
+
+	/**
+	\brief the bits of f rounded to nearest even, overflows become infinity and NaNs stay quiet NaNs.
+	*/
+	SR_INLINE static SrU16 fromFloat(SrF32 f);
+
+	/**
+	\brief the float of the bits h, exact.
+	*/
+	SR_INLINE static SrF32 toFloat(SrU16 h);
+
+	SrU16 bits;
+	};
+
+
+SR_INLINE SrU16 SrHalf::fromFloat(SrF32 value)
+	{
+	SrU32 f;
+	memcpy(&f, &value, sizeof(f));
+	const SrU32 sign = (f >> 16) & 0x8000;
+	f &= 0x7fffffff;
+
+	SrU32 h;
+	if(f > 0x7f800000)
+		h = 0x7e00 | ((f >> 13) & 0x3ff);
+	else if(f >= 0x477ff000)
+		{
+		//65520 and above round to infinity.
+		h = 0x7c00;
+		}
+	else if(f >= 0x38800000)
+		{
+		//rebias the exponent, the rounding carry may run into it.
+		h = (f - ((127 - 15) << 23) + 0xfff + ((f >> 13) & 1)) >> 13;
+		}
+	else if(f > 0x33000000)
+		{
+		//denormal, the mantissa with its implicit bit shifted to units of 2^-24.
+		const SrU32 shift = 126 - (f >> 23);
+		const SrU32 m = (f & 0x7fffff) | 0x800000;
+		const SrU32 rest = m & ((1u << shift) - 1);
+		const SrU32 tie = 1u << (shift - 1);
+		h = m >> shift;
+		if(rest > tie || (rest == tie && (h & 1)))
+			h++;
+		}
+	else
+		h = 0;
+	return (SrU16)(sign | h);
+	}
+
+SR_INLINE SrF32 SrHalf::toFloat(SrU16 h)
+	{
+	const SrU32 sign = (SrU32)(h & 0x8000) << 16;
+	const SrU32 e = h & 0x7c00;
+	const SrU32 m = h & 0x3ff;
+
+	SrU32 f;
+	if(e == 0x7c00)
+		f = sign | 0x7f800000 | (m ? 0x400000 | (m << 13) : 0);
+	else if(e)
+		f = sign | (((SrU32)(h & 0x7fff) << 13) + ((127 - 15) << 23));
+	else
+		{
+		//zero or denormal, m * 2^-24 is exact.
+		const SrF32 d = (SrF32)m * 5.9604644775390625e-8f;
+		memcpy(&f, &d, sizeof(f));
+		f |= sign;
+		}
+	SrF32 value;
+	memcpy(&value, &f, sizeof(value));
+	return value;
+	}
+
+/** @} */
+#endif
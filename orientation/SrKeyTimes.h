@@ -0,0 +1,216 @@
+/************************************************************************
+\file 	SrKeyTimes.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRKEYTIMES_H_
+#define SR_FOUNDATION_SRKEYTIMES_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include <string.h>
+#include "SrSimd.h"
+
+/**
+\brief Sorted key times of a keyframed curve and its records, looked up by sample time.
+
+One block of #SR_SIMD_ALIGNMENT aligned memory holds the records first, so that they
+start on the boundary, then the times and 1 / the duration of every segment. The segments
+run between consecutive keys, one key is a constant segment of length 1. Sorted sample
+times find their segment from the previous one or the one after it, others by binary
+search. SrQuaternionSpline and SrAnimationTrack keep their keys in one.
+*/
+class SrKeyTimes
+	{
+	public:
+	/**
+	\brief Creates an empty set, allocate() must be called before any lookup.
+	*/
+	SR_INLINE SrKeyTimes();
+
+	/**
+	\brief Copy constructor, copies the times and the records.
+	*/
+	SR_INLINE SrKeyTimes(const SrKeyTimes& other);
+
+	SR_INLINE ~SrKeyTimes();
+
+	/**
+	\brief Assignment operator, copies the times and the records.
+	*/
+	SR_INLINE const SrKeyTimes& operator=(const SrKeyTimes& other);
+
+	/**
+	\brief Allocates keyCount keys, recordSize floats of records for every segment and
+	extraRecords more. The contents are left uninitialized.
+	*/
+	SR_INLINE void allocate(SrU32 keyCount, SrU32 recordSize, SrU32 extraRecords);
+
+	/**
+	\brief Sets the times of the allocated keys, strictly increasing, NULL for keys at 0, 1, 2, ...
+	*/
+	SR_INLINE void setTimes(const SrF32* times);
+
+	SR_INLINE SrU32 getKeyCount() const;
+
+	/**
+	\brief getKeyCount() - 1, and 1 for a single key.
+	*/
+	SR_INLINE SrU32 getSegmentCount() const;
+
+	/**
+	\brief the time of key i, i <= getSegmentCount().
+	*/
+	SR_INLINE SrF32 getTime(SrU32 i) const;
+
+	SR_INLINE SrF32* getRecords();
+	SR_INLINE const SrF32* getRecords() const;
+
+	/**
+	\brief the segment of time t, starting the search at hint, and the parameter u in [0, 1]
+	in it. Times outside the keys are clamped.
+	*/
+	SR_INLINE SrU32 findSegment(SrF32 t, SrU32 hint, SrF32& u) const;
+
+	private:
+	SrU32 mKeyCount;
+	SrU32 mSegmentCount;
+	SrU32 mSize;		//floats in the block
+	SrF32* mRecords;
+	SrF32* mTimes;		//mSegmentCount + 1 times
+	SrF32* mInvSpans;	//1 / segment duration
+	};
+
+SR_INLINE SrKeyTimes::SrKeyTimes() : mKeyCount(0), mSegmentCount(0), mSize(0), mRecords(NULL), mTimes(NULL), mInvSpans(NULL)
+	{
+	}
+
+SR_INLINE SrKeyTimes::SrKeyTimes(const SrKeyTimes& other) : mKeyCount(0), mSegmentCount(0), mSize(0), mRecords(NULL), mTimes(NULL), mInvSpans(NULL)
+	{
+	*this = other;
+	}
+
+SR_INLINE SrKeyTimes::~SrKeyTimes()
+	{
+	SrAlignedMemory::deallocate(mRecords);
+	}
+
+SR_INLINE const SrKeyTimes& SrKeyTimes::operator=(const SrKeyTimes& other)
+	{
+	if(this != &other)
+		{
+		SrAlignedMemory::deallocate(mRecords);
+		mRecords = mTimes = mInvSpans = NULL;
+		mKeyCount = other.mKeyCount;
+		mSegmentCount = other.mSegmentCount;
+		mSize = other.mSize;
+		if(mSize)
+			{
+			mRecords = (SrF32*)SrAlignedMemory::allocate(mSize * sizeof(SrF32));
+			SR_ASSERT(mRecords);
+			memcpy(mRecords, other.mRecords, mSize * sizeof(SrF32));
+			mTimes = mRecords + (other.mTimes - other.mRecords);
+			mInvSpans = mTimes + mSegmentCount + 1;
+			}
+		}
+	return *this;
+	}
+
+SR_INLINE void SrKeyTimes::allocate(SrU32 keyCount, SrU32 recordSize, SrU32 extraRecords)
+	{
+	SrAlignedMemory::deallocate(mRecords);
+	mRecords = mTimes = mInvSpans = NULL;
+	mKeyCount = keyCount;
+	mSegmentCount = keyCount > 1 ? keyCount - 1 : keyCount;
+	mSize = 0;
+	if(!keyCount)
+		return;
+	const SrU32 recordFloats = (mSegmentCount + extraRecords) * recordSize;
+	mSize = recordFloats + 2 * mSegmentCount + 1;
+	mRecords = (SrF32*)SrAlignedMemory::allocate(mSize * sizeof(SrF32));
+	SR_ASSERT(mRecords);
+	mTimes = mRecords + recordFloats;
+	mInvSpans = mTimes + mSegmentCount + 1;
+	}
+
+SR_INLINE void SrKeyTimes::setTimes(const SrF32* times)
+	{
+	SR_ASSERT(mKeyCount);
+	const SrU32 n = mKeyCount;
+	for(SrU32 i = 0; i <= mSegmentCount; i++)
+		mTimes[i] = times ? times[i < n ? i : n - 1] + (i < n ? 0.0f : 1.0f) : (SrF32)i;
+	for(SrU32 i = 0; i < mSegmentCount; i++)
+		{
+		SR_ASSERT(mTimes[i + 1] > mTimes[i]);
+		mInvSpans[i] = 1.0f / (mTimes[i + 1] - mTimes[i]);
+		}
+	}
+
+SR_INLINE SrU32 SrKeyTimes::getKeyCount() const
+	{
+	return mKeyCount;
+	}
+
+SR_INLINE SrU32 SrKeyTimes::getSegmentCount() const
+	{
+	return mSegmentCount;
+	}
+
+SR_INLINE SrF32 SrKeyTimes::getTime(SrU32 i) const
+	{
+	SR_ASSERT(i <= mSegmentCount && mKeyCount);
+	return mTimes[i];
+	}
+
+SR_INLINE SrF32* SrKeyTimes::getRecords()
+	{
+	return mRecords;
+	}
+
+SR_INLINE const SrF32* SrKeyTimes::getRecords() const
+	{
+	return mRecords;
+	}
+
+SR_INLINE SrU32 SrKeyTimes::findSegment(SrF32 t, SrU32 hint, SrF32& u) const
+	{
+	SR_ASSERT(mKeyCount);
+	//NaN goes to the start.
+	if(!(t > mTimes[0]))
+		{
+		u = 0.0f;
+		return 0;
+		}
+	if(t >= mTimes[mSegmentCount])
+		{
+		u = 1.0f;
+		return mSegmentCount - 1;
+		}
+	SrU32 s = hint < mSegmentCount ? hint : mSegmentCount - 1;
+	if(!(mTimes[s] <= t && t < mTimes[s + 1]))
+		{
+		if(s + 2 <= mSegmentCount && mTimes[s + 1] <= t && t < mTimes[s + 2])
+			s++;
+		else
+			{
+			//the last time not after t.
+			SrU32 lo = 0, hi = mSegmentCount;
+			while(hi - lo > 1)
+				{
+				const SrU32 mid = (lo + hi) >> 1;
+				if(mTimes[mid] <= t)
+					lo = mid;
+				else
+					hi = mid;
+				}
+			s = lo;
+			}
+		}
+	u = (t - mTimes[s]) * mInvSpans[s];
+	return s;
+	}
+
+/** @} */
+#endif
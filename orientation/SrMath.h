@@ -14,7 +14,13 @@
 #include <math.h>
 #include <float.h>
 #include <stdlib.h>
+#include <atomic>
 #include "SrSimpleTypes.h"
+#include "SrRandom.h"
+#if defined(SR_CONSTEXPR_ENABLED)
+#include <limits>
+#include <type_traits>
+#endif
 
 #ifdef log2
 #undef log2
@@ -26,15 +32,36 @@
 #undef max
 #endif 
 //constants
-static const SrF64 SrPiF64		= 3.141592653589793;
-static const SrF64 SrHalfPiF64	= 1.57079632679489661923;
-static const SrF64 SrTwoPiF64	= 6.28318530717958647692;
-static const SrF64 SrInvPiF64	= 0.31830988618379067154;
+static SR_CONSTANT SrF64 SrPiF64		= 3.141592653589793;
+static SR_CONSTANT SrF64 SrHalfPiF64	= 1.57079632679489661923;
+static SR_CONSTANT SrF64 SrTwoPiF64	= 6.28318530717958647692;
+static SR_CONSTANT SrF64 SrInvPiF64	= 0.31830988618379067154;
 //we can get bad range checks if we use double prec consts to check single prec results.
-static const SrF32 SrPiF32		= 3.141592653589793f;
-static const SrF32 SrHalfPiF32	= 1.57079632679489661923f;
-static const SrF32 SrTwoPiF32	= 6.28318530717958647692f;
-static const SrF32 SrInvPiF32	= 0.31830988618379067154f;
+static SR_CONSTANT SrF32 SrPiF32		= 3.141592653589793f;
+static SR_CONSTANT SrF32 SrHalfPiF32	= 1.57079632679489661923f;
+static SR_CONSTANT SrF32 SrTwoPiF32	= 6.28318530717958647692f;
+static SR_CONSTANT SrF32 SrInvPiF32	= 0.31830988618379067154f;
+
+/**
+\brief Type ranges of SrF32 and SrF64, for the classes templated on their precision.
+*/
+template<class T> class SrLimits;
+
+template<> class SrLimits<SrF32>
+	{
+	public:
+	SR_CONSTEXPR static SrF32 maxValue()	{ return SR_MAX_F32; }
+	SR_CONSTEXPR static SrF32 minValue()	{ return SR_MIN_F32; }
+	SR_CONSTEXPR static SrF32 epsilon()	{ return SR_EPS_F32; }
+	};
+
+template<> class SrLimits<SrF64>
+	{
+	public:
+	SR_CONSTEXPR static SrF64 maxValue()	{ return SR_MAX_F64; }
+	SR_CONSTEXPR static SrF64 minValue()	{ return SR_MIN_F64; }
+	SR_CONSTEXPR static SrF64 epsilon()	{ return SR_EPS_F64; }
+	};
 
 /**
 \brief Static class with stateless scalar math routines.
@@ -47,11 +74,11 @@ class SrMath
 		/**
 		\brief Returns true if the two numbers are within eps of each other.
 		*/
-		SR_INLINE static bool equals(SrF32,SrF32,SrF32 eps);
+		SR_CONSTEXPR static bool equals(SrF32,SrF32,SrF32 eps);
 		/**
 		\brief Returns true if the two numbers are within eps of each other.
 		*/
-		SR_INLINE static bool equals(SrF64,SrF64,SrF64 eps);
+		SR_CONSTEXPR static bool equals(SrF64,SrF64,SrF64 eps);
 		/**
 		\brief The floor function returns a floating-point value representing the largest integer that is less than or equal to x.
 		*/
@@ -82,11 +109,11 @@ class SrMath
 		/**
 		\brief abs returns the absolute value of its argument. 
 		*/
-		SR_INLINE static SrF32 abs(SrF32);
+		SR_CONSTEXPR static SrF32 abs(SrF32);
 		/**
 		\brief abs returns the absolute value of its argument. 
 		*/
-		SR_INLINE static SrF64 abs(SrF64);
+		SR_CONSTEXPR static SrF64 abs(SrF64);
 		/**
 		\brief abs returns the absolute value of its argument. 
 		*/
@@ -186,20 +213,20 @@ class SrMath
 		/**
 		\brief Square root.
 		*/
-		SR_INLINE static SrF32 sqrt(SrF32);
+		SR_CONSTEXPR static SrF32 sqrt(SrF32);
 		/**
 		\brief Square root.
 		*/
-		SR_INLINE static SrF64 sqrt(SrF64);
+		SR_CONSTEXPR static SrF64 sqrt(SrF64);
 		
 		/**
 		\brief reciprocal square root.
 		*/
-		SR_INLINE static SrF32 recipSqrt(SrF32);
+		SR_CONSTEXPR static SrF32 recipSqrt(SrF32);
 		/**
 		\brief reciprocal square root.
 		*/
-		SR_INLINE static SrF64 recipSqrt(SrF64);
+		SR_CONSTEXPR static SrF64 recipSqrt(SrF64);
 		
 		/**
 		\brief Calculates x raised to the power of y.
@@ -250,46 +277,46 @@ class SrMath
 		/**
 		\brief Converts degrees to radians.
 		*/
-		SR_INLINE static SrF32 degToRad(SrF32);
+		SR_CONSTEXPR static SrF32 degToRad(SrF32);
 		/**
 		\brief Converts degrees to radians.
 		*/
-		SR_INLINE static SrF64 degToRad(SrF64);
+		SR_CONSTEXPR static SrF64 degToRad(SrF64);
 
 		/**
 		\brief Converts radians to degrees.
 		*/
-		SR_INLINE static SrF32 radToDeg(SrF32);
+		SR_CONSTEXPR static SrF32 radToDeg(SrF32);
 		/**
 		\brief Converts radians to degrees.
 		*/
-		SR_INLINE static SrF64 radToDeg(SrF64);
+		SR_CONSTEXPR static SrF64 radToDeg(SrF64);
 
 		/**
 		\brief Sine of an angle.
 
 		<b>Unit:</b> Radians
 		*/
-		SR_INLINE static SrF32 sin(SrF32);
+		SR_CONSTEXPR static SrF32 sin(SrF32);
 		/**
 		\brief Sine of an angle.
 
 		<b>Unit:</b> Radians
 		*/
-		SR_INLINE static SrF64 sin(SrF64);
+		SR_CONSTEXPR static SrF64 sin(SrF64);
 		
 		/**
 		\brief Cosine of an angle.
 
 		<b>Unit:</b> Radians
 		*/
-		SR_INLINE static SrF32 cos(SrF32);
+		SR_CONSTEXPR static SrF32 cos(SrF32);
 		/**
 		\brief Cosine of an angle.
 
 		<b>Unit:</b> Radians
 		*/
-		SR_INLINE static SrF64 cos(SrF64);
+		SR_CONSTEXPR static SrF64 cos(SrF64);
 
 		/**
 		\brief Computes both the sin and cos.
@@ -390,15 +417,35 @@ class SrMath
 		//random numbers
 		
 		/**
-		\brief uniform random number in [a,b]
+		\brief uniform random number in [a,b], from the generator of the calling thread.
 		*/
 		SR_INLINE static SrF32 rand(SrF32 a,SrF32 b);
+		/**
+		\brief uniform random number in [a,b], from the generator of the calling thread.
+		*/
+		SR_INLINE static SrF64 rand(SrF64 a,SrF64 b);
 		
 		/**
-		\brief uniform random number in [a,b]
+		\brief uniform random number in [a,b), from the generator of the calling thread.
 		*/
 		SR_INLINE static SrI32 rand(SrI32 a,SrI32 b);
 
+		/**
+		\brief The generator of the calling thread, used by rand().
+
+		Threads are numbered in the order of their first call. Thread 0 starts as SrRandom(1),
+		thread k as the same state with a hash of k xored in, which costs the same for every
+		k and takes no lock. The states are unrelated points of the 2^128 - 1 cycle, so t
+		threads drawing n numbers each overlap with a probability below t * t * n / 2^128.
+		*/
+		SR_INLINE static SrRandom& getRandom();
+
+		/**
+		\brief Reseeds the generator of the calling thread to SrRandom(seed), with its number
+		hashed in as in getRandom().
+		*/
+		SR_INLINE static void setRandomSeed(SrU32 seed);
+
 		/**
 		\brief hashing: hashes an array of n 32 bit values	to a 32 bit value.
 		
@@ -421,6 +468,19 @@ class SrMath
 		\brief returns true if the passed number is a finite floating point number as opposed to INF, NAN, etc.
 		*/
 		SR_INLINE static bool isFinite(SrF64 x);
+
+#if defined(SR_CONSTEXPR_ENABLED)
+	private:
+		/*
+		The compile time sin, cos and sqrt. The angle is reduced by pi/2 in three parts
+		and the series are summed on [-pi/4, pi/4], within 1 ulp of SrF64 for |a| < 2^20.
+		The square root is correctly rounded, as the runtime one.
+		*/
+		static constexpr void constSinCos(SrF64 a, SrF64& s, SrF64& c);
+		static constexpr SrF64 constSin(SrF64 a);
+		static constexpr SrF64 constCos(SrF64 a);
+		static constexpr SrF64 constSqrt(SrF64 a);
+#endif
 	};
 
 /*
@@ -428,13 +488,13 @@ Many of these are just implemented as calls to the C lib right now,
 but later we could replace some of them with some approximations or more
 clever stuff.
 */
-SR_INLINE bool SrMath::equals(SrF32 a,SrF32 b,SrF32 eps)
+SR_CONSTEXPR bool SrMath::equals(SrF32 a,SrF32 b,SrF32 eps)
 	{
 	const SrF32 diff = SrMath::abs(a - b);
 	return (diff < eps);
 	}
 
-SR_INLINE bool SrMath::equals(SrF64 a,SrF64 b,SrF64 eps)
+SR_CONSTEXPR bool SrMath::equals(SrF64 a,SrF64 b,SrF64 eps)
 	{
 	const SrF64 diff = SrMath::abs(a - b);
 	return (diff < eps);
@@ -470,13 +530,21 @@ SR_INLINE SrI32 SrMath::trunc(SrF64 a)
 	return (SrI32) a;	// ### PT: this actually depends on FPU settings
 	}
 
-SR_INLINE SrF32 SrMath::abs(SrF32 a)
+SR_CONSTEXPR SrF32 SrMath::abs(SrF32 a)
 	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return a < 0 ? -a : (a == 0 ? 0.0f : a);
+#endif
 	return ::fabsf(a);
 	}
 
-SR_INLINE SrF64 SrMath::abs(SrF64 a)
+SR_CONSTEXPR SrF64 SrMath::abs(SrF64 a)
 	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return a < 0 ? -a : (a == 0 ? 0.0 : a);
+#endif
 	return ::fabs(a);
 	}
 
@@ -502,12 +570,20 @@ SR_INLINE SrI32 SrMath::sign(SrI32 a)
 
 SR_INLINE bool SrMath::isFinite(SrF32 f)
 	{
+#if defined(_MSC_VER)
 		return (0 == ((_FPCLASS_SNAN | _FPCLASS_QNAN | _FPCLASS_NINF | _FPCLASS_PINF) & _fpclass(f) ));
+#else
+		return isfinite(f) != 0;
+#endif
 	}
 		
 SR_INLINE bool SrMath::isFinite(SrF64 f)
 	{
+#if defined(_MSC_VER)
 		return (0 == ((_FPCLASS_SNAN | _FPCLASS_QNAN | _FPCLASS_NINF | _FPCLASS_PINF) & _fpclass(f) ));
+#else
+		return isfinite(f) != 0;
+#endif
 	}
 SR_INLINE SrF32 SrMath::max(SrF32 a,SrF32 b)
 {
@@ -612,23 +688,33 @@ SR_INLINE SrI32 SrMath::clamp(SrI32 v, SrI32 hi, SrI32 low)
 		return v;
 	}
 
-SR_INLINE SrF32 SrMath::recipSqrt(SrF32 a)
+SR_CONSTEXPR SrF32 SrMath::recipSqrt(SrF32 a)
 	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return 1.0f/(SrF32)constSqrt(a);
+#endif
 	return 1.0f/::sqrtf(a);
 	}
 
-SR_INLINE SrF64 SrMath::recipSqrt(SrF64 a)
+SR_CONSTEXPR SrF64 SrMath::recipSqrt(SrF64 a)
 	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return 1.0/constSqrt(a);
+#endif
 	return 1.0/::sqrt(a);
 	}
 
 
+//the libm versions, SrMathDeterministic.h has the reproducible ones.
+#if !defined(SR_DETERMINISTIC)
 SR_INLINE SrF32 SrMath::pow(SrF32 x, SrF32 y)
 	{
 	return ::powf(x,y);
 	}
 
-SrF64 SrMath::pow(SrF64 x, SrF64 y)
+SR_INLINE SrF64 SrMath::pow(SrF64 x, SrF64 y)
 	{
 	return ::pow(x,y);
 	}
@@ -674,48 +760,66 @@ SR_INLINE SrF64 SrMath::log10(SrF64 a)
 	{
 	return ::log10(a);
 	}
+#endif
 
-SR_INLINE SrF32 SrMath::degToRad(SrF32 a)
+SR_CONSTEXPR SrF32 SrMath::degToRad(SrF32 a)
 	{
 	return (SrF32)0.01745329251994329547 * a;
 	}
 
-SR_INLINE SrF64 SrMath::degToRad(SrF64 a)
+SR_CONSTEXPR SrF64 SrMath::degToRad(SrF64 a)
 	{
 	return (SrF64)0.01745329251994329547 * a;
 	}
 
-SR_INLINE SrF32 SrMath::radToDeg(SrF32 a)
+SR_CONSTEXPR SrF32 SrMath::radToDeg(SrF32 a)
 	{
 	return (SrF32)57.29577951308232286465 * a;
 	}
 
-SR_INLINE SrF64 SrMath::radToDeg(SrF64 a)
+SR_CONSTEXPR SrF64 SrMath::radToDeg(SrF64 a)
 	{
 	return (SrF64)57.29577951308232286465 * a;
 	}
 
-SR_INLINE SrF32 SrMath::sin(SrF32 a)
+#if !defined(SR_DETERMINISTIC)
+SR_CONSTEXPR SrF32 SrMath::sin(SrF32 a)
 	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return (SrF32)constSin(a);
+#endif
 	return ::sinf(a);
 	}
 
-SR_INLINE SrF64 SrMath::sin(SrF64 a)
+SR_CONSTEXPR SrF64 SrMath::sin(SrF64 a)
 	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return constSin(a);
+#endif
 	return ::sin(a);
 	}
 
-SR_INLINE SrF32 SrMath::cos(SrF32 a)
+SR_CONSTEXPR SrF32 SrMath::cos(SrF32 a)
 	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return (SrF32)constCos(a);
+#endif
 	return ::cosf(a);
 	}
 
-SR_INLINE SrF64 SrMath::cos(SrF64 a)
+SR_CONSTEXPR SrF64 SrMath::cos(SrF64 a)
 	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return constCos(a);
+#endif
 	return ::cos(a);
 	}
 
-// Calling fsincos instead of fsin+fcos
+// Calling fsincos instead of fsin+fcos, or sincos with glibc
 SR_INLINE void SrMath::sinCos(SrF32 f, SrF32& s, SrF32& c)
 	{
 #if defined(WIN32) && !defined(_WIN64)
@@ -727,6 +831,8 @@ SR_INLINE void SrMath::sinCos(SrF32 f, SrF32& s, SrF32& c)
 		_asm	fstp	localSin
 		c = localCos;
 		s = localSin;
+#elif defined(__GLIBC__) && defined(_GNU_SOURCE)
+		::sincosf(f, &s, &c);
 #else
 		c = cosf(f);
 		s = sinf(f);
@@ -735,8 +841,12 @@ SR_INLINE void SrMath::sinCos(SrF32 f, SrF32& s, SrF32& c)
 
 SR_INLINE void SrMath::sinCos(SrF64 a, SrF64 & s, SrF64 & c)
 	{
+#if defined(__GLIBC__) && defined(_GNU_SOURCE)
+	::sincos(a, &s, &c);
+#else
 	s = ::sin(a);
 	c = ::cos(a);
+#endif
 	}
 
 SR_INLINE SrF32 SrMath::tan(SrF32 a)
@@ -800,16 +910,64 @@ SR_INLINE SrF64 SrMath::atan2(SrF64 x, SrF64 y)
 	{
 	return ::atan2(x,y);
 	}
+#endif
 
 SR_INLINE SrF32 SrMath::rand(SrF32 a,SrF32 b)
 	{
-	const SrF32 r = (SrF32)::rand()/((SrF32)RAND_MAX+1);
-	return r*(b-a) + a;
+	return getRandom().rand(a,b);
+	}
+
+SR_INLINE SrF64 SrMath::rand(SrF64 a,SrF64 b)
+	{
+	return getRandom().rand(a,b);
 	}
 
 SR_INLINE SrI32 SrMath::rand(SrI32 a,SrI32 b)
 	{
-	return a + (SrI32)(::rand()%(b-a));
+	return getRandom().rand(a,b);
+	}
+
+//the thread numbers of getRandom().
+SR_INLINE SrU32 srRandomThreadIndex()
+	{
+	static std::atomic<SrU32> count(0);
+	static thread_local const SrU32 index = count++;
+	return index;
+	}
+
+//SrRandom(seed) for the calling thread: thread k > 0 xors murmur3 fmix32 of Weyl steps of
+//k into the four state words, a bijection of k per word.
+SR_INLINE SrRandom srRandomForThread(SrU32 seed)
+	{
+	SrRandom random(seed);
+	const SrU32 k = srRandomThreadIndex();
+	if(k > 0)
+		{
+		SrU32 s[4];
+		random.getState(s);
+		for(SrU32 i = 0; i < 4; i++)
+			{
+			SrU32 z = k * 0x9E3779B9u + i * 0x632BE5ABu;
+			z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+			z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+			s[i] ^= z ^ (z >> 16);
+			}
+		if((s[0] | s[1] | s[2] | s[3]) == 0)
+			s[0] = 1;
+		random.setState(s);
+		}
+	return random;
+	}
+
+SR_INLINE SrRandom& SrMath::getRandom()
+	{
+	static thread_local SrRandom random(srRandomForThread(1));
+	return random;
+	}
+
+SR_INLINE void SrMath::setRandomSeed(SrU32 seed)
+	{
+	getRandom() = srRandomForThread(seed);
 	}
 
 /*
@@ -915,15 +1073,102 @@ SR_INLINE int SrMath::hash32(int key)
 	return key;
 	}
 
-SR_INLINE SrF32 SrMath::sqrt(SrF32 a)
+SR_CONSTEXPR SrF32 SrMath::sqrt(SrF32 a)
 	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return (SrF32)constSqrt(a);
+#endif
 		return (SrF32)::sqrt(a);
 	}
-SR_INLINE SrF64 SrMath::sqrt(SrF64 a)
+SR_CONSTEXPR SrF64 SrMath::sqrt(SrF64 a)
 	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return constSqrt(a);
+#endif
 		return (SrF64)::sqrt(a);
 	}
 
 
+#if defined(SR_CONSTEXPR_ENABLED)
+constexpr void SrMath::constSinCos(SrF64 a, SrF64& s, SrF64& c)
+	{
+	if(!(a - a == 0))	//inf or NaN
+		{
+		s = c = std::numeric_limits<SrF64>::quiet_NaN();
+		return;
+		}
+	//pi/2 split as in fdlibm, the first two parts times k are exact.
+	const long long k = (long long)(a * 0.63661977236758134308 + (a < 0 ? -0.5 : 0.5));
+	const SrF64 fk = (SrF64)k;
+	const SrF64 r = ((a - fk * 1.57079632673412561417e+00) - fk * 6.07710050630396597660e-11) - fk * 2.02226624871116645580e-21;
+	const SrF64 r2 = r * r;
+	SrF64 sr = r, sTerm = r;
+	SrF64 cr = 1, cTerm = 1;
+	for(int i = 1; i <= 12; i++)
+		{
+		sTerm *= -r2 / ((2 * i) * (2 * i + 1));
+		cTerm *= -r2 / ((2 * i - 1) * (2 * i));
+		sr += sTerm;
+		cr += cTerm;
+		}
+	switch(k & 3)
+		{
+		case 0:	s = sr;		c = cr;		break;
+		case 1:	s = cr;		c = -sr;	break;
+		case 2:	s = -sr;	c = -cr;	break;
+		default:	s = -cr;	c = sr;		break;
+		}
+	}
+
+constexpr SrF64 SrMath::constSin(SrF64 a)
+	{
+	SrF64 s = 0, c = 0;
+	constSinCos(a, s, c);
+	return s;
+	}
+
+constexpr SrF64 SrMath::constCos(SrF64 a)
+	{
+	SrF64 s = 0, c = 0;
+	constSinCos(a, s, c);
+	return c;
+	}
+
+constexpr SrF64 SrMath::constSqrt(SrF64 a)
+	{
+	if(a < 0 || a != a)
+		return std::numeric_limits<SrF64>::quiet_NaN();
+	if(a == 0 || a == std::numeric_limits<SrF64>::infinity())
+		return a;
+	//keeps x*x below out of the subnormals.
+	if(a < 0x1p-900)
+		return constSqrt(a * 0x1p200) * 0x1p-100;
+	//Newton from above decreases monotonically to within an ulp of the root.
+	SrF64 x = a > 1 ? a : 1;
+	for(;;)
+		{
+		const SrF64 next = 0.5 * (x + a / x);
+		if(!(next < x))
+			break;
+		x = next;
+		}
+	//one more step with the residual a - x*x computed exactly (Dekker) rounds it correctly.
+	const SrF64 split = 134217729.0 * x;
+	const SrF64 hi = split - (split - x);
+	const SrF64 lo = x - hi;
+	const SrF64 p = x * x;
+	const SrF64 err = ((hi * hi - p) + 2 * hi * lo) + lo * lo;
+	return x + ((a - p) - err) / (2 * x);
+	}
+#endif
+
+//the SR_DETERMINISTIC transcendental functions use the SrSimdMath polynomials, SrSimdMath.h
+//includes their definitions once SrSimdMath is complete.
+#if defined(SR_DETERMINISTIC)
+#include "SrSimdMath.h"
+#endif
+
 /** @} */
 #endif
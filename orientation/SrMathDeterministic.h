@@ -0,0 +1,704 @@
+/************************************************************************
+\file 	SrMathDeterministic.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRMATHDETERMINISTIC_H_
+#define SR_FOUNDATION_SRMATHDETERMINISTIC_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include <string.h>
+#include "SrSimdMath.h"
+
+/**
+\brief Double precision kernels of the SrMath functions in the SR_DETERMINISTIC mode.
+
+Defining SR_DETERMINISTIC for the whole program makes SrMath, the vector, quaternion and
+matrix classes and the batch kernels give bitwise identical results with every x86-64
+compiler and instruction set:
+
+	- SrMath no longer calls libm for the transcendental functions. The single precision
+	  ones are the SrSimdMath polynomials on SrSimdScalar, so SrMath::sin(x) is also the
+	  batch SrSimdMath::sin() result. The double precision ones are the fdlibm kernels
+	  below. sqrt, floor, ceil, mod and the ldexp / frexp used inside are exact IEEE
+	  operations and stay in libm.
+	- a*b + c is never contracted into an FMA. The headers do not change the code
+	  generation of the files that include them, the project is built with
+	  -ffp-contract=off, see SrSimpleTypes.h, and isContracted() checks it.
+	- SrSimd madd / nmadd are a multiply and an add on every set, so a batch kernel gives
+	  the same result with SSE2, AVX2, AVX-512, SrSimdScalar or SrSimdDispatch on any
+	  cpu. Elements past the last full register run the same code on SrSimdScalar.
+
+Requirements: SSE arithmetic, which every x86-64 target has, no -ffast-math, no
+contraction, the default MXCSR (round to nearest, no flush to zero), and the same settings
+in every translation unit, the SrSimdDispatch ones included. With C++20 the constant evaluated sin, cos, sqrt
+and recipSqrt keep their constexpr versions. Those are reproducible too but can differ
+from the run time result in the last bit.
+
+What it costs, g++ -O2: single precision sin and cos take 1.7 times as long as glibc, atan2
+is faster, exp and the double precision exp / logE are two to four times slower. The
+batch kernels lose the FMA of AVX2 and AVX-512, which is 20 to 30% on the polynomial
+heavy ones, slerp and the rotation samplers.
+
+Errors against a long double reference; the single precision ones are in SrSimdMath.h.
+
+	function	range				max error
+	sin/cos		|x| <= 1e6			0.8 ulp
+	tan			|x| <= 1e6			2.2 ulp
+	asin/acos	[-1, 1]				2.2 ulp
+	atan/atan2	all					1.5 ulp
+	exp			[-745, 709.7]		1.0 ulp
+	logE		(0, inf]			0.8 ulp
+	pow			all					0.9 ulp
+
+Past 1e6 the sin / cos argument reduction loses bits, and past 8192 the single precision
+polynomials do, where libm reduces exactly.
+*/
+class SrMathDeterministic
+	{
+	public:
+	SR_INLINE static SrF64 sin(SrF64 x);
+	SR_INLINE static SrF64 cos(SrF64 x);
+	SR_INLINE static void sinCos(SrF64 x, SrF64& s, SrF64& c);
+
+	/**
+	\brief atan2(y, x) with the signed zero and infinity cases of libm.
+	*/
+	SR_INLINE static SrF64 atan(SrF64 x);
+	SR_INLINE static SrF64 atan2(SrF64 y, SrF64 x);
+
+	SR_INLINE static SrF64 exp(SrF64 x);
+	SR_INLINE static SrF64 logE(SrF64 x);
+
+	/**
+	\brief x^y with the special cases of libm. As in fdlibm log2(x) and its product with y
+	are carried in two parts, so the error does not grow with y logE(x).
+	*/
+	SR_INLINE static SrF64 pow(SrF64 x, SrF64 y);
+
+	/**
+	\brief true when the file that emits it fuses a*b + c, so it was built without
+	-ffp-contract=off and its results are not reproducible. Only GCC and clang can get here
+	with contraction on, MSVC stops at the preprocessor.
+	*/
+	SR_INLINE static bool isContracted();
+
+	private:
+	/**
+	\brief x = k*pi/2 + r + lo with |r| <= pi/4, returns r, its tail lo and k mod 4. x
+	must be finite.
+	*/
+	SR_INLINE static SrF64 reduce(SrF64 x, SrF64& lo, SrI32& quadrant);
+	SR_INLINE static SrF64 sinKernel(SrF64 r, SrF64 lo);
+	SR_INLINE static SrF64 cosKernel(SrF64 r, SrF64 lo);
+
+	/**
+	\brief the high and low 32 bits of a double, as fdlibm splits them.
+	*/
+	SR_INLINE static SrI32 getHigh(SrF64 x);
+	SR_INLINE static SrU32 getLow(SrF64 x);
+	SR_INLINE static SrF64 setHigh(SrF64 x, SrI32 high);
+	SR_INLINE static SrF64 clearLow(SrF64 x);
+	};
+
+
+SR_INLINE bool SrMathDeterministic::isContracted()
+	{
+	//(1 + 2^-12)^2 - (1 + 2^-11) is 2^-24 fused and 0 rounded, volatile keeps it from folding.
+	volatile SrF32 a = 1.0f + 1.0f / 4096.0f, c = -(1.0f + 1.0f / 2048.0f);
+	const SrF32 x = a;
+	return x * x + c != 0.0f;
+	}
+
+SR_INLINE SrF64 SrMathDeterministic::reduce(SrF64 x, SrF64& lo, SrI32& quadrant)
+	{
+	//fdlibm with pi/2 in 33 bit parts, k*part is exact for |k| < 2^20.
+	const SrF64 k = ::floor(x * 6.36619772367581382433e-01 + 0.5);
+	quadrant = (SrI32)::fmod(k, 4.0) & 3;
+	const SrF64 t = x - k * 1.57079632673412561417e+00;
+	const SrF64 w = k * 6.07710050630396597660e-11;
+	const SrF64 r = t - w;
+	const SrF64 wt = k * 2.02226624879595063154e-21 - ((t - r) - w);
+	const SrF64 hi = r - wt;
+	lo = (r - hi) - wt;
+	return hi;
+	}
+
+SR_INLINE SrF64 SrMathDeterministic::sinKernel(SrF64 r, SrF64 lo)
+	{
+	const SrF64 z = r * r;
+	const SrF64 w = z * z;
+	const SrF64 p = 8.33333333332248946124e-03 + z * (-1.98412698298579493134e-04 + z * 2.75573137070700676789e-06) +
+					z * w * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10);
+	const SrF64 v = z * r;
+	return r - ((z * (0.5 * lo - v * p) - lo) - v * -1.66666666666666324348e-01);
+	}
+
+SR_INLINE SrF64 SrMathDeterministic::cosKernel(SrF64 r, SrF64 lo)
+	{
+	const SrF64 z = r * r;
+	const SrF64 w = z * z;
+	const SrF64 p = z * (4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 + z * 2.48015872894767294178e-05)) +
+					w * w * (-2.75573143513906633035e-07 + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11));
+	//1 - z/2 with the rounding error of the subtraction added back.
+	const SrF64 hz = 0.5 * z;
+	const SrF64 a = 1.0 - hz;
+	return a + (((1.0 - a) - hz) + (z * p - r * lo));
+	}
+
+SR_INLINE SrF64 SrMathDeterministic::sin(SrF64 x)
+	{
+	//NaN for inf and NaN, before k converts to an integer.
+	if(x != x || ::fabs(x) == HUGE_VAL)
+		return x - x;
+	SrF64 lo;
+	SrI32 q;
+	const SrF64 r = reduce(x, lo, q);
+	switch(q)
+		{
+		case 0:		return sinKernel(r, lo);
+		case 1:		return cosKernel(r, lo);
+		case 2:		return -sinKernel(r, lo);
+		default:	return -cosKernel(r, lo);
+		}
+	}
+
+SR_INLINE SrF64 SrMathDeterministic::cos(SrF64 x)
+	{
+	//NaN for inf and NaN, before k converts to an integer.
+	if(x != x || ::fabs(x) == HUGE_VAL)
+		return x - x;
+	SrF64 lo;
+	SrI32 q;
+	const SrF64 r = reduce(x, lo, q);
+	switch(q)
+		{
+		case 0:		return cosKernel(r, lo);
+		case 1:		return -sinKernel(r, lo);
+		case 2:		return -cosKernel(r, lo);
+		default:	return sinKernel(r, lo);
+		}
+	}
+
+SR_INLINE void SrMathDeterministic::sinCos(SrF64 x, SrF64& s, SrF64& c)
+	{
+	if(x != x || ::fabs(x) == HUGE_VAL)
+		{
+		s = c = x - x;
+		return;
+		}
+	SrF64 lo;
+	SrI32 q;
+	const SrF64 r = reduce(x, lo, q);
+	const SrF64 sr = sinKernel(r, lo);
+	const SrF64 cr = cosKernel(r, lo);
+	switch(q)
+		{
+		case 0:		s = sr;		c = cr;		break;
+		case 1:		s = cr;		c = -sr;	break;
+		case 2:		s = -sr;	c = -cr;	break;
+		default:	s = -cr;	c = sr;		break;
+		}
+	}
+
+SR_INLINE SrF64 SrMathDeterministic::atan(SrF64 x)
+	{
+	//fdlibm: atan(a) = atan(c) + atan((a-c)/(1+a*c)) around c = 0.5, 1, 1.5 and inf.
+	static const SrF64 atanHi[4] = { 4.63647609000806093515e-01, 7.85398163397448278999e-01, 9.82793723247329054082e-01, 1.57079632679489655800e+00 };
+	static const SrF64 atanLo[4] = { 2.26987774529616870924e-17, 3.06161699786838301793e-17, 1.39033110312309984516e-17, 6.12323399573676603587e-17 };
+	if(x != x)
+		return x + x;
+	const SrF64 a = ::fabs(x);
+	if(a >= 7.37869762948382064640e+19)
+		return ::copysign(atanHi[3] + atanLo[3], x);
+
+	SrI32 id;
+	SrF64 t;
+	if(a < 0.4375)
+		{
+		id = -1;
+		t = a;
+		}
+	else if(a < 0.6875)
+		{
+		id = 0;
+		t = (2.0 * a - 1.0) / (2.0 + a);
+		}
+	else if(a < 1.1875)
+		{
+		id = 1;
+		t = (a - 1.0) / (a + 1.0);
+		}
+	else if(a < 2.4375)
+		{
+		id = 2;
+		t = (a - 1.5) / (1.0 + 1.5 * a);
+		}
+	else
+		{
+		id = 3;
+		t = -1.0 / a;
+		}
+
+	const SrF64 z = t * t;
+	const SrF64 w = z * z;
+	const SrF64 s1 = z * (3.33333333333329318027e-01 + w * (1.42857142725034663711e-01 + w * (9.09088713343650656196e-02 +
+					 w * (6.66107313738753120669e-02 + w * (4.97687799461593236017e-02 + w * 1.62858201153657823623e-02)))));
+	const SrF64 s2 = w * (-1.99999999998764832476e-01 + w * (-1.11111104054623557880e-01 + w * (-7.69187620504482999495e-02 +
+					 w * (-5.83357013379057348645e-02 + w * -3.65315727442169155270e-02))));
+	const SrF64 r = id < 0 ? t - t * (s1 + s2) : atanHi[id] - ((t * (s1 + s2) - atanLo[id]) - t);
+	return ::copysign(r, x);
+	}
+
+SR_INLINE SrF64 SrMathDeterministic::atan2(SrF64 y, SrF64 x)
+	{
+	const SrF64 pi = 3.1415926535897931160e+00;
+	const SrF64 piLo = 1.2246467991473531772e-16;
+	if(x != x || y != y)
+		return x + y;
+	const SrF64 ax = ::fabs(x);
+	const SrF64 ay = ::fabs(y);
+	const bool left = ::copysign(1.0, x) < 0.0;
+
+	SrF64 r;
+	if(ay == 0.0)
+		r = left ? pi : 0.0;
+	else if(ax == 0.0)
+		r = 0.5 * pi;
+	else if(ax == HUGE_VAL)
+		r = ay == HUGE_VAL ? (left ? 0.75 * pi : 0.25 * pi) : (left ? pi : 0.0);
+	else if(ay == HUGE_VAL)
+		r = 0.5 * pi;
+	else
+		{
+		r = atan(ay / ax);
+		if(left)
+			r = pi - (r - piLo);
+		}
+	return ::copysign(r, y);
+	}
+
+SR_INLINE SrF64 SrMathDeterministic::exp(SrF64 x)
+	{
+	if(x != x)
+		return x + x;
+	if(x > 7.09782712893383973096e+02)
+		return HUGE_VAL;
+	if(x < -7.45133219101941108420e+02)
+		return 0.0;
+
+	//x = k*ln2 + r, ln2 in two parts with k*hi exact, then the fdlibm rational form of exp(r).
+	const SrF64 k = ::floor(x * 1.44269504088896338700e+00 + 0.5);
+	const SrF64 hi = x - k * 6.93147180369123816490e-01;
+	const SrF64 lo = k * 1.90821492927058770002e-10;
+	const SrF64 r = hi - lo;
+	const SrF64 z = r * r;
+	const SrF64 c = r - z * (1.66666666666666019037e-01 + z * (-2.77777777770155933842e-03 + z * (6.61375632143793436117e-05 +
+					z * (-1.65339022054652515390e-06 + z * 4.13813679705723846039e-08))));
+	const SrF64 e = 1.0 - ((lo - (r * c) / (2.0 - c)) - hi);
+	return ::ldexp(e, (int)k);
+	}
+
+SR_INLINE SrF64 SrMathDeterministic::logE(SrF64 x)
+	{
+	if(x != x)
+		return x + x;
+	if(x < 0.0)
+		return NAN;
+	if(x == 0.0)
+		return -HUGE_VAL;
+	if(x == HUGE_VAL)
+		return x;
+
+	//x = 2^k * m with m in [sqrt(1/2), sqrt(2)), log(m) = 2s + 2s^3/3 + ... with s = f/(2+f).
+	int k;
+	SrF64 m = ::frexp(x, &k);
+	if(m < 0.70710678118654752440)
+		{
+		m += m;
+		k--;
+		}
+	const SrF64 f = m - 1.0;
+	const SrF64 s = f / (2.0 + f);
+	const SrF64 z = s * s;
+	const SrF64 w = z * z;
+	const SrF64 t1 = w * (3.999999999940941908e-01 + w * (2.222219843214978396e-01 + w * 1.531383769920937332e-01));
+	const SrF64 t2 = z * (6.666666666666735130e-01 + w * (2.857142874366239149e-01 + w * (1.818357216161805012e-01 + w * 1.479819860511658591e-01)));
+	const SrF64 hfsq = 0.5 * f * f;
+	const SrF64 dk = (SrF64)k;
+	return dk * 6.93147180369123816490e-01 - ((hfsq - (s * (hfsq + t1 + t2) + dk * 1.90821492927058770002e-10)) - f);
+	}
+
+SR_INLINE SrI32 SrMathDeterministic::getHigh(SrF64 x)
+	{
+	SrU64 bits;
+	memcpy(&bits, &x, sizeof(bits));
+	return (SrI32)(SrU32)(bits >> 32);
+	}
+
+SR_INLINE SrU32 SrMathDeterministic::getLow(SrF64 x)
+	{
+	SrU64 bits;
+	memcpy(&bits, &x, sizeof(bits));
+	return (SrU32)bits;
+	}
+
+SR_INLINE SrF64 SrMathDeterministic::setHigh(SrF64 x, SrI32 high)
+	{
+	SrU64 bits;
+	memcpy(&bits, &x, sizeof(bits));
+	bits = ((SrU64)(SrU32)high << 32) | (bits & 0xffffffffull);
+	memcpy(&x, &bits, sizeof(x));
+	return x;
+	}
+
+SR_INLINE SrF64 SrMathDeterministic::clearLow(SrF64 x)
+	{
+	SrU64 bits;
+	memcpy(&bits, &x, sizeof(bits));
+	bits &= 0xffffffff00000000ull;
+	memcpy(&x, &bits, sizeof(x));
+	return x;
+	}
+
+SR_INLINE SrF64 SrMathDeterministic::pow(SrF64 x, SrF64 y)
+	{
+	static const SrF64 bp[2] = { 1.0, 1.5 };
+	static const SrF64 dpHi[2] = { 0.0, 5.84962487220764160156e-01 };
+	static const SrF64 dpLo[2] = { 0.0, 1.35003920212974897128e-08 };
+	const SrF64 ivln2Hi = 1.44269502162933349609e+00;
+	const SrF64 ivln2Lo = 1.92596299112661746887e-08;
+	const SrF64 ivln2 = 1.44269504088896338700e+00;
+	const SrF64 cpHi = 9.61796700954437255859e-01;
+	const SrF64 cpLo = -7.02846165095275826516e-09;
+	const SrF64 cp = 9.61796693925975554329e-01;
+	const SrF64 lg2Hi = 6.93147182464599609375e-01;
+	const SrF64 lg2Lo = -1.90465429995776804525e-09;
+	const SrF64 lg2 = 6.93147180559945286227e-01;
+	const SrF64 ovt = 8.0085662595372944372e-17;
+
+	if(y == 0.0 || x == 1.0)
+		return 1.0;
+	if(x != x || y != y)
+		return x + y;
+	const SrF64 ax = ::fabs(x);
+	const SrF64 ay = ::fabs(y);
+
+	//0 for a non integral y, 1 for an odd and 2 for an even one.
+	SrI32 yIsInt = 0;
+	if(ay >= 9007199254740992.0)
+		yIsInt = ay == HUGE_VAL ? 0 : 2;
+	else if(::floor(y) == y)
+		yIsInt = ::fmod(ay, 2.0) != 0.0 ? 1 : 2;
+	const bool negative = x < 0.0 && yIsInt == 1;
+
+	if(ay == HUGE_VAL)
+		{
+		if(ax == 1.0)
+			return 1.0;
+		return (ax > 1.0) == (y > 0.0) ? HUGE_VAL : 0.0;
+		}
+	if(ax == 0.0 || ax == HUGE_VAL)
+		{
+		//0^y and inf^y, the odd powers keep the sign.
+		const SrF64 r = (ax == 0.0) == (y < 0.0) ? HUGE_VAL : 0.0;
+		return negative ? -r : r;
+		}
+	if(x < 0.0 && !yIsInt)
+		return NAN;
+	if(y == 1.0)
+		return x;
+	if(y == -1.0)
+		return 1.0 / x;
+	if(y == 2.0)
+		return x * x;
+	if(y == 0.5 && x > 0.0)
+		return ::sqrt(x);
+
+	//log2(ax) = t1 + t2, t1 with its low word cleared.
+	const SrI32 iy = getHigh(y) & 0x7fffffff;
+	SrI32 ix = getHigh(ax);
+	SrF64 t1, t2;
+	if(iy > 0x41e00000)
+		{
+		//|y| > 2^31, only x within 2^-20 of 1 stays finite.
+		if(ix < 0x3fefffff)
+			return y < 0.0 ? HUGE_VAL : 0.0;
+		if(ix > 0x3ff00000)
+			return y > 0.0 ? HUGE_VAL : 0.0;
+		//t has up to 30 bits, its high word times ivln2Hi is exact where fdlibm rounds.
+		const SrF64 t = ax - 1.0;
+		const SrF64 tHi = clearLow(t);
+		const SrF64 w = (t * t) * (0.5 - t * (0.3333333333333333333333 - t * 0.25));
+		const SrF64 u = ivln2Hi * tHi;
+		const SrF64 v = (t - tHi) * ivln2Hi + t * ivln2Lo - w * ivln2;
+		t1 = clearLow(u + v);
+		t2 = v - (t1 - u);
+		}
+	else
+		{
+		//ax = 2^n m with m in [sqrt(3/4), sqrt(3)), around 1 or 1.5.
+		SrF64 m = ax;
+		SrI32 n = 0;
+		if(ix < 0x00100000)
+			{
+			m *= 9007199254740992.0;
+			n -= 53;
+			ix = getHigh(m);
+			}
+		n += (ix >> 20) - 0x3ff;
+		const SrI32 j = ix & 0x000fffff;
+		SrI32 k;
+		ix = j | 0x3ff00000;
+		if(j <= 0x3988e)
+			k = 0;
+		else if(j < 0xbb67a)
+			k = 1;
+		else
+			{
+			k = 0;
+			n += 1;
+			ix -= 0x00100000;
+			}
+		m = setHigh(m, ix);
+
+		//ss = sHi + sLo = (m - bp) / (m + bp).
+		const SrF64 u = m - bp[k];
+		const SrF64 v = 1.0 / (m + bp[k]);
+		const SrF64 ss = u * v;
+		const SrF64 sHi = clearLow(ss);
+		SrF64 tHi = setHigh(0.0, ((ix >> 1) | 0x20000000) + 0x00080000 + (k << 18));
+		SrF64 tLo = m - (tHi - bp[k]);
+		const SrF64 sLo = v * ((u - sHi * tHi) - sHi * tLo);
+
+		//log(m) = 2 ss + 2/3 ss^3 + ..., the series to 3 + ss^2 + r in two parts.
+		SrF64 s2 = ss * ss;
+		SrF64 r = s2 * s2 * (5.99999999999994648725e-01 + s2 * (4.28571428578550184252e-01 + s2 * (3.33333329818377432918e-01 +
+				  s2 * (2.72728123808534006489e-01 + s2 * (2.30660745775561754067e-01 + s2 * 2.06975017800338417784e-01)))));
+		r += sLo * (sHi + ss);
+		s2 = sHi * sHi;
+		tHi = clearLow(3.0 + s2 + r);
+		tLo = r - ((tHi - 3.0) - s2);
+
+		//log2(m) = 2/(3 log(2)) (ss (3 + ss^2 + r)).
+		const SrF64 pu = sHi * tHi;
+		const SrF64 pv = sLo * tHi + tLo * ss;
+		const SrF64 pHi = clearLow(pu + pv);
+		const SrF64 pLo = pv - (pHi - pu);
+		const SrF64 zHi = cpHi * pHi;
+		const SrF64 zLo = cpLo * pHi + pLo * cp + dpLo[k];
+		const SrF64 t = (SrF64)n;
+		t1 = clearLow(((zHi + zLo) + dpHi[k]) + t);
+		t2 = zLo - (((t1 - t) - dpHi[k]) - zHi);
+		}
+
+	//y log2(ax) = pHi + pLo, y split so that y1 t1 is exact.
+	const SrF64 y1 = clearLow(y);
+	SrF64 pLo = (y - y1) * t1 + y * t2;
+	SrF64 pHi = y1 * t1;
+	SrF64 z = pLo + pHi;
+	SrI32 j = getHigh(z);
+	const SrU32 i = getLow(z);
+	const SrF64 sign = negative ? -1.0 : 1.0;
+	if(j >= 0x40900000)
+		{
+		//z >= 1024.
+		if(((j - 0x40900000) | (SrI32)i) != 0 || pLo + ovt > z - pHi)
+			return sign * HUGE_VAL;
+		}
+	else if((j & 0x7fffffff) >= 0x4090cc00)
+		{
+		//z <= -1075.
+		if(((j - (SrI32)0xc090cc00) | (SrI32)i) != 0 || pLo <= z - pHi)
+			return sign * 0.0;
+		}
+
+	//2^z = 2^n 2^(pHi + pLo) with |pHi + pLo| <= 0.5.
+	const SrI32 iz = j & 0x7fffffff;
+	SrI32 k = (iz >> 20) - 0x3ff;
+	SrI32 n = 0;
+	if(iz > 0x3fe00000)
+		{
+		n = j + (0x00100000 >> (k + 1));
+		k = ((n & 0x7fffffff) >> 20) - 0x3ff;
+		const SrF64 t = setHigh(0.0, n & ~(0x000fffff >> k));
+		n = ((n & 0x000fffff) | 0x00100000) >> (20 - k);
+		if(j < 0)
+			n = -n;
+		pHi -= t;
+		}
+	const SrF64 t = clearLow(pLo + pHi);
+	const SrF64 u = t * lg2Hi;
+	const SrF64 v = (pLo - (t - pHi)) * lg2 + t * lg2Lo;
+	z = u + v;
+	const SrF64 w = v - (z - u);
+	const SrF64 zz = z * z;
+	const SrF64 c = z - zz * (1.66666666666666019037e-01 + zz * (-2.77777777770155933842e-03 + zz * (6.61375632143793436117e-05 +
+					zz * (-1.65339022054652515390e-06 + zz * 4.13813679705723846039e-08))));
+	const SrF64 r = (z * c) / (c - 2.0) - (w + z * w);
+	z = 1.0 - (r - z);
+	j = getHigh(z) + (n << 20);
+	z = (j >> 20) <= 0 ? ::ldexp(z, n) : setHigh(z, j);
+	return sign * z;
+	}
+
+SR_CONSTEXPR SrF32 SrMath::sin(SrF32 a)
+	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return (SrF32)constSin(a);
+#endif
+	return SrSimdMath::sin<SrSimdScalar>(a);
+	}
+
+SR_CONSTEXPR SrF64 SrMath::sin(SrF64 a)
+	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return constSin(a);
+#endif
+	return SrMathDeterministic::sin(a);
+	}
+
+SR_CONSTEXPR SrF32 SrMath::cos(SrF32 a)
+	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return (SrF32)constCos(a);
+#endif
+	return SrSimdMath::cos<SrSimdScalar>(a);
+	}
+
+SR_CONSTEXPR SrF64 SrMath::cos(SrF64 a)
+	{
+#if defined(SR_CONSTEXPR_ENABLED)
+	if(std::is_constant_evaluated())
+		return constCos(a);
+#endif
+	return SrMathDeterministic::cos(a);
+	}
+
+SR_INLINE void SrMath::sinCos(SrF32 f, SrF32& s, SrF32& c)
+	{
+	SrSimdMath::sinCos<SrSimdScalar>(f, s, c);
+	}
+
+SR_INLINE void SrMath::sinCos(SrF64 a, SrF64& s, SrF64& c)
+	{
+	SrMathDeterministic::sinCos(a, s, c);
+	}
+
+SR_INLINE SrF32 SrMath::tan(SrF32 a)
+	{
+	SrF32 s, c;
+	SrSimdMath::sinCos<SrSimdScalar>(a, s, c);
+	return s / c;
+	}
+
+SR_INLINE SrF64 SrMath::tan(SrF64 a)
+	{
+	SrF64 s, c;
+	SrMathDeterministic::sinCos(a, s, c);
+	return s / c;
+	}
+
+SR_INLINE SrF32 SrMath::asin(SrF32 f)
+	{
+	return SrSimdMath::asin<SrSimdScalar>(f);
+	}
+
+SR_INLINE SrF64 SrMath::asin(SrF64 f)
+	{
+	if(f >= 1.0)	return SrHalfPiF64;
+	if(f <= -1.0)	return -SrHalfPiF64;
+	return SrMathDeterministic::atan2(f, ::sqrt((1.0 - f) * (1.0 + f)));
+	}
+
+SR_INLINE SrF32 SrMath::acos(SrF32 f)
+	{
+	return SrSimdMath::acos<SrSimdScalar>(f);
+	}
+
+SR_INLINE SrF64 SrMath::acos(SrF64 f)
+	{
+	if(f >= 1.0)	return 0.0;
+	if(f <= -1.0)	return SrPiF64;
+	return SrMathDeterministic::atan2(::sqrt((1.0 - f) * (1.0 + f)), f);
+	}
+
+SR_INLINE SrF32 SrMath::atan(SrF32 a)
+	{
+	return SrSimdMath::atan<SrSimdScalar>(a);
+	}
+
+SR_INLINE SrF64 SrMath::atan(SrF64 a)
+	{
+	return SrMathDeterministic::atan(a);
+	}
+
+SR_INLINE SrF32 SrMath::atan2(SrF32 x, SrF32 y)
+	{
+	return SrSimdMath::atan2<SrSimdScalar>(x, y);
+	}
+
+SR_INLINE SrF64 SrMath::atan2(SrF64 x, SrF64 y)
+	{
+	return SrMathDeterministic::atan2(x, y);
+	}
+
+SR_INLINE SrF32 SrMath::pow(SrF32 x, SrF32 y)
+	{
+	//the double precision pow, within 0.9 ulp of double, rounded to float.
+	return (SrF32)SrMathDeterministic::pow(x, y);
+	}
+
+SR_INLINE SrF64 SrMath::pow(SrF64 x, SrF64 y)
+	{
+	return SrMathDeterministic::pow(x, y);
+	}
+
+SR_INLINE SrF32 SrMath::exp(SrF32 a)
+	{
+	return SrSimdMath::exp<SrSimdScalar>(a);
+	}
+
+SR_INLINE SrF64 SrMath::exp(SrF64 a)
+	{
+	return SrMathDeterministic::exp(a);
+	}
+
+SR_INLINE SrF32 SrMath::logE(SrF32 a)
+	{
+	return SrSimdMath::logE<SrSimdScalar>(a);
+	}
+
+SR_INLINE SrF64 SrMath::logE(SrF64 a)
+	{
+	return SrMathDeterministic::logE(a);
+	}
+
+SR_INLINE SrF32 SrMath::log2(SrF32 a)
+	{
+	return logE(a) / (SrF32)0.693147180559945309417;
+	}
+
+SR_INLINE SrF64 SrMath::log2(SrF64 a)
+	{
+	return logE(a) / 0.693147180559945309417;
+	}
+
+SR_INLINE SrF32 SrMath::log10(SrF32 a)
+	{
+	return logE(a) / (SrF32)2.30258509299404568402;
+	}
+
+SR_INLINE SrF64 SrMath::log10(SrF64 a)
+	{
+	return logE(a) / 2.30258509299404568402;
+	}
+
+/** @} */
+#endif
@@ -12,21 +12,11 @@
 
 #include "SrVector3.h"
 #include "SrQuaternion.h"
+template<class T>
 class Mat33DataType
 {
 public:
-	struct S
-	{
-
-		float        _11, _12, _13;
-		float        _21, _22, _23;
-		float        _31, _32, _33;
-	};
-	union 
-	{
-		S s;
-		float m[3][3];
-	};
+	T m[3][3];
 };
 
 /**
@@ -57,10 +47,11 @@ enum SrMatrixType
  This way it should be easier to change formats depending on what is faster/slower
  on a particular platform.
 
- Design issue: We use nameless struct/unions here.
- Design issue: this used to be implemented with a template.  This had no benefit
- but it added syntactic complexity.  Currently we just use a typedef and a preprocessor switch 
- to change between different memory layouts.
+ Design issue: the elements are only accessed as data.m[row][col], a union with named
+ elements could not be used in constant expressions.
+ Design issue: the class is a template on the scalar type only, SrMatrix33 and SrMatrix33F64
+ are the SrF32 and SrF64 typedefs.  The memory layout is still changed with a preprocessor
+ switch.
 
  The matrix math in this class is storage format (row/col major) independent as far
  as the user is concerned.
@@ -68,89 +59,96 @@ enum SrMatrixType
  coming in.  
  
 */
-class SrMatrix33
+template<class T>
+class SrMatrix33T
 	{
 	public:
-	SR_INLINE SrMatrix33();
+	SR_CONSTEXPR SrMatrix33T();
 
 	/**
 	\param type Special matrix type to initialize with.
 
 	@see SrMatrixType
 	*/
-	SR_INLINE SrMatrix33(SrMatrixType type);
-	SR_INLINE SrMatrix33(const SrVector3 &row0, const SrVector3 &row1, const SrVector3 &row2);
+	SR_CONSTEXPR SrMatrix33T(SrMatrixType type);
+	SR_CONSTEXPR SrMatrix33T(const SrVector3T<T> &row0, const SrVector3T<T> &row1, const SrVector3T<T> &row2);
+
+	SR_CONSTEXPR SrMatrix33T(const SrMatrix33T&m);
 
-	SR_INLINE SrMatrix33(const SrMatrix33&m);
-	SR_INLINE SrMatrix33(const SrQuaternion &m);
-	SR_INLINE ~SrMatrix33();
-	SR_INLINE const SrMatrix33& operator=(const SrMatrix33 &src);
+	/**
+	\brief Converts from the other precision.
+	*/
+	template<class U>
+	SR_CONSTEXPR explicit SrMatrix33T(const SrMatrix33T<U>&m);
+	SR_CONSTEXPR SrMatrix33T(const SrQuaternionT<T> &m);
+	SR_CONSTEXPR ~SrMatrix33T();
+	SR_CONSTEXPR const SrMatrix33T& operator=(const SrMatrix33T &src);
 
 	// Access elements
 
 	//low level data access, single or double precision, with eventual translation:
 	//for dense 9 element data
-	SR_INLINE void setRowMajor(const SrF32 *);
-	SR_INLINE void setRowMajor(const SrF32 d[][3]);
-	SR_INLINE void setColumnMajor(const SrF32 *);
-	SR_INLINE void setColumnMajor(const SrF32 d[][3]);
-	SR_INLINE void getRowMajor(SrF32 *) const;
-	SR_INLINE void getRowMajor(SrF32 d[][3]) const;
-	SR_INLINE void getColumnMajor(SrF32 *) const;
-	SR_INLINE void getColumnMajor(SrF32 d[][3]) const;
-
-	SR_INLINE void setRowMajor(const SrF64 *);
-	SR_INLINE void setRowMajor(const SrF64 d[][3]);
-	SR_INLINE void setColumnMajor(const SrF64 *);
-	SR_INLINE void setColumnMajor(const SrF64 d[][3]);
-	SR_INLINE void getRowMajor(SrF64 *) const;
-	SR_INLINE void getRowMajor(SrF64 d[][3]) const;
-	SR_INLINE void getColumnMajor(SrF64 *) const;
-	SR_INLINE void getColumnMajor(SrF64 d[][3]) const;
+	SR_CONSTEXPR void setRowMajor(const SrF32 *);
+	SR_CONSTEXPR void setRowMajor(const SrF32 d[][3]);
+	SR_CONSTEXPR void setColumnMajor(const SrF32 *);
+	SR_CONSTEXPR void setColumnMajor(const SrF32 d[][3]);
+	SR_CONSTEXPR void getRowMajor(SrF32 *) const;
+	SR_CONSTEXPR void getRowMajor(SrF32 d[][3]) const;
+	SR_CONSTEXPR void getColumnMajor(SrF32 *) const;
+	SR_CONSTEXPR void getColumnMajor(SrF32 d[][3]) const;
+
+	SR_CONSTEXPR void setRowMajor(const SrF64 *);
+	SR_CONSTEXPR void setRowMajor(const SrF64 d[][3]);
+	SR_CONSTEXPR void setColumnMajor(const SrF64 *);
+	SR_CONSTEXPR void setColumnMajor(const SrF64 d[][3]);
+	SR_CONSTEXPR void getRowMajor(SrF64 *) const;
+	SR_CONSTEXPR void getRowMajor(SrF64 d[][3]) const;
+	SR_CONSTEXPR void getColumnMajor(SrF64 *) const;
+	SR_CONSTEXPR void getColumnMajor(SrF64 d[][3]) const;
 
 
 	//for loose 4-padded data.
-	SR_INLINE void setRowMajorStride4(const SrF32 *);
-	SR_INLINE void setRowMajorStride4(const SrF32 d[][4]);
-	SR_INLINE void setColumnMajorStride4(const SrF32 *);
-	SR_INLINE void setColumnMajorStride4(const SrF32 d[][4]);
-	SR_INLINE void getRowMajorStride4(SrF32 *) const;
-	SR_INLINE void getRowMajorStride4(SrF32 d[][4]) const;
-	SR_INLINE void getColumnMajorStride4(SrF32 *) const;
-	SR_INLINE void getColumnMajorStride4(SrF32 d[][4]) const;
-
-	SR_INLINE void setRowMajorStride4(const SrF64 *);
-	SR_INLINE void setRowMajorStride4(const SrF64 d[][4]);
-	SR_INLINE void setColumnMajorStride4(const SrF64 *);
-	SR_INLINE void setColumnMajorStride4(const SrF64 d[][4]);
-	SR_INLINE void getRowMajorStride4(SrF64 *) const;
-	SR_INLINE void getRowMajorStride4(SrF64 d[][4]) const;
-	SR_INLINE void getColumnMajorStride4(SrF64 *) const;
-	SR_INLINE void getColumnMajorStride4(SrF64 d[][4]) const;
-
-
-	SR_INLINE void setRow(int row, const SrVector3 &);
-	SR_INLINE void setColumn(int col, const SrVector3 &);
-	SR_INLINE void getRow(int row, SrVector3 &) const;
-	SR_INLINE void getColumn(int col, SrVector3 &) const;
-
-	SR_INLINE SrVector3 getRow(int row) const;
-	SR_INLINE SrVector3 getColumn(int col) const;
+	SR_CONSTEXPR void setRowMajorStride4(const SrF32 *);
+	SR_CONSTEXPR void setRowMajorStride4(const SrF32 d[][4]);
+	SR_CONSTEXPR void setColumnMajorStride4(const SrF32 *);
+	SR_CONSTEXPR void setColumnMajorStride4(const SrF32 d[][4]);
+	SR_CONSTEXPR void getRowMajorStride4(SrF32 *) const;
+	SR_CONSTEXPR void getRowMajorStride4(SrF32 d[][4]) const;
+	SR_CONSTEXPR void getColumnMajorStride4(SrF32 *) const;
+	SR_CONSTEXPR void getColumnMajorStride4(SrF32 d[][4]) const;
+
+	SR_CONSTEXPR void setRowMajorStride4(const SrF64 *);
+	SR_CONSTEXPR void setRowMajorStride4(const SrF64 d[][4]);
+	SR_CONSTEXPR void setColumnMajorStride4(const SrF64 *);
+	SR_CONSTEXPR void setColumnMajorStride4(const SrF64 d[][4]);
+	SR_CONSTEXPR void getRowMajorStride4(SrF64 *) const;
+	SR_CONSTEXPR void getRowMajorStride4(SrF64 d[][4]) const;
+	SR_CONSTEXPR void getColumnMajorStride4(SrF64 *) const;
+	SR_CONSTEXPR void getColumnMajorStride4(SrF64 d[][4]) const;
+
+
+	SR_CONSTEXPR void setRow(int row, const SrVector3T<T> &);
+	SR_CONSTEXPR void setColumn(int col, const SrVector3T<T> &);
+	SR_CONSTEXPR void getRow(int row, SrVector3T<T> &) const;
+	SR_CONSTEXPR void getColumn(int col, SrVector3T<T> &) const;
+
+	SR_CONSTEXPR SrVector3T<T> getRow(int row) const;
+	SR_CONSTEXPR SrVector3T<T> getColumn(int col) const;
 
 
 	//element access:
-    SR_INLINE float & operator()(int row, int col);
-    SR_INLINE const float & operator() (int row, int col) const;
+    SR_CONSTEXPR T & operator()(int row, int col);
+    SR_CONSTEXPR const T & operator() (int row, int col) const;
 
 	/**
 	\brief returns true for identity matrix
 	*/
-	SR_INLINE bool isIdentity() const;
+	SR_CONSTEXPR bool isIdentity() const;
 
 	/**
 	\brief returns true for zero matrix
 	*/
-	SR_INLINE bool isZero() const;
+	SR_CONSTEXPR bool isZero() const;
 
 	/**
 	\brief returns true if all elems are finite (not NAN or INF, etc.)
@@ -162,40 +160,40 @@ class SrMatrix33
 	/**
 	\brief sets this matrix to the zero matrix.
 	*/
-	SR_INLINE void zero();
+	SR_CONSTEXPR void zero();
 
 	/**
 	\brief sets this matrix to the identity matrix.
 	*/
-	SR_INLINE void id();
+	SR_CONSTEXPR void id();
 
 	/**
 	\brief this = -this
 	*/
-	SR_INLINE void setNegative();
+	SR_CONSTEXPR void setNegative();
 
 	/**
 	\brief sets this matrix to the diagonal matrix.
 	*/
-	SR_INLINE void diagonal(const SrVector3 &vec);
+	SR_CONSTEXPR void diagonal(const SrVector3T<T> &vec);
 
 	/**
 	\brief Sets this matrix to the Star(Skew Symetric) matrix.
 
 	So that star(v) * x = v.cross(x) .
 	*/
-	SR_INLINE void star(const SrVector3 &vec);
+	SR_CONSTEXPR void star(const SrVector3T<T> &vec);
 
 
-	SR_INLINE void fromQuat(const SrQuaternion &);
-	SR_INLINE void toQuat(SrQuaternion &) const;
+	SR_CONSTEXPR void fromQuat(const SrQuaternionT<T> &);
+	SR_CONSTEXPR void toQuat(SrQuaternionT<T> &) const;
 
 	//modifications:
 
-	SR_INLINE const SrMatrix33 &operator +=(const SrMatrix33 &s);
-	SR_INLINE const SrMatrix33 &operator -=(const SrMatrix33 &s);
-	SR_INLINE const SrMatrix33 &operator *=(float s);
-	SR_INLINE const SrMatrix33 &operator /=(float s);
+	SR_CONSTEXPR const SrMatrix33T &operator +=(const SrMatrix33T &s);
+	SR_CONSTEXPR const SrMatrix33T &operator -=(const SrMatrix33T &s);
+	SR_CONSTEXPR const SrMatrix33T &operator *=(T s);
+	SR_CONSTEXPR const SrMatrix33T &operator /=(T s);
 
 	/*
 	Gram-Schmidt orthogonalization to correct numerical drift, plus column normalization
@@ -207,110 +205,110 @@ class SrMatrix33
 	/**
 	\brief returns determinant
 	*/
-	SR_INLINE float determinant() const;
+	SR_CONSTEXPR T determinant() const;
 
 	/**
 	\brief assigns inverse to dest.
 	
 	Returns false if singular (i.e. if no inverse exists), setting dest to identity.
 	*/
-	SR_INLINE bool getInverse(SrMatrix33& dest) const;
+	SR_CONSTEXPR bool getInverse(SrMatrix33T& dest) const;
 
 	/**
 	\brief this = transpose(other)
 
 	this == other is OK.
 	*/
-	SR_INLINE void setTransposed(const SrMatrix33& other);
+	SR_CONSTEXPR void setTransposed(const SrMatrix33T& other);
 
 	/**
 	\brief this = transpose(this)
 	*/
-	SR_INLINE void setTransposed();
+	SR_CONSTEXPR void setTransposed();
 
 	/**
 	\brief this = this * [ d.x 0 0; 0 d.y 0; 0 0 d.z];
 	*/
-	SR_INLINE void multiplyDiagonal(const SrVector3 &d);
+	SR_CONSTEXPR void multiplyDiagonal(const SrVector3T<T> &d);
 
 	/**
 	\brief this = transpose(this) * [ d.x 0 0; 0 d.y 0; 0 0 d.z];
 	*/
-	SR_INLINE void multiplyDiagonalTranspose(const SrVector3 &d);
+	SR_CONSTEXPR void multiplyDiagonalTranspose(const SrVector3T<T> &d);
 
 	/**
 	\brief dst = this * [ d.x 0 0; 0 d.y 0; 0 0 d.z];
 	*/
-	SR_INLINE void multiplyDiagonal(const SrVector3 &d, SrMatrix33 &dst) const;
+	SR_CONSTEXPR void multiplyDiagonal(const SrVector3T<T> &d, SrMatrix33T &dst) const;
 
 	/**
 	\brief dst = transpose(this) * [ d.x 0 0; 0 d.y 0; 0 0 d.z];
 	*/
-	SR_INLINE void multiplyDiagonalTranspose(const SrVector3 &d, SrMatrix33 &dst) const;
+	SR_CONSTEXPR void multiplyDiagonalTranspose(const SrVector3T<T> &d, SrMatrix33T &dst) const;
 
 	/**
 	\brief dst = this * src
 	*/
-	SR_INLINE void multiply(const SrVector3 &src, SrVector3 &dst) const;
+	SR_CONSTEXPR void multiply(const SrVector3T<T> &src, SrVector3T<T> &dst) const;
 	/**
 	\brief dst = transpose(this) * src
 	*/
-	SR_INLINE void multiplyByTranspose(const SrVector3 &src, SrVector3 &dst) const;
+	SR_CONSTEXPR void multiplyByTranspose(const SrVector3T<T> &src, SrVector3T<T> &dst) const;
 
 	/**
 	\brief this = a + b
 	*/
-	SR_INLINE void  add(const SrMatrix33 & a, const SrMatrix33 & b);
+	SR_CONSTEXPR void  add(const SrMatrix33T & a, const SrMatrix33T & b);
 	/***
 	\brief this = a - b
 	*/
-	SR_INLINE void  subtract(const SrMatrix33 &a, const SrMatrix33 &b);
+	SR_CONSTEXPR void  subtract(const SrMatrix33T &a, const SrMatrix33T &b);
 	/**
 	\brief this = s * a;
 	*/
-	SR_INLINE void  multiply(float s,  const SrMatrix33 & a);
+	SR_CONSTEXPR void  multiply(T s,  const SrMatrix33T & a);
 	/**
 	\brief this = left * right
 	*/
-	SR_INLINE void multiply(const SrMatrix33& left, const SrMatrix33& right);
+	SR_CONSTEXPR void multiply(const SrMatrix33T& left, const SrMatrix33T& right);
 	/**
 	\brief this = transpose(left) * right
 
 	\note #multiplyByTranspose() is faster.
 	*/
-	SR_INLINE void multiplyTransposeLeft(const SrMatrix33& left, const SrMatrix33& right);
+	SR_CONSTEXPR void multiplyTransposeLeft(const SrMatrix33T& left, const SrMatrix33T& right);
 	/**
 	\brief this = left * transpose(right)
 	
 	\note faster than #multiplyByTranspose().
 	*/
-	SR_INLINE void multiplyTransposeRight(const SrMatrix33& left, const SrMatrix33& right);
+	SR_CONSTEXPR void multiplyTransposeRight(const SrMatrix33T& left, const SrMatrix33T& right);
 
 	/**
 	\brief this = left * transpose(right)
 	*/
-	SR_INLINE void multiplyTransposeRight(const SrVector3 &left, const SrVector3 &right);
+	SR_CONSTEXPR void multiplyTransposeRight(const SrVector3T<T> &left, const SrVector3T<T> &right);
 
 	/**
 	\brief this = rotation matrix around X axis
 
 	<b>Unit:</b> Radians
 	*/
-	SR_INLINE void rotX(float angle);
+	SR_CONSTEXPR void rotX(T angle);
 
 	/**
 	\brief this = rotation matrix around Y axis
 
 	<b>Unit:</b> Radians
 	*/
-	SR_INLINE void rotY(float angle);
+	SR_CONSTEXPR void rotY(T angle);
 
 	/**
 	\brief this = rotation matrix around Z axis
 
 	<b>Unit:</b> Radians
 	*/
-	SR_INLINE void rotZ(float angle);
+	SR_CONSTEXPR void rotZ(T angle);
 
 
 	//overloaded multiply, and transposed-multiply ops:
@@ -318,43 +316,45 @@ class SrMatrix33
 	/**
 	\brief returns transpose(this)*src
 	*/
-	SR_INLINE SrVector3 operator%  (const SrVector3 & src) const;
+	SR_CONSTEXPR SrVector3T<T> operator%  (const SrVector3T<T> & src) const;
 	/**
 	\brief matrix vector product
 	*/
-	SR_INLINE SrVector3 operator*  (const SrVector3 & src) const;
+	SR_CONSTEXPR SrVector3T<T> operator*  (const SrVector3T<T> & src) const;
 	/**
 	\brief matrix product
 	*/
-	SR_INLINE SrMatrix33&	operator*= (const SrMatrix33& mat);
+	SR_CONSTEXPR SrMatrix33T&	operator*= (const SrMatrix33T& mat);
 	/**
 	\brief matrix difference
 	*/
-	SR_INLINE SrMatrix33	operator-  (const SrMatrix33& mat)	const;
+	SR_CONSTEXPR SrMatrix33T	operator-  (const SrMatrix33T& mat)	const;
 	/**
 	\brief matrix addition
 	*/
-	SR_INLINE SrMatrix33	operator+  (const SrMatrix33& mat)	const;
+	SR_CONSTEXPR SrMatrix33T	operator+  (const SrMatrix33T& mat)	const;
 	/**
 	\brief matrix product
 	*/
-	SR_INLINE SrMatrix33	operator*  (const SrMatrix33& mat)	const;
+	SR_CONSTEXPR SrMatrix33T	operator*  (const SrMatrix33T& mat)	const;
 	/**
 	\brief matrix scalar product
 	*/
-	SR_INLINE SrMatrix33	operator*  (float s)				const;
+	SR_CONSTEXPR SrMatrix33T	operator*  (T s)				const;
 
 	private:
-	Mat33DataType data;
+	Mat33DataType<T> data;
 	};
 
 
-SR_INLINE SrMatrix33::SrMatrix33()
+template<class T>
+SR_CONSTEXPR SrMatrix33T<T>::SrMatrix33T()
 	{
 	}
 
 
-SR_INLINE SrMatrix33::SrMatrix33(SrMatrixType type)
+template<class T>
+SR_CONSTEXPR SrMatrix33T<T>::SrMatrix33T(SrMatrixType type)
 	{
 		switch(type)
 		{
@@ -364,592 +364,640 @@ SR_INLINE SrMatrix33::SrMatrix33(SrMatrixType type)
 	}
 
 
-SR_INLINE SrMatrix33::SrMatrix33(const SrMatrix33& a)
+template<class T>
+SR_CONSTEXPR SrMatrix33T<T>::SrMatrix33T(const SrMatrix33T<T>& a)
 	{
 	data = a.data;
 	}
 
 
-SR_INLINE SrMatrix33::SrMatrix33(const SrQuaternion &q)
+template<class T>
+template<class U>
+SR_CONSTEXPR SrMatrix33T<T>::SrMatrix33T(const SrMatrix33T<U>& a)
+	{
+	for(int i = 0; i < 3; i++)
+		for(int j = 0; j < 3; j++)
+			(*this)(i,j) = (T)a(i,j);
+	}
+
+
+template<class T>
+SR_CONSTEXPR SrMatrix33T<T>::SrMatrix33T(const SrQuaternionT<T> &q)
 	{
 	fromQuat(q);
 	}
 
-SR_INLINE SrMatrix33::SrMatrix33(const SrVector3 &row0, const SrVector3 &row1, const SrVector3 &row2)
+template<class T>
+SR_CONSTEXPR SrMatrix33T<T>::SrMatrix33T(const SrVector3T<T> &row0, const SrVector3T<T> &row1, const SrVector3T<T> &row2)
 {
-	data.s._11 = row0.x;  data.s._12 = row0.y;  data.s._13 = row0.z;
-	data.s._21 = row1.x;  data.s._22 = row1.y;  data.s._23 = row1.z;
-	data.s._31 = row2.x;  data.s._32 = row2.y;  data.s._33 = row2.z;
+	data.m[0][0] = row0.x;  data.m[0][1] = row0.y;  data.m[0][2] = row0.z;
+	data.m[1][0] = row1.x;  data.m[1][1] = row1.y;  data.m[1][2] = row1.z;
+	data.m[2][0] = row2.x;  data.m[2][1] = row2.y;  data.m[2][2] = row2.z;
 }
 
 
-SR_INLINE SrMatrix33::~SrMatrix33()
+template<class T>
+SR_CONSTEXPR SrMatrix33T<T>::~SrMatrix33T()
 	{
 	//nothing
 	}
 
 
-SR_INLINE const SrMatrix33& SrMatrix33::operator=(const SrMatrix33 &a)
+template<class T>
+SR_CONSTEXPR const SrMatrix33T<T>& SrMatrix33T<T>::operator=(const SrMatrix33T<T> &a)
 	{
 	data = a.data;
 	return *this;
 	}
 
 
-SR_INLINE void SrMatrix33::setRowMajor(const SrF32* d)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setRowMajor(const SrF32* d)
 	{
 	//we are also row major, so this is a direct copy
-	data.s._11 = (float)d[0];
-	data.s._12 = (float)d[1];
-	data.s._13 = (float)d[2];
+	data.m[0][0] = (T)d[0];
+	data.m[0][1] = (T)d[1];
+	data.m[0][2] = (T)d[2];
 
-	data.s._21 = (float)d[3];
-	data.s._22 = (float)d[4];
-	data.s._23 = (float)d[5];
+	data.m[1][0] = (T)d[3];
+	data.m[1][1] = (T)d[4];
+	data.m[1][2] = (T)d[5];
 
-	data.s._31 = (float)d[6];
-	data.s._32 = (float)d[7];
-	data.s._33 = (float)d[8];
+	data.m[2][0] = (T)d[6];
+	data.m[2][1] = (T)d[7];
+	data.m[2][2] = (T)d[8];
 	}
 
 
-SR_INLINE void SrMatrix33::setRowMajor(const SrF32 d[][3])
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setRowMajor(const SrF32 d[][3])
 	{
 	//we are also row major, so this is a direct copy
-	data.s._11 = (float)d[0][0];
-	data.s._12 = (float)d[0][1];
-	data.s._13 = (float)d[0][2];
+	data.m[0][0] = (T)d[0][0];
+	data.m[0][1] = (T)d[0][1];
+	data.m[0][2] = (T)d[0][2];
 
-	data.s._21 = (float)d[1][0];
-	data.s._22 = (float)d[1][1];
-	data.s._23 = (float)d[1][2];
+	data.m[1][0] = (T)d[1][0];
+	data.m[1][1] = (T)d[1][1];
+	data.m[1][2] = (T)d[1][2];
 
-	data.s._31 = (float)d[2][0];
-	data.s._32 = (float)d[2][1];
-	data.s._33 = (float)d[2][2];
+	data.m[2][0] = (T)d[2][0];
+	data.m[2][1] = (T)d[2][1];
+	data.m[2][2] = (T)d[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::setColumnMajor(const SrF32* d)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setColumnMajor(const SrF32* d)
 	{
 	//we are column major, so copy transposed.
-	data.s._11 = (float)d[0];
-	data.s._12 = (float)d[3];
-	data.s._13 = (float)d[6];
+	data.m[0][0] = (T)d[0];
+	data.m[0][1] = (T)d[3];
+	data.m[0][2] = (T)d[6];
 
-	data.s._21 = (float)d[1];
-	data.s._22 = (float)d[4];
-	data.s._23 = (float)d[7];
+	data.m[1][0] = (T)d[1];
+	data.m[1][1] = (T)d[4];
+	data.m[1][2] = (T)d[7];
 
-	data.s._31 = (float)d[2];
-	data.s._32 = (float)d[5];
-	data.s._33 = (float)d[8];
+	data.m[2][0] = (T)d[2];
+	data.m[2][1] = (T)d[5];
+	data.m[2][2] = (T)d[8];
 	}
 
 
-SR_INLINE void SrMatrix33::setColumnMajor(const SrF32 d[][3])
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setColumnMajor(const SrF32 d[][3])
 	{
 	//we are column major, so copy transposed.
-	data.s._11 = (float)d[0][0];
-	data.s._12 = (float)d[1][0];
-	data.s._13 = (float)d[2][0];
+	data.m[0][0] = (T)d[0][0];
+	data.m[0][1] = (T)d[1][0];
+	data.m[0][2] = (T)d[2][0];
 
-	data.s._21 = (float)d[0][1];
-	data.s._22 = (float)d[1][1];
-	data.s._23 = (float)d[2][1];
+	data.m[1][0] = (T)d[0][1];
+	data.m[1][1] = (T)d[1][1];
+	data.m[1][2] = (T)d[2][1];
 
-	data.s._31 = (float)d[0][2];
-	data.s._32 = (float)d[1][2];
-	data.s._33 = (float)d[2][2];
+	data.m[2][0] = (T)d[0][2];
+	data.m[2][1] = (T)d[1][2];
+	data.m[2][2] = (T)d[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getRowMajor(SrF32* d) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getRowMajor(SrF32* d) const
 	{
 	//we are also row major, so this is a direct copy
-	d[0] = (SrF32)data.s._11;
-	d[1] = (SrF32)data.s._12;
-	d[2] = (SrF32)data.s._13;
+	d[0] = (SrF32)data.m[0][0];
+	d[1] = (SrF32)data.m[0][1];
+	d[2] = (SrF32)data.m[0][2];
 
-	d[3] = (SrF32)data.s._21;
-	d[4] = (SrF32)data.s._22;
-	d[5] = (SrF32)data.s._23;
+	d[3] = (SrF32)data.m[1][0];
+	d[4] = (SrF32)data.m[1][1];
+	d[5] = (SrF32)data.m[1][2];
 
-	d[6] = (SrF32)data.s._31;
-	d[7] = (SrF32)data.s._32;
-	d[8] = (SrF32)data.s._33;
+	d[6] = (SrF32)data.m[2][0];
+	d[7] = (SrF32)data.m[2][1];
+	d[8] = (SrF32)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getRowMajor(SrF32 d[][3]) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getRowMajor(SrF32 d[][3]) const
 	{
 	//we are also row major, so this is a direct copy
-	d[0][0] = (SrF32)data.s._11;
-	d[0][1] = (SrF32)data.s._12;
-	d[0][2] = (SrF32)data.s._13;
+	d[0][0] = (SrF32)data.m[0][0];
+	d[0][1] = (SrF32)data.m[0][1];
+	d[0][2] = (SrF32)data.m[0][2];
 
-	d[1][0] = (SrF32)data.s._21;
-	d[1][1] = (SrF32)data.s._22;
-	d[1][2] = (SrF32)data.s._23;
+	d[1][0] = (SrF32)data.m[1][0];
+	d[1][1] = (SrF32)data.m[1][1];
+	d[1][2] = (SrF32)data.m[1][2];
 
-	d[2][0] = (SrF32)data.s._31;
-	d[2][1] = (SrF32)data.s._32;
-	d[2][2] = (SrF32)data.s._33;
+	d[2][0] = (SrF32)data.m[2][0];
+	d[2][1] = (SrF32)data.m[2][1];
+	d[2][2] = (SrF32)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getColumnMajor(SrF32* d) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getColumnMajor(SrF32* d) const
 	{
 	//we are column major, so copy transposed.
-	d[0] = (SrF32)data.s._11;
-	d[3] = (SrF32)data.s._12;
-	d[6] = (SrF32)data.s._13;
+	d[0] = (SrF32)data.m[0][0];
+	d[3] = (SrF32)data.m[0][1];
+	d[6] = (SrF32)data.m[0][2];
 
-	d[1] = (SrF32)data.s._21;
-	d[4] = (SrF32)data.s._22;
-	d[7] = (SrF32)data.s._23;
+	d[1] = (SrF32)data.m[1][0];
+	d[4] = (SrF32)data.m[1][1];
+	d[7] = (SrF32)data.m[1][2];
 
-	d[2] = (SrF32)data.s._31;
-	d[5] = (SrF32)data.s._32;
-	d[8] = (SrF32)data.s._33;
+	d[2] = (SrF32)data.m[2][0];
+	d[5] = (SrF32)data.m[2][1];
+	d[8] = (SrF32)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getColumnMajor(SrF32 d[][3]) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getColumnMajor(SrF32 d[][3]) const
 	{
 	//we are column major, so copy transposed.
-	d[0][0] = (SrF32)data.s._11;
-	d[1][0] = (SrF32)data.s._12;
-	d[2][0] = (SrF32)data.s._13;
+	d[0][0] = (SrF32)data.m[0][0];
+	d[1][0] = (SrF32)data.m[0][1];
+	d[2][0] = (SrF32)data.m[0][2];
 
-	d[0][1] = (SrF32)data.s._21;
-	d[1][1] = (SrF32)data.s._22;
-	d[2][1] = (SrF32)data.s._23;
+	d[0][1] = (SrF32)data.m[1][0];
+	d[1][1] = (SrF32)data.m[1][1];
+	d[2][1] = (SrF32)data.m[1][2];
 
-	d[0][2] = (SrF32)data.s._31;
-	d[1][2] = (SrF32)data.s._32;
-	d[2][2] = (SrF32)data.s._33;
+	d[0][2] = (SrF32)data.m[2][0];
+	d[1][2] = (SrF32)data.m[2][1];
+	d[2][2] = (SrF32)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::setRowMajorStride4(const SrF32* d)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setRowMajorStride4(const SrF32* d)
 	{
 	//we are also row major, so this is a direct copy
 	//however we've got to skip every 4th element.
-	data.s._11 = (float)d[0];
-	data.s._12 = (float)d[1];
-	data.s._13 = (float)d[2];
+	data.m[0][0] = (T)d[0];
+	data.m[0][1] = (T)d[1];
+	data.m[0][2] = (T)d[2];
 
-	data.s._21 = (float)d[4];
-	data.s._22 = (float)d[5];
-	data.s._23 = (float)d[6];
+	data.m[1][0] = (T)d[4];
+	data.m[1][1] = (T)d[5];
+	data.m[1][2] = (T)d[6];
 
-	data.s._31 = (float)d[8];
-	data.s._32 = (float)d[9];
-	data.s._33 = (float)d[10];
+	data.m[2][0] = (T)d[8];
+	data.m[2][1] = (T)d[9];
+	data.m[2][2] = (T)d[10];
 	}
 
 
-SR_INLINE void SrMatrix33::setRowMajorStride4(const SrF32 d[][4])
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setRowMajorStride4(const SrF32 d[][4])
 	{
 	//we are also row major, so this is a direct copy
-	data.s._11 = (float)d[0][0];
-	data.s._12 = (float)d[0][1];
-	data.s._13 = (float)d[0][2];
+	data.m[0][0] = (T)d[0][0];
+	data.m[0][1] = (T)d[0][1];
+	data.m[0][2] = (T)d[0][2];
 
-	data.s._21 = (float)d[1][0];
-	data.s._22 = (float)d[1][1];
-	data.s._23 = (float)d[1][2];
+	data.m[1][0] = (T)d[1][0];
+	data.m[1][1] = (T)d[1][1];
+	data.m[1][2] = (T)d[1][2];
 
-	data.s._31 = (float)d[2][0];
-	data.s._32 = (float)d[2][1];
-	data.s._33 = (float)d[2][2];
+	data.m[2][0] = (T)d[2][0];
+	data.m[2][1] = (T)d[2][1];
+	data.m[2][2] = (T)d[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::setColumnMajorStride4(const SrF32* d)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setColumnMajorStride4(const SrF32* d)
 	{
 	//we are column major, so copy transposed.
 	//however we've got to skip every 4th element.
-	data.s._11 = (float)d[0];
-	data.s._12 = (float)d[4];
-	data.s._13 = (float)d[8];
+	data.m[0][0] = (T)d[0];
+	data.m[0][1] = (T)d[4];
+	data.m[0][2] = (T)d[8];
 
-	data.s._21 = (float)d[1];
-	data.s._22 = (float)d[5];
-	data.s._23 = (float)d[9];
+	data.m[1][0] = (T)d[1];
+	data.m[1][1] = (T)d[5];
+	data.m[1][2] = (T)d[9];
 
-	data.s._31 = (float)d[2];
-	data.s._32 = (float)d[6];
-	data.s._33 = (float)d[10];
+	data.m[2][0] = (T)d[2];
+	data.m[2][1] = (T)d[6];
+	data.m[2][2] = (T)d[10];
 	}
 
 
-SR_INLINE void SrMatrix33::setColumnMajorStride4(const SrF32 d[][4])
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setColumnMajorStride4(const SrF32 d[][4])
 	{
 	//we are column major, so copy transposed.
-	data.s._11 = (float)d[0][0];
-	data.s._12 = (float)d[1][0];
-	data.s._13 = (float)d[2][0];
+	data.m[0][0] = (T)d[0][0];
+	data.m[0][1] = (T)d[1][0];
+	data.m[0][2] = (T)d[2][0];
 
-	data.s._21 = (float)d[0][1];
-	data.s._22 = (float)d[1][1];
-	data.s._23 = (float)d[2][1];
+	data.m[1][0] = (T)d[0][1];
+	data.m[1][1] = (T)d[1][1];
+	data.m[1][2] = (T)d[2][1];
 
-	data.s._31 = (float)d[0][2];
-	data.s._32 = (float)d[1][2];
-	data.s._33 = (float)d[2][2];
+	data.m[2][0] = (T)d[0][2];
+	data.m[2][1] = (T)d[1][2];
+	data.m[2][2] = (T)d[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getRowMajorStride4(SrF32* d) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getRowMajorStride4(SrF32* d) const
 	{
 	//we are also row major, so this is a direct copy
 	//however we've got to skip every 4th element.
-	d[0] = (SrF32)data.s._11;
-	d[1] = (SrF32)data.s._12;
-	d[2] = (SrF32)data.s._13;
+	d[0] = (SrF32)data.m[0][0];
+	d[1] = (SrF32)data.m[0][1];
+	d[2] = (SrF32)data.m[0][2];
 
-	d[4] = (SrF32)data.s._21;
-	d[5] = (SrF32)data.s._22;
-	d[6] = (SrF32)data.s._23;
+	d[4] = (SrF32)data.m[1][0];
+	d[5] = (SrF32)data.m[1][1];
+	d[6] = (SrF32)data.m[1][2];
 
-	d[8] = (SrF32)data.s._31;
-	d[9] = (SrF32)data.s._32;
-	d[10]= (SrF32)data.s._33;
+	d[8] = (SrF32)data.m[2][0];
+	d[9] = (SrF32)data.m[2][1];
+	d[10]= (SrF32)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getRowMajorStride4(SrF32 d[][4]) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getRowMajorStride4(SrF32 d[][4]) const
 	{
 	//we are also row major, so this is a direct copy
-	d[0][0] = (SrF32)data.s._11;
-	d[0][1] = (SrF32)data.s._12;
-	d[0][2] = (SrF32)data.s._13;
+	d[0][0] = (SrF32)data.m[0][0];
+	d[0][1] = (SrF32)data.m[0][1];
+	d[0][2] = (SrF32)data.m[0][2];
 
-	d[1][0] = (SrF32)data.s._21;
-	d[1][1] = (SrF32)data.s._22;
-	d[1][2] = (SrF32)data.s._23;
+	d[1][0] = (SrF32)data.m[1][0];
+	d[1][1] = (SrF32)data.m[1][1];
+	d[1][2] = (SrF32)data.m[1][2];
 
-	d[2][0] = (SrF32)data.s._31;
-	d[2][1] = (SrF32)data.s._32;
-	d[2][2] = (SrF32)data.s._33;
+	d[2][0] = (SrF32)data.m[2][0];
+	d[2][1] = (SrF32)data.m[2][1];
+	d[2][2] = (SrF32)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getColumnMajorStride4(SrF32* d) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getColumnMajorStride4(SrF32* d) const
 	{
 	//we are column major, so copy transposed.
 	//however we've got to skip every 4th element.
-	d[0] = (SrF32)data.s._11;
-	d[4] = (SrF32)data.s._12;
-	d[8] = (SrF32)data.s._13;
+	d[0] = (SrF32)data.m[0][0];
+	d[4] = (SrF32)data.m[0][1];
+	d[8] = (SrF32)data.m[0][2];
 
-	d[1] = (SrF32)data.s._21;
-	d[5] = (SrF32)data.s._22;
-	d[9] = (SrF32)data.s._23;
+	d[1] = (SrF32)data.m[1][0];
+	d[5] = (SrF32)data.m[1][1];
+	d[9] = (SrF32)data.m[1][2];
 
-	d[2] = (SrF32)data.s._31;
-	d[6] = (SrF32)data.s._32;
-	d[10]= (SrF32)data.s._33;
+	d[2] = (SrF32)data.m[2][0];
+	d[6] = (SrF32)data.m[2][1];
+	d[10]= (SrF32)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getColumnMajorStride4(SrF32 d[][4]) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getColumnMajorStride4(SrF32 d[][4]) const
 	{
 	//we are column major, so copy transposed.
-	d[0][0] = (SrF32)data.s._11;
-	d[1][0] = (SrF32)data.s._12;
-	d[2][0] = (SrF32)data.s._13;
+	d[0][0] = (SrF32)data.m[0][0];
+	d[1][0] = (SrF32)data.m[0][1];
+	d[2][0] = (SrF32)data.m[0][2];
 
-	d[0][1] = (SrF32)data.s._21;
-	d[1][1] = (SrF32)data.s._22;
-	d[2][1] = (SrF32)data.s._23;
+	d[0][1] = (SrF32)data.m[1][0];
+	d[1][1] = (SrF32)data.m[1][1];
+	d[2][1] = (SrF32)data.m[1][2];
 
-	d[0][2] = (SrF32)data.s._31;
-	d[1][2] = (SrF32)data.s._32;
-	d[2][2] = (SrF32)data.s._33;
+	d[0][2] = (SrF32)data.m[2][0];
+	d[1][2] = (SrF32)data.m[2][1];
+	d[2][2] = (SrF32)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::setRowMajor(const SrF64*d)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setRowMajor(const SrF64*d)
 	{
 	//we are also row major, so this is a direct copy
-	data.s._11 = (float)d[0];
-	data.s._12 = (float)d[1];
-	data.s._13 = (float)d[2];
+	data.m[0][0] = (T)d[0];
+	data.m[0][1] = (T)d[1];
+	data.m[0][2] = (T)d[2];
 
-	data.s._21 = (float)d[3];
-	data.s._22 = (float)d[4];
-	data.s._23 = (float)d[5];
+	data.m[1][0] = (T)d[3];
+	data.m[1][1] = (T)d[4];
+	data.m[1][2] = (T)d[5];
 
-	data.s._31 = (float)d[6];
-	data.s._32 = (float)d[7];
-	data.s._33 = (float)d[8];
+	data.m[2][0] = (T)d[6];
+	data.m[2][1] = (T)d[7];
+	data.m[2][2] = (T)d[8];
 	}
 
 
-SR_INLINE void SrMatrix33::setRowMajor(const SrF64 d[][3])
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setRowMajor(const SrF64 d[][3])
 	{
 	//we are also row major, so this is a direct copy
-	data.s._11 = (float)d[0][0];
-	data.s._12 = (float)d[0][1];
-	data.s._13 = (float)d[0][2];
+	data.m[0][0] = (T)d[0][0];
+	data.m[0][1] = (T)d[0][1];
+	data.m[0][2] = (T)d[0][2];
 
-	data.s._21 = (float)d[1][0];
-	data.s._22 = (float)d[1][1];
-	data.s._23 = (float)d[1][2];
+	data.m[1][0] = (T)d[1][0];
+	data.m[1][1] = (T)d[1][1];
+	data.m[1][2] = (T)d[1][2];
 
-	data.s._31 = (float)d[2][0];
-	data.s._32 = (float)d[2][1];
-	data.s._33 = (float)d[2][2];
+	data.m[2][0] = (T)d[2][0];
+	data.m[2][1] = (T)d[2][1];
+	data.m[2][2] = (T)d[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::setColumnMajor(const SrF64*d)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setColumnMajor(const SrF64*d)
 	{
 	//we are column major, so copy transposed.
-	data.s._11 = (float)d[0];
-	data.s._12 = (float)d[3];
-	data.s._13 = (float)d[6];
+	data.m[0][0] = (T)d[0];
+	data.m[0][1] = (T)d[3];
+	data.m[0][2] = (T)d[6];
 
-	data.s._21 = (float)d[1];
-	data.s._22 = (float)d[4];
-	data.s._23 = (float)d[7];
+	data.m[1][0] = (T)d[1];
+	data.m[1][1] = (T)d[4];
+	data.m[1][2] = (T)d[7];
 
-	data.s._31 = (float)d[2];
-	data.s._32 = (float)d[5];
-	data.s._33 = (float)d[8];
+	data.m[2][0] = (T)d[2];
+	data.m[2][1] = (T)d[5];
+	data.m[2][2] = (T)d[8];
 	}
 
 
-SR_INLINE void SrMatrix33::setColumnMajor(const SrF64 d[][3])
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setColumnMajor(const SrF64 d[][3])
 	{
 	//we are column major, so copy transposed.
-	data.s._11 = (float)d[0][0];
-	data.s._12 = (float)d[1][0];
-	data.s._13 = (float)d[2][0];
+	data.m[0][0] = (T)d[0][0];
+	data.m[0][1] = (T)d[1][0];
+	data.m[0][2] = (T)d[2][0];
 
-	data.s._21 = (float)d[0][1];
-	data.s._22 = (float)d[1][1];
-	data.s._23 = (float)d[2][1];
+	data.m[1][0] = (T)d[0][1];
+	data.m[1][1] = (T)d[1][1];
+	data.m[1][2] = (T)d[2][1];
 
-	data.s._31 = (float)d[0][2];
-	data.s._32 = (float)d[1][2];
-	data.s._33 = (float)d[2][2];
+	data.m[2][0] = (T)d[0][2];
+	data.m[2][1] = (T)d[1][2];
+	data.m[2][2] = (T)d[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getRowMajor(SrF64*d) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getRowMajor(SrF64*d) const
 	{
 	//we are also row major, so this is a direct copy
-	d[0] = (SrF64)data.s._11;
-	d[1] = (SrF64)data.s._12;
-	d[2] = (SrF64)data.s._13;
+	d[0] = (SrF64)data.m[0][0];
+	d[1] = (SrF64)data.m[0][1];
+	d[2] = (SrF64)data.m[0][2];
 
-	d[3] = (SrF64)data.s._21;
-	d[4] = (SrF64)data.s._22;
-	d[5] = (SrF64)data.s._23;
+	d[3] = (SrF64)data.m[1][0];
+	d[4] = (SrF64)data.m[1][1];
+	d[5] = (SrF64)data.m[1][2];
 
-	d[6] = (SrF64)data.s._31;
-	d[7] = (SrF64)data.s._32;
-	d[8] = (SrF64)data.s._33;
+	d[6] = (SrF64)data.m[2][0];
+	d[7] = (SrF64)data.m[2][1];
+	d[8] = (SrF64)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getRowMajor(SrF64 d[][3]) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getRowMajor(SrF64 d[][3]) const
 	{
 	//we are also row major, so this is a direct copy
-	d[0][0] = (SrF64)data.s._11;
-	d[0][1] = (SrF64)data.s._12;
-	d[0][2] = (SrF64)data.s._13;
+	d[0][0] = (SrF64)data.m[0][0];
+	d[0][1] = (SrF64)data.m[0][1];
+	d[0][2] = (SrF64)data.m[0][2];
 
-	d[1][0] = (SrF64)data.s._21;
-	d[1][1] = (SrF64)data.s._22;
-	d[1][2] = (SrF64)data.s._23;
+	d[1][0] = (SrF64)data.m[1][0];
+	d[1][1] = (SrF64)data.m[1][1];
+	d[1][2] = (SrF64)data.m[1][2];
 
-	d[2][0] = (SrF64)data.s._31;
-	d[2][1] = (SrF64)data.s._32;
-	d[2][2] = (SrF64)data.s._33;
+	d[2][0] = (SrF64)data.m[2][0];
+	d[2][1] = (SrF64)data.m[2][1];
+	d[2][2] = (SrF64)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getColumnMajor(SrF64*d) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getColumnMajor(SrF64*d) const
 	{
 	//we are column major, so copy transposed.
-	d[0] = (SrF64)data.s._11;
-	d[3] = (SrF64)data.s._12;
-	d[6] = (SrF64)data.s._13;
+	d[0] = (SrF64)data.m[0][0];
+	d[3] = (SrF64)data.m[0][1];
+	d[6] = (SrF64)data.m[0][2];
 
-	d[1] = (SrF64)data.s._21;
-	d[4] = (SrF64)data.s._22;
-	d[7] = (SrF64)data.s._23;
+	d[1] = (SrF64)data.m[1][0];
+	d[4] = (SrF64)data.m[1][1];
+	d[7] = (SrF64)data.m[1][2];
 
-	d[2] = (SrF64)data.s._31;
-	d[5] = (SrF64)data.s._32;
-	d[8] = (SrF64)data.s._33;
+	d[2] = (SrF64)data.m[2][0];
+	d[5] = (SrF64)data.m[2][1];
+	d[8] = (SrF64)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getColumnMajor(SrF64 d[][3]) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getColumnMajor(SrF64 d[][3]) const
 	{
 	//we are column major, so copy transposed.
-	d[0][0] = (SrF64)data.s._11;
-	d[1][0] = (SrF64)data.s._12;
-	d[2][0] = (SrF64)data.s._13;
+	d[0][0] = (SrF64)data.m[0][0];
+	d[1][0] = (SrF64)data.m[0][1];
+	d[2][0] = (SrF64)data.m[0][2];
 
-	d[0][1] = (SrF64)data.s._21;
-	d[1][1] = (SrF64)data.s._22;
-	d[2][1] = (SrF64)data.s._23;
+	d[0][1] = (SrF64)data.m[1][0];
+	d[1][1] = (SrF64)data.m[1][1];
+	d[2][1] = (SrF64)data.m[1][2];
 
-	d[0][2] = (SrF64)data.s._31;
-	d[1][2] = (SrF64)data.s._32;
-	d[2][2] = (SrF64)data.s._33;
+	d[0][2] = (SrF64)data.m[2][0];
+	d[1][2] = (SrF64)data.m[2][1];
+	d[2][2] = (SrF64)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::setRowMajorStride4(const SrF64*d)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setRowMajorStride4(const SrF64*d)
 	{
 	//we are also row major, so this is a direct copy
 	//however we've got to skip every 4th element.
-	data.s._11 = (float)d[0];
-	data.s._12 = (float)d[1];
-	data.s._13 = (float)d[2];
+	data.m[0][0] = (T)d[0];
+	data.m[0][1] = (T)d[1];
+	data.m[0][2] = (T)d[2];
 
-	data.s._21 = (float)d[4];
-	data.s._22 = (float)d[5];
-	data.s._23 = (float)d[6];
+	data.m[1][0] = (T)d[4];
+	data.m[1][1] = (T)d[5];
+	data.m[1][2] = (T)d[6];
 
-	data.s._31 = (float)d[8];
-	data.s._32 = (float)d[9];
-	data.s._33 = (float)d[10];
+	data.m[2][0] = (T)d[8];
+	data.m[2][1] = (T)d[9];
+	data.m[2][2] = (T)d[10];
 	}
 
 
-SR_INLINE void SrMatrix33::setRowMajorStride4(const SrF64 d[][4])
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setRowMajorStride4(const SrF64 d[][4])
 	{
 	//we are also row major, so this is a direct copy
-	data.s._11 = (float)d[0][0];
-	data.s._12 = (float)d[0][1];
-	data.s._13 = (float)d[0][2];
+	data.m[0][0] = (T)d[0][0];
+	data.m[0][1] = (T)d[0][1];
+	data.m[0][2] = (T)d[0][2];
 
-	data.s._21 = (float)d[1][0];
-	data.s._22 = (float)d[1][1];
-	data.s._23 = (float)d[1][2];
+	data.m[1][0] = (T)d[1][0];
+	data.m[1][1] = (T)d[1][1];
+	data.m[1][2] = (T)d[1][2];
 
-	data.s._31 = (float)d[2][0];
-	data.s._32 = (float)d[2][1];
-	data.s._33 = (float)d[2][2];
+	data.m[2][0] = (T)d[2][0];
+	data.m[2][1] = (T)d[2][1];
+	data.m[2][2] = (T)d[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::setColumnMajorStride4(const SrF64*d)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setColumnMajorStride4(const SrF64*d)
 	{
 	//we are column major, so copy transposed.
 	//however we've got to skip every 4th element.
-	data.s._11 = (float)d[0];
-	data.s._12 = (float)d[4];
-	data.s._13 = (float)d[8];
+	data.m[0][0] = (T)d[0];
+	data.m[0][1] = (T)d[4];
+	data.m[0][2] = (T)d[8];
 
-	data.s._21 = (float)d[1];
-	data.s._22 = (float)d[5];
-	data.s._23 = (float)d[9];
+	data.m[1][0] = (T)d[1];
+	data.m[1][1] = (T)d[5];
+	data.m[1][2] = (T)d[9];
 
-	data.s._31 = (float)d[2];
-	data.s._32 = (float)d[6];
-	data.s._33 = (float)d[10];
+	data.m[2][0] = (T)d[2];
+	data.m[2][1] = (T)d[6];
+	data.m[2][2] = (T)d[10];
 	}
 
 
-SR_INLINE void SrMatrix33::setColumnMajorStride4(const SrF64 d[][4])
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setColumnMajorStride4(const SrF64 d[][4])
 	{
 	//we are column major, so copy transposed.
-	data.s._11 = (float)d[0][0];
-	data.s._12 = (float)d[1][0];
-	data.s._13 = (float)d[2][0];
+	data.m[0][0] = (T)d[0][0];
+	data.m[0][1] = (T)d[1][0];
+	data.m[0][2] = (T)d[2][0];
 
-	data.s._21 = (float)d[0][1];
-	data.s._22 = (float)d[1][1];
-	data.s._23 = (float)d[2][1];
+	data.m[1][0] = (T)d[0][1];
+	data.m[1][1] = (T)d[1][1];
+	data.m[1][2] = (T)d[2][1];
 
-	data.s._31 = (float)d[0][2];
-	data.s._32 = (float)d[1][2];
-	data.s._33 = (float)d[2][2];
+	data.m[2][0] = (T)d[0][2];
+	data.m[2][1] = (T)d[1][2];
+	data.m[2][2] = (T)d[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getRowMajorStride4(SrF64*d) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getRowMajorStride4(SrF64*d) const
 	{
 	//we are also row major, so this is a direct copy
 	//however we've got to skip every 4th element.
-	d[0] = (SrF64)data.s._11;
-	d[1] = (SrF64)data.s._12;
-	d[2] = (SrF64)data.s._13;
+	d[0] = (SrF64)data.m[0][0];
+	d[1] = (SrF64)data.m[0][1];
+	d[2] = (SrF64)data.m[0][2];
 
-	d[4] = (SrF64)data.s._21;
-	d[5] = (SrF64)data.s._22;
-	d[6] = (SrF64)data.s._23;
+	d[4] = (SrF64)data.m[1][0];
+	d[5] = (SrF64)data.m[1][1];
+	d[6] = (SrF64)data.m[1][2];
 
-	d[8] = (SrF64)data.s._31;
-	d[9] = (SrF64)data.s._32;
-	d[10]= (SrF64)data.s._33;
+	d[8] = (SrF64)data.m[2][0];
+	d[9] = (SrF64)data.m[2][1];
+	d[10]= (SrF64)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getRowMajorStride4(SrF64 d[][4]) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getRowMajorStride4(SrF64 d[][4]) const
 	{
 	//we are also row major, so this is a direct copy
-	d[0][0] = (SrF64)data.s._11;
-	d[0][1] = (SrF64)data.s._12;
-	d[0][2] = (SrF64)data.s._13;
+	d[0][0] = (SrF64)data.m[0][0];
+	d[0][1] = (SrF64)data.m[0][1];
+	d[0][2] = (SrF64)data.m[0][2];
 
-	d[1][0] = (SrF64)data.s._21;
-	d[1][1] = (SrF64)data.s._22;
-	d[1][2] = (SrF64)data.s._23;
+	d[1][0] = (SrF64)data.m[1][0];
+	d[1][1] = (SrF64)data.m[1][1];
+	d[1][2] = (SrF64)data.m[1][2];
 
-	d[2][0] = (SrF64)data.s._31;
-	d[2][1] = (SrF64)data.s._32;
-	d[2][2] = (SrF64)data.s._33;
+	d[2][0] = (SrF64)data.m[2][0];
+	d[2][1] = (SrF64)data.m[2][1];
+	d[2][2] = (SrF64)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getColumnMajorStride4(SrF64*d) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getColumnMajorStride4(SrF64*d) const
 
 	{
 	//we are column major, so copy transposed.
 	//however we've got to skip every 4th element.
-	d[0] = (SrF64)data.s._11;
-	d[4] = (SrF64)data.s._12;
-	d[8] = (SrF64)data.s._13;
+	d[0] = (SrF64)data.m[0][0];
+	d[4] = (SrF64)data.m[0][1];
+	d[8] = (SrF64)data.m[0][2];
 
-	d[1] = (SrF64)data.s._21;
-	d[5] = (SrF64)data.s._22;
-	d[9] = (SrF64)data.s._23;
+	d[1] = (SrF64)data.m[1][0];
+	d[5] = (SrF64)data.m[1][1];
+	d[9] = (SrF64)data.m[1][2];
 
-	d[2] = (SrF64)data.s._31;
-	d[6] = (SrF64)data.s._32;
-	d[10]= (SrF64)data.s._33;
+	d[2] = (SrF64)data.m[2][0];
+	d[6] = (SrF64)data.m[2][1];
+	d[10]= (SrF64)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::getColumnMajorStride4(SrF64 d[][4]) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getColumnMajorStride4(SrF64 d[][4]) const
 	{
 	//we are column major, so copy transposed.
-	d[0][0] = (SrF64)data.s._11;
-	d[1][0] = (SrF64)data.s._12;
-	d[2][0] = (SrF64)data.s._13;
+	d[0][0] = (SrF64)data.m[0][0];
+	d[1][0] = (SrF64)data.m[0][1];
+	d[2][0] = (SrF64)data.m[0][2];
 
-	d[0][1] = (SrF64)data.s._21;
-	d[1][1] = (SrF64)data.s._22;
-	d[2][1] = (SrF64)data.s._23;
+	d[0][1] = (SrF64)data.m[1][0];
+	d[1][1] = (SrF64)data.m[1][1];
+	d[2][1] = (SrF64)data.m[1][2];
 
-	d[0][2] = (SrF64)data.s._31;
-	d[1][2] = (SrF64)data.s._32;
-	d[2][2] = (SrF64)data.s._33;
+	d[0][2] = (SrF64)data.m[2][0];
+	d[1][2] = (SrF64)data.m[2][1];
+	d[2][2] = (SrF64)data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::setRow(int row, const SrVector3 & v)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setRow(int row, const SrVector3T<T> & v)
 	{
 #ifndef TRANSPOSED_MAT33
 	data.m[row][0] = v.x;
@@ -963,7 +1011,8 @@ SR_INLINE void SrMatrix33::setRow(int row, const SrVector3 & v)
 	}
 
 
-SR_INLINE void SrMatrix33::setColumn(int col, const SrVector3 & v)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setColumn(int col, const SrVector3T<T> & v)
 	{
 #ifndef TRANSPOSED_MAT33
 	data.m[0][col] = v.x;
@@ -977,7 +1026,8 @@ SR_INLINE void SrMatrix33::setColumn(int col, const SrVector3 & v)
 	}
 
 
-SR_INLINE void SrMatrix33::getRow(int row, SrVector3 & v) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getRow(int row, SrVector3T<T> & v) const
 	{
 #ifndef TRANSPOSED_MAT33
 	v.x = data.m[row][0];
@@ -991,7 +1041,8 @@ SR_INLINE void SrMatrix33::getRow(int row, SrVector3 & v) const
 	}
 
 
-SR_INLINE void SrMatrix33::getColumn(int col, SrVector3 & v) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::getColumn(int col, SrVector3T<T> & v) const
 	{
 #ifndef TRANSPOSED_MAT33
 	v.x = data.m[0][col];
@@ -1005,25 +1056,28 @@ SR_INLINE void SrMatrix33::getColumn(int col, SrVector3 & v) const
 	}
 
 
-SR_INLINE SrVector3 SrMatrix33::getRow(int row) const
+template<class T>
+SR_CONSTEXPR SrVector3T<T> SrMatrix33T<T>::getRow(int row) const
 {
 #ifndef TRANSPOSED_MAT33
-	return SrVector3(data.m[row][0],data.m[row][1],data.m[row][2]);
+	return SrVector3T<T>(data.m[row][0],data.m[row][1],data.m[row][2]);
 #else
-	return SrVector3(data.m[0][row],data.m[1][row],data.m[2][row]);
+	return SrVector3T<T>(data.m[0][row],data.m[1][row],data.m[2][row]);
 #endif
 }
 
-SR_INLINE SrVector3 SrMatrix33::getColumn(int col) const
+template<class T>
+SR_CONSTEXPR SrVector3T<T> SrMatrix33T<T>::getColumn(int col) const
 {
 #ifndef TRANSPOSED_MAT33
-	return SrVector3(data.m[0][col],data.m[1][col],data.m[2][col]);
+	return SrVector3T<T>(data.m[0][col],data.m[1][col],data.m[2][col]);
 #else
-	return SrVector3(data.m[col][0],data.m[col][1],data.m[col][2]);
+	return SrVector3T<T>(data.m[col][0],data.m[col][1],data.m[col][2]);
 #endif
 }
 
-SR_INLINE float & SrMatrix33::operator()(int row, int col)
+template<class T>
+SR_CONSTEXPR T & SrMatrix33T<T>::operator()(int row, int col)
 	{
 #ifndef TRANSPOSED_MAT33
 	return data.m[row][col];
@@ -1033,7 +1087,8 @@ SR_INLINE float & SrMatrix33::operator()(int row, int col)
 	}
 
 
-SR_INLINE const float & SrMatrix33::operator() (int row, int col) const
+template<class T>
+SR_CONSTEXPR const T & SrMatrix33T<T>::operator() (int row, int col) const
 	{
 #ifndef TRANSPOSED_MAT33
 	return data.m[row][col];
@@ -1045,161 +1100,171 @@ SR_INLINE const float & SrMatrix33::operator() (int row, int col) const
 //const methods
 
 
-SR_INLINE bool SrMatrix33::isIdentity() const
+template<class T>
+SR_CONSTEXPR bool SrMatrix33T<T>::isIdentity() const
 	{
-	if(data.s._11 != 1.0f)		return false;
-	if(data.s._12 != 0.0f)		return false;
-	if(data.s._13 != 0.0f)		return false;
+	if(data.m[0][0] != 1.0f)		return false;
+	if(data.m[0][1] != 0.0f)		return false;
+	if(data.m[0][2] != 0.0f)		return false;
 
-	if(data.s._21 != 0.0f)		return false;
-	if(data.s._22 != 1.0f)		return false;
-	if(data.s._23 != 0.0f)		return false;
+	if(data.m[1][0] != 0.0f)		return false;
+	if(data.m[1][1] != 1.0f)		return false;
+	if(data.m[1][2] != 0.0f)		return false;
 
-	if(data.s._31 != 0.0f)		return false;
-	if(data.s._32 != 0.0f)		return false;
-	if(data.s._33 != 1.0f)		return false;
+	if(data.m[2][0] != 0.0f)		return false;
+	if(data.m[2][1] != 0.0f)		return false;
+	if(data.m[2][2] != 1.0f)		return false;
 
 	return true;
 	}
 
 
-SR_INLINE bool SrMatrix33::isZero() const
+template<class T>
+SR_CONSTEXPR bool SrMatrix33T<T>::isZero() const
 	{
-	if(data.s._11 != 0.0f)		return false;
-	if(data.s._12 != 0.0f)		return false;
-	if(data.s._13 != 0.0f)		return false;
+	if(data.m[0][0] != 0.0f)		return false;
+	if(data.m[0][1] != 0.0f)		return false;
+	if(data.m[0][2] != 0.0f)		return false;
 
-	if(data.s._21 != 0.0f)		return false;
-	if(data.s._22 != 0.0f)		return false;
-	if(data.s._23 != 0.0f)		return false;
+	if(data.m[1][0] != 0.0f)		return false;
+	if(data.m[1][1] != 0.0f)		return false;
+	if(data.m[1][2] != 0.0f)		return false;
 
-	if(data.s._31 != 0.0f)		return false;
-	if(data.s._32 != 0.0f)		return false;
-	if(data.s._33 != 0.0f)		return false;
+	if(data.m[2][0] != 0.0f)		return false;
+	if(data.m[2][1] != 0.0f)		return false;
+	if(data.m[2][2] != 0.0f)		return false;
 
 	return true;
 	}
 
 
-SR_INLINE bool SrMatrix33::isFinite() const
+template<class T>
+SR_INLINE bool SrMatrix33T<T>::isFinite() const
 	{
-	return SrMath::isFinite(data.s._11)
-	&& SrMath::isFinite(data.s._12)
-	&& SrMath::isFinite(data.s._13)
+	return SrMath::isFinite(data.m[0][0])
+	&& SrMath::isFinite(data.m[0][1])
+	&& SrMath::isFinite(data.m[0][2])
 
-	&& SrMath::isFinite(data.s._21)
-	&& SrMath::isFinite(data.s._22)
-	&& SrMath::isFinite(data.s._23)
+	&& SrMath::isFinite(data.m[1][0])
+	&& SrMath::isFinite(data.m[1][1])
+	&& SrMath::isFinite(data.m[1][2])
 
-	&& SrMath::isFinite(data.s._31)
-	&& SrMath::isFinite(data.s._32)
-	&& SrMath::isFinite(data.s._33);
+	&& SrMath::isFinite(data.m[2][0])
+	&& SrMath::isFinite(data.m[2][1])
+	&& SrMath::isFinite(data.m[2][2]);
 	}
 
 
 
-SR_INLINE void SrMatrix33::zero()
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::zero()
 	{
-	data.s._11 = float(0.0);
-	data.s._12 = float(0.0);
-	data.s._13 = float(0.0);
+	data.m[0][0] = T(0.0);
+	data.m[0][1] = T(0.0);
+	data.m[0][2] = T(0.0);
 
-	data.s._21 = float(0.0);
-	data.s._22 = float(0.0);
-	data.s._23 = float(0.0);
+	data.m[1][0] = T(0.0);
+	data.m[1][1] = T(0.0);
+	data.m[1][2] = T(0.0);
 
-	data.s._31 = float(0.0);
-	data.s._32 = float(0.0);
-	data.s._33 = float(0.0);
+	data.m[2][0] = T(0.0);
+	data.m[2][1] = T(0.0);
+	data.m[2][2] = T(0.0);
 	}
 
 
-SR_INLINE void SrMatrix33::id()
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::id()
 	{
-	data.s._11 = float(1.0);
-	data.s._12 = float(0.0);
-	data.s._13 = float(0.0);
+	data.m[0][0] = T(1.0);
+	data.m[0][1] = T(0.0);
+	data.m[0][2] = T(0.0);
 
-	data.s._21 = float(0.0);
-	data.s._22 = float(1.0);
-	data.s._23 = float(0.0);
+	data.m[1][0] = T(0.0);
+	data.m[1][1] = T(1.0);
+	data.m[1][2] = T(0.0);
 
-	data.s._31 = float(0.0);
-	data.s._32 = float(0.0);
-	data.s._33 = float(1.0);
+	data.m[2][0] = T(0.0);
+	data.m[2][1] = T(0.0);
+	data.m[2][2] = T(1.0);
 	}
 
 
-SR_INLINE void SrMatrix33::setNegative()
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setNegative()
 	{
-	data.s._11 = -data.s._11;
-	data.s._12 = -data.s._12;
-	data.s._13 = -data.s._13;
+	data.m[0][0] = -data.m[0][0];
+	data.m[0][1] = -data.m[0][1];
+	data.m[0][2] = -data.m[0][2];
 
-	data.s._21 = -data.s._21;
-	data.s._22 = -data.s._22;
-	data.s._23 = -data.s._23;
+	data.m[1][0] = -data.m[1][0];
+	data.m[1][1] = -data.m[1][1];
+	data.m[1][2] = -data.m[1][2];
 
-	data.s._31 = -data.s._31;
-	data.s._32 = -data.s._32;
-	data.s._33 = -data.s._33;
+	data.m[2][0] = -data.m[2][0];
+	data.m[2][1] = -data.m[2][1];
+	data.m[2][2] = -data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::diagonal(const SrVector3 &v)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::diagonal(const SrVector3T<T> &v)
 	{
-	data.s._11 = v.x;
-	data.s._12 = float(0.0);
-	data.s._13 = float(0.0);
+	data.m[0][0] = v.x;
+	data.m[0][1] = T(0.0);
+	data.m[0][2] = T(0.0);
 
-	data.s._21 = float(0.0);
-	data.s._22 = v.y;
-	data.s._23 = float(0.0);
+	data.m[1][0] = T(0.0);
+	data.m[1][1] = v.y;
+	data.m[1][2] = T(0.0);
 
-	data.s._31 = float(0.0);
-	data.s._32 = float(0.0);
-	data.s._33 = v.z;
+	data.m[2][0] = T(0.0);
+	data.m[2][1] = T(0.0);
+	data.m[2][2] = v.z;
 	}
 
 
-SR_INLINE void SrMatrix33::star(const SrVector3 &v)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::star(const SrVector3T<T> &v)
 	{
-	data.s._11 = float(0.0);	data.s._12 =-v.z;	data.s._13 = v.y;
-	data.s._21 = v.z;	data.s._22 = float(0.0);	data.s._23 =-v.x;
-	data.s._31 =-v.y;	data.s._32 = v.x;	data.s._33 = float(0.0);
+	data.m[0][0] = T(0.0);	data.m[0][1] =-v.z;	data.m[0][2] = v.y;
+	data.m[1][0] = v.z;	data.m[1][1] = T(0.0);	data.m[1][2] =-v.x;
+	data.m[2][0] =-v.y;	data.m[2][1] = v.x;	data.m[2][2] = T(0.0);
 	}
 
 
-SR_INLINE void SrMatrix33::fromQuat(const SrQuaternion & q)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::fromQuat(const SrQuaternionT<T> & q)
 	{
-	const float w = q.w;
-	const float x = q.x;
-	const float y = q.y;
-	const float z = q.z;
+	const T w = q.w;
+	const T x = q.x;
+	const T y = q.y;
+	const T z = q.z;
 
-	data.s._11 = float(1.0) - y*y*float(2.0) - z*z*float(2.0);
-	data.s._12 = x*y*float(2.0) - w*z*float(2.0);	
-	data.s._13 = x*z*float(2.0) + w*y*float(2.0);	
+	data.m[0][0] = T(1.0) - y*y*T(2.0) - z*z*T(2.0);
+	data.m[0][1] = x*y*T(2.0) - w*z*T(2.0);	
+	data.m[0][2] = x*z*T(2.0) + w*y*T(2.0);	
 
-	data.s._21 = x*y*float(2.0) + w*z*float(2.0);	
-	data.s._22 = float(1.0) - x*x*float(2.0) - z*z*float(2.0);	
-	data.s._23 = y*z*float(2.0) - w*x*float(2.0);	
+	data.m[1][0] = x*y*T(2.0) + w*z*T(2.0);	
+	data.m[1][1] = T(1.0) - x*x*T(2.0) - z*z*T(2.0);	
+	data.m[1][2] = y*z*T(2.0) - w*x*T(2.0);	
 	
-	data.s._31 = x*z*float(2.0) - w*y*float(2.0);	
-	data.s._32 = y*z*float(2.0) + w*x*float(2.0);	
-	data.s._33 = float(1.0) - x*x*float(2.0) - y*y*float(2.0);	
+	data.m[2][0] = x*z*T(2.0) - w*y*T(2.0);	
+	data.m[2][1] = y*z*T(2.0) + w*x*T(2.0);	
+	data.m[2][2] = T(1.0) - x*x*T(2.0) - y*y*T(2.0);	
 	}
 
 
-SR_INLINE void SrMatrix33::toQuat(SrQuaternion & q) const					// set the SrQuaternion from a rotation matrix
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::toQuat(SrQuaternionT<T> & q) const					// set the SrQuaternion from a rotation matrix
 	{
-    float tr, s;
-    tr = data.s._11 + data.s._22 + data.s._33;
+    T tr, s;
+    tr = data.m[0][0] + data.m[1][1] + data.m[2][2];
     if(tr >= 0)
 		{
-		s = (float)SrMath::sqrt(tr +1);
-		q.w = float(0.5) * s;
-		s = float(0.5) / s;
+		s = (T)SrMath::sqrt(tr +1);
+		q.w = T(0.5) * s;
+		s = T(0.5) / s;
 		q.x = ((*this)(2,1) - (*this)(1,2)) * s;
 		q.y = ((*this)(0,2) - (*this)(2,0)) * s;
 		q.z = ((*this)(1,0) - (*this)(0,1)) * s;
@@ -1207,32 +1272,32 @@ SR_INLINE void SrMatrix33::toQuat(SrQuaternion & q) const					// set the SrQuate
     else
 		{
 		int i = 0; 
-		if (data.s._22 > data.s._11)
+		if (data.m[1][1] > data.m[0][0])
 			i = 1; 
-		if(data.s._33 > (*this)(i,i))
+		if(data.m[2][2] > (*this)(i,i))
 			i=2; 
 		switch (i)
 			{
 			case 0:
-				s = (float)SrMath::sqrt((data.s._11 - (data.s._22 + data.s._33)) + 1);
-				q.x = float(0.5) * s;
-				s = float(0.5) / s;
+				s = (T)SrMath::sqrt((data.m[0][0] - (data.m[1][1] + data.m[2][2])) + 1);
+				q.x = T(0.5) * s;
+				s = T(0.5) / s;
 				q.y = ((*this)(0,1) + (*this)(1,0)) * s; 
 				q.z = ((*this)(2,0) + (*this)(0,2)) * s;
 				q.w = ((*this)(2,1) - (*this)(1,2)) * s;
 				break;
 			case 1:
-				s = (float)SrMath::sqrt((data.s._22 - (data.s._33 + data.s._11)) + 1);
-				q.y = float(0.5) * s;
-				s = float(0.5) / s;
+				s = (T)SrMath::sqrt((data.m[1][1] - (data.m[2][2] + data.m[0][0])) + 1);
+				q.y = T(0.5) * s;
+				s = T(0.5) / s;
 				q.z = ((*this)(1,2) + (*this)(2,1)) * s;
 				q.x = ((*this)(0,1) + (*this)(1,0)) * s;
 				q.w = ((*this)(0,2) - (*this)(2,0)) * s;
 				break;
 			case 2:
-				s = (float)SrMath::sqrt((data.s._33 - (data.s._11 + data.s._22)) + 1);
-				q.z = float(0.5) * s;
-				s = float(0.5) / s;
+				s = (T)SrMath::sqrt((data.m[2][2] - (data.m[0][0] + data.m[1][1])) + 1);
+				q.z = T(0.5) * s;
+				s = T(0.5) / s;
 				q.x = ((*this)(2,0) + (*this)(0,2)) * s;
 				q.y = ((*this)(1,2) + (*this)(2,1)) * s;
 				q.w = ((*this)(1,0) - (*this)(0,1)) * s;
@@ -1240,116 +1305,123 @@ SR_INLINE void SrMatrix33::toQuat(SrQuaternion & q) const					// set the SrQuate
 		}
 	}
 
-SR_INLINE void SrMatrix33::setTransposed(const SrMatrix33& other)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setTransposed(const SrMatrix33T<T>& other)
 	{
 	//gotta special case in-place case
 	if (this != &other)
 		{
-		data.s._11 = other.data.s._11;
-		data.s._12 = other.data.s._21;
-		data.s._13 = other.data.s._31;
+		data.m[0][0] = other.data.m[0][0];
+		data.m[0][1] = other.data.m[1][0];
+		data.m[0][2] = other.data.m[2][0];
 
-		data.s._21 = other.data.s._12;
-		data.s._22 = other.data.s._22;
-		data.s._23 = other.data.s._32;
+		data.m[1][0] = other.data.m[0][1];
+		data.m[1][1] = other.data.m[1][1];
+		data.m[1][2] = other.data.m[2][1];
 
-		data.s._31 = other.data.s._13;
-		data.s._32 = other.data.s._23;
-		data.s._33 = other.data.s._33;
+		data.m[2][0] = other.data.m[0][2];
+		data.m[2][1] = other.data.m[1][2];
+		data.m[2][2] = other.data.m[2][2];
 		}
 	else
 		{
-		float tx, ty, tz;
-		tx = data.s._21;	data.s._21 = other.data.s._12;	data.s._12 = tx;
-		ty = data.s._31;	data.s._31 = other.data.s._13;	data.s._13 = ty;
-		tz = data.s._32;	data.s._32 = other.data.s._23;	data.s._23 = tz;
+		T tx, ty, tz;
+		tx = data.m[1][0];	data.m[1][0] = other.data.m[0][1];	data.m[0][1] = tx;
+		ty = data.m[2][0];	data.m[2][0] = other.data.m[0][2];	data.m[0][2] = ty;
+		tz = data.m[2][1];	data.m[2][1] = other.data.m[1][2];	data.m[1][2] = tz;
 		}
 	}
 
 
-SR_INLINE void SrMatrix33::setTransposed()
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::setTransposed()
 	{
-		float tempValue = data.s._21;data.s._21 = data.s._12; data.s._12 = tempValue;
-		tempValue = data.s._23;data.s._23 = data.s._32; data.s._32 = tempValue;
-		tempValue = data.s._13;data.s._13 = data.s._31; data.s._31 = tempValue;
+		T tempValue = data.m[1][0];data.m[1][0] = data.m[0][1]; data.m[0][1] = tempValue;
+		tempValue = data.m[1][2];data.m[1][2] = data.m[2][1]; data.m[2][1] = tempValue;
+		tempValue = data.m[0][2];data.m[0][2] = data.m[2][0]; data.m[2][0] = tempValue;
 	}
 
 
-SR_INLINE void SrMatrix33::multiplyDiagonal(const SrVector3 &d)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::multiplyDiagonal(const SrVector3T<T> &d)
 	{
-	data.s._11 *= d.x;
-	data.s._12 *= d.y;
-	data.s._13 *= d.z;
+	data.m[0][0] *= d.x;
+	data.m[0][1] *= d.y;
+	data.m[0][2] *= d.z;
 
-	data.s._21 *= d.x;
-	data.s._22 *= d.y;
-	data.s._23 *= d.z;
+	data.m[1][0] *= d.x;
+	data.m[1][1] *= d.y;
+	data.m[1][2] *= d.z;
 
-	data.s._31 *= d.x;
-	data.s._32 *= d.y;
-	data.s._33 *= d.z;
+	data.m[2][0] *= d.x;
+	data.m[2][1] *= d.y;
+	data.m[2][2] *= d.z;
 	}
 
 
-SR_INLINE void SrMatrix33::multiplyDiagonalTranspose(const SrVector3 &d)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::multiplyDiagonalTranspose(const SrVector3T<T> &d)
 	{
-		float temp;
-		data.s._11 = data.s._11 * d.x;
-		data.s._22 = data.s._22 * d.y;
-		data.s._33 = data.s._33 * d.z;
+		T temp;
+		data.m[0][0] = data.m[0][0] * d.x;
+		data.m[1][1] = data.m[1][1] * d.y;
+		data.m[2][2] = data.m[2][2] * d.z;
 
-		temp = data.s._21 * d.y;
-		data.s._21 = data.s._12 * d.x;
-		data.s._12 = temp;
+		temp = data.m[1][0] * d.y;
+		data.m[1][0] = data.m[0][1] * d.x;
+		data.m[0][1] = temp;
 
-		temp = data.s._31 * d.z;
-		data.s._31 = data.s._13 * d.x;
-		data.s._13 = temp;
+		temp = data.m[2][0] * d.z;
+		data.m[2][0] = data.m[0][2] * d.x;
+		data.m[0][2] = temp;
 		
-		temp = data.s._32 * d.z;
-		data.s._32 = data.s._23 * d.y;
-		data.s._23 = temp;
+		temp = data.m[2][1] * d.z;
+		data.m[2][1] = data.m[1][2] * d.y;
+		data.m[1][2] = temp;
 	}
 
 
-SR_INLINE void SrMatrix33::multiplyDiagonal(const SrVector3 &d, SrMatrix33& dst) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::multiplyDiagonal(const SrVector3T<T> &d, SrMatrix33T<T>& dst) const
 	{
-	dst.data.s._11 = data.s._11 * d.x;
-	dst.data.s._12 = data.s._12 * d.y;
-	dst.data.s._13 = data.s._13 * d.z;
+	dst.data.m[0][0] = data.m[0][0] * d.x;
+	dst.data.m[0][1] = data.m[0][1] * d.y;
+	dst.data.m[0][2] = data.m[0][2] * d.z;
 
-	dst.data.s._21 = data.s._21 * d.x;
-	dst.data.s._22 = data.s._22 * d.y;
-	dst.data.s._23 = data.s._23 * d.z;
+	dst.data.m[1][0] = data.m[1][0] * d.x;
+	dst.data.m[1][1] = data.m[1][1] * d.y;
+	dst.data.m[1][2] = data.m[1][2] * d.z;
 
-	dst.data.s._31 = data.s._31 * d.x;
-	dst.data.s._32 = data.s._32 * d.y;
-	dst.data.s._33 = data.s._33 * d.z;
+	dst.data.m[2][0] = data.m[2][0] * d.x;
+	dst.data.m[2][1] = data.m[2][1] * d.y;
+	dst.data.m[2][2] = data.m[2][2] * d.z;
 	}
 
 
-SR_INLINE void SrMatrix33::multiplyDiagonalTranspose(const SrVector3 &d, SrMatrix33& dst) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::multiplyDiagonalTranspose(const SrVector3T<T> &d, SrMatrix33T<T>& dst) const
 	{
-	dst.data.s._11 = data.s._11 * d.x;
-	dst.data.s._12 = data.s._21 * d.y;
-	dst.data.s._13 = data.s._31 * d.z;
+	dst.data.m[0][0] = data.m[0][0] * d.x;
+	dst.data.m[0][1] = data.m[1][0] * d.y;
+	dst.data.m[0][2] = data.m[2][0] * d.z;
 
-	dst.data.s._21 = data.s._12 * d.x;
-	dst.data.s._22 = data.s._22 * d.y;
-	dst.data.s._23 = data.s._32 * d.z;
+	dst.data.m[1][0] = data.m[0][1] * d.x;
+	dst.data.m[1][1] = data.m[1][1] * d.y;
+	dst.data.m[1][2] = data.m[2][1] * d.z;
 
-	dst.data.s._31 = data.s._13 * d.x;
-	dst.data.s._32 = data.s._23 * d.y;
-	dst.data.s._33 = data.s._33 * d.z;
+	dst.data.m[2][0] = data.m[0][2] * d.x;
+	dst.data.m[2][1] = data.m[1][2] * d.y;
+	dst.data.m[2][2] = data.m[2][2] * d.z;
 	}
 
 
-SR_INLINE void SrMatrix33::multiply(const SrVector3 &src, SrVector3 &dst) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::multiply(const SrVector3T<T> &src, SrVector3T<T> &dst) const
 	{
-	float x,y,z;	//so it works if src == dst
-	x = data.s._11 * src.x + data.s._12 * src.y + data.s._13 * src.z;
-	y = data.s._21 * src.x + data.s._22 * src.y + data.s._23 * src.z;
-	z = data.s._31 * src.x + data.s._32 * src.y + data.s._33 * src.z;
+	T x,y,z;	//so it works if src == dst
+	x = data.m[0][0] * src.x + data.m[0][1] * src.y + data.m[0][2] * src.z;
+	y = data.m[1][0] * src.x + data.m[1][1] * src.y + data.m[1][2] * src.z;
+	z = data.m[2][0] * src.x + data.m[2][1] * src.y + data.m[2][2] * src.z;
 
 	dst.x = x;
 	dst.y = y;
@@ -1357,12 +1429,13 @@ SR_INLINE void SrMatrix33::multiply(const SrVector3 &src, SrVector3 &dst) const
 	}
 
 
-SR_INLINE void SrMatrix33::multiplyByTranspose(const SrVector3 &src, SrVector3 &dst) const
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::multiplyByTranspose(const SrVector3T<T> &src, SrVector3T<T> &dst) const
 	{
-	float x,y,z;	//so it works if src == dst
-	x = data.s._11 * src.x + data.s._21 * src.y + data.s._31 * src.z;
-	y = data.s._12 * src.x + data.s._22 * src.y + data.s._32 * src.z;
-	z = data.s._13 * src.x + data.s._23 * src.y + data.s._33 * src.z;
+	T x,y,z;	//so it works if src == dst
+	x = data.m[0][0] * src.x + data.m[1][0] * src.y + data.m[2][0] * src.z;
+	y = data.m[0][1] * src.x + data.m[1][1] * src.y + data.m[2][1] * src.z;
+	z = data.m[0][2] * src.x + data.m[1][2] * src.y + data.m[2][2] * src.z;
 
 	dst.x = x;
 	dst.y = y;
@@ -1370,366 +1443,390 @@ SR_INLINE void SrMatrix33::multiplyByTranspose(const SrVector3 &src, SrVector3 &
 	}
 
 
-SR_INLINE void SrMatrix33::add(const SrMatrix33 & a, const SrMatrix33 & b)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::add(const SrMatrix33T<T> & a, const SrMatrix33T<T> & b)
 	{
-	data.s._11 = a.data.s._11 + b.data.s._11;
-	data.s._12 = a.data.s._12 + b.data.s._12;
-	data.s._13 = a.data.s._13 + b.data.s._13;
+	data.m[0][0] = a.data.m[0][0] + b.data.m[0][0];
+	data.m[0][1] = a.data.m[0][1] + b.data.m[0][1];
+	data.m[0][2] = a.data.m[0][2] + b.data.m[0][2];
 
-	data.s._21 = a.data.s._21 + b.data.s._21;
-	data.s._22 = a.data.s._22 + b.data.s._22;
-	data.s._23 = a.data.s._23 + b.data.s._23;
+	data.m[1][0] = a.data.m[1][0] + b.data.m[1][0];
+	data.m[1][1] = a.data.m[1][1] + b.data.m[1][1];
+	data.m[1][2] = a.data.m[1][2] + b.data.m[1][2];
 
-	data.s._31 = a.data.s._31 + b.data.s._31;
-	data.s._32 = a.data.s._32 + b.data.s._32;
-	data.s._33 = a.data.s._33 + b.data.s._33;
+	data.m[2][0] = a.data.m[2][0] + b.data.m[2][0];
+	data.m[2][1] = a.data.m[2][1] + b.data.m[2][1];
+	data.m[2][2] = a.data.m[2][2] + b.data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::subtract(const SrMatrix33 &a, const SrMatrix33 &b)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::subtract(const SrMatrix33T<T> &a, const SrMatrix33T<T> &b)
 	{
-	data.s._11 = a.data.s._11 - b.data.s._11;
-	data.s._12 = a.data.s._12 - b.data.s._12;
-	data.s._13 = a.data.s._13 - b.data.s._13;
+	data.m[0][0] = a.data.m[0][0] - b.data.m[0][0];
+	data.m[0][1] = a.data.m[0][1] - b.data.m[0][1];
+	data.m[0][2] = a.data.m[0][2] - b.data.m[0][2];
 
-	data.s._21 = a.data.s._21 - b.data.s._21;
-	data.s._22 = a.data.s._22 - b.data.s._22;
-	data.s._23 = a.data.s._23 - b.data.s._23;
+	data.m[1][0] = a.data.m[1][0] - b.data.m[1][0];
+	data.m[1][1] = a.data.m[1][1] - b.data.m[1][1];
+	data.m[1][2] = a.data.m[1][2] - b.data.m[1][2];
 
-	data.s._31 = a.data.s._31 - b.data.s._31;
-	data.s._32 = a.data.s._32 - b.data.s._32;
-	data.s._33 = a.data.s._33 - b.data.s._33;
+	data.m[2][0] = a.data.m[2][0] - b.data.m[2][0];
+	data.m[2][1] = a.data.m[2][1] - b.data.m[2][1];
+	data.m[2][2] = a.data.m[2][2] - b.data.m[2][2];
 	}
 
 
-SR_INLINE void SrMatrix33::multiply(float d,  const SrMatrix33 & a)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::multiply(T d,  const SrMatrix33T<T> & a)
 	{
-	data.s._11 = a.data.s._11 * d;
-	data.s._12 = a.data.s._12 * d;
-	data.s._13 = a.data.s._13 * d;
+	data.m[0][0] = a.data.m[0][0] * d;
+	data.m[0][1] = a.data.m[0][1] * d;
+	data.m[0][2] = a.data.m[0][2] * d;
 
-	data.s._21 = a.data.s._21 * d;
-	data.s._22 = a.data.s._22 * d;
-	data.s._23 = a.data.s._23 * d;
+	data.m[1][0] = a.data.m[1][0] * d;
+	data.m[1][1] = a.data.m[1][1] * d;
+	data.m[1][2] = a.data.m[1][2] * d;
 
-	data.s._31 = a.data.s._31 * d;
-	data.s._32 = a.data.s._32 * d;
-	data.s._33 = a.data.s._33 * d;
+	data.m[2][0] = a.data.m[2][0] * d;
+	data.m[2][1] = a.data.m[2][1] * d;
+	data.m[2][2] = a.data.m[2][2] * d;
 	}
 
 
-SR_INLINE void SrMatrix33::multiply(const SrMatrix33& left, const SrMatrix33& right)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::multiply(const SrMatrix33T<T>& left, const SrMatrix33T<T>& right)
 	{
-	float a,b,c, d,e,f, g,h,i;
+	T a,b,c, d,e,f, g,h,i;
 	//note: temps needed so that x.multiply(x,y) works OK.
-	a =left.data.s._11 * right.data.s._11 +left.data.s._12 * right.data.s._21 +left.data.s._13 * right.data.s._31;
-	b =left.data.s._11 * right.data.s._12 +left.data.s._12 * right.data.s._22 +left.data.s._13 * right.data.s._32;
-	c =left.data.s._11 * right.data.s._13 +left.data.s._12 * right.data.s._23 +left.data.s._13 * right.data.s._33;
+	a =left.data.m[0][0] * right.data.m[0][0] +left.data.m[0][1] * right.data.m[1][0] +left.data.m[0][2] * right.data.m[2][0];
+	b =left.data.m[0][0] * right.data.m[0][1] +left.data.m[0][1] * right.data.m[1][1] +left.data.m[0][2] * right.data.m[2][1];
+	c =left.data.m[0][0] * right.data.m[0][2] +left.data.m[0][1] * right.data.m[1][2] +left.data.m[0][2] * right.data.m[2][2];
 
-	d =left.data.s._21 * right.data.s._11 +left.data.s._22 * right.data.s._21 +left.data.s._23 * right.data.s._31;
-	e =left.data.s._21 * right.data.s._12 +left.data.s._22 * right.data.s._22 +left.data.s._23 * right.data.s._32;
-	f =left.data.s._21 * right.data.s._13 +left.data.s._22 * right.data.s._23 +left.data.s._23 * right.data.s._33;
+	d =left.data.m[1][0] * right.data.m[0][0] +left.data.m[1][1] * right.data.m[1][0] +left.data.m[1][2] * right.data.m[2][0];
+	e =left.data.m[1][0] * right.data.m[0][1] +left.data.m[1][1] * right.data.m[1][1] +left.data.m[1][2] * right.data.m[2][1];
+	f =left.data.m[1][0] * right.data.m[0][2] +left.data.m[1][1] * right.data.m[1][2] +left.data.m[1][2] * right.data.m[2][2];
 
-	g =left.data.s._31 * right.data.s._11 +left.data.s._32 * right.data.s._21 +left.data.s._33 * right.data.s._31;
-	h =left.data.s._31 * right.data.s._12 +left.data.s._32 * right.data.s._22 +left.data.s._33 * right.data.s._32;
-	i =left.data.s._31 * right.data.s._13 +left.data.s._32 * right.data.s._23 +left.data.s._33 * right.data.s._33;
+	g =left.data.m[2][0] * right.data.m[0][0] +left.data.m[2][1] * right.data.m[1][0] +left.data.m[2][2] * right.data.m[2][0];
+	h =left.data.m[2][0] * right.data.m[0][1] +left.data.m[2][1] * right.data.m[1][1] +left.data.m[2][2] * right.data.m[2][1];
+	i =left.data.m[2][0] * right.data.m[0][2] +left.data.m[2][1] * right.data.m[1][2] +left.data.m[2][2] * right.data.m[2][2];
 
 
-	data.s._11 = a;
-	data.s._12 = b;
-	data.s._13 = c;
+	data.m[0][0] = a;
+	data.m[0][1] = b;
+	data.m[0][2] = c;
 
-	data.s._21 = d;
-	data.s._22 = e;
-	data.s._23 = f;
+	data.m[1][0] = d;
+	data.m[1][1] = e;
+	data.m[1][2] = f;
 
-	data.s._31 = g;
-	data.s._32 = h;
-	data.s._33 = i;
+	data.m[2][0] = g;
+	data.m[2][1] = h;
+	data.m[2][2] = i;
 	}
 
 
-SR_INLINE void SrMatrix33::multiplyTransposeLeft(const SrMatrix33& left, const SrMatrix33& right)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::multiplyTransposeLeft(const SrMatrix33T<T>& left, const SrMatrix33T<T>& right)
 	{
-	float a,b,c, d,e,f, g,h,i;
+	T a,b,c, d,e,f, g,h,i;
 	//note: temps needed so that x.multiply(x,y) works OK.
-	a =left.data.s._11 * right.data.s._11 +left.data.s._21 * right.data.s._21 +left.data.s._31 * right.data.s._31;
-	b =left.data.s._11 * right.data.s._12 +left.data.s._21 * right.data.s._22 +left.data.s._31 * right.data.s._32;
-	c =left.data.s._11 * right.data.s._13 +left.data.s._21 * right.data.s._23 +left.data.s._31 * right.data.s._33;
+	a =left.data.m[0][0] * right.data.m[0][0] +left.data.m[1][0] * right.data.m[1][0] +left.data.m[2][0] * right.data.m[2][0];
+	b =left.data.m[0][0] * right.data.m[0][1] +left.data.m[1][0] * right.data.m[1][1] +left.data.m[2][0] * right.data.m[2][1];
+	c =left.data.m[0][0] * right.data.m[0][2] +left.data.m[1][0] * right.data.m[1][2] +left.data.m[2][0] * right.data.m[2][2];
 
-	d =left.data.s._12 * right.data.s._11 +left.data.s._22 * right.data.s._21 +left.data.s._32 * right.data.s._31;
-	e =left.data.s._12 * right.data.s._12 +left.data.s._22 * right.data.s._22 +left.data.s._32 * right.data.s._32;
-	f =left.data.s._12 * right.data.s._13 +left.data.s._22 * right.data.s._23 +left.data.s._32 * right.data.s._33;
+	d =left.data.m[0][1] * right.data.m[0][0] +left.data.m[1][1] * right.data.m[1][0] +left.data.m[2][1] * right.data.m[2][0];
+	e =left.data.m[0][1] * right.data.m[0][1] +left.data.m[1][1] * right.data.m[1][1] +left.data.m[2][1] * right.data.m[2][1];
+	f =left.data.m[0][1] * right.data.m[0][2] +left.data.m[1][1] * right.data.m[1][2] +left.data.m[2][1] * right.data.m[2][2];
 
-	g =left.data.s._13 * right.data.s._11 +left.data.s._23 * right.data.s._21 +left.data.s._33 * right.data.s._31;
-	h =left.data.s._13 * right.data.s._12 +left.data.s._23 * right.data.s._22 +left.data.s._33 * right.data.s._32;
-	i =left.data.s._13 * right.data.s._13 +left.data.s._23 * right.data.s._23 +left.data.s._33 * right.data.s._33;
+	g =left.data.m[0][2] * right.data.m[0][0] +left.data.m[1][2] * right.data.m[1][0] +left.data.m[2][2] * right.data.m[2][0];
+	h =left.data.m[0][2] * right.data.m[0][1] +left.data.m[1][2] * right.data.m[1][1] +left.data.m[2][2] * right.data.m[2][1];
+	i =left.data.m[0][2] * right.data.m[0][2] +left.data.m[1][2] * right.data.m[1][2] +left.data.m[2][2] * right.data.m[2][2];
 
-	data.s._11 = a;
-	data.s._12 = b;
-	data.s._13 = c;
+	data.m[0][0] = a;
+	data.m[0][1] = b;
+	data.m[0][2] = c;
 
-	data.s._21 = d;
-	data.s._22 = e;
-	data.s._23 = f;
+	data.m[1][0] = d;
+	data.m[1][1] = e;
+	data.m[1][2] = f;
 
-	data.s._31 = g;
-	data.s._32 = h;
-	data.s._33 = i;
+	data.m[2][0] = g;
+	data.m[2][1] = h;
+	data.m[2][2] = i;
 	}
 
 
-SR_INLINE void SrMatrix33::multiplyTransposeRight(const SrMatrix33& left, const SrMatrix33& right)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::multiplyTransposeRight(const SrMatrix33T<T>& left, const SrMatrix33T<T>& right)
 	{
-	float a,b,c, d,e,f, g,h,i;
+	T a,b,c, d,e,f, g,h,i;
 	//note: temps needed so that x.multiply(x,y) works OK.
-	a =left.data.s._11 * right.data.s._11 +left.data.s._12 * right.data.s._12 +left.data.s._13 * right.data.s._13;
-	b =left.data.s._11 * right.data.s._21 +left.data.s._12 * right.data.s._22 +left.data.s._13 * right.data.s._23;
-	c =left.data.s._11 * right.data.s._31 +left.data.s._12 * right.data.s._32 +left.data.s._13 * right.data.s._33;
+	a =left.data.m[0][0] * right.data.m[0][0] +left.data.m[0][1] * right.data.m[0][1] +left.data.m[0][2] * right.data.m[0][2];
+	b =left.data.m[0][0] * right.data.m[1][0] +left.data.m[0][1] * right.data.m[1][1] +left.data.m[0][2] * right.data.m[1][2];
+	c =left.data.m[0][0] * right.data.m[2][0] +left.data.m[0][1] * right.data.m[2][1] +left.data.m[0][2] * right.data.m[2][2];
 
-	d =left.data.s._21 * right.data.s._11 +left.data.s._22 * right.data.s._12 +left.data.s._23 * right.data.s._13;
-	e =left.data.s._21 * right.data.s._21 +left.data.s._22 * right.data.s._22 +left.data.s._23 * right.data.s._23;
-	f =left.data.s._21 * right.data.s._31 +left.data.s._22 * right.data.s._32 +left.data.s._23 * right.data.s._33;
+	d =left.data.m[1][0] * right.data.m[0][0] +left.data.m[1][1] * right.data.m[0][1] +left.data.m[1][2] * right.data.m[0][2];
+	e =left.data.m[1][0] * right.data.m[1][0] +left.data.m[1][1] * right.data.m[1][1] +left.data.m[1][2] * right.data.m[1][2];
+	f =left.data.m[1][0] * right.data.m[2][0] +left.data.m[1][1] * right.data.m[2][1] +left.data.m[1][2] * right.data.m[2][2];
 
-	g =left.data.s._31 * right.data.s._11 +left.data.s._32 * right.data.s._12 +left.data.s._33 * right.data.s._13;
-	h =left.data.s._31 * right.data.s._21 +left.data.s._32 * right.data.s._22 +left.data.s._33 * right.data.s._23;
-	i =left.data.s._31 * right.data.s._31 +left.data.s._32 * right.data.s._32 +left.data.s._33 * right.data.s._33;
+	g =left.data.m[2][0] * right.data.m[0][0] +left.data.m[2][1] * right.data.m[0][1] +left.data.m[2][2] * right.data.m[0][2];
+	h =left.data.m[2][0] * right.data.m[1][0] +left.data.m[2][1] * right.data.m[1][1] +left.data.m[2][2] * right.data.m[1][2];
+	i =left.data.m[2][0] * right.data.m[2][0] +left.data.m[2][1] * right.data.m[2][1] +left.data.m[2][2] * right.data.m[2][2];
 
-	data.s._11 = a;
-	data.s._12 = b;
-	data.s._13 = c;
+	data.m[0][0] = a;
+	data.m[0][1] = b;
+	data.m[0][2] = c;
 
-	data.s._21 = d;
-	data.s._22 = e;
-	data.s._23 = f;
+	data.m[1][0] = d;
+	data.m[1][1] = e;
+	data.m[1][2] = f;
 
-	data.s._31 = g;
-	data.s._32 = h;
-	data.s._33 = i;
+	data.m[2][0] = g;
+	data.m[2][1] = h;
+	data.m[2][2] = i;
 	}
 
 
-SR_INLINE void SrMatrix33::multiplyTransposeRight(const SrVector3 &left, const SrVector3 &right)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::multiplyTransposeRight(const SrVector3T<T> &left, const SrVector3T<T> &right)
 	{
-	data.s._11 = left.x * right.x;
-	data.s._12 = left.x * right.y;
-	data.s._13 = left.x * right.z;
+	data.m[0][0] = left.x * right.x;
+	data.m[0][1] = left.x * right.y;
+	data.m[0][2] = left.x * right.z;
 
-	data.s._21 = left.y * right.x;
-	data.s._22 = left.y * right.y;
-	data.s._23 = left.y * right.z;
+	data.m[1][0] = left.y * right.x;
+	data.m[1][1] = left.y * right.y;
+	data.m[1][2] = left.y * right.z;
 
-	data.s._31 = left.z * right.x;
-	data.s._32 = left.z * right.y;
-	data.s._33 = left.z * right.z;
+	data.m[2][0] = left.z * right.x;
+	data.m[2][1] = left.z * right.y;
+	data.m[2][2] = left.z * right.z;
 	}
 
-SR_INLINE void SrMatrix33::rotX(float angle)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::rotX(T angle)
 	{
-	float Cos = cosf(angle);
-	float Sin = sinf(angle);
+	T Cos = SrMath::cos(angle);
+	T Sin = SrMath::sin(angle);
 	id();
 	data.m[1][1] = data.m[2][2] = Cos;
 	data.m[1][2] = -Sin;
 	data.m[2][1] = Sin;
 	}
 
-SR_INLINE void SrMatrix33::rotY(float angle)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::rotY(T angle)
 	{
-	float Cos = cosf(angle);
-	float Sin = sinf(angle);
+	T Cos = SrMath::cos(angle);
+	T Sin = SrMath::sin(angle);
 	id();
 	data.m[0][0] = data.m[2][2] = Cos;
 	data.m[0][2] = Sin;
 	data.m[2][0] = -Sin;
 	}
 
-SR_INLINE void SrMatrix33::rotZ(float angle)
+template<class T>
+SR_CONSTEXPR void SrMatrix33T<T>::rotZ(T angle)
 	{
-	float Cos = cosf(angle);
-	float Sin = sinf(angle);
+	T Cos = SrMath::cos(angle);
+	T Sin = SrMath::sin(angle);
 	id();
 	data.m[0][0] = data.m[1][1] = Cos;
 	data.m[0][1] = -Sin;
 	data.m[1][0] = Sin;
 	}
 
-SR_INLINE SrVector3  SrMatrix33::operator%(const SrVector3 & src) const
+template<class T>
+SR_CONSTEXPR SrVector3T<T>  SrMatrix33T<T>::operator%(const SrVector3T<T> & src) const
 	{
-	SrVector3 dest;
+	SrVector3T<T> dest;
 	this->multiplyByTranspose(src, dest);
 	return dest;
 	}
 
 
-SR_INLINE SrVector3  SrMatrix33::operator*(const SrVector3 & src) const
+template<class T>
+SR_CONSTEXPR SrVector3T<T>  SrMatrix33T<T>::operator*(const SrVector3T<T> & src) const
 	{
-	SrVector3 dest;
+	SrVector3T<T> dest;
 	this->multiply(src, dest);
 	return dest;
 	}
 
 
-SR_INLINE const SrMatrix33 &SrMatrix33::operator +=(const SrMatrix33 &d)
+template<class T>
+SR_CONSTEXPR const SrMatrix33T<T> &SrMatrix33T<T>::operator +=(const SrMatrix33T<T> &d)
 	{
-	data.s._11 += d.data.s._11;
-	data.s._12 += d.data.s._12;
-	data.s._13 += d.data.s._13;
+	data.m[0][0] += d.data.m[0][0];
+	data.m[0][1] += d.data.m[0][1];
+	data.m[0][2] += d.data.m[0][2];
 
-	data.s._21 += d.data.s._21;
-	data.s._22 += d.data.s._22;
-	data.s._23 += d.data.s._23;
+	data.m[1][0] += d.data.m[1][0];
+	data.m[1][1] += d.data.m[1][1];
+	data.m[1][2] += d.data.m[1][2];
 
-	data.s._31 += d.data.s._31;
-	data.s._32 += d.data.s._32;
-	data.s._33 += d.data.s._33;
+	data.m[2][0] += d.data.m[2][0];
+	data.m[2][1] += d.data.m[2][1];
+	data.m[2][2] += d.data.m[2][2];
 	return *this;
 	}
 
 
-SR_INLINE const SrMatrix33 &SrMatrix33::operator -=(const SrMatrix33 &d)
+template<class T>
+SR_CONSTEXPR const SrMatrix33T<T> &SrMatrix33T<T>::operator -=(const SrMatrix33T<T> &d)
 	{
-	data.s._11 -= d.data.s._11;
-	data.s._12 -= d.data.s._12;
-	data.s._13 -= d.data.s._13;
+	data.m[0][0] -= d.data.m[0][0];
+	data.m[0][1] -= d.data.m[0][1];
+	data.m[0][2] -= d.data.m[0][2];
 
-	data.s._21 -= d.data.s._21;
-	data.s._22 -= d.data.s._22;
-	data.s._23 -= d.data.s._23;
+	data.m[1][0] -= d.data.m[1][0];
+	data.m[1][1] -= d.data.m[1][1];
+	data.m[1][2] -= d.data.m[1][2];
 
-	data.s._31 -= d.data.s._31;
-	data.s._32 -= d.data.s._32;
-	data.s._33 -= d.data.s._33;
+	data.m[2][0] -= d.data.m[2][0];
+	data.m[2][1] -= d.data.m[2][1];
+	data.m[2][2] -= d.data.m[2][2];
 	return *this;
 	}
 
 
-SR_INLINE const SrMatrix33 &SrMatrix33::operator *=(float f)
+template<class T>
+SR_CONSTEXPR const SrMatrix33T<T> &SrMatrix33T<T>::operator *=(T f)
 	{
-	data.s._11 *= f;
-	data.s._12 *= f;
-	data.s._13 *= f;
+	data.m[0][0] *= f;
+	data.m[0][1] *= f;
+	data.m[0][2] *= f;
 
-	data.s._21 *= f;
-	data.s._22 *= f;
-	data.s._23 *= f;
+	data.m[1][0] *= f;
+	data.m[1][1] *= f;
+	data.m[1][2] *= f;
 
-	data.s._31 *= f;
-	data.s._32 *= f;
-	data.s._33 *= f;
+	data.m[2][0] *= f;
+	data.m[2][1] *= f;
+	data.m[2][2] *= f;
 	return *this;
 	}
 
 
-SR_INLINE const SrMatrix33 &SrMatrix33::operator /=(float x)
+template<class T>
+SR_CONSTEXPR const SrMatrix33T<T> &SrMatrix33T<T>::operator /=(T x)
 	{
-	float f = float(1.0) / x;
-	data.s._11 *= f;
-	data.s._12 *= f;
-	data.s._13 *= f;
+	T f = T(1.0) / x;
+	data.m[0][0] *= f;
+	data.m[0][1] *= f;
+	data.m[0][2] *= f;
 
-	data.s._21 *= f;
-	data.s._22 *= f;
-	data.s._23 *= f;
+	data.m[1][0] *= f;
+	data.m[1][1] *= f;
+	data.m[1][2] *= f;
 
-	data.s._31 *= f;
-	data.s._32 *= f;
-	data.s._33 *= f;
+	data.m[2][0] *= f;
+	data.m[2][1] *= f;
+	data.m[2][2] *= f;
 	return *this;
 	}
 
 
-SR_INLINE float SrMatrix33::determinant() const
+template<class T>
+SR_CONSTEXPR T SrMatrix33T<T>::determinant() const
 	{
-	return  data.s._11*data.s._22*data.s._33 + data.s._12*data.s._23*data.s._31 + data.s._13*data.s._21*data.s._32 
-		  - data.s._13*data.s._22*data.s._31 - data.s._12*data.s._21*data.s._33 - data.s._11*data.s._23*data.s._32;
+	return  data.m[0][0]*data.m[1][1]*data.m[2][2] + data.m[0][1]*data.m[1][2]*data.m[2][0] + data.m[0][2]*data.m[1][0]*data.m[2][1] 
+		  - data.m[0][2]*data.m[1][1]*data.m[2][0] - data.m[0][1]*data.m[1][0]*data.m[2][2] - data.m[0][0]*data.m[1][2]*data.m[2][1];
 	}
 
 
-SR_INLINE bool SrMatrix33::getInverse(SrMatrix33& dest) const
+template<class T>
+SR_CONSTEXPR bool SrMatrix33T<T>::getInverse(SrMatrix33T<T>& dest) const
 	{
-	float b00,b01,b02,b10,b11,b12,b20,b21,b22;
+	T b00,b01,b02,b10,b11,b12,b20,b21,b22;
 
-	b00 = data.s._22*data.s._33-data.s._23*data.s._32;	b01 = data.s._13*data.s._32-data.s._12*data.s._33;	b02 = data.s._12*data.s._23-data.s._13*data.s._22;
-	b10 = data.s._23*data.s._31-data.s._21*data.s._33;	b11 = data.s._11*data.s._33-data.s._13*data.s._31;	b12 = data.s._13*data.s._21-data.s._11*data.s._23;
-	b20 = data.s._21*data.s._32-data.s._22*data.s._31;	b21 = data.s._12*data.s._31-data.s._11*data.s._32;	b22 = data.s._11*data.s._22-data.s._12*data.s._21;
+	b00 = data.m[1][1]*data.m[2][2]-data.m[1][2]*data.m[2][1];	b01 = data.m[0][2]*data.m[2][1]-data.m[0][1]*data.m[2][2];	b02 = data.m[0][1]*data.m[1][2]-data.m[0][2]*data.m[1][1];
+	b10 = data.m[1][2]*data.m[2][0]-data.m[1][0]*data.m[2][2];	b11 = data.m[0][0]*data.m[2][2]-data.m[0][2]*data.m[2][0];	b12 = data.m[0][2]*data.m[1][0]-data.m[0][0]*data.m[1][2];
+	b20 = data.m[1][0]*data.m[2][1]-data.m[1][1]*data.m[2][0];	b21 = data.m[0][1]*data.m[2][0]-data.m[0][0]*data.m[2][1];	b22 = data.m[0][0]*data.m[1][1]-data.m[0][1]*data.m[1][0];
 	
 
 
 	/*
 	compute determinant: 
-	float d =   a00*a11*a22 + a01*a12*a20 + a02*a10*a21	- a02*a11*a20 - a01*a10*a22 - a00*a12*a21;
+	T d =   a00*a11*a22 + a01*a12*a20 + a02*a10*a21	- a02*a11*a20 - a01*a10*a22 - a00*a12*a21;
 				0				1			2			3				4			5
 
 	this is a subset of the multiplies done above:
 
-	float d = b00*a00				+		b01*a10						 + b02 * a20;
-	float d = (a11*a22-a12*a21)*a00 +		(a02*a21-a01*a22)*a10		 + (a01*a12-a02*a11) * a20;
+	T d = b00*a00				+		b01*a10						 + b02 * a20;
+	T d = (a11*a22-a12*a21)*a00 +		(a02*a21-a01*a22)*a10		 + (a01*a12-a02*a11) * a20;
 
-	float d = a11*a22*a00-a12*a21*a00 +		a02*a21*a10-a01*a22*a10		 + a01*a12*a20-a02*a11*a20;
+	T d = a11*a22*a00-a12*a21*a00 +		a02*a21*a10-a01*a22*a10		 + a01*a12*a20-a02*a11*a20;
 			0			5					2			4					1			3
 	*/
 
-	float d = b00*data.s._11		+		b01*data.s._21				 + b02 * data.s._31;
+	T d = b00*data.m[0][0]		+		b01*data.m[1][0]				 + b02 * data.m[2][0];
 	
-	if (d == float(0.0))		//singular?
+	if (d == T(0.0))		//singular?
 		{
 		dest.id();
 		return false;
 		}
 	
-	d = float(1.0)/d;
+	d = T(1.0)/d;
 
 	//only do assignment at the end, in case dest == this:
 
 
-	dest.data.s._11 = b00*d; dest.data.s._12 = b01*d; dest.data.s._13 = b02*d;
-	dest.data.s._21 = b10*d; dest.data.s._22 = b11*d; dest.data.s._23 = b12*d;
-	dest.data.s._31 = b20*d; dest.data.s._32 = b21*d; dest.data.s._33 = b22*d;
+	dest.data.m[0][0] = b00*d; dest.data.m[0][1] = b01*d; dest.data.m[0][2] = b02*d;
+	dest.data.m[1][0] = b10*d; dest.data.m[1][1] = b11*d; dest.data.m[1][2] = b12*d;
+	dest.data.m[2][0] = b20*d; dest.data.m[2][1] = b21*d; dest.data.m[2][2] = b22*d;
 
 	return true;
 	}
 
 
-SR_INLINE SrMatrix33&	SrMatrix33::operator*= (const SrMatrix33& mat)
+template<class T>
+SR_CONSTEXPR SrMatrix33T<T>&	SrMatrix33T<T>::operator*= (const SrMatrix33T<T>& mat)
 	{
 	this->multiply(*this, mat);
 	return *this;
 	}
 
 
-SR_INLINE SrMatrix33	SrMatrix33::operator-  (const SrMatrix33& mat)	const
+template<class T>
+SR_CONSTEXPR SrMatrix33T<T>	SrMatrix33T<T>::operator-  (const SrMatrix33T<T>& mat)	const
 	{
-	SrMatrix33 temp;
+	SrMatrix33T<T> temp;
 	temp.subtract(*this, mat);
 	return temp;
 	}
 
 
-SR_INLINE SrMatrix33	SrMatrix33::operator+  (const SrMatrix33& mat)	const
+template<class T>
+SR_CONSTEXPR SrMatrix33T<T>	SrMatrix33T<T>::operator+  (const SrMatrix33T<T>& mat)	const
 	{
-	SrMatrix33 temp;
+	SrMatrix33T<T> temp;
 	temp.add(*this, mat);
 	return temp;
 	}
 
 
-SR_INLINE SrMatrix33	SrMatrix33::operator*  (const SrMatrix33& mat)	const
+template<class T>
+SR_CONSTEXPR SrMatrix33T<T>	SrMatrix33T<T>::operator*  (const SrMatrix33T<T>& mat)	const
 	{
-	SrMatrix33 temp;
+	SrMatrix33T<T> temp;
 	temp.multiply(*this, mat);
 	return temp;
 	}
 
 
-SR_INLINE SrMatrix33	SrMatrix33::operator*  (float s)			const
+template<class T>
+SR_CONSTEXPR SrMatrix33T<T>	SrMatrix33T<T>::operator*  (T s)			const
 	{
-	SrMatrix33 temp;
+	SrMatrix33T<T> temp;
 	temp.multiply(s, *this);
 	return temp;
 	}
 
-SR_INLINE SrQuaternion::SrQuaternion(const class SrMatrix33 &m)
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T>::SrQuaternionT(const SrMatrix33T<T> &m)
 {
 	m.toQuat(*this);
 }
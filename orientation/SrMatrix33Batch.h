@@ -0,0 +1,439 @@
+/************************************************************************
+\file 	SrMatrix33Batch.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRMATRIX33BATCH_H_
+#define SR_FOUNDATION_SRMATRIX33BATCH_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include "SrSimd.h"
+#include "SrSimdDispatch.h"
+#include "SrMatrix33SoA.h"
+#include "SrQuaternionSoA.h"
+
+/**
+\brief Static class with batch versions of SrMatrix33::fromQuat() and SrMatrix33::toQuat().
+
+SrMatrix33::toQuat() branches on the trace and then on the largest diagonal element,
+which mispredicts badly on mixed rotation sets. The batch version evaluates the same
+case selection with SIMD compares, takes a single square root of the selected radicand
+and blends the results, so every lane runs the same branch free code. Since the
+selected case is exactly the scalar one, the results agree with the scalar path to
+rounding, including the rotations close to 180 degrees where the trace is near -1.
+
+Both AoS arrays of SrMatrix33 / SrQuaternion and the SrMatrix33SoA / SrQuaternionSoA
+containers are accepted. Matrices are assumed to be rotations and quaternions unit length.
+Elements that do not fill a whole register run the same register code on SrSimdScalar.
+*/
+class SrMatrix33Batch
+	{
+	public:
+	/**
+	\brief dst[i].fromQuat(src[i]) for the n quaternions.
+	*/
+	SR_INLINE static void fromQuat(const SrQuaternion* src, SrMatrix33* dst, SrU32 n);
+
+	/**
+	\brief src[i].toQuat(dst[i]) for the n matrices.
+	*/
+	SR_INLINE static void toQuat(const SrMatrix33* src, SrQuaternion* dst, SrU32 n);
+
+	/**
+	\brief SoA versions, dst is resized to src.size().
+	*/
+	SR_INLINE static void fromQuat(const SrQuaternionSoA& src, SrMatrix33SoA& dst);
+	SR_INLINE static void toQuat(const SrMatrix33SoA& src, SrQuaternionSoA& dst);
+
+	/**
+	\brief dst[i].multiply(a[i], b[i]) for the n matrices, dst may be a or b.
+	*/
+	SR_INLINE static void multiply(const SrMatrix33* a, const SrMatrix33* b, SrMatrix33* dst, SrU32 n);
+
+	/**
+	\brief SoA version, dst is resized to a.size().
+	*/
+	SR_INLINE static void multiply(const SrMatrix33SoA& a, const SrMatrix33SoA& b, SrMatrix33SoA& dst);
+
+	/**
+	\brief register level conversions, same formulas as the SrMatrix33 members.
+	*/
+	template<class V>
+	SR_INLINE static void quatToMatrix(typename V::Float qx, typename V::Float qy, typename V::Float qz, typename V::Float qw,
+									   typename V::Float m[3][3]);
+	template<class V>
+	SR_INLINE static void matrixToQuat(const typename V::Float m[3][3],
+									   typename V::Float& qx, typename V::Float& qy, typename V::Float& qz, typename V::Float& qw);
+	template<class V>
+	SR_INLINE static void multiply(const typename V::Float a[3][3], const typename V::Float b[3][3], typename V::Float dst[3][3]);
+
+	template<class V>
+	SR_INLINE static void fromQuatAoS(const SrQuaternion* src, SrMatrix33* dst, SrU32 n);
+	template<class V>
+	SR_INLINE static void toQuatAoS(const SrMatrix33* src, SrQuaternion* dst, SrU32 n);
+	template<class V>
+	SR_INLINE static void fromQuatLanes(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+										SrF32* const m[3][3], SrU32 n);
+	template<class V>
+	SR_INLINE static void toQuatLanes(const SrF32* const m[3][3],
+									  SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n);
+	template<class V>
+	SR_INLINE static void multiplyAoS(const SrMatrix33* a, const SrMatrix33* b, SrMatrix33* dst, SrU32 n);
+	template<class V>
+	SR_INLINE static void multiplyLanes(const SrF32* const a[3][3], const SrF32* const b[3][3], SrF32* const dst[3][3], SrU32 n);
+	};
+
+/**
+\brief The SrMatrix33Batch kernels of one SrSimd set, the table SR_SIMD_KERNEL() calls through
+with SR_SIMD_DISPATCH.
+*/
+struct SrMatrix33BatchKernels
+	{
+	void (*mat33FromQuatAoS)(const SrQuaternion* src, SrMatrix33* dst, SrU32 n);
+	void (*mat33ToQuatAoS)(const SrMatrix33* src, SrQuaternion* dst, SrU32 n);
+	void (*mat33FromQuatLanes)(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw, SrF32* const m[3][3], SrU32 n);
+	void (*mat33ToQuatLanes)(const SrF32* const m[3][3], SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n);
+	void (*mat33MultiplyAoS)(const SrMatrix33* a, const SrMatrix33* b, SrMatrix33* dst, SrU32 n);
+	void (*mat33MultiplyLanes)(const SrF32* const a[3][3], const SrF32* const b[3][3], SrF32* const dst[3][3], SrU32 n);
+
+	/**
+	\brief The table of the set V, see SrSimdDispatch.h.
+	*/
+	template<class V>
+	class Table
+		{
+		public:
+		static SrMatrix33BatchKernels create()
+			{
+			SrMatrix33BatchKernels k;
+			k.mat33FromQuatAoS = mat33FromQuatAoS;
+			k.mat33ToQuatAoS = mat33ToQuatAoS;
+			k.mat33FromQuatLanes = mat33FromQuatLanes;
+			k.mat33ToQuatLanes = mat33ToQuatLanes;
+			k.mat33MultiplyAoS = mat33MultiplyAoS;
+			k.mat33MultiplyLanes = mat33MultiplyLanes;
+			return k;
+			}
+
+		private:
+		SR_SIMD_FLATTEN static void mat33FromQuatAoS(const SrQuaternion* src, SrMatrix33* dst, SrU32 n)
+			{
+			SrMatrix33Batch::fromQuatAoS<V>(src, dst, n);
+			}
+
+		SR_SIMD_FLATTEN static void mat33ToQuatAoS(const SrMatrix33* src, SrQuaternion* dst, SrU32 n)
+			{
+			SrMatrix33Batch::toQuatAoS<V>(src, dst, n);
+			}
+
+		SR_SIMD_FLATTEN static void mat33FromQuatLanes(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw, SrF32* const m[3][3], SrU32 n)
+			{
+			SrMatrix33Batch::fromQuatLanes<V>(qx, qy, qz, qw, m, n);
+			}
+
+		SR_SIMD_FLATTEN static void mat33ToQuatLanes(const SrF32* const m[3][3], SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n)
+			{
+			SrMatrix33Batch::toQuatLanes<V>(m, qx, qy, qz, qw, n);
+			}
+
+		SR_SIMD_FLATTEN static void mat33MultiplyAoS(const SrMatrix33* a, const SrMatrix33* b, SrMatrix33* dst, SrU32 n)
+			{
+			SrMatrix33Batch::multiplyAoS<V>(a, b, dst, n);
+			}
+
+		SR_SIMD_FLATTEN static void mat33MultiplyLanes(const SrF32* const a[3][3], const SrF32* const b[3][3], SrF32* const dst[3][3], SrU32 n)
+			{
+			SrMatrix33Batch::multiplyLanes<V>(a, b, dst, n);
+			}
+		};
+	};
+
+
+template<class V>
+SR_INLINE void SrMatrix33Batch::quatToMatrix(typename V::Float qx, typename V::Float qy, typename V::Float qz, typename V::Float qw,
+											 typename V::Float m[3][3])
+	{
+	const typename V::Float one = V::splat(1.0f);
+	const typename V::Float x2 = V::add(qx, qx);
+	const typename V::Float y2 = V::add(qy, qy);
+	const typename V::Float z2 = V::add(qz, qz);
+
+	const typename V::Float xx = V::mul(qx, x2), yy = V::mul(qy, y2), zz = V::mul(qz, z2);
+	const typename V::Float xy = V::mul(qx, y2), xz = V::mul(qx, z2), yz = V::mul(qy, z2);
+	const typename V::Float wx = V::mul(qw, x2), wy = V::mul(qw, y2), wz = V::mul(qw, z2);
+
+	m[0][0] = V::sub(V::sub(one, yy), zz);
+	m[0][1] = V::sub(xy, wz);
+	m[0][2] = V::add(xz, wy);
+
+	m[1][0] = V::add(xy, wz);
+	m[1][1] = V::sub(V::sub(one, xx), zz);
+	m[1][2] = V::sub(yz, wx);
+
+	m[2][0] = V::sub(xz, wy);
+	m[2][1] = V::add(yz, wx);
+	m[2][2] = V::sub(V::sub(one, xx), yy);
+	}
+
+template<class V>
+SR_INLINE void SrMatrix33Batch::matrixToQuat(const typename V::Float m[3][3],
+											 typename V::Float& qx, typename V::Float& qy, typename V::Float& qz, typename V::Float& qw)
+	{
+	const typename V::Float half = V::splat(0.5f);
+	const typename V::Float tr = V::add(V::add(m[0][0], m[1][1]), m[2][2]);
+
+	//the case selection of SrMatrix33::toQuat(): the trace if it is not negative, otherwise
+	//the largest diagonal element, where ties go to the lower index.
+	const typename V::Mask caseW = V::cmpGe(tr, V::zero());
+	const typename V::Mask caseY = V::cmpGt(m[1][1], m[0][0]);
+	const typename V::Mask caseZ = V::cmpGt(m[2][2], V::select(caseY, m[1][1], m[0][0]));
+
+	const typename V::Float dx = V::sub(m[0][0], V::add(m[1][1], m[2][2]));
+	const typename V::Float dy = V::sub(m[1][1], V::add(m[2][2], m[0][0]));
+	const typename V::Float dz = V::sub(m[2][2], V::add(m[0][0], m[1][1]));
+	const typename V::Float d = V::select(caseW, tr, V::select(caseZ, dz, V::select(caseY, dy, dx)));
+
+	//one square root and one division for whichever case was picked.
+	const typename V::Float s = V::sqrt(V::add(d, V::splat(1.0f)));
+	const typename V::Float big = V::mul(half, s);
+	const typename V::Float inv = V::div(half, s);
+
+	const typename V::Float a = V::mul(V::sub(m[2][1], m[1][2]), inv);
+	const typename V::Float b = V::mul(V::sub(m[0][2], m[2][0]), inv);
+	const typename V::Float c = V::mul(V::sub(m[1][0], m[0][1]), inv);
+	const typename V::Float p = V::mul(V::add(m[0][1], m[1][0]), inv);
+	const typename V::Float q = V::mul(V::add(m[2][0], m[0][2]), inv);
+	const typename V::Float r = V::mul(V::add(m[1][2], m[2][1]), inv);
+
+	//		trace	x		y		z
+	//	x	a		big		p		q
+	//	y	b		p		big		r
+	//	z	c		q		r		big
+	//	w	big		a		b		c
+	qx = V::select(caseW, a, V::select(caseZ, q, V::select(caseY, p, big)));
+	qy = V::select(caseW, b, V::select(caseZ, r, V::select(caseY, big, p)));
+	qz = V::select(caseW, c, V::select(caseZ, big, V::select(caseY, r, q)));
+	qw = V::select(caseW, big, V::select(caseZ, c, V::select(caseY, b, a)));
+	}
+
+template<class V>
+SR_INLINE void SrMatrix33Batch::multiply(const typename V::Float a[3][3], const typename V::Float b[3][3], typename V::Float dst[3][3])
+	{
+	//dst must not be a or b.
+	for(int r = 0; r < 3; r++)
+		for(int c = 0; c < 3; c++)
+			dst[r][c] = V::madd(a[r][0], b[0][c], V::madd(a[r][1], b[1][c], V::mul(a[r][2], b[2][c])));
+	}
+
+template<class V>
+SR_INLINE void SrMatrix33Batch::fromQuatAoS(const SrQuaternion* src, SrMatrix33* dst, SrU32 n)
+	{
+	//SrQuaternion is 4 floats and SrMatrix33 is 9 row major floats.
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float qx, qy, qz, qw;
+		V::loadTransposed4(&src[i].x, 4, qx, qy, qz, qw);
+		typename V::Float m[3][3];
+		quatToMatrix<V>(qx, qy, qz, qw, m);
+		SrF32* d = &dst[i](0, 0);
+		for(int r = 0; r < 3; r++)
+			V::storeTransposed3(d + 3 * r, 9, m[r][0], m[r][1], m[r][2]);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 m[3][3];
+		quatToMatrix<SrSimdScalar>(src[i].x, src[i].y, src[i].z, src[i].w, m);
+		for(int r = 0; r < 3; r++)
+			for(int c = 0; c < 3; c++)
+				dst[i](r, c) = m[r][c];
+		}
+	}
+
+template<class V>
+SR_INLINE void SrMatrix33Batch::toQuatAoS(const SrMatrix33* src, SrQuaternion* dst, SrU32 n)
+	{
+	//the row loads read one float past each row, so the last matrix is left to the tail.
+	SrU32 i = 0;
+	for(; i + V::Width < n; i += V::Width)
+		{
+		const SrF32* s = &src[i](0, 0);
+		typename V::Float m[3][3];
+		for(int r = 0; r < 3; r++)
+			V::loadTransposed3(s + 3 * r, 9, m[r][0], m[r][1], m[r][2]);
+		typename V::Float qx, qy, qz, qw;
+		matrixToQuat<V>(m, qx, qy, qz, qw);
+		V::storeTransposed4(&dst[i].x, 4, qx, qy, qz, qw);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 m[3][3];
+		for(int r = 0; r < 3; r++)
+			for(int c = 0; c < 3; c++)
+				m[r][c] = src[i](r, c);
+		matrixToQuat<SrSimdScalar>(m, dst[i].x, dst[i].y, dst[i].z, dst[i].w);
+		}
+	}
+
+template<class V>
+SR_INLINE void SrMatrix33Batch::fromQuatLanes(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+											  SrF32* const m[3][3], SrU32 n)
+	{
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float r[3][3];
+		quatToMatrix<V>(V::load(qx + i), V::load(qy + i), V::load(qz + i), V::load(qw + i), r);
+		for(int j = 0; j < 3; j++)
+			for(int k = 0; k < 3; k++)
+				V::store(m[j][k] + i, r[j][k]);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 r[3][3];
+		quatToMatrix<SrSimdScalar>(qx[i], qy[i], qz[i], qw[i], r);
+		for(int j = 0; j < 3; j++)
+			for(int k = 0; k < 3; k++)
+				m[j][k][i] = r[j][k];
+		}
+	}
+
+template<class V>
+SR_INLINE void SrMatrix33Batch::toQuatLanes(const SrF32* const m[3][3],
+											SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n)
+	{
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float r[3][3];
+		for(int j = 0; j < 3; j++)
+			for(int k = 0; k < 3; k++)
+				r[j][k] = V::load(m[j][k] + i);
+		typename V::Float x, y, z, w;
+		matrixToQuat<V>(r, x, y, z, w);
+		V::store(qx + i, x);
+		V::store(qy + i, y);
+		V::store(qz + i, z);
+		V::store(qw + i, w);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 r[3][3];
+		for(int j = 0; j < 3; j++)
+			for(int k = 0; k < 3; k++)
+				r[j][k] = m[j][k][i];
+		matrixToQuat<SrSimdScalar>(r, qx[i], qy[i], qz[i], qw[i]);
+		}
+	}
+
+template<class V>
+SR_INLINE void SrMatrix33Batch::multiplyAoS(const SrMatrix33* a, const SrMatrix33* b, SrMatrix33* dst, SrU32 n)
+	{
+	//the row loads read one float past each row, so the last matrix is left to the tail.
+	SrU32 i = 0;
+	for(; i + V::Width < n; i += V::Width)
+		{
+		const SrF32* pa = &a[i](0, 0);
+		const SrF32* pb = &b[i](0, 0);
+		typename V::Float ma[3][3], mb[3][3], md[3][3];
+		for(int r = 0; r < 3; r++)
+			{
+			V::loadTransposed3(pa + 3 * r, 9, ma[r][0], ma[r][1], ma[r][2]);
+			V::loadTransposed3(pb + 3 * r, 9, mb[r][0], mb[r][1], mb[r][2]);
+			}
+		multiply<V>(ma, mb, md);
+		SrF32* d = &dst[i](0, 0);
+		for(int r = 0; r < 3; r++)
+			V::storeTransposed3(d + 3 * r, 9, md[r][0], md[r][1], md[r][2]);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 ma[3][3], mb[3][3], md[3][3];
+		for(int r = 0; r < 3; r++)
+			for(int c = 0; c < 3; c++)
+				{
+				ma[r][c] = a[i](r, c);
+				mb[r][c] = b[i](r, c);
+				}
+		multiply<SrSimdScalar>(ma, mb, md);
+		for(int r = 0; r < 3; r++)
+			for(int c = 0; c < 3; c++)
+				dst[i](r, c) = md[r][c];
+		}
+	}
+
+template<class V>
+SR_INLINE void SrMatrix33Batch::multiplyLanes(const SrF32* const a[3][3], const SrF32* const b[3][3], SrF32* const dst[3][3], SrU32 n)
+	{
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float ma[3][3], mb[3][3], md[3][3];
+		for(int j = 0; j < 3; j++)
+			for(int k = 0; k < 3; k++)
+				{
+				ma[j][k] = V::load(a[j][k] + i);
+				mb[j][k] = V::load(b[j][k] + i);
+				}
+		multiply<V>(ma, mb, md);
+		for(int j = 0; j < 3; j++)
+			for(int k = 0; k < 3; k++)
+				V::store(dst[j][k] + i, md[j][k]);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 ma[3][3], mb[3][3], md[3][3];
+		for(int j = 0; j < 3; j++)
+			for(int k = 0; k < 3; k++)
+				{
+				ma[j][k] = a[j][k][i];
+				mb[j][k] = b[j][k][i];
+				}
+		multiply<SrSimdScalar>(ma, mb, md);
+		for(int j = 0; j < 3; j++)
+			for(int k = 0; k < 3; k++)
+				dst[j][k][i] = md[j][k];
+		}
+	}
+
+SR_INLINE void SrMatrix33Batch::fromQuat(const SrQuaternion* src, SrMatrix33* dst, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrMatrix33BatchKernels, mat33FromQuatAoS, fromQuatAoS<SrSimdNative>)(src, dst, n);
+	}
+
+SR_INLINE void SrMatrix33Batch::toQuat(const SrMatrix33* src, SrQuaternion* dst, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrMatrix33BatchKernels, mat33ToQuatAoS, toQuatAoS<SrSimdNative>)(src, dst, n);
+	}
+
+SR_INLINE void SrMatrix33Batch::fromQuat(const SrQuaternionSoA& src, SrMatrix33SoA& dst)
+	{
+	dst.resize(src.size());
+	SR_SIMD_KERNEL(SrMatrix33BatchKernels, mat33FromQuatLanes, fromQuatLanes<SrSimdNative>)(src.x, src.y, src.z, src.w, dst.m, src.size());
+	}
+
+SR_INLINE void SrMatrix33Batch::toQuat(const SrMatrix33SoA& src, SrQuaternionSoA& dst)
+	{
+	dst.resize(src.size());
+	SR_SIMD_KERNEL(SrMatrix33BatchKernels, mat33ToQuatLanes, toQuatLanes<SrSimdNative>)(src.m, dst.x, dst.y, dst.z, dst.w, src.size());
+	}
+
+SR_INLINE void SrMatrix33Batch::multiply(const SrMatrix33* a, const SrMatrix33* b, SrMatrix33* dst, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrMatrix33BatchKernels, mat33MultiplyAoS, multiplyAoS<SrSimdNative>)(a, b, dst, n);
+	}
+
+SR_INLINE void SrMatrix33Batch::multiply(const SrMatrix33SoA& a, const SrMatrix33SoA& b, SrMatrix33SoA& dst)
+	{
+	SR_ASSERT(a.size() == b.size());
+	dst.resize(a.size());
+	SR_SIMD_KERNEL(SrMatrix33BatchKernels, mat33MultiplyLanes, multiplyLanes<SrSimdNative>)(a.m, b.m, dst.m, a.size());
+	}
+
+SR_SIMD_KERNEL_TABLES(SrMatrix33BatchKernels)
+
+/** @} */
+#endif
@@ -0,0 +1,191 @@
+/************************************************************************
+\file 	SrMatrix33SoA.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRMATRIX33SOA_H_
+#define SR_FOUNDATION_SRMATRIX33SOA_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include <string.h>
+#include "SrSimd.h"
+#include "SrMatrix33.h"
+
+/**
+\brief Structure of arrays container for 3x3 matrices, typically rotations.
+
+Same layout rules as SrVector3SoA: one lane m[row][col][] per matrix element, nine in
+total, each aligned to #SR_SIMD_ALIGNMENT bytes and padded to a multiple of 16 elements.
+*/
+class SrMatrix33SoA
+	{
+	public:
+	/**
+	\brief Creates an empty container.
+	*/
+	SR_INLINE SrMatrix33SoA();
+
+	/**
+	\brief Creates a container of n elements, data is left uninitialized.
+	*/
+	SR_INLINE explicit SrMatrix33SoA(SrU32 n);
+
+	/**
+	\brief Copy constructor, copies all n elements.
+	*/
+	SR_INLINE SrMatrix33SoA(const SrMatrix33SoA& other);
+
+	SR_INLINE ~SrMatrix33SoA();
+
+	/**
+	\brief Assignment operator, copies all n elements.
+	*/
+	SR_INLINE const SrMatrix33SoA& operator=(const SrMatrix33SoA& other);
+
+	/**
+	\brief Changes the number of elements. Existing data is kept up to the new size.
+	*/
+	SR_INLINE void resize(SrU32 n);
+
+	/**
+	\brief number of elements.
+	*/
+	SR_INLINE SrU32 size() const;
+
+	/**
+	\brief number of elements allocated per lane, a multiple of 16.
+	*/
+	SR_INLINE SrU32 capacity() const;
+
+	/**
+	\brief writes element i.
+	*/
+	SR_INLINE void set(SrU32 i, const SrMatrix33& mat);
+
+	/**
+	\brief reads element i.
+	*/
+	SR_INLINE SrMatrix33 get(SrU32 i) const;
+
+	/**
+	\brief resizes to n and scatters the n AoS matrices into the lanes.
+	*/
+	SR_INLINE void setAoS(const SrMatrix33* src, SrU32 n);
+
+	/**
+	\brief gathers all elements into the AoS array dst, which must hold size() matrices.
+	*/
+	SR_INLINE void getAoS(SrMatrix33* dst) const;
+
+	/** the lanes, m[row][col] holds element (row, col) of every matrix */
+	SrF32* m[3][3];
+
+	private:
+	SrU32 mSize;
+	SrU32 mCapacity;
+	};
+
+
+SR_INLINE SrMatrix33SoA::SrMatrix33SoA() : mSize(0), mCapacity(0)
+	{
+	memset(m, 0, sizeof(m));
+	}
+
+SR_INLINE SrMatrix33SoA::SrMatrix33SoA(SrU32 n) : mSize(0), mCapacity(0)
+	{
+	memset(m, 0, sizeof(m));
+	resize(n);
+	}
+
+SR_INLINE SrMatrix33SoA::SrMatrix33SoA(const SrMatrix33SoA& other) : mSize(0), mCapacity(0)
+	{
+	memset(m, 0, sizeof(m));
+	*this = other;
+	}
+
+SR_INLINE SrMatrix33SoA::~SrMatrix33SoA()
+	{
+	SrAlignedMemory::deallocate(m[0][0]);
+	}
+
+SR_INLINE const SrMatrix33SoA& SrMatrix33SoA::operator=(const SrMatrix33SoA& other)
+	{
+	if(this != &other)
+		{
+		resize(other.mSize);
+		for(int r = 0; r < 3; r++)
+			for(int c = 0; c < 3; c++)
+				memcpy(m[r][c], other.m[r][c], mSize * sizeof(SrF32));
+		}
+	return *this;
+	}
+
+SR_INLINE void SrMatrix33SoA::resize(SrU32 n)
+	{
+	if(n > mCapacity)
+		{
+		//one block for all lanes, every lane starts on a SR_SIMD_ALIGNMENT boundary.
+		const SrU32 cap = (n + 15) & ~15u;
+		SrF32* block = (SrF32*)SrAlignedMemory::allocate(9 * cap * sizeof(SrF32));
+		SR_ASSERT(block);
+		SrF32* old = m[0][0];
+		for(int r = 0; r < 3; r++)
+			for(int c = 0; c < 3; c++)
+				{
+				SrF32* lane = block + (3 * r + c) * cap;
+				if(mSize)
+					memcpy(lane, m[r][c], mSize * sizeof(SrF32));
+				m[r][c] = lane;
+				}
+		SrAlignedMemory::deallocate(old);
+		mCapacity = cap;
+		}
+	mSize = n;
+	}
+
+SR_INLINE SrU32 SrMatrix33SoA::size() const
+	{
+	return mSize;
+	}
+
+SR_INLINE SrU32 SrMatrix33SoA::capacity() const
+	{
+	return mCapacity;
+	}
+
+SR_INLINE void SrMatrix33SoA::set(SrU32 i, const SrMatrix33& mat)
+	{
+	SR_ASSERT(i < mSize);
+	for(int r = 0; r < 3; r++)
+		for(int c = 0; c < 3; c++)
+			m[r][c][i] = mat(r, c);
+	}
+
+SR_INLINE SrMatrix33 SrMatrix33SoA::get(SrU32 i) const
+	{
+	SR_ASSERT(i < mSize);
+	SrMatrix33 mat;
+	for(int r = 0; r < 3; r++)
+		for(int c = 0; c < 3; c++)
+			mat(r, c) = m[r][c][i];
+	return mat;
+	}
+
+SR_INLINE void SrMatrix33SoA::setAoS(const SrMatrix33* src, SrU32 n)
+	{
+	resize(n);
+	for(SrU32 i = 0; i < n; i++)
+		set(i, src[i]);
+	}
+
+SR_INLINE void SrMatrix33SoA::getAoS(SrMatrix33* dst) const
+	{
+	for(SrU32 i = 0; i < mSize; i++)
+		dst[i] = get(i);
+	}
+
+/** @} */
+#endif
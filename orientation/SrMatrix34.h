@@ -16,34 +16,44 @@
 \brief Combination of a 3x3 rotation matrix and a translation vector.
 
 homogenous transform class composed of a matrix and a vector.
+T is the precision, SrMatrix34 and SrMatrix34F64 are the SrF32 and SrF64 typedefs.
 */
 
-class SrMatrix34
+template<class T>
+class SrMatrix34T
 	{
 	public:
 	/**
 	\brief [ M t ]
 	*/
-	SrMatrix33 M;
-	SrVector3 t;
+	SrMatrix33T<T> M;
+	SrVector3T<T> t;
 
 	/**
 	\brief by default M is inited and t isn't.  Use this ctor to either init or not init in full.
 	*/
-	SR_INLINE explicit SrMatrix34(bool init = true);
+	SR_CONSTEXPR explicit SrMatrix34T(bool init = true);
 
-	SR_INLINE SrMatrix34(const SrMatrix33& rot, const SrVector3& trans) : M(rot), t(trans)
+	SR_CONSTEXPR SrMatrix34T(const SrMatrix33T<T>& rot, const SrVector3T<T>& trans) : M(rot), t(trans)
 		{
 		}
 
-	SR_INLINE void zero();
+	/**
+	\brief Converts from the other precision.
+	*/
+	template<class U>
+	SR_CONSTEXPR explicit SrMatrix34T(const SrMatrix34T<U>& m) : M(m.M), t(m.t)
+		{
+		}
+
+	SR_CONSTEXPR void zero();
 
-	SR_INLINE void id();
+	SR_CONSTEXPR void id();
 
 	/**
 	\brief returns true for identity matrix
 	*/
-	SR_INLINE bool isIdentity() const;
+	SR_CONSTEXPR bool isIdentity() const;
 
 	/**
 	\brief returns true if all elems are finite (not NAN or INF, etc.)
@@ -55,88 +65,89 @@ class SrMatrix34
 	
 	Returns false if singular (i.e. if no inverse exists), setting dest to identity.  dest may equal this.
 	*/
-	SR_INLINE bool getInverse(SrMatrix34& dest) const;
+	SR_CONSTEXPR bool getInverse(SrMatrix34T& dest) const;
 
 	/**
 	\brief same as #getInverse(), but assumes that M is orthonormal
 	*/
-	SR_INLINE bool getInverseRT(SrMatrix34& dest) const;
+	SR_CONSTEXPR bool getInverseRT(SrMatrix34T& dest) const;
 
 	/**
 	\brief dst = this * src
 	*/
-	SR_INLINE void multiply(const SrVector3 &src, SrVector3 &dst) const;
+	SR_CONSTEXPR void multiply(const SrVector3T<T> &src, SrVector3T<T> &dst) const;
 
 	/**
 	\brief operator wrapper for multiply
 	*/
-	SR_INLINE SrVector3 operator*  (const SrVector3 & src) const { SrVector3 dest; multiply(src, dest); return dest; }
+	SR_CONSTEXPR SrVector3T<T> operator*  (const SrVector3T<T> & src) const { SrVector3T<T> dest; multiply(src, dest); return dest; }
 	/**
 	\brief dst = inverse(this) * src	-- assumes M is rotation matrix!!!
 	*/
-	SR_INLINE void multiplyByInverseRT(const SrVector3 &src, SrVector3 &dst) const;
+	SR_CONSTEXPR void multiplyByInverseRT(const SrVector3T<T> &src, SrVector3T<T> &dst) const;
 
 	/**
 	\brief operator wrapper for multiplyByInverseRT
 	*/
-	SR_INLINE SrVector3 operator%  (const SrVector3 & src) const { SrVector3 dest; multiplyByInverseRT(src, dest); return dest; }
+	SR_CONSTEXPR SrVector3T<T> operator%  (const SrVector3T<T> & src) const { SrVector3T<T> dest; multiplyByInverseRT(src, dest); return dest; }
 
 	/**
 	\brief this = left * right	
 	*/
-	SR_INLINE void multiply(const SrMatrix34& left, const SrMatrix34& right);
+	SR_CONSTEXPR void multiply(const SrMatrix34T& left, const SrMatrix34T& right);
 
 	/**
 	\brief this = inverse(left) * right	-- assumes M is rotation matrix!!!
 	*/
-	SR_INLINE void multiplyInverseRTLeft(const SrMatrix34& left, const SrMatrix34& right);
+	SR_CONSTEXPR void multiplyInverseRTLeft(const SrMatrix34T& left, const SrMatrix34T& right);
 
 	/**
 	\brief this = left * inverse(right)	-- assumes M is rotation matrix!!!
 	*/
-	SR_INLINE void multiplyInverseRTRight(const SrMatrix34& left, const SrMatrix34& right);
+	SR_CONSTEXPR void multiplyInverseRTRight(const SrMatrix34T& left, const SrMatrix34T& right);
 
 	/**
 	\brief operator wrapper for multiply
 	*/
-	SR_INLINE SrMatrix34 operator*  (const SrMatrix34 & right) const { SrMatrix34 dest(false); dest.multiply(*this, right); return dest; }
+	SR_CONSTEXPR SrMatrix34T operator*  (const SrMatrix34T & right) const { SrMatrix34T dest(false); dest.multiply(*this, right); return dest; }
 
 	/**
 	\brief convert from a matrix format appropriate for rendering
 	*/
-	SR_INLINE void setColumnMajor44(const SrF32 *);
+	SR_CONSTEXPR void setColumnMajor44(const SrF32 *);
 	/**
 	\brief convert from a matrix format appropriate for rendering
 	*/
-	SR_INLINE void setColumnMajor44(const SrF32 d[4][4]);
+	SR_CONSTEXPR void setColumnMajor44(const SrF32 d[4][4]);
 	/**
 	\brief convert to a matrix format appropriate for rendering
 	*/
-	SR_INLINE void getColumnMajor44(SrF32 *) const;
+	SR_CONSTEXPR void getColumnMajor44(SrF32 *) const;
 	/**
 	\brief convert to a matrix format appropriate for rendering
 	*/
-	SR_INLINE void getColumnMajor44(SrF32 d[4][4]) const;
+	SR_CONSTEXPR void getColumnMajor44(SrF32 d[4][4]) const;
 	/**
 	\brief set the matrix given a row major matrix.
 	*/
-	SR_INLINE void setRowMajor44(const SrF32 *);
+	SR_CONSTEXPR void setRowMajor44(const SrF32 *);
 	/**
 	\brief set the matrix given a row major matrix.
 	*/
-	SR_INLINE void setRowMajor44(const SrF32 d[4][4]);
+	SR_CONSTEXPR void setRowMajor44(const SrF32 d[4][4]);
 	/**
 	\brief retrieve the matrix in a row major format.
 	*/
-	SR_INLINE void getRowMajor44(SrF32 *) const;
+	SR_CONSTEXPR void getRowMajor44(SrF32 *) const;
 	/**
 	\brief retrieve the matrix in a row major format.
 	*/
-	SR_INLINE void getRowMajor44(SrF32 d[4][4]) const;
+	SR_CONSTEXPR void getRowMajor44(SrF32 d[4][4]) const;
 	};
 
 
-SR_INLINE SrMatrix34::SrMatrix34(bool init)
+template<class T>
+SR_CONSTEXPR SrMatrix34T<T>::SrMatrix34T(bool init)
 	{
 	if (init)
 	{
@@ -146,21 +157,24 @@ SR_INLINE SrMatrix34::SrMatrix34(bool init)
 	}
 
 
-SR_INLINE void SrMatrix34::zero()
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::zero()
 	{
 	M.zero();
 	t.zero();
 	}
 
 
-SR_INLINE void SrMatrix34::id()
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::id()
 	{
 	M.id();
 	t.zero();
 	}
 
 
-SR_INLINE bool SrMatrix34::isIdentity() const
+template<class T>
+SR_CONSTEXPR bool SrMatrix34T<T>::isIdentity() const
 	{
 	if(!M.isIdentity())	return false;
 	if(!t.isZero())		return false;
@@ -168,7 +182,8 @@ SR_INLINE bool SrMatrix34::isIdentity() const
 	}
 
 
-SR_INLINE bool SrMatrix34::isFinite() const
+template<class T>
+SR_INLINE bool SrMatrix34T<T>::isFinite() const
 	{
 	if(!M.isFinite())	return false;
 	if(!t.isFinite())	return false;
@@ -176,7 +191,8 @@ SR_INLINE bool SrMatrix34::isFinite() const
 	}
 
 
-SR_INLINE bool SrMatrix34::getInverse(SrMatrix34& dest) const
+template<class T>
+SR_CONSTEXPR bool SrMatrix34T<T>::getInverse(SrMatrix34T<T>& dest) const
 	{
 	// inv(this) = [ inv(M) , inv(M) * -t ]
 	bool status = M.getInverse(dest.M);
@@ -185,7 +201,8 @@ SR_INLINE bool SrMatrix34::getInverse(SrMatrix34& dest) const
 	}
 
 
-SR_INLINE bool SrMatrix34::getInverseRT(SrMatrix34& dest) const
+template<class T>
+SR_CONSTEXPR bool SrMatrix34T<T>::getInverseRT(SrMatrix34T<T>& dest) const
 	{
 	// inv(this) = [ M' , M' * -t ]
 	dest.M.setTransposed(M);
@@ -195,20 +212,23 @@ SR_INLINE bool SrMatrix34::getInverseRT(SrMatrix34& dest) const
 
 
 
-SR_INLINE void SrMatrix34::multiply(const SrVector3 &src, SrVector3 &dst) const
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::multiply(const SrVector3T<T> &src, SrVector3T<T> &dst) const
 	{
 	dst = M * src + t;
 	}
 
 
-SR_INLINE void SrMatrix34::multiplyByInverseRT(const SrVector3 &src, SrVector3 &dst) const
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::multiplyByInverseRT(const SrVector3T<T> &src, SrVector3T<T> &dst) const
 	{
 	//dst = M' * src - M' * t = M' * (src - t)
 	M.multiplyByTranspose(src - t, dst);
 	}
 
 
-SR_INLINE void SrMatrix34::multiply(const SrMatrix34& left, const SrMatrix34& right)
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::multiply(const SrMatrix34T<T>& left, const SrMatrix34T<T>& right)
 	{
 	//[aR at] * [bR bt] = [aR * bR		aR * bt + at]  NOTE: order of operations important so it works when this ?= left ?= right.
 	t = left.M * right.t + left.t;
@@ -216,7 +236,8 @@ SR_INLINE void SrMatrix34::multiply(const SrMatrix34& left, const SrMatrix34& ri
 	}
 
 
-SR_INLINE void SrMatrix34::multiplyInverseRTLeft(const SrMatrix34& left, const SrMatrix34& right)
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::multiplyInverseRTLeft(const SrMatrix34T<T>& left, const SrMatrix34T<T>& right)
 	{
 	//[aR' -aR'*at] * [bR bt] = [aR' * bR		aR' * bt  - aR'*at]	//aR' ( bt  - at )	NOTE: order of operations important so it works when this ?= left ?= right.
 	t = left.M % (right.t - left.t);
@@ -224,14 +245,16 @@ SR_INLINE void SrMatrix34::multiplyInverseRTLeft(const SrMatrix34& left, const S
 	}
 
 
-SR_INLINE void SrMatrix34::multiplyInverseRTRight(const SrMatrix34& left, const SrMatrix34& right)
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::multiplyInverseRTRight(const SrMatrix34T<T>& left, const SrMatrix34T<T>& right)
 	{
 	//[aR at] * [bR' -bR'*bt] = [aR * bR'		-aR * bR' * bt + at]	NOTE: order of operations important so it works when this ?= left ?= right.
 	M.multiplyTransposeRight(left.M, right.M);
 	t = left.t - M * right.t;
 	}
 
-SR_INLINE void SrMatrix34::setColumnMajor44(const SrF32 * d) 
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::setColumnMajor44(const SrF32 * d) 
 	{
 	M.setColumnMajorStride4(d);
     t.x = d[12];
@@ -239,7 +262,8 @@ SR_INLINE void SrMatrix34::setColumnMajor44(const SrF32 * d)
 	t.z = d[14];
 	}
 
-SR_INLINE void SrMatrix34::setColumnMajor44(const SrF32 d[4][4]) 
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::setColumnMajor44(const SrF32 d[4][4]) 
 	{
 	M.setColumnMajorStride4(d);
     t.x = d[3][0];
@@ -247,27 +271,30 @@ SR_INLINE void SrMatrix34::setColumnMajor44(const SrF32 d[4][4])
 	t.z = d[3][2];
 	}
 
-SR_INLINE void SrMatrix34::getColumnMajor44(SrF32 * d) const
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::getColumnMajor44(SrF32 * d) const
 	{
 	M.getColumnMajorStride4(d);
-    d[12] = t.x;
-	d[13] = t.y;
-	d[14] = t.z;
+    d[12] = (SrF32)t.x;
+	d[13] = (SrF32)t.y;
+	d[14] = (SrF32)t.z;
 	d[3] = d[7] = d[11] = 0.0f;
 	d[15] = 1.0f;
 	}
 
-SR_INLINE void SrMatrix34::getColumnMajor44(SrF32 d[4][4]) const
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::getColumnMajor44(SrF32 d[4][4]) const
 	{
 	M.getColumnMajorStride4(d);
-    d[3][0] = t.x;
-	d[3][1] = t.y;
-	d[3][2] = t.z;
+    d[3][0] = (SrF32)t.x;
+	d[3][1] = (SrF32)t.y;
+	d[3][2] = (SrF32)t.z;
 	d[0][3] = d[1][3] = d[2][3] = 0.0f;
 	d[3][3] = 1.0f;
 	}
 
-SR_INLINE void SrMatrix34::setRowMajor44(const SrF32 * d) 
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::setRowMajor44(const SrF32 * d) 
 	{
 	M.setRowMajorStride4(d);
     t.x = d[3];
@@ -275,7 +302,8 @@ SR_INLINE void SrMatrix34::setRowMajor44(const SrF32 * d)
 	t.z = d[11];
 	}
 
-SR_INLINE void SrMatrix34::setRowMajor44(const SrF32 d[4][4])
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::setRowMajor44(const SrF32 d[4][4])
 	{
 	M.setRowMajorStride4(d);
     t.x = d[0][3];
@@ -283,22 +311,24 @@ SR_INLINE void SrMatrix34::setRowMajor44(const SrF32 d[4][4])
 	t.z = d[2][3];
 	}
 
-SR_INLINE void SrMatrix34::getRowMajor44(SrF32 * d) const
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::getRowMajor44(SrF32 * d) const
 	{
 	M.getRowMajorStride4(d);
-    d[3] = t.x;
-	d[7] = t.y;
-	d[11] = t.z;
+    d[3] = (SrF32)t.x;
+	d[7] = (SrF32)t.y;
+	d[11] = (SrF32)t.z;
 	d[12] = d[13] = d[14] = 0.0f;
 	d[15] = 1.0f;
 	}
 
-SR_INLINE void SrMatrix34::getRowMajor44(SrF32 d[4][4]) const
+template<class T>
+SR_CONSTEXPR void SrMatrix34T<T>::getRowMajor44(SrF32 d[4][4]) const
 	{
 	M.getRowMajorStride4(d);
-    d[0][3] = t.x;
-	d[1][3] = t.y;
-	d[2][3] = t.z;
+    d[0][3] = (SrF32)t.x;
+	d[1][3] = (SrF32)t.y;
+	d[2][3] = (SrF32)t.z;
 	d[3][0] = d[3][1] = d[3][2] = 0.0f;
 	d[3][3] = 1.0f;
 	}
@@ -0,0 +1,285 @@
+/************************************************************************
+\file 	SrMatrix34Batch.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRMATRIX34BATCH_H_
+#define SR_FOUNDATION_SRMATRIX34BATCH_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include "SrSimd.h"
+#include "SrSimdDispatch.h"
+#include "SrMatrix34.h"
+#include "SrVector3SoA.h"
+
+/**
+\brief Static class with batch versions of the SrMatrix34 vector transforms.
+
+The strided versions read and write interleaved vertex buffers in place: src and dst
+point at the first x component and srcStride / dstStride are the distances in bytes
+between two consecutive vertices, so a position or normal stream inside a vertex
+structure can be transformed without copying it out. Strides must be multiples of 4
+and at least 12. Blocks of SrSimdNative::Width vertices are loaded with one 4 float
+read each and transposed in registers, which is much cheaper than gathers.
+src and dst may be the same buffer.
+
+Points get the full transform, same as SrMatrix34::multiply():	dst = M * src + t
+Directions only get the rotation part:							dst = M * src
+
+Elements that do not fill a whole register run the same register code on SrSimdScalar.
+*/
+class SrMatrix34Batch
+	{
+	public:
+	/**
+	\brief dst[i] = m * src[i] over strided buffers.
+	*/
+	SR_INLINE static void transformPoints(const SrMatrix34& m, const SrF32* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n);
+
+	/**
+	\brief dst[i] = m.M * src[i] over strided buffers.
+	*/
+	SR_INLINE static void transformDirections(const SrMatrix34& m, const SrF32* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n);
+
+	/**
+	\brief dst[i] = m * src[i] over arrays of SrVector3.
+	*/
+	SR_INLINE static void transformPoints(const SrMatrix34& m, const SrVector3* src, SrVector3* dst, SrU32 n);
+
+	/**
+	\brief dst[i] = m.M * src[i] over arrays of SrVector3.
+	*/
+	SR_INLINE static void transformDirections(const SrMatrix34& m, const SrVector3* src, SrVector3* dst, SrU32 n);
+
+	/**
+	\brief SoA versions, dst is resized to src.size().
+	*/
+	SR_INLINE static void transformPoints(const SrMatrix34& m, const SrVector3SoA& src, SrVector3SoA& dst);
+	SR_INLINE static void transformDirections(const SrMatrix34& m, const SrVector3SoA& src, SrVector3SoA& dst);
+
+	/**
+	\brief half precision sources, converted as they are loaded. srcStride is in bytes and
+	must be a multiple of 2 and at least 6.
+	*/
+	SR_INLINE static void transformPoints(const SrMatrix34& m, const SrHalf* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n);
+	SR_INLINE static void transformDirections(const SrMatrix34& m, const SrHalf* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n);
+	SR_INLINE static void transformPoints(const SrMatrix34& m, const SrVector3F16* src, SrVector3* dst, SrU32 n);
+	SR_INLINE static void transformDirections(const SrMatrix34& m, const SrVector3F16* src, SrVector3* dst, SrU32 n);
+
+	/**
+	\brief register level transform, m holds the matrix rows with the translation as fourth column.
+	*/
+	template<class V>
+	SR_INLINE static void transform(const typename V::Float m[3][4], typename V::Float& x, typename V::Float& y, typename V::Float& z);
+
+	/**
+	\brief the strided kernel, T is SrF32 or SrHalf for the source.
+	*/
+	template<class V, class T>
+	SR_INLINE static void transformStrided(const SrMatrix34& m, bool translate, const T* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n);
+	template<class V>
+	SR_INLINE static void transformLanes(const SrMatrix34& m, bool translate,
+										 const SrF32* x, const SrF32* y, const SrF32* z,
+										 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+
+	private:
+	/**
+	\brief the rows for transform(), splat for V and as scalars for the tail.
+	*/
+	template<class V>
+	SR_INLINE static void loadRows(const SrMatrix34& m, bool translate, typename V::Float rows[3][4], SrF32 scalarRows[3][4]);
+	};
+
+/**
+\brief The SrMatrix34Batch kernels of one SrSimd set, the table SR_SIMD_KERNEL() calls through
+with SR_SIMD_DISPATCH.
+*/
+struct SrMatrix34BatchKernels
+	{
+	void (*mat34TransformStrided)(const SrMatrix34& m, bool translate, const SrF32* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n);
+	void (*mat34TransformLanes)(const SrMatrix34& m, bool translate,
+								const SrF32* x, const SrF32* y, const SrF32* z,
+								SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+	void (*mat34TransformStridedHalf)(const SrMatrix34& m, bool translate, const SrHalf* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n);
+
+	/**
+	\brief The table of the set V, see SrSimdDispatch.h.
+	*/
+	template<class V>
+	class Table
+		{
+		public:
+		static SrMatrix34BatchKernels create()
+			{
+			SrMatrix34BatchKernels k;
+			k.mat34TransformStrided = mat34TransformStrided;
+			k.mat34TransformLanes = mat34TransformLanes;
+			k.mat34TransformStridedHalf = mat34TransformStridedHalf;
+			return k;
+			}
+
+		private:
+		SR_SIMD_FLATTEN static void mat34TransformStrided(const SrMatrix34& m, bool translate, const SrF32* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n)
+			{
+			SrMatrix34Batch::transformStrided<V>(m, translate, src, srcStride, dst, dstStride, n);
+			}
+
+		SR_SIMD_FLATTEN static void mat34TransformLanes(const SrMatrix34& m, bool translate,
+														const SrF32* x, const SrF32* y, const SrF32* z,
+														SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+			{
+			SrMatrix34Batch::transformLanes<V>(m, translate, x, y, z, dstX, dstY, dstZ, n);
+			}
+
+		SR_SIMD_FLATTEN static void mat34TransformStridedHalf(const SrMatrix34& m, bool translate, const SrHalf* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n)
+			{
+			SrMatrix34Batch::transformStrided<V>(m, translate, src, srcStride, dst, dstStride, n);
+			}
+		};
+	};
+
+
+template<class V>
+SR_INLINE void SrMatrix34Batch::transform(const typename V::Float m[3][4], typename V::Float& x, typename V::Float& y, typename V::Float& z)
+	{
+	const typename V::Float rx = V::madd(m[0][0], x, V::madd(m[0][1], y, V::madd(m[0][2], z, m[0][3])));
+	const typename V::Float ry = V::madd(m[1][0], x, V::madd(m[1][1], y, V::madd(m[1][2], z, m[1][3])));
+	const typename V::Float rz = V::madd(m[2][0], x, V::madd(m[2][1], y, V::madd(m[2][2], z, m[2][3])));
+	x = rx;
+	y = ry;
+	z = rz;
+	}
+
+template<class V>
+SR_INLINE void SrMatrix34Batch::loadRows(const SrMatrix34& m, bool translate, typename V::Float rows[3][4], SrF32 scalarRows[3][4])
+	{
+	for(int r = 0; r < 3; r++)
+		{
+		for(int c = 0; c < 3; c++)
+			scalarRows[r][c] = m.M(r, c);
+		scalarRows[r][3] = translate ? m.t[r] : 0.0f;
+		for(int c = 0; c < 4; c++)
+			rows[r][c] = V::splat(scalarRows[r][c]);
+		}
+	}
+
+template<class V, class T>
+SR_INLINE void SrMatrix34Batch::transformStrided(const SrMatrix34& m, bool translate, const T* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n)
+	{
+	SR_ASSERT(srcStride % sizeof(T) == 0 && (dstStride & 3) == 0);
+	const SrI32 ss = (SrI32)(srcStride / sizeof(T));
+	const SrI32 ds = (SrI32)(dstStride / sizeof(SrF32));
+	typename V::Float rows[3][4];
+	SrF32 scalarRows[3][4];
+	loadRows<V>(m, translate, rows, scalarRows);
+
+	//loadTransposed3 reads one float past each record, so the last record is always left to the tail.
+	SrU32 i = 0;
+	for(; i + V::Width < n; i += V::Width)
+		{
+		typename V::Float x, y, z;
+		V::loadTransposed3(src + (size_t)i * ss, ss, x, y, z);
+		transform<V>(rows, x, y, z);
+		V::storeTransposed3(dst + (size_t)i * ds, ds, x, y, z);
+		}
+	for(; i < n; i++)
+		{
+		const T* s = src + (size_t)i * ss;
+		SrF32* d = dst + (size_t)i * ds;
+		SrF32 x = s[0], y = s[1], z = s[2];
+		transform<SrSimdScalar>(scalarRows, x, y, z);
+		d[0] = x;
+		d[1] = y;
+		d[2] = z;
+		}
+	}
+
+template<class V>
+SR_INLINE void SrMatrix34Batch::transformLanes(const SrMatrix34& m, bool translate,
+											   const SrF32* x, const SrF32* y, const SrF32* z,
+											   SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+	{
+	typename V::Float rows[3][4];
+	SrF32 scalarRows[3][4];
+	loadRows<V>(m, translate, rows, scalarRows);
+
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float vx = V::load(x + i);
+		typename V::Float vy = V::load(y + i);
+		typename V::Float vz = V::load(z + i);
+		transform<V>(rows, vx, vy, vz);
+		V::store(dstX + i, vx);
+		V::store(dstY + i, vy);
+		V::store(dstZ + i, vz);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 vx = x[i], vy = y[i], vz = z[i];
+		transform<SrSimdScalar>(scalarRows, vx, vy, vz);
+		dstX[i] = vx;
+		dstY[i] = vy;
+		dstZ[i] = vz;
+		}
+	}
+
+SR_INLINE void SrMatrix34Batch::transformPoints(const SrMatrix34& m, const SrF32* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrMatrix34BatchKernels, mat34TransformStrided, transformStrided<SrSimdNative>)(m, true, src, srcStride, dst, dstStride, n);
+	}
+
+SR_INLINE void SrMatrix34Batch::transformDirections(const SrMatrix34& m, const SrF32* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrMatrix34BatchKernels, mat34TransformStrided, transformStrided<SrSimdNative>)(m, false, src, srcStride, dst, dstStride, n);
+	}
+
+SR_INLINE void SrMatrix34Batch::transformPoints(const SrMatrix34& m, const SrVector3* src, SrVector3* dst, SrU32 n)
+	{
+	transformPoints(m, &src->x, sizeof(SrVector3), &dst->x, sizeof(SrVector3), n);
+	}
+
+SR_INLINE void SrMatrix34Batch::transformDirections(const SrMatrix34& m, const SrVector3* src, SrVector3* dst, SrU32 n)
+	{
+	transformDirections(m, &src->x, sizeof(SrVector3), &dst->x, sizeof(SrVector3), n);
+	}
+
+SR_INLINE void SrMatrix34Batch::transformPoints(const SrMatrix34& m, const SrVector3SoA& src, SrVector3SoA& dst)
+	{
+	dst.resize(src.size());
+	SR_SIMD_KERNEL(SrMatrix34BatchKernels, mat34TransformLanes, transformLanes<SrSimdNative>)(m, true, src.x, src.y, src.z, dst.x, dst.y, dst.z, src.size());
+	}
+
+SR_INLINE void SrMatrix34Batch::transformDirections(const SrMatrix34& m, const SrVector3SoA& src, SrVector3SoA& dst)
+	{
+	dst.resize(src.size());
+	SR_SIMD_KERNEL(SrMatrix34BatchKernels, mat34TransformLanes, transformLanes<SrSimdNative>)(m, false, src.x, src.y, src.z, dst.x, dst.y, dst.z, src.size());
+	}
+
+SR_INLINE void SrMatrix34Batch::transformPoints(const SrMatrix34& m, const SrHalf* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrMatrix34BatchKernels, mat34TransformStridedHalf, transformStrided<SrSimdNative>)(m, true, src, srcStride, dst, dstStride, n);
+	}
+
+SR_INLINE void SrMatrix34Batch::transformDirections(const SrMatrix34& m, const SrHalf* src, SrU32 srcStride, SrF32* dst, SrU32 dstStride, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrMatrix34BatchKernels, mat34TransformStridedHalf, transformStrided<SrSimdNative>)(m, false, src, srcStride, dst, dstStride, n);
+	}
+
+SR_INLINE void SrMatrix34Batch::transformPoints(const SrMatrix34& m, const SrVector3F16* src, SrVector3* dst, SrU32 n)
+	{
+	transformPoints(m, &src->x, sizeof(SrVector3F16), &dst->x, sizeof(SrVector3), n);
+	}
+
+SR_INLINE void SrMatrix34Batch::transformDirections(const SrMatrix34& m, const SrVector3F16* src, SrVector3* dst, SrU32 n)
+	{
+	transformDirections(m, &src->x, sizeof(SrVector3F16), &dst->x, sizeof(SrVector3), n);
+	}
+
+SR_SIMD_KERNEL_TABLES(SrMatrix34BatchKernels)
+
+/** @} */
+#endif
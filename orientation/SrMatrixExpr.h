@@ -0,0 +1,223 @@
+/************************************************************************
+\file 	SrMatrixExpr.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRMATRIXEXPR_H_
+#define SR_FOUNDATION_SRMATRIXEXPR_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include "SrMatrix34.h"
+
+/*
+Lazy products of SrMatrix33 or SrMatrix34 chains.
+
+The operator* of the matrix classes returns a full matrix at each step, so A * B * C * v
+costs two matrix products and a matrix-vector product, with a temporary per step.
+Wrapping the first operand in srLazy() builds the chain as an expression instead, which
+is only evaluated at its end:
+
+	SrVector3 w = srLazy(A) * B * C * v;	//C * v, then B *, then A *: three matrix-vector products
+	SrMatrix33 R = srLazy(A) * B * C;		//A, then R *= B, R *= C, no temporaries
+	(srLazy(A) * B * C).evaluate(R);		//the same into an existing matrix
+
+The expression refers to its operands, it must be evaluated in the statement that builds it.
+One chain contains either SrMatrix33T or SrMatrix34T matrices of one precision.
+*/
+
+/**
+\brief A single matrix of a lazy product.
+*/
+template<class M>
+class SrMatLeaf
+	{
+	public:
+	typedef M Matrix;
+
+	SR_CONSTEXPR explicit SrMatLeaf(const M& matrix) : m(matrix)
+		{
+		}
+
+	/**
+	\brief dst = this
+	*/
+	SR_CONSTEXPR void evaluate(M& dst) const
+		{
+		dst = m;
+		}
+
+	/**
+	\brief dst = dst * this
+	*/
+	SR_CONSTEXPR void multiplyRight(M& dst) const
+		{
+		dst.multiply(dst, m);
+		}
+
+	/**
+	\brief dst = this * src, src may equal dst.
+	*/
+	template<class V>
+	SR_CONSTEXPR void transform(const V& src, V& dst) const
+		{
+		m.multiply(src, dst);
+		}
+
+	private:
+	const M& m;
+	};
+
+/**
+\brief The product of two lazy expressions, left * right.
+*/
+template<class L, class R>
+class SrMatProduct
+	{
+	public:
+	typedef typename L::Matrix Matrix;
+
+	SR_CONSTEXPR SrMatProduct(const L& l, const R& r) : left(l), right(r)
+		{
+		}
+
+	SR_CONSTEXPR void evaluate(Matrix& dst) const
+		{
+		left.evaluate(dst);
+		right.multiplyRight(dst);
+		}
+
+	SR_CONSTEXPR void multiplyRight(Matrix& dst) const
+		{
+		left.multiplyRight(dst);
+		right.multiplyRight(dst);
+		}
+
+	/**
+	\brief The vector goes through the chain from the right, one matrix-vector product per matrix.
+	*/
+	template<class V>
+	SR_CONSTEXPR void transform(const V& src, V& dst) const
+		{
+		right.transform(src, dst);
+		left.transform(dst, dst);
+		}
+
+	private:
+	L left;
+	R right;
+	};
+
+/**
+\brief Wrapper of the expression nodes, provides the operators.
+*/
+template<class E>
+class SrMatExpr
+	{
+	public:
+	typedef typename E::Matrix Matrix;
+
+	SR_CONSTEXPR explicit SrMatExpr(const E& node) : e(node)
+		{
+		}
+
+	/**
+	\brief dst = this. dst must not be an operand of the expression.
+	*/
+	SR_CONSTEXPR void evaluate(Matrix& dst) const
+		{
+		e.evaluate(dst);
+		}
+
+	/**
+	\brief The product as a matrix, can be assigned to an operand.
+	*/
+	SR_CONSTEXPR Matrix eval() const
+		{
+		Matrix dst;
+		e.evaluate(dst);
+		return dst;
+		}
+
+	SR_CONSTEXPR operator Matrix() const
+		{
+		return eval();
+		}
+
+	/**
+	\brief dst = this * src, without evaluating the product.
+	*/
+	template<class V>
+	SR_CONSTEXPR void transform(const V& src, V& dst) const
+		{
+		e.transform(src, dst);
+		}
+
+	SR_CONSTEXPR const E& node() const
+		{
+		return e;
+		}
+
+	private:
+	E e;
+	};
+
+/**
+\brief Starts a lazy product with m.
+*/
+template<class T>
+SR_CONSTEXPR SrMatExpr<SrMatLeaf<SrMatrix33T<T> > > srLazy(const SrMatrix33T<T>& m)
+	{
+	return SrMatExpr<SrMatLeaf<SrMatrix33T<T> > >(SrMatLeaf<SrMatrix33T<T> >(m));
+	}
+
+template<class T>
+SR_CONSTEXPR SrMatExpr<SrMatLeaf<SrMatrix34T<T> > > srLazy(const SrMatrix34T<T>& m)
+	{
+	return SrMatExpr<SrMatLeaf<SrMatrix34T<T> > >(SrMatLeaf<SrMatrix34T<T> >(m));
+	}
+
+/**
+\brief expression * matrix, lazy.
+*/
+template<class E>
+SR_CONSTEXPR SrMatExpr<SrMatProduct<E, SrMatLeaf<typename E::Matrix> > > operator*(const SrMatExpr<E>& left, const typename E::Matrix& right)
+	{
+	typedef SrMatProduct<E, SrMatLeaf<typename E::Matrix> > P;
+	return SrMatExpr<P>(P(left.node(), SrMatLeaf<typename E::Matrix>(right)));
+	}
+
+/**
+\brief matrix * expression, lazy.
+*/
+template<class E>
+SR_CONSTEXPR SrMatExpr<SrMatProduct<SrMatLeaf<typename E::Matrix>, E> > operator*(const typename E::Matrix& left, const SrMatExpr<E>& right)
+	{
+	typedef SrMatProduct<SrMatLeaf<typename E::Matrix>, E> P;
+	return SrMatExpr<P>(P(SrMatLeaf<typename E::Matrix>(left), right.node()));
+	}
+
+/**
+\brief expression * expression, lazy.
+*/
+template<class L, class R>
+SR_CONSTEXPR SrMatExpr<SrMatProduct<L, R> > operator*(const SrMatExpr<L>& left, const SrMatExpr<R>& right)
+	{
+	return SrMatExpr<SrMatProduct<L, R> >(SrMatProduct<L, R>(left.node(), right.node()));
+	}
+
+/**
+\brief expression * vector, evaluated with matrix-vector products only.
+*/
+template<class E, class T>
+SR_CONSTEXPR SrVector3T<T> operator*(const SrMatExpr<E>& left, const SrVector3T<T>& right)
+	{
+	SrVector3T<T> dst;
+	left.transform(right, dst);
+	return dst;
+	}
+
+/** @} */
+#endif
@@ -0,0 +1,357 @@
+/************************************************************************
+\file 	SrParallel.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRPARALLEL_H_
+#define SR_FOUNDATION_SRPARALLEL_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include "SrSimpleTypes.h"
+
+/**
+\brief One task of a parallel loop, called with the context of the loop and its index.
+*/
+typedef void (*SrParallelTask)(void* context, SrU32 index);
+
+/**
+\brief A job system running the loops of SrParallel, see SrParallel::setJobSystem().
+
+Must call task(context, i) once for every i in [0, count), on the calling thread and up
+to count - 1 others, and return when all calls are done. The tasks may run in any order,
+concurrently or not; user is the pointer given to setJobSystem().
+*/
+typedef void (*SrParallelRun)(void* user, SrU32 count, SrParallelTask task, void* context);
+
+/**
+\brief Pool of worker threads, the default job system of SrParallel.
+
+The workers are started by the first run that needs them and then wait on a condition
+variable, so a run costs waking them instead of starting threads. The calling thread
+takes tasks as well. One run at a time: a run from inside a task, or from another thread
+while one is going on, calls its tasks on the calling thread.
+*/
+class SrThreadPool
+	{
+	public:
+	SR_INLINE SrThreadPool();
+	SR_INLINE ~SrThreadPool();
+
+	/**
+	\brief Calls task(context, i) for every i in [0, count) on up to count threads, the
+	calling one included, and returns when all are done.
+	*/
+	SR_INLINE void run(SrU32 count, SrParallelTask task, void* context);
+
+	/**
+	\brief Worker threads started so far.
+	*/
+	SR_INLINE SrU32 getWorkerCount() const;
+
+	private:
+	SrThreadPool(const SrThreadPool&);
+	SrThreadPool& operator=(const SrThreadPool&);
+
+	SR_INLINE void work(SrU32 count, SrParallelTask task, void* context);
+	SR_INLINE void workerLoop();
+
+	std::vector<std::thread> mWorkers;
+	std::mutex mRunLock;
+	std::mutex mLock;
+	std::condition_variable mWake;
+	std::condition_variable mIdle;
+	std::atomic<SrU32> mNext;
+	SrParallelTask mTask;
+	void* mContext;
+	SrU32 mCount;
+	SrU32 mGeneration;
+	SrU32 mActive;
+	bool mOpen;
+	bool mStop;
+	};
+
+/**
+\brief Static class splitting a loop over n elements across threads.
+
+The ranges run on the threads of an SrThreadPool shared by the program, or on the job
+system of the application once setJobSystem() was called. Waking the pool costs a few
+microseconds per thread, so loops are only split into ranges of several thousand
+elements. GCC and clang need -pthread to link it with glibc older than 2.34.
+*/
+class SrParallel
+	{
+	public:
+	/**
+	\brief The ranges start at multiples of this, so the lanes of the SoA containers are
+	split on cache line boundaries and every range but the last fills whole registers.
+	*/
+	static const SrU32 Granularity = 16;
+
+	/**
+	\brief Hardware threads of the machine, at least 1.
+	*/
+	SR_INLINE static SrU32 getThreadCount();
+
+	/**
+	\brief Runs the loops on run(user, ...) instead of the pool, NULL restores the pool.
+
+	Not thread safe, call it before loops run on other threads.
+	*/
+	SR_INLINE static void setJobSystem(SrParallelRun run, void* user);
+
+	/**
+	\brief The pool used when no job system was set.
+	*/
+	SR_INLINE static SrThreadPool& getPool();
+
+	/**
+	\brief Calls function(begin, end) on up to threadCount contiguous ranges covering [0, n),
+	and returns when all are done.
+
+	No range is shorter than minCount, so small loops run on fewer threads or only on the
+	calling one. threadCount 0 means getThreadCount().
+	*/
+	template<class F>
+	SR_INLINE static void forRange(SrU32 n, SrU32 threadCount, SrU32 minCount, const F& function);
+
+	/**
+	\brief Like forRange(), but the threads take chunks of chunkCount elements in turn until
+	[0, n) is done, so function(begin, end) runs many times per thread on ranges that fit a
+	cache, and a thread that is slowed down does not hold up the others.
+
+	chunkCount is rounded up to a multiple of Granularity.
+	*/
+	template<class F>
+	SR_INLINE static void forChunks(SrU32 n, SrU32 threadCount, SrU32 minCount, SrU32 chunkCount, const F& function);
+
+	private:
+	struct JobSystem
+		{
+		SrParallelRun run;
+		void* user;
+		};
+
+	SR_INLINE static JobSystem& getJobSystem();
+	SR_INLINE static void run(SrU32 count, SrParallelTask task, void* context);
+
+	template<class F>
+	struct Ranges
+		{
+		const F* function;
+		SrU32 n;
+		SrU32 chunk;
+
+		static void task(void* context, SrU32 index);
+		};
+
+	template<class F>
+	struct Chunks
+		{
+		const F* function;
+		SrU64 n;
+		SrU64 chunk;
+		std::atomic<SrU64> next;
+
+		static void task(void* context, SrU32 index);
+		};
+
+	SR_INLINE static SrU32 getLoopThreads(SrU32 n, SrU32 threadCount, SrU32 minCount);
+	};
+
+
+SR_INLINE SrThreadPool::SrThreadPool()
+	: mNext(0), mTask(NULL), mContext(NULL), mCount(0), mGeneration(0), mActive(0), mOpen(false), mStop(false)
+	{
+	}
+
+SR_INLINE SrThreadPool::~SrThreadPool()
+	{
+		{
+		std::lock_guard<std::mutex> lock(mLock);
+		mStop = true;
+		}
+	mWake.notify_all();
+	for(SrU32 i = 0; i < mWorkers.size(); i++)
+		mWorkers[i].join();
+	}
+
+SR_INLINE SrU32 SrThreadPool::getWorkerCount() const
+	{
+	return (SrU32)mWorkers.size();
+	}
+
+SR_INLINE void SrThreadPool::work(SrU32 count, SrParallelTask task, void* context)
+	{
+	for(;;)
+		{
+		const SrU32 i = mNext.fetch_add(1);
+		if(i >= count)
+			break;
+		task(context, i);
+		}
+	}
+
+SR_INLINE void SrThreadPool::workerLoop()
+	{
+	std::unique_lock<std::mutex> lock(mLock);
+	SrU32 seen = mGeneration;
+	for(;;)
+		{
+		mWake.wait(lock, [&]() { return mStop || (mOpen && mGeneration != seen); });
+		if(mStop)
+			return;
+		//a run only returns once no worker is active, so the job read here stays valid.
+		seen = mGeneration;
+		mActive++;
+		const SrU32 count = mCount;
+		const SrParallelTask task = mTask;
+		void* const context = mContext;
+		lock.unlock();
+		work(count, task, context);
+		lock.lock();
+		if(--mActive == 0)
+			mIdle.notify_one();
+		}
+	}
+
+SR_INLINE void SrThreadPool::run(SrU32 count, SrParallelTask task, void* context)
+	{
+	std::unique_lock<std::mutex> runLock(mRunLock, std::try_to_lock);
+	if(count <= 1 || !runLock.owns_lock())
+		{
+		for(SrU32 i = 0; i < count; i++)
+			task(context, i);
+		return;
+		}
+
+		{
+		std::lock_guard<std::mutex> lock(mLock);
+		while(mWorkers.size() < count - 1)
+			mWorkers.push_back(std::thread(&SrThreadPool::workerLoop, this));
+		mTask = task;
+		mContext = context;
+		mCount = count;
+		mNext = 0;
+		mGeneration++;
+		mOpen = true;
+		}
+	mWake.notify_all();
+	work(count, task, context);
+
+	//the tasks are all taken, wait for the workers still running theirs.
+	std::unique_lock<std::mutex> lock(mLock);
+	mOpen = false;
+	mIdle.wait(lock, [&]() { return mActive == 0; });
+	}
+
+SR_INLINE SrU32 SrParallel::getThreadCount()
+	{
+	const SrU32 count = std::thread::hardware_concurrency();
+	return count ? count : 1;
+	}
+
+SR_INLINE SrParallel::JobSystem& SrParallel::getJobSystem()
+	{
+	static JobSystem jobSystem = { NULL, NULL };
+	return jobSystem;
+	}
+
+SR_INLINE void SrParallel::setJobSystem(SrParallelRun run, void* user)
+	{
+	getJobSystem().run = run;
+	getJobSystem().user = user;
+	}
+
+SR_INLINE SrThreadPool& SrParallel::getPool()
+	{
+	static SrThreadPool pool;
+	return pool;
+	}
+
+SR_INLINE void SrParallel::run(SrU32 count, SrParallelTask task, void* context)
+	{
+	const JobSystem& jobSystem = getJobSystem();
+	if(jobSystem.run)
+		jobSystem.run(jobSystem.user, count, task, context);
+	else
+		getPool().run(count, task, context);
+	}
+
+SR_INLINE SrU32 SrParallel::getLoopThreads(SrU32 n, SrU32 threadCount, SrU32 minCount)
+	{
+	if(threadCount == 0)
+		threadCount = getThreadCount();
+	if(minCount && threadCount > n / minCount)
+		threadCount = n / minCount;
+	return threadCount;
+	}
+
+template<class F>
+void SrParallel::Ranges<F>::task(void* context, SrU32 index)
+	{
+	const Ranges& ranges = *(const Ranges*)context;
+	const SrU32 begin = index * ranges.chunk;
+	const SrU32 end = ranges.n - begin > ranges.chunk ? begin + ranges.chunk : ranges.n;
+	(*ranges.function)(begin, end);
+	}
+
+template<class F>
+void SrParallel::Chunks<F>::task(void* context, SrU32)
+	{
+	Chunks& chunks = *(Chunks*)context;
+	for(;;)
+		{
+		const SrU64 begin = chunks.next.fetch_add(chunks.chunk);
+		if(begin >= chunks.n)
+			break;
+		(*chunks.function)((SrU32)begin, (SrU32)(begin + chunks.chunk < chunks.n ? begin + chunks.chunk : chunks.n));
+		}
+	}
+
+template<class F>
+SR_INLINE void SrParallel::forRange(SrU32 n, SrU32 threadCount, SrU32 minCount, const F& function)
+	{
+	threadCount = getLoopThreads(n, threadCount, minCount);
+	if(threadCount <= 1)
+		{
+		function(0, n);
+		return;
+		}
+
+	Ranges<F> ranges;
+	ranges.function = &function;
+	ranges.n = n;
+	ranges.chunk = (n + threadCount - 1) / threadCount;
+	ranges.chunk = (ranges.chunk + Granularity - 1) / Granularity * Granularity;
+	run((n + ranges.chunk - 1) / ranges.chunk, Ranges<F>::task, &ranges);
+	}
+
+template<class F>
+SR_INLINE void SrParallel::forChunks(SrU32 n, SrU32 threadCount, SrU32 minCount, SrU32 chunkCount, const F& function)
+	{
+	threadCount = getLoopThreads(n, threadCount, minCount);
+	if(threadCount <= 1)
+		{
+		function(0, n);
+		return;
+		}
+
+	//every task takes chunks until none is left, so each one runs wherever it is started.
+	Chunks<F> chunks;
+	chunks.function = &function;
+	chunks.n = n;
+	chunks.chunk = chunkCount ? (chunkCount + Granularity - 1) / Granularity * Granularity : Granularity;
+	chunks.next = 0;
+	run(threadCount, Chunks<F>::task, &chunks);
+	}
+
+/** @} */
+#endif
@@ -16,26 +16,34 @@
 /**
 \brief This is a quaternion class. For more information on quaternion mathematics
 consult a mathematics source on complex numbers.
- 
+
+T is the precision, SrQuaternion and SrQuaternionF64 are the SrF32 and SrF64 typedefs.
 */
 
-class SrQuaternion
+template<class T>
+class SrQuaternionT
 	{
 	public:
 	/**
 	\brief Default constructor, does not do any initialization.
 	*/
-	SR_INLINE SrQuaternion();
+	SR_CONSTEXPR SrQuaternionT();
 
 	/**
 	\brief Copy constructor.
 	*/
-	SR_INLINE SrQuaternion(const SrQuaternion&);
+	SR_CONSTEXPR SrQuaternionT(const SrQuaternionT&);
+
+	/**
+	\brief Converts from the other precision.
+	*/
+	template<class U>
+	SR_CONSTEXPR explicit SrQuaternionT(const SrQuaternionT<U>&);
 
 	/**
 	\brief copies xyz elements from v, and scalar from w (defaults to 0).
 	*/
-	SR_INLINE SrQuaternion(const SrVector3& v, float w = 0);
+	SR_CONSTEXPR SrQuaternionT(const SrVector3T<T>& v, T w = 0);
 
 	/**
 	\brief creates from angle-axis representation.
@@ -44,65 +52,65 @@ class SrQuaternion
 	
 	<b>Unit:</b> Degrees
 	*/
-	SR_INLINE SrQuaternion(const float angle, const SrVector3 & axis);
+	SR_CONSTEXPR SrQuaternionT(const T angle, const SrVector3T<T> & axis);
 
 	/**
 	\brief Creates from orientation matrix.
 
 	\param[in] m Rotation matrix to extract quaternion from.
 	*/
-	SR_INLINE SrQuaternion(const class SrMatrix33 &m); /* defined in SrMatrix33.h */
+	SR_CONSTEXPR SrQuaternionT(const SrMatrix33T<T> &m); /* defined in SrMatrix33.h */
 
 
 	/**
 	\brief Set the quaternion to the identity rotation.
 	*/
-	SR_INLINE void id();
+	SR_CONSTEXPR void id();
 
 	/**
 	\brief Test if the quaternion is the identity rotation.
 	*/
-	SR_INLINE bool isIdentityRotation() const;
+	SR_CONSTEXPR bool isIdentityRotation() const;
 
 	//setting:
 
 	/**
 	\brief Set the members of the quaternion, in order WXYZ
 	*/
-	SR_INLINE void setWXYZ(float w, float x, float y, float z);
+	SR_CONSTEXPR void setWXYZ(T w, T x, T y, T z);
 
 	/**
 	\brief Set the members of the quaternion, in order XYZW
 	*/
-	SR_INLINE void setXYZW(float x, float y, float z, float w);
+	SR_CONSTEXPR void setXYZW(T x, T y, T z, T w);
 
 	/**
 	\brief Set the members of the quaternion, in order WXYZ
 	*/
-	SR_INLINE void setWXYZ(const float *);
+	SR_CONSTEXPR void setWXYZ(const T *);
 
 	/**
 	\brief Set the members of the quaternion, in order XYZW
 	*/
-	SR_INLINE void setXYZW(const float *);
+	SR_CONSTEXPR void setXYZW(const T *);
 
-	SR_INLINE SrQuaternion& operator=  (const SrQuaternion&);
+	SR_CONSTEXPR SrQuaternionT& operator=  (const SrQuaternionT&);
 
 	/**
 	\brief Implicitly extends vector by a 0 w element.
 	*/
-	SR_INLINE SrQuaternion& operator=  (const SrVector3&);
+	SR_INLINE SrQuaternionT& operator=  (const SrVector3T<T>&);
 
-	SR_INLINE void setx(const float& d);
-	SR_INLINE void sety(const float& d);
-	SR_INLINE void setz(const float& d);
-	SR_INLINE void setw(const float& d);
+	SR_CONSTEXPR void setx(const T& d);
+	SR_CONSTEXPR void sety(const T& d);
+	SR_CONSTEXPR void setz(const T& d);
+	SR_CONSTEXPR void setw(const T& d);
 
-	SR_INLINE void getWXYZ(SrF32 *) const;
-	SR_INLINE void getXYZW(SrF32 *) const;
+	SR_CONSTEXPR void getWXYZ(SrF32 *) const;
+	SR_CONSTEXPR void getXYZW(SrF32 *) const;
 
-	SR_INLINE void getWXYZ(SrF64 *) const;
-	SR_INLINE void getXYZW(SrF64 *) const;
+	SR_CONSTEXPR void getWXYZ(SrF64 *) const;
+	SR_CONSTEXPR void getXYZW(SrF64 *) const;
 
 	/**
 	\brief returns true if all elements are finite (not NAN or INF, etc.)
@@ -112,12 +120,27 @@ class SrQuaternion
 	/**
 	\brief sets to the quat [0,0,0,1]
 	*/
-	SR_INLINE void zero();
+	SR_CONSTEXPR void zero();
 
 	/**
-	\brief creates a random unit quaternion.
+	\brief creates a random unit quaternion, uniform over all rotations, from SrMath::getRandom().
 	*/
 	SR_INLINE void random();
+
+	/**
+	\brief creates a random unit quaternion, uniform over all rotations, from r.
+	*/
+	SR_INLINE void random(SrRandom& r);
+
+	/**
+	\brief maps a point of the unit cube to a unit quaternion (Shoemake, Graphics Gems III):
+
+	(sqrt(1-u1) sin(2 pi u2), sqrt(1-u1) cos(2 pi u2), sqrt(u1) sin(2 pi u3), sqrt(u1) cos(2 pi u3))
+
+	The map preserves volume, uniform points give uniform rotations and evenly spread
+	points, stratified or low-discrepancy, give evenly spread rotations. See SrRotationSampler.
+	*/
+	SR_INLINE void fromUnitCube(T u1, T u2, T u3);
 	/**
 	\brief creates from angle-axis representation.
 
@@ -125,7 +148,7 @@ class SrQuaternion
 	
 	<b>Unit:</b> Degrees
 	*/
-	SR_INLINE void fromAngleAxis(float angle, const SrVector3 & axis);
+	SR_CONSTEXPR void fromAngleAxis(T angle, const SrVector3T<T> & axis);
 
 	/**
 	\brief Creates from angle-axis representation.
@@ -134,160 +157,232 @@ class SrQuaternion
 	
 	<b>Unit:</b> Radians
 	*/
-	SR_INLINE void fromAngleAxisFast(float AngleRadians, const SrVector3 & axis);
+	SR_INLINE void fromAngleAxisFast(T AngleRadians, const SrVector3T<T> & axis);
 
 	/**
 	\brief Sets this to the opposite rotation of this.
 	*/
-	SR_INLINE void invert();
+	SR_CONSTEXPR void invert();
 
 	/**
 	\brief Fetches the Angle/axis given by the SrQuaternion.
 
 	<b>Unit:</b> Degrees
 	*/
-	SR_INLINE void getAngleAxis(float& Angle, SrVector3 & axis) const;
+	SR_INLINE void getAngleAxis(T& Angle, SrVector3T<T> & axis) const;
 
 	/**
 	\brief Gets the angle between this quat and the identity quaternion.
 
 	<b>Unit:</b> Degrees
 	*/
-	SR_INLINE float getAngle() const;
+	SR_INLINE T getAngle() const;
 
 	/**
 	\brief Gets the angle between this quat and the argument
 
 	<b>Unit:</b> Degrees
 	*/
-	SR_INLINE float getAngle(const SrQuaternion &) const;
+	SR_INLINE T getAngle(const SrQuaternionT &) const;
+
+	/**
+	\brief this = exp((v, 0)) = (v/|v| sin|v|, cos|v|), the rotation by 2|v| about v.
+
+	Below |v| = 0.12 (0.0045 in double) sin|v|/|v| comes from its series, which is within
+	rounding there, so small and zero v need no division.
+
+	<b>Unit:</b> Radians
+	*/
+	SR_INLINE void exp(const SrVector3T<T>& v);
+
+	/**
+	\brief The inverse of exp(): the vector part of the logarithm, xyz/|xyz| atan2(|xyz|, w).
+
+	Its length is half the angle of the rotation, in [0, pi]. The magnitude of this is
+	ignored. Below r = |xyz|/w = 0.08 (0.003 in double) atan(r)/r comes from its series
+	instead of a division by the sine, within 1.12 ulp (1.44 in double) of atan(r)/r. The
+	identity and -identity give (0,0,0) and (pi,0,0).
+
+	<b>Unit:</b> Radians
+	*/
+	SR_INLINE SrVector3T<T> log() const;
+
+	/**
+	\brief this = q^t = exp(t log(q)), t times the rotation of q about the same axis.
+
+	The magnitude of q is ignored. q and -q give different powers, negate q when w < 0 to
+	scale the shorter rotation.
+	*/
+	SR_INLINE void pow(const SrQuaternionT& q, T t);
+
+	/**
+	\brief creates from a rotation vector, the axis scaled by the angle: exp(v/2).
+
+	<b>Unit:</b> Radians
+	*/
+	SR_INLINE void fromRotationVector(const SrVector3T<T>& v);
+
+	/**
+	\brief the rotation vector, 2 log() of this or of -this, whichever has w >= 0, so the
+	angle is in [0, pi].
+
+	<b>Unit:</b> Radians
+	*/
+	SR_INLINE SrVector3T<T> getRotationVector() const;
 
 	/**
 	\brief This is the squared 4D vector length, should be 1 for unit quaternions.
 	*/
-	SR_INLINE float magnitudeSquared() const;
+	SR_CONSTEXPR T magnitudeSquared() const;
 
 	/**
 	\brief returns the scalar product of this and other.
 	*/
-	SR_INLINE float dot(const SrQuaternion &other) const;
+	SR_CONSTEXPR T dot(const SrQuaternionT &other) const;
 
 	//modifiers:
 	/**
 	\brief maps to the closest unit quaternion.
 	*/
-	SR_INLINE void normalize();
+	SR_CONSTEXPR void normalize();
 
 	/*
 	\brief assigns its own conjugate to itself.
 
 	\note for unit quaternions, this is the inverse.
 	*/
-	SR_INLINE void conjugate();
+	SR_CONSTEXPR void conjugate();
 
 	/**
 	this = a * b
 	*/
-	SR_INLINE void multiply(const SrQuaternion& a, const SrQuaternion& b);
+	SR_CONSTEXPR void multiply(const SrQuaternionT& a, const SrQuaternionT& b);
 
 	/**
 	this = a * v
 	v is interpreted as quat [xyz0]
 	*/
-	SR_INLINE void multiply(const SrQuaternion& a, const SrVector3& v);
+	SR_CONSTEXPR void multiply(const SrQuaternionT& a, const SrVector3T<T>& v);
 
 	/**
 	this = slerp(t, a, b)
 	*/
-	SR_INLINE void slerp(const float t, const SrQuaternion& a, const SrQuaternion& b);
+	SR_INLINE void slerp(const T t, const SrQuaternionT& a, const SrQuaternionT& b);
+
+	/**
+	this = normalize(a*(1-t) + b*t), b sign flipped for the shorter arc.
+	No trig but the angular velocity is not constant, up to 0.14 rad off slerp at 180 degrees.
+	*/
+	SR_CONSTEXPR void nlerp(const T t, const SrQuaternionT& a, const SrQuaternionT& b);
+
+	/**
+	nlerp with t reparameterised by a polynomial in t and |a.dot(b)|, so that it follows
+	slerp to within 1e-4 rad of rotation, still without any trig.
+	*/
+	SR_CONSTEXPR void correctedNlerp(const T t, const SrQuaternionT& a, const SrQuaternionT& b);
+
+	/**
+	\brief the reparameterised t used by correctedNlerp(), cosine is |a.dot(b)|.
+	*/
+	SR_CONSTEXPR static T correctNlerpT(const T t, const T cosine);
 
 	/**
 	rotates passed vec by rot expressed by unit quaternion.  overwrites arg with the result.
 	*/
-	SR_INLINE void rotate(SrVector3 &) const;
+	SR_CONSTEXPR void rotate(SrVector3T<T> &) const;
 
 	/**
 	rotates passed vec by this (assumed unitary)
 	*/
-	SR_INLINE const SrVector3 rot(const SrVector3 &) const;
+	SR_CONSTEXPR const SrVector3T<T> rot(const SrVector3T<T> &) const;
 
 	/**
 	inverse rotates passed vec by this (assumed unitary)
 	*/
-	SR_INLINE const SrVector3 invRot(const SrVector3 &) const;
+	SR_CONSTEXPR const SrVector3T<T> invRot(const SrVector3T<T> &) const;
 
 	/**
 	transform passed vec by this rotation (assumed unitary) and translation p
 	*/
-	SR_INLINE const SrVector3 transform(const SrVector3 &v, const SrVector3 &p) const;
+	SR_CONSTEXPR const SrVector3T<T> transform(const SrVector3T<T> &v, const SrVector3T<T> &p) const;
 
 	/**
 	inverse rotates passed vec by this (assumed unitary)
 	*/
-	SR_INLINE const SrVector3 invTransform(const SrVector3 &v, const SrVector3 &p) const;
+	SR_CONSTEXPR const SrVector3T<T> invTransform(const SrVector3T<T> &v, const SrVector3T<T> &p) const;
 
 
 	/**
 	rotates passed vec by opposite of rot expressed by unit quaternion.  overwrites arg with the result.
 	*/
-	SR_INLINE void inverseRotate(SrVector3 &) const;
+	SR_CONSTEXPR void inverseRotate(SrVector3T<T> &) const;
 
 
 
 	/**
 	negates all the elements of the quat.  q and -q represent the same rotation.
 	*/
-	SR_INLINE void negate();
-	SR_INLINE SrQuaternion operator -() const; 
+	SR_CONSTEXPR void negate();
+	SR_CONSTEXPR SrQuaternionT operator -() const; 
 
-	SR_INLINE SrQuaternion& operator*= (const SrQuaternion&);
-	SR_INLINE SrQuaternion& operator+= (const SrQuaternion&);
-	SR_INLINE SrQuaternion& operator-= (const SrQuaternion&);
-	SR_INLINE SrQuaternion& operator*= (const float s);
+	SR_CONSTEXPR SrQuaternionT& operator*= (const SrQuaternionT&);
+	SR_CONSTEXPR SrQuaternionT& operator+= (const SrQuaternionT&);
+	SR_CONSTEXPR SrQuaternionT& operator-= (const SrQuaternionT&);
+	SR_CONSTEXPR SrQuaternionT& operator*= (const T s);
 
 	/** the quaternion elements */
-    float x,y,z,w;
+    T x,y,z,w;
 
 	/** quaternion multiplication */
-	SR_INLINE SrQuaternion operator *(const SrQuaternion &) const; 
+	SR_CONSTEXPR SrQuaternionT operator *(const SrQuaternionT &) const; 
 
 	/** quaternion addition */
-	SR_INLINE SrQuaternion operator +(const SrQuaternion &) const; 
+	SR_CONSTEXPR SrQuaternionT operator +(const SrQuaternionT &) const; 
 
 	/** quaternion subtraction */
-	SR_INLINE SrQuaternion operator -(const SrQuaternion &) const; 
+	SR_CONSTEXPR SrQuaternionT operator -(const SrQuaternionT &) const; 
 
 	/** quaternion conjugate */
-	SR_INLINE SrQuaternion operator !() const; 
+	SR_CONSTEXPR SrQuaternionT operator !() const; 
 
     /* 
 	ops we decided not to implement:
-	bool  operator== (const SrQuaternion&) const;
-	SrVector3  operator^  (const SrQuaternion& r_h_s) const;//same as normal quat rot, but casts itself into a vector.  (doesn't compute w term)
-	SrQuaternion  operator*  (const SrVector3& v) const;//implicitly extends vector by a 0 w element.
-	SrQuaternion  operator*  (const float Scale) const;
+	bool  operator== (const SrQuaternionT&) const;
+	SrVector3T<T>  operator^  (const SrQuaternionT& r_h_s) const;//same as normal quat rot, but casts itself into a vector.  (doesn't compute w term)
+	SrQuaternionT  operator*  (const SrVector3T<T>& v) const;//implicitly extends vector by a 0 w element.
+	SrQuaternionT  operator*  (const T Scale) const;
 	*/
 
-	friend class SrMatrix33;
+	friend class SrMatrix33T<T>;
 	private:
-		SrQuaternion(float ix, float iy, float iz, float iw);
+		SR_CONSTEXPR SrQuaternionT(T ix, T iy, T iz, T iw);
 	};
 
 
 
 
-SR_INLINE SrQuaternion::SrQuaternion()
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T>::SrQuaternionT()
 	{
 	//nothing
 	}
 
 
-SR_INLINE SrQuaternion::SrQuaternion(const SrQuaternion& q) : x(q.x), y(q.y), z(q.z), w(q.w)
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T>::SrQuaternionT(const SrQuaternionT<T>& q) : x(q.x), y(q.y), z(q.z), w(q.w)
 	{
 	}
 
 
-SR_INLINE SrQuaternion::SrQuaternion(const SrVector3& v, float s)						// copy constructor, assumes w=0 
+template<class T>
+template<class U>
+SR_CONSTEXPR SrQuaternionT<T>::SrQuaternionT(const SrQuaternionT<U>& q) : x((T)q.x), y((T)q.y), z((T)q.z), w((T)q.w)
+	{
+	}
+
+
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T>::SrQuaternionT(const SrVector3T<T>& v, T s)						// copy constructor, assumes w=0 
 	{
 	x = v.x;
 	y = v.y;
@@ -296,27 +391,31 @@ SR_INLINE SrQuaternion::SrQuaternion(const SrVector3& v, float s)						// copy c
 	}
 
 
-SR_INLINE SrQuaternion::SrQuaternion(const float angle, const SrVector3 & axis)				// creates a SrQuaternion from an Angle axis -- note that if Angle > 360 the resulting rotation is Angle mod 360
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T>::SrQuaternionT(const T angle, const SrVector3T<T> & axis)				// creates a SrQuaternion from an Angle axis -- note that if Angle > 360 the resulting rotation is Angle mod 360
 	{
 	fromAngleAxis(angle,axis);
 	}
 
 
-SR_INLINE void SrQuaternion::id()
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::id()
 	{
-	x = float(0);
-	y = float(0);
-	z = float(0);
-	w = float(1);
+	x = T(0);
+	y = T(0);
+	z = T(0);
+	w = T(1);
 	}
 
-SR_INLINE bool SrQuaternion::isIdentityRotation() const
+template<class T>
+SR_CONSTEXPR bool SrQuaternionT<T>::isIdentityRotation() const
 {
-	return x==0 && y==0 && z==0 && fabsf(w)==1;
+	return x==0 && y==0 && z==0 && SrMath::abs(w)==1;
 }
 
 
-SR_INLINE void SrQuaternion::setWXYZ(float sw, float sx, float sy, float sz)
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::setWXYZ(T sw, T sx, T sy, T sz)
 	{
 	x = sx;
 	y = sy;
@@ -325,7 +424,8 @@ SR_INLINE void SrQuaternion::setWXYZ(float sw, float sx, float sy, float sz)
 	}
 
 
-SR_INLINE void SrQuaternion::setXYZW(float sx, float sy, float sz, float sw)
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::setXYZW(T sx, T sy, T sz, T sw)
 	{
 	x = sx;
 	y = sy;
@@ -334,7 +434,8 @@ SR_INLINE void SrQuaternion::setXYZW(float sx, float sy, float sz, float sw)
 	}
 
 
-SR_INLINE void SrQuaternion::setWXYZ(const float * d)
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::setWXYZ(const T * d)
 	{
 	x = d[1];
 	y = d[2];
@@ -343,7 +444,8 @@ SR_INLINE void SrQuaternion::setWXYZ(const float * d)
 	}
 
 
-SR_INLINE void SrQuaternion::setXYZW(const float * d)
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::setXYZW(const T * d)
 	{
 	x = d[0];
 	y = d[1];
@@ -352,7 +454,8 @@ SR_INLINE void SrQuaternion::setXYZW(const float * d)
 	}
 
 
-SR_INLINE void SrQuaternion::getWXYZ(SrF32 *d) const
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::getWXYZ(SrF32 *d) const
 	{
 	d[1] = (SrF32)x;
 	d[2] = (SrF32)y;
@@ -361,7 +464,8 @@ SR_INLINE void SrQuaternion::getWXYZ(SrF32 *d) const
 	}
 
 
-SR_INLINE void SrQuaternion::getXYZW(SrF32 *d) const
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::getXYZW(SrF32 *d) const
 	{
 	d[0] = (SrF32)x;
 	d[1] = (SrF32)y;
@@ -370,7 +474,8 @@ SR_INLINE void SrQuaternion::getXYZW(SrF32 *d) const
 	}
 
 
-SR_INLINE void SrQuaternion::getWXYZ(SrF64 *d) const
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::getWXYZ(SrF64 *d) const
 	{
 	d[1] = (SrF64)x;
 	d[2] = (SrF64)y;
@@ -379,7 +484,8 @@ SR_INLINE void SrQuaternion::getWXYZ(SrF64 *d) const
 	}
 
 
-SR_INLINE void SrQuaternion::getXYZW(SrF64 *d) const
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::getXYZW(SrF64 *d) const
 	{
 	d[0] = (SrF64)x;
 	d[1] = (SrF64)y;
@@ -389,7 +495,8 @@ SR_INLINE void SrQuaternion::getXYZW(SrF64 *d) const
 
 //const methods
  
-SR_INLINE bool SrQuaternion::isFinite() const
+template<class T>
+SR_INLINE bool SrQuaternionT<T>::isFinite() const
 	{
 	return SrMath::isFinite(x) 
 		&& SrMath::isFinite(y) 
@@ -399,16 +506,18 @@ SR_INLINE bool SrQuaternion::isFinite() const
 
 
 
-SR_INLINE void SrQuaternion::zero()
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::zero()
 	{
-	x = float(0.0);
-	y = float(0.0);
-	z = float(0.0);
-	w = float(1.0);
+	x = T(0.0);
+	y = T(0.0);
+	z = T(0.0);
+	w = T(1.0);
 	}
 
 
-SR_INLINE void SrQuaternion::negate()
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::negate()
 	{
 	x = -x;
 	y = -y;
@@ -416,23 +525,45 @@ SR_INLINE void SrQuaternion::negate()
 	w = -w;
 	}
 
-SR_INLINE SrQuaternion SrQuaternion::operator-() const
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T> SrQuaternionT<T>::operator-() const
 	{
-	return SrQuaternion(-x,-y,-z,-w);
+	return SrQuaternionT<T>(-x,-y,-z,-w);
 	}
 
 
-SR_INLINE void SrQuaternion::random()
+template<class T>
+SR_INLINE void SrQuaternionT<T>::random()
 	{
-	x = SrMath::rand(float(0.0),float(1.0));
-	y = SrMath::rand(float(0.0),float(1.0));
-	z = SrMath::rand(float(0.0),float(1.0));
-	w = SrMath::rand(float(0.0),float(1.0));
-	normalize();
+	random(SrMath::getRandom());
 	}
 
+template<class T>
+SR_INLINE void SrQuaternionT<T>::random(SrRandom& r)
+	{
+	const T u1 = r.rand(T(0.0),T(1.0));
+	const T u2 = r.rand(T(0.0),T(1.0));
+	const T u3 = r.rand(T(0.0),T(1.0));
+	fromUnitCube(u1, u2, u3);
+	}
 
-SR_INLINE void SrQuaternion::fromAngleAxis(float Angle, const SrVector3 & axis)			// set the SrQuaternion by Angle-axis (see AA constructor)
+template<class T>
+SR_INLINE void SrQuaternionT<T>::fromUnitCube(T u1, T u2, T u3)
+	{
+	const T r1 = SrMath::sqrt(T(1.0) - u1);
+	const T r2 = SrMath::sqrt(u1);
+	T s2, c2, s3, c3;
+	SrMath::sinCos(T(SrTwoPiF64) * u2, s2, c2);
+	SrMath::sinCos(T(SrTwoPiF64) * u3, s3, c3);
+	x = r1 * s2;
+	y = r1 * c2;
+	z = r2 * s3;
+	w = r2 * c3;
+	}
+
+
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::fromAngleAxis(T Angle, const SrVector3T<T> & axis)			// set the SrQuaternion by Angle-axis (see AA constructor)
 	{
 	x = axis.x;
 	y = axis.y;
@@ -440,93 +571,172 @@ SR_INLINE void SrQuaternion::fromAngleAxis(float Angle, const SrVector3 & axis)
 
 	// required: Normalize the axis
 
-	const float i_length =  float(1.0) / SrMath::sqrt( x*x + y*y + z*z );
+	const T i_length =  T(1.0) / SrMath::sqrt( x*x + y*y + z*z );
 	
 	x = x * i_length;
 	y = y * i_length;
 	z = z * i_length;
 
 	// now make a clQuaternionernion out of it
-	float Half = SrMath::degToRad(Angle * float(0.5));
+	T Half = SrMath::degToRad(Angle * T(0.5));
 
 	w = SrMath::cos(Half);//this used to be w/o deg to rad.
-	const float sin_theta_over_two = SrMath::sin(Half);
+	const T sin_theta_over_two = SrMath::sin(Half);
 	x = x * sin_theta_over_two;
 	y = y * sin_theta_over_two;
 	z = z * sin_theta_over_two;
 	}
 
-SR_INLINE void SrQuaternion::fromAngleAxisFast(float AngleRadians, const SrVector3 & axis)
+template<class T>
+SR_INLINE void SrQuaternionT<T>::fromAngleAxisFast(T AngleRadians, const SrVector3T<T> & axis)
 	{
-	float s;
+	T s;
 	SrMath::sinCos(AngleRadians * 0.5f, s, w);
 	x = axis.x * s;
 	y = axis.y * s;
 	z = axis.z * s;
 	}
 
-SR_INLINE void SrQuaternion::invert()
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::invert()
 	{
 	x = -x;
 	y = -y;
 	z = -z;
 	}
 
-SR_INLINE void SrQuaternion::setx(const float& d) 
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::setx(const T& d) 
 	{ 
 	x = d;
 	}
 
 
-SR_INLINE void SrQuaternion::sety(const float& d) 
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::sety(const T& d) 
 	{ 
 	y = d;
 	}
 
 
-SR_INLINE void SrQuaternion::setz(const float& d) 
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::setz(const T& d) 
 	{ 
 	z = d;
 	}
 
 
-SR_INLINE void SrQuaternion::setw(const float& d) 
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::setw(const T& d) 
 	{ 
 	w = d;
 	}
 
 
-SR_INLINE void SrQuaternion::getAngleAxis(float& angle, SrVector3 & axis) const
+template<class T>
+SR_INLINE void SrQuaternionT<T>::getAngleAxis(T& angle, SrVector3T<T> & axis) const
 	{
 	//return axis and angle of rotation of quaternion
-    angle = SrMath::acos(w) * float(2.0);		//this is getAngle()
-    float sa = SrMath::sqrt(float(1.0) - w*w);
+    angle = SrMath::acos(w) * T(2.0);		//this is getAngle()
+    T sa = SrMath::sqrt(T(1.0) - w*w);
 	if (sa)
 		{
 		axis.set(x/sa,y/sa,z/sa);
 		angle = SrMath::radToDeg(angle);
 		}
 	else
-		axis.set(float(1.0),float(0.0),float(0.0));
+		axis.set(T(1.0),T(0.0),T(0.0));
+
+	}
+
+
+
+template<class T>
+SR_INLINE T SrQuaternionT<T>::getAngle() const
+	{
+	return SrMath::acos(w) * T(2.0);
+	}
+
+
+
+template<class T>
+SR_INLINE T SrQuaternionT<T>::getAngle(const SrQuaternionT<T> & q) const
+	{
+	return SrMath::acos(dot(q)) * T(2.0);
+	}
+
+
+template<class T>
+SR_INLINE void SrQuaternionT<T>::exp(const SrVector3T<T>& v)
+	{
+	//sin(a)/a = 1 - a^2/6 + a^4/120, the next term is below half an ulp under the limit,
+	//so the series is within 0.52 ulp of sin(a)/a.
+	const T limit = sizeof(T) == sizeof(SrF32) ? T(0.12) : T(0.0045);
+	const T angle = v.magnitude();
+	T s;
+	SrMath::sinCos(angle, s, w);
+	T k;
+	if(angle < limit)
+		{
+		const T a2 = angle * angle;
+		k = T(1) - a2 * (T(1.0 / 6.0) - a2 * T(1.0 / 120.0));
+		}
+	else
+		k = s / angle;
+	x = v.x * k;
+	y = v.y * k;
+	z = v.z * k;
+	}
+
+
 
+template<class T>
+SR_INLINE SrVector3T<T> SrQuaternionT<T>::log() const
+	{
+	//atan(r)/r = 1 - r^2/3 + r^4/5, within 1.12 ulp (1.44 in double) under the limit,
+	//which is still closer than atan2(s, w)/s.
+	const T limit = sizeof(T) == sizeof(SrF32) ? T(0.08) : T(0.003);
+	const SrVector3T<T> v(x, y, z);
+	const T s = v.magnitude();
+	if(w > 0 && s < limit * w)
+		{
+		const T r = s / w;
+		const T r2 = r * r;
+		return v * ((T(1) - r2 * (T(1.0 / 3.0) - r2 * T(0.2))) / w);
+		}
+	if(s == 0)
+		return SrVector3T<T>(w < 0 ? T(SrPiF64) : T(0), T(0), T(0));
+	return v * (SrMath::atan2(s, w) / s);
 	}
 
 
 
-SR_INLINE float SrQuaternion::getAngle() const
+template<class T>
+SR_INLINE void SrQuaternionT<T>::pow(const SrQuaternionT<T>& q, T t)
 	{
-	return SrMath::acos(w) * float(2.0);
+	exp(q.log() * t);
 	}
 
 
 
-SR_INLINE float SrQuaternion::getAngle(const SrQuaternion & q) const
+template<class T>
+SR_INLINE void SrQuaternionT<T>::fromRotationVector(const SrVector3T<T>& v)
 	{
-	return SrMath::acos(dot(q)) * float(2.0);
+	exp(v * T(0.5));
 	}
 
 
-SR_INLINE float SrQuaternion::magnitudeSquared() const
+
+template<class T>
+SR_INLINE SrVector3T<T> SrQuaternionT<T>::getRotationVector() const
+	{
+	const SrQuaternionT<T> q = w < 0 ? -*this : *this;
+	return q.log() * T(2);
+	}
+
+
+template<class T>
+SR_CONSTEXPR T SrQuaternionT<T>::magnitudeSquared() const
 
 //modifiers:
 	{
@@ -534,18 +744,20 @@ SR_INLINE float SrQuaternion::magnitudeSquared() const
 	}
 
 
-SR_INLINE float SrQuaternion::dot(const SrQuaternion &v) const
+template<class T>
+SR_CONSTEXPR T SrQuaternionT<T>::dot(const SrQuaternionT<T> &v) const
 	{
 	return x * v.x + y * v.y + z * v.z  + w * v.w;
 	}
 
 
-SR_INLINE void SrQuaternion::normalize()											// convert this SrQuaternion to a unit clQuaternionernion
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::normalize()											// convert this SrQuaternion to a unit clQuaternionernion
 	{
-	const float mag = SrMath::sqrt(magnitudeSquared());
+	const T mag = SrMath::sqrt(magnitudeSquared());
 	if (mag)
 		{
-		const float imag = float(1.0) / mag;
+		const T imag = T(1.0) / mag;
 		
 		x *= imag;
 		y *= imag;
@@ -555,7 +767,8 @@ SR_INLINE void SrQuaternion::normalize()											// convert this SrQuaternion
 	}
 
 
-SR_INLINE void SrQuaternion::conjugate()											// convert this SrQuaternion to a unit clQuaternionernion
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::conjugate()											// convert this SrQuaternion to a unit clQuaternionernion
 	{
 	x = -x;
 	y = -y;
@@ -563,9 +776,10 @@ SR_INLINE void SrQuaternion::conjugate()											// convert this SrQuaternion
 	}
 
 
-SR_INLINE void SrQuaternion::multiply(const SrQuaternion& left, const SrQuaternion& right)		// this = a * b
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::multiply(const SrQuaternionT<T>& left, const SrQuaternionT<T>& right)		// this = a * b
 	{
-	float a,b,c,d;
+	T a,b,c,d;
 
 	a =left.w*right.w - left.x*right.x - left.y*right.y - left.z*right.z;
 	b =left.w*right.x + right.w*left.x + left.y*right.z - right.y*left.z;
@@ -579,9 +793,10 @@ SR_INLINE void SrQuaternion::multiply(const SrQuaternion& left, const SrQuaterni
 	}
 
 
-SR_INLINE void SrQuaternion::multiply(const SrQuaternion& left, const SrVector3& right)		// this = a * b
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::multiply(const SrQuaternionT<T>& left, const SrVector3T<T>& right)		// this = a * b
 	{
-	float a,b,c,d;
+	T a,b,c,d;
 
 	a = - left.x*right.x - left.y*right.y - left.z *right.z;
 	b =   left.w*right.x + left.y*right.z - right.y*left.z;
@@ -594,37 +809,38 @@ SR_INLINE void SrQuaternion::multiply(const SrQuaternion& left, const SrVector3&
 	z = d;
 	}
 
-SR_INLINE void SrQuaternion::slerp(const float t, const SrQuaternion& left, const SrQuaternion& right) // this = slerp(t, a, b)
+template<class T>
+SR_INLINE void SrQuaternionT<T>::slerp(const T t, const SrQuaternionT<T>& left, const SrQuaternionT<T>& right) // this = slerp(t, a, b)
 	{
-	const float	quatEpsilon = (float(1.0e-8f));
+	const T	quatEpsilon = (T(1.0e-8f));
 
 	*this = left;
 
-	float cosine = 
+	T cosine = 
 		x * right.x + 
 		y * right.y + 
 		z * right.z + 
 		w * right.w;		//this is left.dot(right)
 
-	float sign = float(1);
+	T sign = T(1);
 	if (cosine < 0)
 		{
 		cosine = - cosine;
-		sign = float(-1);
+		sign = T(-1);
 		}
 
-	float Sin = float(1) - cosine*cosine;
+	T Sin = T(1) - cosine*cosine;
 
 	if(Sin>=quatEpsilon*quatEpsilon)	
 		{
 		Sin = SrMath::sqrt(Sin);
-		const float angle = SrMath::atan2(Sin, cosine);
-		const float i_sin_angle = float(1) / Sin;
+		const T angle = SrMath::atan2(Sin, cosine);
+		const T i_sin_angle = T(1) / Sin;
 
 
 
-		float lower_weight = SrMath::sin(angle*(float(1)-t)) * i_sin_angle;
-		float upper_weight = SrMath::sin(angle * t) * i_sin_angle * sign;
+		T lower_weight = SrMath::sin(angle*(T(1)-t)) * i_sin_angle;
+		T upper_weight = SrMath::sin(angle * t) * i_sin_angle * sign;
 
 		w = (w * (lower_weight)) + (right.w * (upper_weight));
 		x = (x * (lower_weight)) + (right.x * (upper_weight));
@@ -634,10 +850,47 @@ SR_INLINE void SrQuaternion::slerp(const float t, const SrQuaternion& left, cons
 	}
 
 
-SR_INLINE void SrQuaternion::rotate(SrVector3 & v) const						//rotates passed vec by rot expressed by quaternion.  overwrites arg ith the result.
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::nlerp(const T t, const SrQuaternionT<T>& left, const SrQuaternionT<T>& right)
+	{
+	const T cosine = left.dot(right);
+	const T lower = T(1) - t;
+	const T upper = cosine < 0 ? -t : t;
+
+	w = left.w * lower + right.w * upper;
+	x = left.x * lower + right.x * upper;
+	y = left.y * lower + right.y * upper;
+	z = left.z * lower + right.z * upper;
+	normalize();
+	}
+
+
+template<class T>
+SR_CONSTEXPR T SrQuaternionT<T>::correctNlerpT(const T t, const T d)
+	{
+	//t + t(t-1/2)(t-1) * k(d, (t-1/2)^2), k fitted to the exact reparameterisation
+	//sin(t*a) / (sin(t*a) + sin((1-t)*a)) with cos(a) = d, max rotation error 8.2e-5 rad.
+	const T u = (t - T(0.5)) * (t - T(0.5));
+	const T A = T(0.80868966) + d * (T(-2.1468603) + d * (T(2.3788222) + d * T(-1.1890495)));
+	const T B = T(0.85932463) + d * (T(-1.1317307) + d * (T(0.34351365) + d * T(-0.065014729)));
+	const T C = T(1.2257706) + d * (T(-4.1967484) + d * T(3.4871353));
+	const T k = (C * u + A) * u + B;
+	return t + t * (t - T(0.5)) * (t - T(1)) * k;
+	}
+
+
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::correctedNlerp(const T t, const SrQuaternionT<T>& left, const SrQuaternionT<T>& right)
+	{
+	nlerp(correctNlerpT(t, SrMath::abs(left.dot(right))), left, right);
+	}
+
+
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::rotate(SrVector3T<T> & v) const						//rotates passed vec by rot expressed by quaternion.  overwrites arg ith the result.
 	{
-	//float msq = float(1.0)/magnitudeSquared();	//assume unit quat!
-	SrQuaternion myInverse;
+	//T msq = T(1.0)/magnitudeSquared();	//assume unit quat!
+	SrQuaternionT<T> myInverse;
 	myInverse.x = -x;//*msq;
 	myInverse.y = -y;//*msq;
 	myInverse.z = -z;//*msq;
@@ -645,7 +898,7 @@ SR_INLINE void SrQuaternion::rotate(SrVector3 & v) const						//rotates passed v
 
 	//v = ((*this) * v) ^ myInverse;
 
-	SrQuaternion left;
+	SrQuaternionT<T> left;
 	left.multiply(*this,v);
 	v.x =left.w*myInverse.x + myInverse.w*left.x + left.y*myInverse.z - myInverse.y*left.z;
 	v.y =left.w*myInverse.y + myInverse.w*left.y + left.z*myInverse.x - myInverse.z*left.x;
@@ -653,17 +906,18 @@ SR_INLINE void SrQuaternion::rotate(SrVector3 & v) const						//rotates passed v
 	}
 
 
-SR_INLINE void SrQuaternion::inverseRotate(SrVector3 & v) const				//rotates passed vec by opposite of rot expressed by quaternion.  overwrites arg ith the result.
+template<class T>
+SR_CONSTEXPR void SrQuaternionT<T>::inverseRotate(SrVector3T<T> & v) const				//rotates passed vec by opposite of rot expressed by quaternion.  overwrites arg ith the result.
 	{
-	//float msq = float(1.0)/magnitudeSquared();	//assume unit quat!
-	SrQuaternion myInverse;
+	//T msq = T(1.0)/magnitudeSquared();	//assume unit quat!
+	SrQuaternionT<T> myInverse;
 	myInverse.x = -x;//*msq;
 	myInverse.y = -y;//*msq;
 	myInverse.z = -z;//*msq;
 	myInverse.w =  w;//*msq;
 
 	//v = (myInverse * v) ^ (*this);
-	SrQuaternion left;
+	SrQuaternionT<T> left;
 	left.multiply(myInverse,v);
 	v.x =left.w*x + w*left.x + left.y*z - y*left.z;
 	v.y =left.w*y + w*left.y + left.z*x - z*left.x;
@@ -671,7 +925,8 @@ SR_INLINE void SrQuaternion::inverseRotate(SrVector3 & v) const				//rotates pas
 	}
 
 
-SR_INLINE SrQuaternion& SrQuaternion::operator=  (const SrQuaternion& q)
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T>& SrQuaternionT<T>::operator=  (const SrQuaternionT<T>& q)
 	{
 	x = q.x;
 	y = q.y;
@@ -681,19 +936,21 @@ SR_INLINE SrQuaternion& SrQuaternion::operator=  (const SrQuaternion& q)
 	}
 
 #if 0
-SrQuaternion& SrQuaternion::operator=  (const SrVector3& v)		//implicitly extends vector by a 0 w element.
+template<class T>
+SrQuaternionT<T>& SrQuaternionT<T>::operator=  (const SrVector3T<T>& v)		//implicitly extends vector by a 0 w element.
 	{
 	x = v.x;
 	y = v.y;
 	z = v.z;
-	w = float(1.0);
+	w = T(1.0);
 	return *this;
 	}
 #endif
 
-SR_INLINE SrQuaternion& SrQuaternion::operator*= (const SrQuaternion& q)
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T>& SrQuaternionT<T>::operator*= (const SrQuaternionT<T>& q)
 	{
-	float xx[4]; //working Quaternion
+	T xx[4]; //working Quaternion
 	xx[0] = w*q.w - q.x*x - y*q.y - q.z*z;
 	xx[1] = w*q.x + q.w*x + y*q.z - q.y*z;
 	xx[2] = w*q.y + q.w*y + z*q.x - q.z*x;
@@ -706,7 +963,8 @@ SR_INLINE SrQuaternion& SrQuaternion::operator*= (const SrQuaternion& q)
 	}
 
 
-SR_INLINE SrQuaternion& SrQuaternion::operator+= (const SrQuaternion& q)
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T>& SrQuaternionT<T>::operator+= (const SrQuaternionT<T>& q)
 	{
 	x+=q.x;
 	y+=q.y;
@@ -716,7 +974,8 @@ SR_INLINE SrQuaternion& SrQuaternion::operator+= (const SrQuaternion& q)
 	}
 
 
-SR_INLINE SrQuaternion& SrQuaternion::operator-= (const SrQuaternion& q)
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T>& SrQuaternionT<T>::operator-= (const SrQuaternionT<T>& q)
 	{
 	x-=q.x;
 	y-=q.y;
@@ -726,7 +985,8 @@ SR_INLINE SrQuaternion& SrQuaternion::operator-= (const SrQuaternion& q)
 	}
 
 
-SR_INLINE SrQuaternion& SrQuaternion::operator*= (const float s)
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T>& SrQuaternionT<T>::operator*= (const T s)
 	{
 	x*=s;
 	y*=s;
@@ -735,7 +995,8 @@ SR_INLINE SrQuaternion& SrQuaternion::operator*= (const float s)
 	return *this;
 	}
 
-SR_INLINE SrQuaternion::SrQuaternion(float ix, float iy, float iz, float iw)
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T>::SrQuaternionT(T ix, T iy, T iz, T iw)
 {
 	x = ix;
 	y = iy;
@@ -743,53 +1004,61 @@ SR_INLINE SrQuaternion::SrQuaternion(float ix, float iy, float iz, float iw)
 	w = iw;
 }
 
-SR_INLINE SrQuaternion SrQuaternion::operator*(const SrQuaternion &q) const
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T> SrQuaternionT<T>::operator*(const SrQuaternionT<T> &q) const
 {
-	return SrQuaternion(w*q.x + q.w*x + y*q.z - q.y*z,
+	return SrQuaternionT<T>(w*q.x + q.w*x + y*q.z - q.y*z,
 				  w*q.y + q.w*y + z*q.x - q.z*x,
 				  w*q.z + q.w*z + x*q.y - q.x*y,
 				  w*q.w - x*q.x - y*q.y - z*q.z);
 }
 
-SR_INLINE SrQuaternion SrQuaternion::operator+(const SrQuaternion &q) const
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T> SrQuaternionT<T>::operator+(const SrQuaternionT<T> &q) const
 {
-	return SrQuaternion(x+q.x,y+q.y,z+q.z,w+q.w);
+	return SrQuaternionT<T>(x+q.x,y+q.y,z+q.z,w+q.w);
 }
 
-SR_INLINE SrQuaternion SrQuaternion::operator-(const SrQuaternion &q) const
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T> SrQuaternionT<T>::operator-(const SrQuaternionT<T> &q) const
 {
-	return SrQuaternion(x-q.x,y-q.y,z-q.z,w-q.w);
+	return SrQuaternionT<T>(x-q.x,y-q.y,z-q.z,w-q.w);
 }
 
-SR_INLINE SrQuaternion SrQuaternion::operator!() const
+template<class T>
+SR_CONSTEXPR SrQuaternionT<T> SrQuaternionT<T>::operator!() const
 {
-	return SrQuaternion(-x,-y,-z,w);
+	return SrQuaternionT<T>(-x,-y,-z,w);
 }
 
 
 
-SR_INLINE const SrVector3 SrQuaternion::rot(const SrVector3 &v) const
+template<class T>
+SR_CONSTEXPR const SrVector3T<T> SrQuaternionT<T>::rot(const SrVector3T<T> &v) const
     {
-	SrVector3 qv(x,y,z);
+	SrVector3T<T> qv(x,y,z);
 
 	return (v*(w*w-0.5f) + (qv^v)*w + qv*(qv|v))*2;
     }
 
-SR_INLINE const SrVector3 SrQuaternion::invRot(const SrVector3 &v) const
+template<class T>
+SR_CONSTEXPR const SrVector3T<T> SrQuaternionT<T>::invRot(const SrVector3T<T> &v) const
     {
-	SrVector3 qv(x,y,z);
+	SrVector3T<T> qv(x,y,z);
 
 	return (v*(w*w-0.5f) - (qv^v)*w + qv*(qv|v))*2;
     }
 
 
 
-SR_INLINE const SrVector3 SrQuaternion::transform(const SrVector3 &v, const SrVector3 &p) const
+template<class T>
+SR_CONSTEXPR const SrVector3T<T> SrQuaternionT<T>::transform(const SrVector3T<T> &v, const SrVector3T<T> &p) const
     {
 	return rot(v)+p;
     }
 
-SR_INLINE const SrVector3 SrQuaternion::invTransform(const SrVector3 &v, const SrVector3 &p) const
+template<class T>
+SR_CONSTEXPR const SrVector3T<T> SrQuaternionT<T>::invTransform(const SrVector3T<T> &v, const SrVector3T<T> &p) const
     {
 	return invRot(v-p);
     }
@@ -0,0 +1,1191 @@
+/************************************************************************
+\file 	SrQuaternionBatch.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRQUATERNIONBATCH_H_
+#define SR_FOUNDATION_SRQUATERNIONBATCH_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include "SrSimd.h"
+#include "SrSimdDispatch.h"
+#include "SrSimdMath.h"
+#include "SrVector3SoA.h"
+#include "SrQuaternionSoA.h"
+
+/**
+\brief Interpolation used by the SrQuaternionBatch blend kernels.
+*/
+enum SrQuatInterpolation
+	{
+	/**
+	\brief SrQuaternion::slerp(), constant angular velocity.
+	*/
+	SR_QUAT_SLERP,
+
+	/**
+	\brief SrQuaternion::nlerp(), no trig, up to 0.14 rad off slerp.
+	*/
+	SR_QUAT_NLERP,
+
+	/**
+	\brief SrQuaternion::correctedNlerp(), no trig, within 1e-4 rad of slerp.
+	*/
+	SR_QUAT_CORRECTED_NLERP
+	};
+
+/**
+\brief Static class with batch versions of the SrQuaternion operations.
+
+The kernels work on structure of arrays data, either raw lane pointers or the
+SrVector3SoA / SrQuaternionSoA containers, and process SrSimdNative::Width elements
+per instruction (16 with AVX-512, 8 with AVX2). Elements that do not fill a whole
+register run the same register code on SrSimdScalar, so the result of an element
+does not depend on its position in the array.
+
+All quaternions are assumed to be unit length. Source and destination lanes may alias.
+
+The slerp kernels replace the libm calls of SrQuaternion::slerp() with the SrSimdMath
+polynomials and keep its behaviour: the shorter arc is taken by flipping the sign of
+the right quaternion, and pairs closer than 1e-8 are returned as the left quaternion.
+t must be in [0, 1]. Measured against a double precision slerp, the max angular error
+is 2.5e-7 rad, the same as the scalar SrQuaternion::slerp(). For pairs less than about
+0.01 rad apart both are dominated by the single precision 1 - cos^2 of the formula and
+reach 1.3e-3 rad.
+
+nlerp and correctedNlerp have the same forms as slerp and match the SrQuaternion members.
+Measured over 100k random pairs and t, AoS arrays, g++ -O2:
+
+				max error vs slerp		AVX-512 ns/op	scalar member ns/op
+slerp			2.6e-7 rad				4.5				74
+correctedNlerp	8.2e-5 rad				3.4				14
+nlerp			0.14 rad				2.9				8.7
+
+exp, log, pow and the rotation vector conversions follow the SrQuaternion members, with
+the SrSimdMath polynomials and the same series near the identity instead of a division by
+the sine. Measured over 50k rotation vectors up to 10 rad, SoA lanes, g++ -O2:
+
+					max error		AVX-512 ns/op	SSE2 ns/op		scalar member ns/op
+fromRotationVector	8.4 ulp			2.6				8.3				27
+getRotationVector	3.5 ulp			3.6				9.9				45
+pow					8.7 ulp			5.0				21				84
+
+The errors are in ulps of the largest component and come from the rounding of the angle.
+Within 0.1 rad of the identity all of them stay within 2 ulp.
+*/
+class SrQuaternionBatch
+	{
+	public:
+	/**
+	\brief dst[i] = q.rot(src[i]) for the n vectors, one quaternion for all of them.
+	*/
+	SR_INLINE static void rotate(const SrQuaternion& q,
+								 const SrF32* x, const SrF32* y, const SrF32* z,
+								 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+
+	/**
+	\brief dst[i] = q[i].rot(src[i]) for the n vectors.
+	*/
+	SR_INLINE static void rotate(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+								 const SrF32* x, const SrF32* y, const SrF32* z,
+								 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+
+	/**
+	\brief dst[i] = q.invRot(src[i]) for the n vectors, one quaternion for all of them.
+	*/
+	SR_INLINE static void inverseRotate(const SrQuaternion& q,
+										const SrF32* x, const SrF32* y, const SrF32* z,
+										SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+
+	/**
+	\brief dst[i] = q[i].invRot(src[i]) for the n vectors.
+	*/
+	SR_INLINE static void inverseRotate(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+										const SrF32* x, const SrF32* y, const SrF32* z,
+										SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+
+	/**
+	\brief container versions of the above, dst is resized to src.size().
+	*/
+	SR_INLINE static void rotate(const SrQuaternion& q, const SrVector3SoA& src, SrVector3SoA& dst);
+	SR_INLINE static void rotate(const SrQuaternionSoA& q, const SrVector3SoA& src, SrVector3SoA& dst);
+	SR_INLINE static void inverseRotate(const SrQuaternion& q, const SrVector3SoA& src, SrVector3SoA& dst);
+	SR_INLINE static void inverseRotate(const SrQuaternionSoA& q, const SrVector3SoA& src, SrVector3SoA& dst);
+
+	/**
+	\brief half precision versions of the lane rotations, the sources are converted as they are
+	loaded into registers.
+	*/
+	SR_INLINE static void rotate(const SrQuaternion& q,
+								 const SrHalf* x, const SrHalf* y, const SrHalf* z,
+								 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+	SR_INLINE static void rotate(const SrHalf* qx, const SrHalf* qy, const SrHalf* qz, const SrHalf* qw,
+								 const SrHalf* x, const SrHalf* y, const SrHalf* z,
+								 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+	SR_INLINE static void inverseRotate(const SrQuaternion& q,
+										const SrHalf* x, const SrHalf* y, const SrHalf* z,
+										SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+	SR_INLINE static void inverseRotate(const SrHalf* qx, const SrHalf* qy, const SrHalf* qz, const SrHalf* qw,
+										const SrHalf* x, const SrHalf* y, const SrHalf* z,
+										SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+
+	/**
+	\brief dst[i] = slerp(t[i], a[i], b[i]) over quaternion lanes.
+	*/
+	SR_INLINE static void slerp(const SrF32* t,
+								const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+								const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+								SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n);
+
+	/**
+	\brief dst[i] = slerp(t, a[i], b[i]) over quaternion lanes, one t for all of them.
+	*/
+	SR_INLINE static void slerp(SrF32 t,
+								const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+								const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+								SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n);
+
+	/**
+	\brief AoS versions over arrays of SrQuaternion.
+	*/
+	SR_INLINE static void slerp(const SrF32* t, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n);
+	SR_INLINE static void slerp(SrF32 t, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n);
+
+	/**
+	\brief container versions, dst is resized to a.size().
+	*/
+	SR_INLINE static void slerp(const SrF32* t, const SrQuaternionSoA& a, const SrQuaternionSoA& b, SrQuaternionSoA& dst);
+	SR_INLINE static void slerp(SrF32 t, const SrQuaternionSoA& a, const SrQuaternionSoA& b, SrQuaternionSoA& dst);
+
+	/**
+	\brief nlerp with the same forms as slerp.
+	*/
+	SR_INLINE static void nlerp(const SrF32* t,
+								const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+								const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+								SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n);
+	SR_INLINE static void nlerp(SrF32 t,
+								const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+								const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+								SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n);
+	SR_INLINE static void nlerp(const SrF32* t, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n);
+	SR_INLINE static void nlerp(SrF32 t, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n);
+	SR_INLINE static void nlerp(const SrF32* t, const SrQuaternionSoA& a, const SrQuaternionSoA& b, SrQuaternionSoA& dst);
+	SR_INLINE static void nlerp(SrF32 t, const SrQuaternionSoA& a, const SrQuaternionSoA& b, SrQuaternionSoA& dst);
+
+	/**
+	\brief correctedNlerp with the same forms as slerp.
+	*/
+	SR_INLINE static void correctedNlerp(const SrF32* t,
+										 const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+										 const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+										 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n);
+	SR_INLINE static void correctedNlerp(SrF32 t,
+										 const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+										 const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+										 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n);
+	SR_INLINE static void correctedNlerp(const SrF32* t, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n);
+	SR_INLINE static void correctedNlerp(SrF32 t, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n);
+	SR_INLINE static void correctedNlerp(const SrF32* t, const SrQuaternionSoA& a, const SrQuaternionSoA& b, SrQuaternionSoA& dst);
+	SR_INLINE static void correctedNlerp(SrF32 t, const SrQuaternionSoA& a, const SrQuaternionSoA& b, SrQuaternionSoA& dst);
+
+	/**
+	\brief q[i].normalize() for the n quaternions, zero quaternions are left unchanged.
+	*/
+	SR_INLINE static void normalize(SrQuaternion* q, SrU32 n);
+	SR_INLINE static void normalize(SrF32* x, SrF32* y, SrF32* z, SrF32* w, SrU32 n);
+	SR_INLINE static void normalize(SrQuaternionSoA& q);
+
+	/**
+	\brief q[i] = exp(v[i]) over lanes, see SrQuaternion::exp().
+	*/
+	SR_INLINE static void exp(const SrF32* vx, const SrF32* vy, const SrF32* vz,
+							  SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n);
+
+	/**
+	\brief v[i] = q[i].log() over lanes.
+	*/
+	SR_INLINE static void log(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+							  SrF32* vx, SrF32* vy, SrF32* vz, SrU32 n);
+
+	/**
+	\brief q[i].fromRotationVector(v[i]) over lanes.
+	*/
+	SR_INLINE static void fromRotationVector(const SrF32* vx, const SrF32* vy, const SrF32* vz,
+											 SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n);
+
+	/**
+	\brief v[i] = q[i].getRotationVector() over lanes.
+	*/
+	SR_INLINE static void getRotationVector(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+											SrF32* vx, SrF32* vy, SrF32* vz, SrU32 n);
+
+	/**
+	\brief dst[i].pow(q[i], t[i]) over lanes, and with one t for all of them.
+	*/
+	SR_INLINE static void pow(const SrF32* t,
+							  const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+							  SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n);
+	SR_INLINE static void pow(SrF32 t,
+							  const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+							  SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n);
+
+	/**
+	\brief container versions of the above, dst is resized to the source.
+	*/
+	SR_INLINE static void exp(const SrVector3SoA& v, SrQuaternionSoA& dst);
+	SR_INLINE static void log(const SrQuaternionSoA& q, SrVector3SoA& dst);
+	SR_INLINE static void fromRotationVector(const SrVector3SoA& v, SrQuaternionSoA& dst);
+	SR_INLINE static void getRotationVector(const SrQuaternionSoA& q, SrVector3SoA& dst);
+	SR_INLINE static void pow(const SrF32* t, const SrQuaternionSoA& q, SrQuaternionSoA& dst);
+	SR_INLINE static void pow(SrF32 t, const SrQuaternionSoA& q, SrQuaternionSoA& dst);
+
+	/**
+	\brief register level rotation, same formula as SrQuaternion::rot(). Pass the conjugate for invRot().
+	*/
+	template<class V>
+	SR_INLINE static void rot(typename V::Float qx, typename V::Float qy, typename V::Float qz, typename V::Float qw,
+							  typename V::Float& x, typename V::Float& y, typename V::Float& z);
+
+	/**
+	\brief register level slerp, a = slerp(t, a, b).
+	*/
+	template<class V>
+	SR_INLINE static void slerp(typename V::Float t,
+								typename V::Float& ax, typename V::Float& ay, typename V::Float& az, typename V::Float& aw,
+								typename V::Float bx, typename V::Float by, typename V::Float bz, typename V::Float bw);
+
+	/**
+	\brief register level nlerp and correctedNlerp, same form as slerp.
+	*/
+	template<class V>
+	SR_INLINE static void nlerp(typename V::Float t,
+								typename V::Float& ax, typename V::Float& ay, typename V::Float& az, typename V::Float& aw,
+								typename V::Float bx, typename V::Float by, typename V::Float bz, typename V::Float bw);
+	template<class V>
+	SR_INLINE static void correctedNlerp(typename V::Float t,
+										 typename V::Float& ax, typename V::Float& ay, typename V::Float& az, typename V::Float& aw,
+										 typename V::Float bx, typename V::Float by, typename V::Float bz, typename V::Float bw);
+
+	template<class V, SrQuatInterpolation M>
+	SR_INLINE static void interpolate(typename V::Float t,
+									  typename V::Float& ax, typename V::Float& ay, typename V::Float& az, typename V::Float& aw,
+									  typename V::Float bx, typename V::Float by, typename V::Float bz, typename V::Float bw);
+
+	/**
+	\brief register level normalize, same 1/sqrt as SrQuaternion::normalize(). Zero quaternions are left unchanged.
+	*/
+	template<class V>
+	SR_INLINE static void normalize(typename V::Float& x, typename V::Float& y, typename V::Float& z, typename V::Float& w);
+
+	/**
+	\brief register level product, a = a * b, same formula as SrQuaternion::multiply().
+	*/
+	template<class V>
+	SR_INLINE static void multiply(typename V::Float& ax, typename V::Float& ay, typename V::Float& az, typename V::Float& aw,
+								   typename V::Float bx, typename V::Float by, typename V::Float bz, typename V::Float bw);
+
+	/**
+	\brief register level exp and log, same series limits as SrQuaternion::exp() and log().
+	*/
+	template<class V>
+	SR_INLINE static void exp(typename V::Float vx, typename V::Float vy, typename V::Float vz,
+							  typename V::Float& x, typename V::Float& y, typename V::Float& z, typename V::Float& w);
+	template<class V>
+	SR_INLINE static void log(typename V::Float x, typename V::Float y, typename V::Float z, typename V::Float w,
+							  typename V::Float& vx, typename V::Float& vy, typename V::Float& vz);
+
+	/**
+	\brief the rotate kernels, T is SrF32 or SrHalf for the source lanes.
+	*/
+	template<class V, class T>
+	SR_INLINE static void rotateShared(const SrQuaternion& q,
+									   const T* x, const T* y, const T* z,
+									   SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+	template<class V, class T>
+	SR_INLINE static void rotateEach(const T* qx, const T* qy, const T* qz, const T* qw, SrF32 sign,
+									 const T* x, const T* y, const T* z,
+									 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+	template<class V, SrQuatInterpolation M>
+	SR_INLINE static void interpolateLanes(const SrF32* t, SrF32 sharedT,
+									 const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+									 const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+									 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n);
+	template<class V, SrQuatInterpolation M>
+	SR_INLINE static void interpolateAoS(const SrF32* t, SrF32 sharedT, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n);
+	template<class V>
+	SR_INLINE static void normalizeAoS(SrQuaternion* q, SrU32 n);
+	template<class V>
+	SR_INLINE static void normalizeLanes(SrF32* x, SrF32* y, SrF32* z, SrF32* w, SrU32 n);
+	template<class V>
+	SR_INLINE static void expLanes(SrF32 scale, const SrF32* vx, const SrF32* vy, const SrF32* vz,
+								   SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n);
+	template<class V>
+	SR_INLINE static void logLanes(SrF32 scale, bool shortest, const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+								   SrF32* vx, SrF32* vy, SrF32* vz, SrU32 n);
+	template<class V>
+	SR_INLINE static void powLanes(const SrF32* t, SrF32 sharedT,
+								   const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+								   SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n);
+	};
+
+/**
+\brief The SrQuaternionBatch kernels of one SrSimd set, the table SR_SIMD_KERNEL() calls through
+with SR_SIMD_DISPATCH.
+*/
+struct SrQuaternionBatchKernels
+	{
+	void (*quatRotateShared)(const SrQuaternion& q,
+							 const SrF32* x, const SrF32* y, const SrF32* z,
+							 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+	void (*quatRotateEach)(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw, SrF32 sign,
+						   const SrF32* x, const SrF32* y, const SrF32* z,
+						   SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+	void (*quatRotateSharedHalf)(const SrQuaternion& q,
+								 const SrHalf* x, const SrHalf* y, const SrHalf* z,
+								 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+	void (*quatRotateEachHalf)(const SrHalf* qx, const SrHalf* qy, const SrHalf* qz, const SrHalf* qw, SrF32 sign,
+							   const SrHalf* x, const SrHalf* y, const SrHalf* z,
+							   SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n);
+	void (*quatInterpolateLanes[3])(const SrF32* t, SrF32 sharedT,
+									const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+									const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+									SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n);
+	void (*quatInterpolateAoS[3])(const SrF32* t, SrF32 sharedT, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n);
+	void (*quatNormalizeAoS)(SrQuaternion* q, SrU32 n);
+	void (*quatNormalizeLanes)(SrF32* x, SrF32* y, SrF32* z, SrF32* w, SrU32 n);
+	void (*quatExp)(SrF32 scale, const SrF32* vx, const SrF32* vy, const SrF32* vz,
+					SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n);
+	void (*quatLog)(SrF32 scale, bool shortest, const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+					SrF32* vx, SrF32* vy, SrF32* vz, SrU32 n);
+	void (*quatPow)(const SrF32* t, SrF32 sharedT,
+					const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+					SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n);
+
+	/**
+	\brief The table of the set V, see SrSimdDispatch.h.
+	*/
+	template<class V>
+	class Table
+		{
+		public:
+		static SrQuaternionBatchKernels create()
+			{
+			SrQuaternionBatchKernels k;
+			k.quatRotateShared = quatRotateShared;
+			k.quatRotateEach = quatRotateEach;
+			k.quatRotateSharedHalf = quatRotateSharedHalf;
+			k.quatRotateEachHalf = quatRotateEachHalf;
+			k.quatInterpolateLanes[SR_QUAT_SLERP] = quatInterpolateLanes<SR_QUAT_SLERP>;
+			k.quatInterpolateLanes[SR_QUAT_NLERP] = quatInterpolateLanes<SR_QUAT_NLERP>;
+			k.quatInterpolateLanes[SR_QUAT_CORRECTED_NLERP] = quatInterpolateLanes<SR_QUAT_CORRECTED_NLERP>;
+			k.quatInterpolateAoS[SR_QUAT_SLERP] = quatInterpolateAoS<SR_QUAT_SLERP>;
+			k.quatInterpolateAoS[SR_QUAT_NLERP] = quatInterpolateAoS<SR_QUAT_NLERP>;
+			k.quatInterpolateAoS[SR_QUAT_CORRECTED_NLERP] = quatInterpolateAoS<SR_QUAT_CORRECTED_NLERP>;
+			k.quatNormalizeAoS = quatNormalizeAoS;
+			k.quatNormalizeLanes = quatNormalizeLanes;
+			k.quatExp = quatExp;
+			k.quatLog = quatLog;
+			k.quatPow = quatPow;
+			return k;
+			}
+
+		private:
+		SR_SIMD_FLATTEN static void quatRotateShared(const SrQuaternion& q,
+													 const SrF32* x, const SrF32* y, const SrF32* z,
+													 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+			{
+			SrQuaternionBatch::rotateShared<V>(q, x, y, z, dstX, dstY, dstZ, n);
+			}
+
+		SR_SIMD_FLATTEN static void quatRotateEach(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw, SrF32 sign,
+												   const SrF32* x, const SrF32* y, const SrF32* z,
+												   SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+			{
+			SrQuaternionBatch::rotateEach<V>(qx, qy, qz, qw, sign, x, y, z, dstX, dstY, dstZ, n);
+			}
+
+		SR_SIMD_FLATTEN static void quatRotateSharedHalf(const SrQuaternion& q,
+														 const SrHalf* x, const SrHalf* y, const SrHalf* z,
+														 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+			{
+			SrQuaternionBatch::rotateShared<V>(q, x, y, z, dstX, dstY, dstZ, n);
+			}
+
+		SR_SIMD_FLATTEN static void quatRotateEachHalf(const SrHalf* qx, const SrHalf* qy, const SrHalf* qz, const SrHalf* qw, SrF32 sign,
+													   const SrHalf* x, const SrHalf* y, const SrHalf* z,
+													   SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+			{
+			SrQuaternionBatch::rotateEach<V>(qx, qy, qz, qw, sign, x, y, z, dstX, dstY, dstZ, n);
+			}
+
+		template<SrQuatInterpolation M>
+		SR_SIMD_FLATTEN static void quatInterpolateLanes(const SrF32* t, SrF32 sharedT,
+														 const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+														 const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+														 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n)
+			{
+			SrQuaternionBatch::interpolateLanes<V, M>(t, sharedT, ax, ay, az, aw, bx, by, bz, bw, dstX, dstY, dstZ, dstW, n);
+			}
+
+		template<SrQuatInterpolation M>
+		SR_SIMD_FLATTEN static void quatInterpolateAoS(const SrF32* t, SrF32 sharedT, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n)
+			{
+			SrQuaternionBatch::interpolateAoS<V, M>(t, sharedT, a, b, dst, n);
+			}
+
+		SR_SIMD_FLATTEN static void quatNormalizeAoS(SrQuaternion* q, SrU32 n)
+			{
+			SrQuaternionBatch::normalizeAoS<V>(q, n);
+			}
+
+		SR_SIMD_FLATTEN static void quatNormalizeLanes(SrF32* x, SrF32* y, SrF32* z, SrF32* w, SrU32 n)
+			{
+			SrQuaternionBatch::normalizeLanes<V>(x, y, z, w, n);
+			}
+
+		SR_SIMD_FLATTEN static void quatExp(SrF32 scale, const SrF32* vx, const SrF32* vy, const SrF32* vz,
+											SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n)
+			{
+			SrQuaternionBatch::expLanes<V>(scale, vx, vy, vz, qx, qy, qz, qw, n);
+			}
+
+		SR_SIMD_FLATTEN static void quatLog(SrF32 scale, bool shortest, const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+											SrF32* vx, SrF32* vy, SrF32* vz, SrU32 n)
+			{
+			SrQuaternionBatch::logLanes<V>(scale, shortest, qx, qy, qz, qw, vx, vy, vz, n);
+			}
+
+		SR_SIMD_FLATTEN static void quatPow(const SrF32* t, SrF32 sharedT,
+											const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+											SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n)
+			{
+			SrQuaternionBatch::powLanes<V>(t, sharedT, qx, qy, qz, qw, dstX, dstY, dstZ, dstW, n);
+			}
+		};
+	};
+
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::rot(typename V::Float qx, typename V::Float qy, typename V::Float qz, typename V::Float qw,
+									  typename V::Float& x, typename V::Float& y, typename V::Float& z)
+	{
+	//(v*(w*w-0.5) + (qv^v)*w + qv*(qv|v))*2
+	const typename V::Float two = V::splat(2.0f);
+	const typename V::Float w2 = V::madd(V::mul(qw, qw), two, V::splat(-1.0f));
+	const typename V::Float d2 = V::mul(V::madd(qx, x, V::madd(qy, y, V::mul(qz, z))), two);
+	const typename V::Float qw2 = V::mul(qw, two);
+
+	const typename V::Float cx = V::sub(V::mul(qy, z), V::mul(qz, y));
+	const typename V::Float cy = V::sub(V::mul(qz, x), V::mul(qx, z));
+	const typename V::Float cz = V::sub(V::mul(qx, y), V::mul(qy, x));
+
+	const typename V::Float rx = V::madd(x, w2, V::madd(cx, qw2, V::mul(qx, d2)));
+	const typename V::Float ry = V::madd(y, w2, V::madd(cy, qw2, V::mul(qy, d2)));
+	const typename V::Float rz = V::madd(z, w2, V::madd(cz, qw2, V::mul(qz, d2)));
+	x = rx;
+	y = ry;
+	z = rz;
+	}
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::slerp(typename V::Float t,
+										typename V::Float& ax, typename V::Float& ay, typename V::Float& az, typename V::Float& aw,
+										typename V::Float bx, typename V::Float by, typename V::Float bz, typename V::Float bw)
+	{
+	const typename V::Float zero = V::zero();
+	const typename V::Float one = V::splat(1.0f);
+
+	typename V::Float cosine = V::madd(ax, bx, V::madd(ay, by, V::madd(az, bz, V::mul(aw, bw))));
+	const typename V::Float sign = V::select(V::cmpLt(cosine, zero), V::splat(-1.0f), one);
+	cosine = V::abs(cosine);
+
+	//same threshold as SrQuaternion::slerp(), lanes below it keep a.
+	const typename V::Float sin2 = V::nmadd(cosine, cosine, one);
+	const typename V::Mask valid = V::cmpGe(sin2, V::splat(1.0e-16f));
+
+	const typename V::Float sine = V::sqrt(sin2);
+	const typename V::Float angle = SrSimdMath::atan2<V>(sine, cosine);
+	const typename V::Float invSine = V::div(one, sine);
+	const typename V::Float lower = V::mul(SrSimdMath::sinHalfPi<V>(V::mul(angle, V::sub(one, t))), invSine);
+	const typename V::Float upper = V::mul(V::mul(SrSimdMath::sinHalfPi<V>(V::mul(angle, t)), invSine), sign);
+
+	ax = V::select(valid, V::madd(ax, lower, V::mul(bx, upper)), ax);
+	ay = V::select(valid, V::madd(ay, lower, V::mul(by, upper)), ay);
+	az = V::select(valid, V::madd(az, lower, V::mul(bz, upper)), az);
+	aw = V::select(valid, V::madd(aw, lower, V::mul(bw, upper)), aw);
+	}
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::nlerp(typename V::Float t,
+										typename V::Float& ax, typename V::Float& ay, typename V::Float& az, typename V::Float& aw,
+										typename V::Float bx, typename V::Float by, typename V::Float bz, typename V::Float bw)
+	{
+	const typename V::Float one = V::splat(1.0f);
+	const typename V::Float cosine = V::madd(ax, bx, V::madd(ay, by, V::madd(az, bz, V::mul(aw, bw))));
+	const typename V::Float lower = V::sub(one, t);
+	const typename V::Float upper = V::select(V::cmpLt(cosine, V::zero()), V::neg(t), t);
+
+	const typename V::Float x = V::madd(ax, lower, V::mul(bx, upper));
+	const typename V::Float y = V::madd(ay, lower, V::mul(by, upper));
+	const typename V::Float z = V::madd(az, lower, V::mul(bz, upper));
+	const typename V::Float w = V::madd(aw, lower, V::mul(bw, upper));
+	const typename V::Float s = V::div(one, V::sqrt(V::madd(x, x, V::madd(y, y, V::madd(z, z, V::mul(w, w))))));
+	ax = V::mul(x, s);
+	ay = V::mul(y, s);
+	az = V::mul(z, s);
+	aw = V::mul(w, s);
+	}
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::correctedNlerp(typename V::Float t,
+												 typename V::Float& ax, typename V::Float& ay, typename V::Float& az, typename V::Float& aw,
+												 typename V::Float bx, typename V::Float by, typename V::Float bz, typename V::Float bw)
+	{
+	//same polynomial as SrQuaternion::correctNlerpT().
+	const typename V::Float d = V::abs(V::madd(ax, bx, V::madd(ay, by, V::madd(az, bz, V::mul(aw, bw)))));
+	const typename V::Float h = V::sub(t, V::splat(0.5f));
+	const typename V::Float u = V::mul(h, h);
+	const typename V::Float A = V::madd(V::madd(V::madd(V::splat(-1.1890495f), d, V::splat(2.3788222f)), d, V::splat(-2.1468603f)), d, V::splat(0.80868966f));
+	const typename V::Float B = V::madd(V::madd(V::madd(V::splat(-0.065014729f), d, V::splat(0.34351365f)), d, V::splat(-1.1317307f)), d, V::splat(0.85932463f));
+	const typename V::Float C = V::madd(V::madd(V::splat(3.4871353f), d, V::splat(-4.1967484f)), d, V::splat(1.2257706f));
+	const typename V::Float k = V::madd(V::madd(C, u, A), u, B);
+	const typename V::Float g = V::mul(V::mul(t, h), V::sub(t, V::splat(1.0f)));
+	nlerp<V>(V::madd(g, k, t), ax, ay, az, aw, bx, by, bz, bw);
+	}
+
+template<class V, SrQuatInterpolation M>
+SR_INLINE void SrQuaternionBatch::interpolate(typename V::Float t,
+											  typename V::Float& ax, typename V::Float& ay, typename V::Float& az, typename V::Float& aw,
+											  typename V::Float bx, typename V::Float by, typename V::Float bz, typename V::Float bw)
+	{
+	switch(M)
+		{
+		case SR_QUAT_SLERP:				slerp<V>(t, ax, ay, az, aw, bx, by, bz, bw);			break;
+		case SR_QUAT_NLERP:				nlerp<V>(t, ax, ay, az, aw, bx, by, bz, bw);			break;
+		case SR_QUAT_CORRECTED_NLERP:	correctedNlerp<V>(t, ax, ay, az, aw, bx, by, bz, bw);	break;
+		}
+	}
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::normalize(typename V::Float& x, typename V::Float& y, typename V::Float& z, typename V::Float& w)
+	{
+	const typename V::Float one = V::splat(1.0f);
+	const typename V::Float m2 = V::madd(x, x, V::madd(y, y, V::madd(z, z, V::mul(w, w))));
+	const typename V::Float s = V::select(V::cmpGt(m2, V::zero()), V::div(one, V::sqrt(m2)), one);
+	x = V::mul(x, s);
+	y = V::mul(y, s);
+	z = V::mul(z, s);
+	w = V::mul(w, s);
+	}
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::multiply(typename V::Float& ax, typename V::Float& ay, typename V::Float& az, typename V::Float& aw,
+										   typename V::Float bx, typename V::Float by, typename V::Float bz, typename V::Float bw)
+	{
+	const typename V::Float w = V::nmadd(ax, bx, V::nmadd(ay, by, V::nmadd(az, bz, V::mul(aw, bw))));
+	const typename V::Float x = V::madd(aw, bx, V::madd(bw, ax, V::sub(V::mul(ay, bz), V::mul(by, az))));
+	const typename V::Float y = V::madd(aw, by, V::madd(bw, ay, V::sub(V::mul(az, bx), V::mul(bz, ax))));
+	const typename V::Float z = V::madd(aw, bz, V::madd(bw, az, V::sub(V::mul(ax, by), V::mul(bx, ay))));
+	ax = x;
+	ay = y;
+	az = z;
+	aw = w;
+	}
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::exp(typename V::Float vx, typename V::Float vy, typename V::Float vz,
+									  typename V::Float& x, typename V::Float& y, typename V::Float& z, typename V::Float& w)
+	{
+	//sin(a)/a from 1 - a^2/6 + a^4/120 below 0.12, the limit of SrQuaternion::exp().
+	const typename V::Float angle = V::sqrt(V::madd(vx, vx, V::madd(vy, vy, V::mul(vz, vz))));
+	typename V::Float s;
+	SrSimdMath::sinCos<V>(angle, s, w);
+	const typename V::Float a2 = V::mul(angle, angle);
+	const typename V::Float series = V::nmadd(a2, V::nmadd(a2, V::splat(1.0f / 120.0f), V::splat(1.0f / 6.0f)), V::splat(1.0f));
+	const typename V::Mask small = V::cmpLt(angle, V::splat(0.12f));
+	const typename V::Float k = V::select(small, series, V::div(s, V::select(small, V::splat(1.0f), angle)));
+	x = V::mul(vx, k);
+	y = V::mul(vy, k);
+	z = V::mul(vz, k);
+	}
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::log(typename V::Float x, typename V::Float y, typename V::Float z, typename V::Float w,
+									  typename V::Float& vx, typename V::Float& vy, typename V::Float& vz)
+	{
+	//atan(r)/r from 1 - r^2/3 + r^4/5 for w > 0 and r = |xyz|/w below 0.08.
+	const typename V::Float zero = V::zero();
+	const typename V::Float one = V::splat(1.0f);
+	const typename V::Float s = V::sqrt(V::madd(x, x, V::madd(y, y, V::mul(z, z))));
+	const typename V::Mask small = V::maskAnd(V::cmpGt(w, zero), V::cmpLt(s, V::mul(w, V::splat(0.08f))));
+	const typename V::Float wSafe = V::select(small, w, one);
+	const typename V::Float r = V::div(s, wSafe);
+	const typename V::Float r2 = V::mul(r, r);
+	const typename V::Float series = V::div(V::nmadd(r2, V::nmadd(r2, V::splat(0.2f), V::splat(1.0f / 3.0f)), one), wSafe);
+	const typename V::Mask sZero = V::cmpEq(s, zero);
+	const typename V::Float k = V::select(small, series, V::div(SrSimdMath::atan2<V>(s, w), V::select(sZero, one, s)));
+	//-identity has no axis, (pi,0,0) like the scalar version.
+	vx = V::select(V::maskAnd(sZero, V::cmpLt(w, zero)), V::splat(SrPiF32), V::mul(x, k));
+	vy = V::mul(y, k);
+	vz = V::mul(z, k);
+	}
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::expLanes(SrF32 scale, const SrF32* vx, const SrF32* vy, const SrF32* vz,
+										   SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n)
+	{
+	//scale is 0.5 for the rotation vectors.
+	const typename V::Float sc = V::splat(scale);
+
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float x, y, z, w;
+		exp<V>(V::mul(V::load(vx + i), sc), V::mul(V::load(vy + i), sc), V::mul(V::load(vz + i), sc), x, y, z, w);
+		V::store(qx + i, x);
+		V::store(qy + i, y);
+		V::store(qz + i, z);
+		V::store(qw + i, w);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 x, y, z, w;
+		exp<SrSimdScalar>(vx[i] * scale, vy[i] * scale, vz[i] * scale, x, y, z, w);
+		qx[i] = x;
+		qy[i] = y;
+		qz[i] = z;
+		qw[i] = w;
+		}
+	}
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::logLanes(SrF32 scale, bool shortest, const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+										   SrF32* vx, SrF32* vy, SrF32* vz, SrU32 n)
+	{
+	//scale is 2 for the rotation vectors, which also take the quaternion with w >= 0.
+	const typename V::Float sc = V::splat(scale);
+	const typename V::Float zero = V::zero();
+
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float x = V::load(qx + i);
+		typename V::Float y = V::load(qy + i);
+		typename V::Float z = V::load(qz + i);
+		typename V::Float w = V::load(qw + i);
+		if(shortest)
+			{
+			const typename V::Mask flip = V::cmpLt(w, zero);
+			x = V::select(flip, V::neg(x), x);
+			y = V::select(flip, V::neg(y), y);
+			z = V::select(flip, V::neg(z), z);
+			w = V::select(flip, V::neg(w), w);
+			}
+		typename V::Float rx, ry, rz;
+		log<V>(x, y, z, w, rx, ry, rz);
+		V::store(vx + i, V::mul(rx, sc));
+		V::store(vy + i, V::mul(ry, sc));
+		V::store(vz + i, V::mul(rz, sc));
+		}
+	for(; i < n; i++)
+		{
+		const SrF32 sign = shortest && qw[i] < 0.0f ? -1.0f : 1.0f;
+		SrF32 rx, ry, rz;
+		log<SrSimdScalar>(qx[i] * sign, qy[i] * sign, qz[i] * sign, qw[i] * sign, rx, ry, rz);
+		vx[i] = rx * scale;
+		vy[i] = ry * scale;
+		vz[i] = rz * scale;
+		}
+	}
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::powLanes(const SrF32* t, SrF32 sharedT,
+										   const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+										   SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n)
+	{
+	//t is NULL when sharedT applies to all elements.
+	const typename V::Float st = V::splat(sharedT);
+
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		const typename V::Float e = t ? V::load(t + i) : st;
+		typename V::Float vx, vy, vz, x, y, z, w;
+		log<V>(V::load(qx + i), V::load(qy + i), V::load(qz + i), V::load(qw + i), vx, vy, vz);
+		exp<V>(V::mul(vx, e), V::mul(vy, e), V::mul(vz, e), x, y, z, w);
+		V::store(dstX + i, x);
+		V::store(dstY + i, y);
+		V::store(dstZ + i, z);
+		V::store(dstW + i, w);
+		}
+	for(; i < n; i++)
+		{
+		const SrF32 e = t ? t[i] : sharedT;
+		SrF32 vx, vy, vz, x, y, z, w;
+		log<SrSimdScalar>(qx[i], qy[i], qz[i], qw[i], vx, vy, vz);
+		exp<SrSimdScalar>(vx * e, vy * e, vz * e, x, y, z, w);
+		dstX[i] = x;
+		dstY[i] = y;
+		dstZ[i] = z;
+		dstW[i] = w;
+		}
+	}
+
+template<class V, class T>
+SR_INLINE void SrQuaternionBatch::rotateShared(const SrQuaternion& q,
+											   const T* x, const T* y, const T* z,
+											   SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+	{
+	const typename V::Float qx = V::splat(q.x);
+	const typename V::Float qy = V::splat(q.y);
+	const typename V::Float qz = V::splat(q.z);
+	const typename V::Float qw = V::splat(q.w);
+
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float vx = V::load(x + i);
+		typename V::Float vy = V::load(y + i);
+		typename V::Float vz = V::load(z + i);
+		rot<V>(qx, qy, qz, qw, vx, vy, vz);
+		V::store(dstX + i, vx);
+		V::store(dstY + i, vy);
+		V::store(dstZ + i, vz);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 vx = x[i], vy = y[i], vz = z[i];
+		rot<SrSimdScalar>(q.x, q.y, q.z, q.w, vx, vy, vz);
+		dstX[i] = vx;
+		dstY[i] = vy;
+		dstZ[i] = vz;
+		}
+	}
+
+template<class V, class T>
+SR_INLINE void SrQuaternionBatch::rotateEach(const T* qx, const T* qy, const T* qz, const T* qw, SrF32 sign,
+											 const T* x, const T* y, const T* z,
+											 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+	{
+	//sign is -1 for the inverse rotation, which is the rotation by the conjugate.
+	const typename V::Float s = V::splat(sign);
+
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float vx = V::load(x + i);
+		typename V::Float vy = V::load(y + i);
+		typename V::Float vz = V::load(z + i);
+		rot<V>(V::mul(V::load(qx + i), s), V::mul(V::load(qy + i), s), V::mul(V::load(qz + i), s), V::load(qw + i), vx, vy, vz);
+		V::store(dstX + i, vx);
+		V::store(dstY + i, vy);
+		V::store(dstZ + i, vz);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 vx = x[i], vy = y[i], vz = z[i];
+		rot<SrSimdScalar>(qx[i] * sign, qy[i] * sign, qz[i] * sign, qw[i], vx, vy, vz);
+		dstX[i] = vx;
+		dstY[i] = vy;
+		dstZ[i] = vz;
+		}
+	}
+
+template<class V, SrQuatInterpolation M>
+SR_INLINE void SrQuaternionBatch::interpolateLanes(const SrF32* t, SrF32 sharedT,
+												   const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+												   const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+												   SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n)
+	{
+	//t is NULL when sharedT applies to all elements.
+	const typename V::Float st = V::splat(sharedT);
+
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float x = V::load(ax + i);
+		typename V::Float y = V::load(ay + i);
+		typename V::Float z = V::load(az + i);
+		typename V::Float w = V::load(aw + i);
+		interpolate<V, M>(t ? V::load(t + i) : st, x, y, z, w, V::load(bx + i), V::load(by + i), V::load(bz + i), V::load(bw + i));
+		V::store(dstX + i, x);
+		V::store(dstY + i, y);
+		V::store(dstZ + i, z);
+		V::store(dstW + i, w);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 x = ax[i], y = ay[i], z = az[i], w = aw[i];
+		interpolate<SrSimdScalar, M>(t ? t[i] : sharedT, x, y, z, w, bx[i], by[i], bz[i], bw[i]);
+		dstX[i] = x;
+		dstY[i] = y;
+		dstZ[i] = z;
+		dstW[i] = w;
+		}
+	}
+
+template<class V, SrQuatInterpolation M>
+SR_INLINE void SrQuaternionBatch::interpolateAoS(const SrF32* t, SrF32 sharedT, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n)
+	{
+	const typename V::Float st = V::splat(sharedT);
+
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float x, y, z, w, bx, by, bz, bw;
+		V::loadTransposed4(&a[i].x, 4, x, y, z, w);
+		V::loadTransposed4(&b[i].x, 4, bx, by, bz, bw);
+		interpolate<V, M>(t ? V::load(t + i) : st, x, y, z, w, bx, by, bz, bw);
+		V::storeTransposed4(&dst[i].x, 4, x, y, z, w);
+		}
+	for(; i < n; i++)
+		{
+		//copies, dst may be a or b.
+		SrQuaternion r = a[i];
+		const SrQuaternion q = b[i];
+		interpolate<SrSimdScalar, M>(t ? t[i] : sharedT, r.x, r.y, r.z, r.w, q.x, q.y, q.z, q.w);
+		dst[i] = r;
+		}
+	}
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::normalizeAoS(SrQuaternion* q, SrU32 n)
+	{
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float x, y, z, w;
+		V::loadTransposed4(&q[i].x, 4, x, y, z, w);
+		normalize<V>(x, y, z, w);
+		V::storeTransposed4(&q[i].x, 4, x, y, z, w);
+		}
+	for(; i < n; i++)
+		normalize<SrSimdScalar>(q[i].x, q[i].y, q[i].z, q[i].w);
+	}
+
+template<class V>
+SR_INLINE void SrQuaternionBatch::normalizeLanes(SrF32* x, SrF32* y, SrF32* z, SrF32* w, SrU32 n)
+	{
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float vx = V::load(x + i);
+		typename V::Float vy = V::load(y + i);
+		typename V::Float vz = V::load(z + i);
+		typename V::Float vw = V::load(w + i);
+		normalize<V>(vx, vy, vz, vw);
+		V::store(x + i, vx);
+		V::store(y + i, vy);
+		V::store(z + i, vz);
+		V::store(w + i, vw);
+		}
+	for(; i < n; i++)
+		normalize<SrSimdScalar>(x[i], y[i], z[i], w[i]);
+	}
+
+SR_INLINE void SrQuaternionBatch::rotate(const SrQuaternion& q,
+										 const SrF32* x, const SrF32* y, const SrF32* z,
+										 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatRotateShared, rotateShared<SrSimdNative>)(q, x, y, z, dstX, dstY, dstZ, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::rotate(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+										 const SrF32* x, const SrF32* y, const SrF32* z,
+										 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatRotateEach, rotateEach<SrSimdNative>)(qx, qy, qz, qw, 1.0f, x, y, z, dstX, dstY, dstZ, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::inverseRotate(const SrQuaternion& q,
+												const SrF32* x, const SrF32* y, const SrF32* z,
+												SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatRotateShared, rotateShared<SrSimdNative>)(!q, x, y, z, dstX, dstY, dstZ, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::inverseRotate(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+												const SrF32* x, const SrF32* y, const SrF32* z,
+												SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatRotateEach, rotateEach<SrSimdNative>)(qx, qy, qz, qw, -1.0f, x, y, z, dstX, dstY, dstZ, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::rotate(const SrQuaternion& q, const SrVector3SoA& src, SrVector3SoA& dst)
+	{
+	dst.resize(src.size());
+	rotate(q, src.x, src.y, src.z, dst.x, dst.y, dst.z, src.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::rotate(const SrQuaternionSoA& q, const SrVector3SoA& src, SrVector3SoA& dst)
+	{
+	SR_ASSERT(q.size() == src.size());
+	dst.resize(src.size());
+	rotate(q.x, q.y, q.z, q.w, src.x, src.y, src.z, dst.x, dst.y, dst.z, src.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::inverseRotate(const SrQuaternion& q, const SrVector3SoA& src, SrVector3SoA& dst)
+	{
+	dst.resize(src.size());
+	inverseRotate(q, src.x, src.y, src.z, dst.x, dst.y, dst.z, src.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::inverseRotate(const SrQuaternionSoA& q, const SrVector3SoA& src, SrVector3SoA& dst)
+	{
+	SR_ASSERT(q.size() == src.size());
+	dst.resize(src.size());
+	inverseRotate(q.x, q.y, q.z, q.w, src.x, src.y, src.z, dst.x, dst.y, dst.z, src.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::rotate(const SrQuaternion& q,
+										 const SrHalf* x, const SrHalf* y, const SrHalf* z,
+										 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatRotateSharedHalf, rotateShared<SrSimdNative>)(q, x, y, z, dstX, dstY, dstZ, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::rotate(const SrHalf* qx, const SrHalf* qy, const SrHalf* qz, const SrHalf* qw,
+										 const SrHalf* x, const SrHalf* y, const SrHalf* z,
+										 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatRotateEachHalf, rotateEach<SrSimdNative>)(qx, qy, qz, qw, 1.0f, x, y, z, dstX, dstY, dstZ, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::inverseRotate(const SrQuaternion& q,
+												const SrHalf* x, const SrHalf* y, const SrHalf* z,
+												SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatRotateSharedHalf, rotateShared<SrSimdNative>)(!q, x, y, z, dstX, dstY, dstZ, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::inverseRotate(const SrHalf* qx, const SrHalf* qy, const SrHalf* qz, const SrHalf* qw,
+												const SrHalf* x, const SrHalf* y, const SrHalf* z,
+												SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatRotateEachHalf, rotateEach<SrSimdNative>)(qx, qy, qz, qw, -1.0f, x, y, z, dstX, dstY, dstZ, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::slerp(const SrF32* t,
+										const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+										const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+										SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n)
+	{
+	SR_ASSERT(t);
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatInterpolateLanes[SR_QUAT_SLERP], (interpolateLanes<SrSimdNative, SR_QUAT_SLERP>))(t, 0.0f, ax, ay, az, aw, bx, by, bz, bw, dstX, dstY, dstZ, dstW, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::slerp(SrF32 t,
+										const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+										const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+										SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatInterpolateLanes[SR_QUAT_SLERP], (interpolateLanes<SrSimdNative, SR_QUAT_SLERP>))((const SrF32*)NULL, t, ax, ay, az, aw, bx, by, bz, bw, dstX, dstY, dstZ, dstW, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::slerp(const SrF32* t, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n)
+	{
+	SR_ASSERT(t);
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatInterpolateAoS[SR_QUAT_SLERP], (interpolateAoS<SrSimdNative, SR_QUAT_SLERP>))(t, 0.0f, a, b, dst, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::slerp(SrF32 t, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatInterpolateAoS[SR_QUAT_SLERP], (interpolateAoS<SrSimdNative, SR_QUAT_SLERP>))((const SrF32*)NULL, t, a, b, dst, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::slerp(const SrF32* t, const SrQuaternionSoA& a, const SrQuaternionSoA& b, SrQuaternionSoA& dst)
+	{
+	SR_ASSERT(a.size() == b.size());
+	dst.resize(a.size());
+	slerp(t, a.x, a.y, a.z, a.w, b.x, b.y, b.z, b.w, dst.x, dst.y, dst.z, dst.w, a.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::slerp(SrF32 t, const SrQuaternionSoA& a, const SrQuaternionSoA& b, SrQuaternionSoA& dst)
+	{
+	SR_ASSERT(a.size() == b.size());
+	dst.resize(a.size());
+	slerp(t, a.x, a.y, a.z, a.w, b.x, b.y, b.z, b.w, dst.x, dst.y, dst.z, dst.w, a.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::nlerp(const SrF32* t,
+										const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+										const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+										SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n)
+	{
+	SR_ASSERT(t);
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatInterpolateLanes[SR_QUAT_NLERP], (interpolateLanes<SrSimdNative, SR_QUAT_NLERP>))(t, 0.0f, ax, ay, az, aw, bx, by, bz, bw, dstX, dstY, dstZ, dstW, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::nlerp(SrF32 t,
+										const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+										const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+										SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatInterpolateLanes[SR_QUAT_NLERP], (interpolateLanes<SrSimdNative, SR_QUAT_NLERP>))((const SrF32*)NULL, t, ax, ay, az, aw, bx, by, bz, bw, dstX, dstY, dstZ, dstW, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::nlerp(const SrF32* t, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n)
+	{
+	SR_ASSERT(t);
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatInterpolateAoS[SR_QUAT_NLERP], (interpolateAoS<SrSimdNative, SR_QUAT_NLERP>))(t, 0.0f, a, b, dst, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::nlerp(SrF32 t, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatInterpolateAoS[SR_QUAT_NLERP], (interpolateAoS<SrSimdNative, SR_QUAT_NLERP>))((const SrF32*)NULL, t, a, b, dst, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::nlerp(const SrF32* t, const SrQuaternionSoA& a, const SrQuaternionSoA& b, SrQuaternionSoA& dst)
+	{
+	SR_ASSERT(a.size() == b.size());
+	dst.resize(a.size());
+	nlerp(t, a.x, a.y, a.z, a.w, b.x, b.y, b.z, b.w, dst.x, dst.y, dst.z, dst.w, a.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::nlerp(SrF32 t, const SrQuaternionSoA& a, const SrQuaternionSoA& b, SrQuaternionSoA& dst)
+	{
+	SR_ASSERT(a.size() == b.size());
+	dst.resize(a.size());
+	nlerp(t, a.x, a.y, a.z, a.w, b.x, b.y, b.z, b.w, dst.x, dst.y, dst.z, dst.w, a.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::correctedNlerp(const SrF32* t,
+												 const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+												 const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+												 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n)
+	{
+	SR_ASSERT(t);
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatInterpolateLanes[SR_QUAT_CORRECTED_NLERP], (interpolateLanes<SrSimdNative, SR_QUAT_CORRECTED_NLERP>))(t, 0.0f, ax, ay, az, aw, bx, by, bz, bw, dstX, dstY, dstZ, dstW, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::correctedNlerp(SrF32 t,
+												 const SrF32* ax, const SrF32* ay, const SrF32* az, const SrF32* aw,
+												 const SrF32* bx, const SrF32* by, const SrF32* bz, const SrF32* bw,
+												 SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatInterpolateLanes[SR_QUAT_CORRECTED_NLERP], (interpolateLanes<SrSimdNative, SR_QUAT_CORRECTED_NLERP>))((const SrF32*)NULL, t, ax, ay, az, aw, bx, by, bz, bw, dstX, dstY, dstZ, dstW, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::correctedNlerp(const SrF32* t, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n)
+	{
+	SR_ASSERT(t);
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatInterpolateAoS[SR_QUAT_CORRECTED_NLERP], (interpolateAoS<SrSimdNative, SR_QUAT_CORRECTED_NLERP>))(t, 0.0f, a, b, dst, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::correctedNlerp(SrF32 t, const SrQuaternion* a, const SrQuaternion* b, SrQuaternion* dst, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatInterpolateAoS[SR_QUAT_CORRECTED_NLERP], (interpolateAoS<SrSimdNative, SR_QUAT_CORRECTED_NLERP>))((const SrF32*)NULL, t, a, b, dst, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::correctedNlerp(const SrF32* t, const SrQuaternionSoA& a, const SrQuaternionSoA& b, SrQuaternionSoA& dst)
+	{
+	SR_ASSERT(a.size() == b.size());
+	dst.resize(a.size());
+	correctedNlerp(t, a.x, a.y, a.z, a.w, b.x, b.y, b.z, b.w, dst.x, dst.y, dst.z, dst.w, a.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::correctedNlerp(SrF32 t, const SrQuaternionSoA& a, const SrQuaternionSoA& b, SrQuaternionSoA& dst)
+	{
+	SR_ASSERT(a.size() == b.size());
+	dst.resize(a.size());
+	correctedNlerp(t, a.x, a.y, a.z, a.w, b.x, b.y, b.z, b.w, dst.x, dst.y, dst.z, dst.w, a.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::normalize(SrQuaternion* q, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatNormalizeAoS, normalizeAoS<SrSimdNative>)(q, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::normalize(SrF32* x, SrF32* y, SrF32* z, SrF32* w, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatNormalizeLanes, normalizeLanes<SrSimdNative>)(x, y, z, w, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::normalize(SrQuaternionSoA& q)
+	{
+	normalize(q.x, q.y, q.z, q.w, q.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::exp(const SrF32* vx, const SrF32* vy, const SrF32* vz,
+									  SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatExp, expLanes<SrSimdNative>)(1.0f, vx, vy, vz, qx, qy, qz, qw, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::log(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+									  SrF32* vx, SrF32* vy, SrF32* vz, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatLog, logLanes<SrSimdNative>)(1.0f, false, qx, qy, qz, qw, vx, vy, vz, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::fromRotationVector(const SrF32* vx, const SrF32* vy, const SrF32* vz,
+													 SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatExp, expLanes<SrSimdNative>)(0.5f, vx, vy, vz, qx, qy, qz, qw, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::getRotationVector(const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+													SrF32* vx, SrF32* vy, SrF32* vz, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatLog, logLanes<SrSimdNative>)(2.0f, true, qx, qy, qz, qw, vx, vy, vz, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::pow(const SrF32* t,
+									  const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+									  SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n)
+	{
+	SR_ASSERT(t);
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatPow, powLanes<SrSimdNative>)(t, 0.0f, qx, qy, qz, qw, dstX, dstY, dstZ, dstW, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::pow(SrF32 t,
+									  const SrF32* qx, const SrF32* qy, const SrF32* qz, const SrF32* qw,
+									  SrF32* dstX, SrF32* dstY, SrF32* dstZ, SrF32* dstW, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrQuaternionBatchKernels, quatPow, powLanes<SrSimdNative>)((const SrF32*)NULL, t, qx, qy, qz, qw, dstX, dstY, dstZ, dstW, n);
+	}
+
+SR_INLINE void SrQuaternionBatch::exp(const SrVector3SoA& v, SrQuaternionSoA& dst)
+	{
+	dst.resize(v.size());
+	exp(v.x, v.y, v.z, dst.x, dst.y, dst.z, dst.w, v.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::log(const SrQuaternionSoA& q, SrVector3SoA& dst)
+	{
+	dst.resize(q.size());
+	log(q.x, q.y, q.z, q.w, dst.x, dst.y, dst.z, q.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::fromRotationVector(const SrVector3SoA& v, SrQuaternionSoA& dst)
+	{
+	dst.resize(v.size());
+	fromRotationVector(v.x, v.y, v.z, dst.x, dst.y, dst.z, dst.w, v.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::getRotationVector(const SrQuaternionSoA& q, SrVector3SoA& dst)
+	{
+	dst.resize(q.size());
+	getRotationVector(q.x, q.y, q.z, q.w, dst.x, dst.y, dst.z, q.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::pow(const SrF32* t, const SrQuaternionSoA& q, SrQuaternionSoA& dst)
+	{
+	dst.resize(q.size());
+	pow(t, q.x, q.y, q.z, q.w, dst.x, dst.y, dst.z, dst.w, q.size());
+	}
+
+SR_INLINE void SrQuaternionBatch::pow(SrF32 t, const SrQuaternionSoA& q, SrQuaternionSoA& dst)
+	{
+	dst.resize(q.size());
+	pow(t, q.x, q.y, q.z, q.w, dst.x, dst.y, dst.z, dst.w, q.size());
+	}
+
+SR_SIMD_KERNEL_TABLES(SrQuaternionBatchKernels)
+
+/** @} */
+#endif
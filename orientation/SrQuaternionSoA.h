@@ -0,0 +1,207 @@
+/************************************************************************
+\file 	SrQuaternionSoA.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRQUATERNIONSOA_H_
+#define SR_FOUNDATION_SRQUATERNIONSOA_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include <string.h>
+#include "SrSimd.h"
+#include "SrQuaternion.h"
+
+/**
+\brief Structure of arrays container for quaternions.
+
+Same layout rules as SrVector3SoA: four lanes x[], y[], z[] and w[], each aligned to
+#SR_SIMD_ALIGNMENT bytes and padded to a multiple of 16 elements.
+*/
+class SrQuaternionSoA
+	{
+	public:
+	/**
+	\brief Creates an empty container.
+	*/
+	SR_INLINE SrQuaternionSoA();
+
+	/**
+	\brief Creates a container of n elements, data is left uninitialized.
+	*/
+	SR_INLINE explicit SrQuaternionSoA(SrU32 n);
+
+	/**
+	\brief Copy constructor, copies all n elements.
+	*/
+	SR_INLINE SrQuaternionSoA(const SrQuaternionSoA& other);
+
+	SR_INLINE ~SrQuaternionSoA();
+
+	/**
+	\brief Assignment operator, copies all n elements.
+	*/
+	SR_INLINE const SrQuaternionSoA& operator=(const SrQuaternionSoA& other);
+
+	/**
+	\brief Changes the number of elements. Existing data is kept up to the new size.
+	n must be at most SR_MAX_U32 - 15 and small enough that all lanes fit in a size_t,
+	a larger n is rejected.
+	*/
+	SR_INLINE void resize(SrU32 n);
+
+	/**
+	\brief number of elements.
+	*/
+	SR_INLINE SrU32 size() const;
+
+	/**
+	\brief number of elements allocated per lane, a multiple of 16.
+	*/
+	SR_INLINE SrU32 capacity() const;
+
+	/**
+	\brief writes element i.
+	*/
+	SR_INLINE void set(SrU32 i, const SrQuaternion& q);
+
+	/**
+	\brief reads element i.
+	*/
+	SR_INLINE SrQuaternion get(SrU32 i) const;
+
+	/**
+	\brief resizes to n and scatters the n AoS quaternions into the lanes.
+	*/
+	SR_INLINE void setAoS(const SrQuaternion* src, SrU32 n);
+
+	/**
+	\brief gathers all elements into the AoS array dst, which must hold size() quaternions.
+	*/
+	SR_INLINE void getAoS(SrQuaternion* dst) const;
+
+	/** the lanes */
+	SrF32* x;
+	SrF32* y;
+	SrF32* z;
+	SrF32* w;
+
+	private:
+	SrU32 mSize;
+	SrU32 mCapacity;
+	};
+
+
+SR_INLINE SrQuaternionSoA::SrQuaternionSoA() : x(NULL), y(NULL), z(NULL), w(NULL), mSize(0), mCapacity(0)
+	{
+	}
+
+SR_INLINE SrQuaternionSoA::SrQuaternionSoA(SrU32 n) : x(NULL), y(NULL), z(NULL), w(NULL), mSize(0), mCapacity(0)
+	{
+	resize(n);
+	}
+
+SR_INLINE SrQuaternionSoA::SrQuaternionSoA(const SrQuaternionSoA& other) : x(NULL), y(NULL), z(NULL), w(NULL), mSize(0), mCapacity(0)
+	{
+	*this = other;
+	}
+
+SR_INLINE SrQuaternionSoA::~SrQuaternionSoA()
+	{
+	SrAlignedMemory::deallocate(x);
+	}
+
+SR_INLINE const SrQuaternionSoA& SrQuaternionSoA::operator=(const SrQuaternionSoA& other)
+	{
+	if(this != &other)
+		{
+		resize(other.mSize);
+		memcpy(x, other.x, mSize * sizeof(SrF32));
+		memcpy(y, other.y, mSize * sizeof(SrF32));
+		memcpy(z, other.z, mSize * sizeof(SrF32));
+		memcpy(w, other.w, mSize * sizeof(SrF32));
+		}
+	return *this;
+	}
+
+SR_INLINE void SrQuaternionSoA::resize(SrU32 n)
+	{
+	if(n > mCapacity)
+		{
+		//neither the rounded capacity nor the byte count of the block may wrap, a larger n
+		//leaves the container as it is.
+		const bool fits = n <= (SR_MAX_U32 & ~15u) && n <= ((size_t)-1) / (4 * sizeof(SrF32)) - 15;
+		SR_ASSERT(fits);
+		if(!fits)
+			return;
+
+		//one block for all lanes, every lane starts on a SR_SIMD_ALIGNMENT boundary.
+		const SrU32 cap = (n + 15) & ~15u;
+		SrF32* block = (SrF32*)SrAlignedMemory::allocate(4 * (size_t)cap * sizeof(SrF32));
+		SR_ASSERT(block);
+		if(mSize)
+			{
+			memcpy(block, x, mSize * sizeof(SrF32));
+			memcpy(block + cap, y, mSize * sizeof(SrF32));
+			memcpy(block + 2 * cap, z, mSize * sizeof(SrF32));
+			memcpy(block + 3 * cap, w, mSize * sizeof(SrF32));
+			}
+		SrAlignedMemory::deallocate(x);
+		x = block;
+		y = block + cap;
+		z = block + 2 * cap;
+		w = block + 3 * cap;
+		mCapacity = cap;
+		}
+	mSize = n;
+	}
+
+SR_INLINE SrU32 SrQuaternionSoA::size() const
+	{
+	return mSize;
+	}
+
+SR_INLINE SrU32 SrQuaternionSoA::capacity() const
+	{
+	return mCapacity;
+	}
+
+SR_INLINE void SrQuaternionSoA::set(SrU32 i, const SrQuaternion& q)
+	{
+	SR_ASSERT(i < mSize);
+	x[i] = q.x;
+	y[i] = q.y;
+	z[i] = q.z;
+	w[i] = q.w;
+	}
+
+SR_INLINE SrQuaternion SrQuaternionSoA::get(SrU32 i) const
+	{
+	SR_ASSERT(i < mSize);
+	SrQuaternion q;
+	q.setXYZW(x[i], y[i], z[i], w[i]);
+	return q;
+	}
+
+SR_INLINE void SrQuaternionSoA::setAoS(const SrQuaternion* src, SrU32 n)
+	{
+	resize(n);
+	for(SrU32 i = 0; i < n; i++)
+		{
+		x[i] = src[i].x;
+		y[i] = src[i].y;
+		z[i] = src[i].z;
+		w[i] = src[i].w;
+		}
+	}
+
+SR_INLINE void SrQuaternionSoA::getAoS(SrQuaternion* dst) const
+	{
+	for(SrU32 i = 0; i < mSize; i++)
+		dst[i].setXYZW(x[i], y[i], z[i], w[i]);
+	}
+
+/** @} */
+#endif
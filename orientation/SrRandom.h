@@ -0,0 +1,257 @@
+/************************************************************************
+\file 	SrRandom.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRRANDOM_H_
+#define SR_FOUNDATION_SRRANDOM_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include "SrSimpleTypes.h"
+
+/**
+\brief Pseudo random number generator, xoshiro128** by Blackman and Vigna.
+
+128 bits of state, period 2^128 - 1, passes BigCrush. The generator is a plain value:
+it has no hidden global state, copies continue the same sequence, and each thread or
+task owns its own instance.
+
+Parallel streams are taken from one seed with jump(), which advances the state by 2^64
+numbers, so n streams never overlap unless one of them draws 2^64 numbers:
+
+	SrRandom master(seed);
+	for(i = 0; i < workers; i++)
+		{
+		worker[i] = master;
+		master.jump();
+		}
+
+SrRandomBatch fills arrays from 16 such streams with the SIMD sets. SrMath::rand() uses
+a generator per thread, see SrMath::getRandom().
+*/
+class SrRandom
+	{
+	public:
+	/**
+	\brief Same as setSeed(seed).
+	*/
+	SR_INLINE explicit SrRandom(SrU32 seed = 1);
+
+	/**
+	\brief setSeed(seed) followed by stream long jumps, the stream-th of the 2^32
+	non overlapping streams of 2^96 numbers of a seed. Costs O(stream).
+	*/
+	SR_INLINE SrRandom(SrU32 seed, SrU32 stream);
+
+	/**
+	\brief Restarts the sequence. Every seed gives a different, fixed sequence.
+	*/
+	SR_INLINE void setSeed(SrU32 seed);
+
+	/**
+	\brief Uniform 32 bit integer, all bits equally random.
+	*/
+	SR_INLINE SrU32 nextU32();
+
+	/**
+	\brief Uniform float in [0, 1), a multiple of 2^-24.
+	*/
+	SR_INLINE SrF32 nextF32();
+
+	/**
+	\brief Uniform double in [0, 1), a multiple of 2^-53.
+	*/
+	SR_INLINE SrF64 nextF64();
+
+	/**
+	\brief Uniform integer in [0, n), without modulo bias. n must not be 0.
+	*/
+	SR_INLINE SrU32 nextBelow(SrU32 n);
+
+	/**
+	\brief uniform random number in [a,b]
+	*/
+	SR_INLINE SrF32 rand(SrF32 a, SrF32 b);
+	/**
+	\brief uniform random number in [a,b]
+	*/
+	SR_INLINE SrF64 rand(SrF64 a, SrF64 b);
+	/**
+	\brief uniform random number in [a,b), b must be greater than a.
+	*/
+	SR_INLINE SrI32 rand(SrI32 a, SrI32 b);
+
+	/**
+	\brief Advances the state by 2^64 numbers.
+	*/
+	SR_INLINE void jump();
+
+	/**
+	\brief Advances the state by 2^96 numbers.
+	*/
+	SR_INLINE void longJump();
+
+	/**
+	\brief The four state words, for saving a generator or seeding SrRandomBatch.
+	*/
+	SR_INLINE void getState(SrU32* dst) const;
+
+	/**
+	\brief Restores a state from getState(). The state must not be all zero.
+	*/
+	SR_INLINE void setState(const SrU32* src);
+
+	private:
+	SR_INLINE static SrU32 rotl(SrU32 x, SrI32 k);
+	SR_INLINE void jump(const SrU32* polynomial);
+
+	SrU32 s[4];
+	};
+
+
+SR_INLINE SrRandom::SrRandom(SrU32 seed)
+	{
+	setSeed(seed);
+	}
+
+SR_INLINE SrRandom::SrRandom(SrU32 seed, SrU32 stream)
+	{
+	setSeed(seed);
+	for(SrU32 i = 0; i < stream; i++)
+		longJump();
+	}
+
+SR_INLINE void SrRandom::setSeed(SrU32 seed)
+	{
+	//the state words are a 32 bit finaliser (murmur3 fmix32) of consecutive Weyl steps,
+	//so close seeds give unrelated states.
+	for(SrI32 i = 0; i < 4; i++)
+		{
+		seed += 0x9E3779B9u;
+		SrU32 z = seed;
+		z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+		z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+		s[i] = z ^ (z >> 16);
+		}
+	if((s[0] | s[1] | s[2] | s[3]) == 0)
+		s[0] = 1;
+	}
+
+SR_INLINE SrU32 SrRandom::rotl(SrU32 x, SrI32 k)
+	{
+	return (x << k) | (x >> (32 - k));
+	}
+
+SR_INLINE SrU32 SrRandom::nextU32()
+	{
+	const SrU32 result = rotl(s[1] * 5, 7) * 9;
+	const SrU32 t = s[1] << 9;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl(s[3], 11);
+	return result;
+	}
+
+SR_INLINE SrF32 SrRandom::nextF32()
+	{
+	return (SrF32)(nextU32() >> 8) * (1.0f / 16777216.0f);
+	}
+
+SR_INLINE SrF64 SrRandom::nextF64()
+	{
+	const SrU32 hi = nextU32() >> 5;
+	const SrU32 lo = nextU32() >> 6;
+	return ((SrF64)hi * 67108864.0 + (SrF64)lo) * (1.0 / 9007199254740992.0);
+	}
+
+SR_INLINE SrU32 SrRandom::nextBelow(SrU32 n)
+	{
+	//Lemire's multiply and shift, draws again in the (2^32 mod n) / 2^32 biased cases.
+	SrU64 m = (SrU64)nextU32() * n;
+	SrU32 low = (SrU32)m;
+	if(low < n)
+		{
+		const SrU32 threshold = (0u - n) % n;
+		while(low < threshold)
+			{
+			m = (SrU64)nextU32() * n;
+			low = (SrU32)m;
+			}
+		}
+	return (SrU32)(m >> 32);
+	}
+
+SR_INLINE SrF32 SrRandom::rand(SrF32 a, SrF32 b)
+	{
+	return nextF32() * (b - a) + a;
+	}
+
+SR_INLINE SrF64 SrRandom::rand(SrF64 a, SrF64 b)
+	{
+	return nextF64() * (b - a) + a;
+	}
+
+SR_INLINE SrI32 SrRandom::rand(SrI32 a, SrI32 b)
+	{
+	return (SrI32)((SrU32)a + nextBelow((SrU32)b - (SrU32)a));
+	}
+
+SR_INLINE void SrRandom::jump(const SrU32* polynomial)
+	{
+	SrU32 t[4] = { 0, 0, 0, 0 };
+	for(SrI32 i = 0; i < 4; i++)
+		{
+		for(SrI32 b = 0; b < 32; b++)
+			{
+			if(polynomial[i] & (1u << b))
+				{
+				t[0] ^= s[0];
+				t[1] ^= s[1];
+				t[2] ^= s[2];
+				t[3] ^= s[3];
+				}
+			nextU32();
+			}
+		}
+	s[0] = t[0];
+	s[1] = t[1];
+	s[2] = t[2];
+	s[3] = t[3];
+	}
+
+SR_INLINE void SrRandom::jump()
+	{
+	static const SrU32 polynomial[4] = { 0x8764000Bu, 0xF542D2D3u, 0x6FA035C3u, 0x77F2DB5Bu };
+	jump(polynomial);
+	}
+
+SR_INLINE void SrRandom::longJump()
+	{
+	static const SrU32 polynomial[4] = { 0xB523952Eu, 0x0B6F099Fu, 0xCCF5A0EFu, 0x1C580662u };
+	jump(polynomial);
+	}
+
+SR_INLINE void SrRandom::getState(SrU32* dst) const
+	{
+	dst[0] = s[0];
+	dst[1] = s[1];
+	dst[2] = s[2];
+	dst[3] = s[3];
+	}
+
+SR_INLINE void SrRandom::setState(const SrU32* src)
+	{
+	s[0] = src[0];
+	s[1] = src[1];
+	s[2] = src[2];
+	s[3] = src[3];
+	}
+
+/** @} */
+#endif
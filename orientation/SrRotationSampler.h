@@ -0,0 +1,354 @@
+/************************************************************************
+\file 	SrRotationSampler.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRROTATIONSAMPLER_H_
+#define SR_FOUNDATION_SRROTATIONSAMPLER_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include "SrSimd.h"
+#include "SrSimdDispatch.h"
+#include "SrSimdMath.h"
+#include "SrRandomBatch.h"
+#include "SrQuaternion.h"
+#include "SrQuaternionSoA.h"
+
+/**
+\brief Static class generating sets of rotations, as unit quaternions.
+
+All of them map points of the unit cube to rotations with SrQuaternion::fromUnitCube(),
+which preserves volume, so the spread of the points carries over to the rotations:
+
+	uniform		independent uniform points, uniform random rotations.
+	stratified	k^3 points, one uniform point in each cell of a k x k x k grid. Each cell is
+				a region of rotations of equal volume, so no region of 1/k^3 of SO(3) is
+				left without a sample.
+	sequence	the R3 Kronecker sequence of Roberts, point i = frac(1/2 + i (1/g, 1/g^2, 1/g^3))
+				with g^4 = g + 1. Low-discrepancy and open ended: any prefix is evenly spread,
+				a search can continue from where it stopped. An SrRandom may shift the whole
+				sequence (Cranley-Patterson rotation) for independent randomised replicas.
+
+The quaternions have w of both signs, q and -q are the same rotation.
+
+The AoS functions use the scalar SrQuaternion code. The SoA functions draw from an
+SrRandomBatch and map with the SrSimdMath polynomials, SrSimdNative::Width rotations per
+instruction; the sequence gives the same points in both forms. Measured for 64K rotations,
+g++ -O2, ns per rotation:
+
+				AVX-512		SSE2		AoS scalar
+	uniform		1.8			11			38
+	sequence	1.2			8.3			17
+*/
+class SrRotationSampler
+	{
+	public:
+	/**
+	\brief n uniform random rotations.
+	*/
+	SR_INLINE static void uniform(SrRandom& random, SrQuaternion* dst, SrU32 n);
+	SR_INLINE static void uniform(SrRandomBatch& random, SrQuaternionSoA& dst, SrU32 n);
+
+	/**
+	\brief k^3 stratified random rotations, dst must hold k^3 quaternions. Sample i lies in
+	cell (i / k^2, i / k % k, i % k).
+	*/
+	SR_INLINE static void stratified(SrRandom& random, SrU32 k, SrQuaternion* dst);
+	SR_INLINE static void stratified(SrRandomBatch& random, SrU32 k, SrQuaternionSoA& dst);
+
+	/**
+	\brief rotations first to first + n - 1 of the low-discrepancy sequence.
+	*/
+	SR_INLINE static void sequence(SrU32 first, SrQuaternion* dst, SrU32 n);
+	SR_INLINE static void sequence(SrU32 first, SrQuaternionSoA& dst, SrU32 n);
+
+	/**
+	\brief the same, with the sequence shifted by three numbers drawn from shift.
+	The same shift state gives the same rotations.
+	*/
+	SR_INLINE static void sequence(SrRandom& shift, SrU32 first, SrQuaternion* dst, SrU32 n);
+	SR_INLINE static void sequence(SrRandom& shift, SrU32 first, SrQuaternionSoA& dst, SrU32 n);
+
+	/**
+	\brief point i of the sequence as 32 bit fixed point fractions, with the offsets of the shift added.
+	*/
+	SR_INLINE static void sequencePoint(SrU32 i, const SrU32* offset, SrU32* u);
+
+	/**
+	\brief register level SrQuaternion::fromUnitCube().
+	*/
+	template<class V>
+	SR_INLINE static void fromUnitCube(typename V::Float u1, typename V::Float u2, typename V::Float u3,
+									   typename V::Float& x, typename V::Float& y, typename V::Float& z, typename V::Float& w);
+
+	/**
+	\brief q[i] = fromUnitCube(u1[i], u2[i], u3[i]) over lanes, u1, u2 and u3 may alias
+	qx, qy and qz.
+	*/
+	template<class V>
+	SR_INLINE static void fromUnitCubeLanes(const SrF32* u1, const SrF32* u2, const SrF32* u3,
+											SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n);
+
+	/**
+	\brief rotations first to first + n - 1 of the sequence with the fixed point offset, over lanes.
+	*/
+	template<class V>
+	SR_INLINE static void sequenceLanes(SrU32 first, const SrU32* offset,
+										SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n);
+
+	private:
+	SR_INLINE static SrF32 toUnit(SrU32 u);
+	};
+
+/**
+\brief The SrRotationSampler kernels of one SrSimd set, the table SR_SIMD_KERNEL() calls through
+with SR_SIMD_DISPATCH.
+*/
+struct SrRotationSamplerKernels
+	{
+	void (*rotationFromUnitCube)(const SrF32* u1, const SrF32* u2, const SrF32* u3, SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n);
+	void (*rotationSequence)(SrU32 first, const SrU32* offset, SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n);
+
+	/**
+	\brief The table of the set V, see SrSimdDispatch.h.
+	*/
+	template<class V>
+	class Table
+		{
+		public:
+		static SrRotationSamplerKernels create()
+			{
+			SrRotationSamplerKernels k;
+			k.rotationFromUnitCube = rotationFromUnitCube;
+			k.rotationSequence = rotationSequence;
+			return k;
+			}
+
+		private:
+		SR_SIMD_FLATTEN static void rotationFromUnitCube(const SrF32* u1, const SrF32* u2, const SrF32* u3, SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n)
+			{
+			SrRotationSampler::fromUnitCubeLanes<V>(u1, u2, u3, qx, qy, qz, qw, n);
+			}
+
+		SR_SIMD_FLATTEN static void rotationSequence(SrU32 first, const SrU32* offset, SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n)
+			{
+			SrRotationSampler::sequenceLanes<V>(first, offset, qx, qy, qz, qw, n);
+			}
+		};
+	};
+
+
+/*
+1/g, 1/g^2 and 1/g^3 in 32 bit fixed point. Stepping the fractions with integer adds is
+exact for any index, a float sum loses the low digits after a few million points.
+*/
+#define SR_ROTATION_SEQUENCE_1		0xD1B54A33u
+#define SR_ROTATION_SEQUENCE_2		0xABC98389u
+#define SR_ROTATION_SEQUENCE_3		0x8CB92BA7u
+
+SR_INLINE SrF32 SrRotationSampler::toUnit(SrU32 u)
+	{
+	//the 24 high bits, as SrSimd toUnit.
+	return (SrF32)(u >> 8) * (1.0f / 16777216.0f);
+	}
+
+SR_INLINE void SrRotationSampler::uniform(SrRandom& random, SrQuaternion* dst, SrU32 n)
+	{
+	for(SrU32 i = 0; i < n; i++)
+		dst[i].random(random);
+	}
+
+SR_INLINE void SrRotationSampler::uniform(SrRandomBatch& random, SrQuaternionSoA& dst, SrU32 n)
+	{
+	//the points are drawn into the x, y and z lanes and mapped in place.
+	dst.resize(n);
+	random.fill(dst.x, n);
+	random.fill(dst.y, n);
+	random.fill(dst.z, n);
+	SR_SIMD_KERNEL(SrRotationSamplerKernels, rotationFromUnitCube, fromUnitCubeLanes<SrSimdNative>)(dst.x, dst.y, dst.z, dst.x, dst.y, dst.z, dst.w, n);
+	}
+
+SR_INLINE void SrRotationSampler::stratified(SrRandom& random, SrU32 k, SrQuaternion* dst)
+	{
+	const SrF32 cell = 1.0f / (SrF32)k;
+	SrU32 i = 0;
+	for(SrU32 a = 0; a < k; a++)
+		for(SrU32 b = 0; b < k; b++)
+			for(SrU32 c = 0; c < k; c++, i++)
+				{
+				const SrF32 u1 = ((SrF32)a + random.nextF32()) * cell;
+				const SrF32 u2 = ((SrF32)b + random.nextF32()) * cell;
+				const SrF32 u3 = ((SrF32)c + random.nextF32()) * cell;
+				dst[i].fromUnitCube(u1, u2, u3);
+				}
+	}
+
+SR_INLINE void SrRotationSampler::stratified(SrRandomBatch& random, SrU32 k, SrQuaternionSoA& dst)
+	{
+	const SrU32 n = k * k * k;
+	const SrF32 cell = 1.0f / (SrF32)k;
+	dst.resize(n);
+	random.fill(dst.x, n);
+	random.fill(dst.y, n);
+	random.fill(dst.z, n);
+	SrU32 i = 0;
+	for(SrU32 a = 0; a < k; a++)
+		for(SrU32 b = 0; b < k; b++)
+			for(SrU32 c = 0; c < k; c++, i++)
+				{
+				dst.x[i] = ((SrF32)a + dst.x[i]) * cell;
+				dst.y[i] = ((SrF32)b + dst.y[i]) * cell;
+				dst.z[i] = ((SrF32)c + dst.z[i]) * cell;
+				}
+	SR_SIMD_KERNEL(SrRotationSamplerKernels, rotationFromUnitCube, fromUnitCubeLanes<SrSimdNative>)(dst.x, dst.y, dst.z, dst.x, dst.y, dst.z, dst.w, n);
+	}
+
+SR_INLINE void SrRotationSampler::sequencePoint(SrU32 i, const SrU32* offset, SrU32* u)
+	{
+	u[0] = 0x80000000u + offset[0] + i * SR_ROTATION_SEQUENCE_1;
+	u[1] = 0x80000000u + offset[1] + i * SR_ROTATION_SEQUENCE_2;
+	u[2] = 0x80000000u + offset[2] + i * SR_ROTATION_SEQUENCE_3;
+	}
+
+SR_INLINE void SrRotationSampler::sequence(SrU32 first, SrQuaternion* dst, SrU32 n)
+	{
+	const SrU32 offset[3] = { 0, 0, 0 };
+	SrU32 u[3];
+	for(SrU32 i = 0; i < n; i++)
+		{
+		sequencePoint(first + i, offset, u);
+		dst[i].fromUnitCube(toUnit(u[0]), toUnit(u[1]), toUnit(u[2]));
+		}
+	}
+
+SR_INLINE void SrRotationSampler::sequence(SrU32 first, SrQuaternionSoA& dst, SrU32 n)
+	{
+	const SrU32 offset[3] = { 0, 0, 0 };
+	dst.resize(n);
+	SR_SIMD_KERNEL(SrRotationSamplerKernels, rotationSequence, sequenceLanes<SrSimdNative>)(first, offset, dst.x, dst.y, dst.z, dst.w, n);
+	}
+
+SR_INLINE void SrRotationSampler::sequence(SrRandom& shift, SrU32 first, SrQuaternion* dst, SrU32 n)
+	{
+	const SrU32 offset[3] = { shift.nextU32(), shift.nextU32(), shift.nextU32() };
+	SrU32 u[3];
+	for(SrU32 i = 0; i < n; i++)
+		{
+		sequencePoint(first + i, offset, u);
+		dst[i].fromUnitCube(toUnit(u[0]), toUnit(u[1]), toUnit(u[2]));
+		}
+	}
+
+SR_INLINE void SrRotationSampler::sequence(SrRandom& shift, SrU32 first, SrQuaternionSoA& dst, SrU32 n)
+	{
+	const SrU32 offset[3] = { shift.nextU32(), shift.nextU32(), shift.nextU32() };
+	dst.resize(n);
+	SR_SIMD_KERNEL(SrRotationSamplerKernels, rotationSequence, sequenceLanes<SrSimdNative>)(first, offset, dst.x, dst.y, dst.z, dst.w, n);
+	}
+
+template<class V>
+SR_INLINE void SrRotationSampler::fromUnitCube(typename V::Float u1, typename V::Float u2, typename V::Float u3,
+											   typename V::Float& x, typename V::Float& y, typename V::Float& z, typename V::Float& w)
+	{
+	//the angles are taken as 2 pi (u - 1/2), in [-pi, pi) where the polynomials are most
+	//accurate. That negates sin and cos, which the negated radii undo.
+	const typename V::Float one = V::splat(1.0f);
+	const typename V::Float half = V::splat(0.5f);
+	const typename V::Float twoPi = V::splat(SrTwoPiF32);
+	const typename V::Float r1 = V::neg(V::sqrt(V::max(V::sub(one, u1), V::zero())));
+	const typename V::Float r2 = V::neg(V::sqrt(V::max(u1, V::zero())));
+	typename V::Float s2, c2, s3, c3;
+	SrSimdMath::sinCos<V>(V::mul(V::sub(u2, half), twoPi), s2, c2);
+	SrSimdMath::sinCos<V>(V::mul(V::sub(u3, half), twoPi), s3, c3);
+	x = V::mul(r1, s2);
+	y = V::mul(r1, c2);
+	z = V::mul(r2, s3);
+	w = V::mul(r2, c3);
+	}
+
+template<class V>
+SR_INLINE void SrRotationSampler::fromUnitCubeLanes(const SrF32* u1, const SrF32* u2, const SrF32* u3,
+													SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n)
+	{
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float x, y, z, w;
+		fromUnitCube<V>(V::load(u1 + i), V::load(u2 + i), V::load(u3 + i), x, y, z, w);
+		V::store(qx + i, x);
+		V::store(qy + i, y);
+		V::store(qz + i, z);
+		V::store(qw + i, w);
+		}
+	for(; i < n; i++)
+		{
+		SrF32 x, y, z, w;
+		fromUnitCube<SrSimdScalar>(u1[i], u2[i], u3[i], x, y, z, w);
+		qx[i] = x;
+		qy[i] = y;
+		qz[i] = z;
+		qw[i] = w;
+		}
+	}
+
+template<class V>
+SR_INLINE void SrRotationSampler::sequenceLanes(SrU32 first, const SrU32* offset,
+												SrF32* qx, SrF32* qy, SrF32* qz, SrF32* qw, SrU32 n)
+	{
+	//the fractions of Width consecutive points, stepped by Width points per register.
+	SrU32 start[3][V::Width];
+	for(SrU32 l = 0; l < (SrU32)V::Width; l++)
+		{
+		SrU32 u[3];
+		sequencePoint(first + l, offset, u);
+		start[0][l] = u[0];
+		start[1][l] = u[1];
+		start[2][l] = u[2];
+		}
+	typename V::Int f1 = V::loadInt(start[0]);
+	typename V::Int f2 = V::loadInt(start[1]);
+	typename V::Int f3 = V::loadInt(start[2]);
+	SrU32 step[3][V::Width];
+	for(SrU32 l = 0; l < (SrU32)V::Width; l++)
+		{
+		step[0][l] = (SrU32)V::Width * SR_ROTATION_SEQUENCE_1;
+		step[1][l] = (SrU32)V::Width * SR_ROTATION_SEQUENCE_2;
+		step[2][l] = (SrU32)V::Width * SR_ROTATION_SEQUENCE_3;
+		}
+	const typename V::Int d1 = V::loadInt(step[0]);
+	const typename V::Int d2 = V::loadInt(step[1]);
+	const typename V::Int d3 = V::loadInt(step[2]);
+
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float x, y, z, w;
+		fromUnitCube<V>(V::toUnit(f1), V::toUnit(f2), V::toUnit(f3), x, y, z, w);
+		V::store(qx + i, x);
+		V::store(qy + i, y);
+		V::store(qz + i, z);
+		V::store(qw + i, w);
+		f1 = V::addInt(f1, d1);
+		f2 = V::addInt(f2, d2);
+		f3 = V::addInt(f3, d3);
+		}
+	for(; i < n; i++)
+		{
+		SrU32 u[3];
+		sequencePoint(first + i, offset, u);
+		SrF32 x, y, z, w;
+		fromUnitCube<SrSimdScalar>(toUnit(u[0]), toUnit(u[1]), toUnit(u[2]), x, y, z, w);
+		qx[i] = x;
+		qy[i] = y;
+		qz[i] = z;
+		qw[i] = w;
+		}
+	}
+
+SR_SIMD_KERNEL_TABLES(SrRotationSamplerKernels)
+
+/** @} */
+#endif
@@ -0,0 +1,698 @@
+/************************************************************************
+\file 	SrSimd.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRSIMD_H_
+#define SR_FOUNDATION_SRSIMD_H_
+
+/** \addtogroup foundation
+  @{
+*/
+
+#include <stdlib.h>
+#include <math.h>
+#include "SrSimpleTypes.h"
+#include "SrHalf.h"
+
+/*
+Instruction set selection. The widest instruction set the compiler was told about
+is picked as SrSimdNative; define SR_SIMD_DISABLE to force the scalar path.
+SrSimdDispatch.h picks the set at run time instead.
+*/
+#if !defined(SR_SIMD_DISABLE)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SR_SIMD_SSE
+#endif
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define SR_SIMD_AVX2
+#endif
+#if defined(__AVX512F__)
+#define SR_SIMD_AVX512
+#endif
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define SR_SIMD_F16C
+#endif
+#endif
+
+#if defined(SR_SIMD_SSE) || defined(SR_SIMD_AVX2) || defined(SR_SIMD_AVX512)
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+/**
+\brief Alignment in bytes of the lane arrays handed out by the SoA containers.
+
+64 bytes is one cache line and the width of an AVX-512 register.
+*/
+#define SR_SIMD_ALIGNMENT	64
+
+/**
+\brief Static class handing out memory aligned to #SR_SIMD_ALIGNMENT.
+*/
+class SrAlignedMemory
+	{
+	public:
+	/**
+	\brief Allocates size bytes aligned to #SR_SIMD_ALIGNMENT. Returns NULL on failure.
+	*/
+	SR_INLINE static void* allocate(size_t size);
+
+	/**
+	\brief Releases memory obtained from #allocate(). NULL is ignored.
+	*/
+	SR_INLINE static void deallocate(void* ptr);
+	};
+
+SR_INLINE void* SrAlignedMemory::allocate(size_t size)
+	{
+#if defined(_MSC_VER)
+	return _aligned_malloc(size, SR_SIMD_ALIGNMENT);
+#else
+	void* ptr = NULL;
+	if(posix_memalign(&ptr, SR_SIMD_ALIGNMENT, size) != 0)
+		return NULL;
+	return ptr;
+#endif
+	}
+
+SR_INLINE void SrAlignedMemory::deallocate(void* ptr)
+	{
+#if defined(_MSC_VER)
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+	}
+
+/*
+The SrSimdXXX classes below all expose the same static interface over one register
+of Width floats, so that batch kernels can be written once as a template over it:
+
+	Float		register type, Width lanes of SrF32
+	Mask		per lane boolean, result of the comparisons
+	load/store	unaligned memory access of Width consecutive floats, or of Width SrHalf
+				converted from and to float. The SSE and AVX2 classes convert with
+				F16C when the compiler enables it (-mf16c) and lane by lane otherwise
+	loadTransposed3/storeTransposed3
+				reads or writes Width 3 float records that are stride floats apart,
+				transposed to one register per component. The load reads 4 elements
+				per record, so the one after the last record read must be addressable.
+	loadTransposed4/storeTransposed4
+				same for 4 float records such as SrQuaternion; both loads also read
+				records of SrHalf, 4 halves each
+	gatherTransposed4
+				reads the 4 floats at p[l] + offset for each lane l, transposed like
+				loadTransposed4, for records that are not evenly spaced such as table
+				lookups
+	splat		broadcasts a scalar to all lanes
+	madd		a*b + c, fused where the set has FMA unless SR_DETERMINISTIC is defined
+	nmadd		c - a*b, same
+	round		round to nearest, ties to even
+	ldexp		a * 2^n for integral n in [-252, 254]
+	frexp		splits a normal a into m * 2^e with m in [0.5, 1), returns m
+	select		m ? a : b, per lane
+	Int			register of Width SrU32 lanes, with wrapping add, xor, or, and and logical
+				shifts by a constant; toUnit turns the 24 high bits of each lane into a
+				float in [0, 1), toInt truncates floats in [0, 2^31) to integers and
+				toFloat converts integers below 2^31 back
+*/
+
+/**
+\brief One lane "register", used when no vector instruction set is available and for loop tails.
+*/
+class SrSimdScalar
+	{
+	public:
+	typedef SrF32	Float;
+	typedef bool	Mask;
+	enum { Width = 1 };
+
+	SR_INLINE static Float load(const SrF32* p)				{ return *p;	}
+	SR_INLINE static void store(SrF32* p, Float a)			{ *p = a;		}
+	SR_INLINE static Float load(const SrHalf* p)			{ return *p;	}
+	SR_INLINE static void store(SrHalf* p, Float a)			{ *p = SrHalf(a);	}
+	SR_INLINE static void loadTransposed3(const SrF32* p, SrI32, Float& x, Float& y, Float& z)	{ x = p[0]; y = p[1]; z = p[2];	}
+	SR_INLINE static void storeTransposed3(SrF32* p, SrI32, Float x, Float y, Float z)			{ p[0] = x; p[1] = y; p[2] = z;	}
+	SR_INLINE static void loadTransposed4(const SrF32* p, SrI32, Float& x, Float& y, Float& z, Float& w)	{ x = p[0]; y = p[1]; z = p[2]; w = p[3];	}
+	SR_INLINE static void storeTransposed4(SrF32* p, SrI32, Float x, Float y, Float z, Float w)			{ p[0] = x; p[1] = y; p[2] = z; p[3] = w;	}
+	SR_INLINE static void loadTransposed3(const SrHalf* p, SrI32, Float& x, Float& y, Float& z)	{ x = p[0]; y = p[1]; z = p[2];	}
+	SR_INLINE static void loadTransposed4(const SrHalf* p, SrI32, Float& x, Float& y, Float& z, Float& w)	{ x = p[0]; y = p[1]; z = p[2]; w = p[3];	}
+	SR_INLINE static void gatherTransposed4(const SrF32* const* p, SrI32 offset, Float& x, Float& y, Float& z, Float& w)
+		{
+		const SrF32* q = p[0] + offset;
+		x = q[0]; y = q[1]; z = q[2]; w = q[3];
+		}
+	SR_INLINE static Float splat(SrF32 a)					{ return a;		}
+	SR_INLINE static Float zero()							{ return 0.0f;	}
+
+	SR_INLINE static Float add(Float a, Float b)			{ return a + b;	}
+	SR_INLINE static Float sub(Float a, Float b)			{ return a - b;	}
+	SR_INLINE static Float mul(Float a, Float b)			{ return a * b;	}
+	SR_INLINE static Float div(Float a, Float b)			{ return a / b;	}
+	SR_INLINE static Float madd(Float a, Float b, Float c)	{ return a * b + c;	}
+	SR_INLINE static Float nmadd(Float a, Float b, Float c)	{ return c - a * b;	}
+	SR_INLINE static Float neg(Float a)						{ return -a;	}
+	SR_INLINE static Float abs(Float a)						{ return ::fabsf(a);	}
+	SR_INLINE static Float sqrt(Float a)					{ return ::sqrtf(a);	}
+	SR_INLINE static Float min(Float a, Float b)			{ return a < b ? a : b;	}
+	SR_INLINE static Float max(Float a, Float b)			{ return a < b ? b : a;	}
+	SR_INLINE static Float round(Float a)					{ return ::rintf(a);	}
+	SR_INLINE static Float floor(Float a)					{ return ::floorf(a);	}
+	SR_INLINE static Float ldexp(Float a, Float n)			{ return ::ldexpf(a, (int)n);	}
+	SR_INLINE static Float frexp(Float a, Float& e)			{ int i; const Float m = ::frexpf(a, &i); e = (Float)i; return m;	}
+
+	SR_INLINE static Mask cmpEq(Float a, Float b)			{ return a == b;	}
+	SR_INLINE static Mask cmpLt(Float a, Float b)			{ return a < b;		}
+	SR_INLINE static Mask cmpLe(Float a, Float b)			{ return a <= b;	}
+	SR_INLINE static Mask cmpGt(Float a, Float b)			{ return a > b;		}
+	SR_INLINE static Mask cmpGe(Float a, Float b)			{ return a >= b;	}
+	SR_INLINE static Mask maskAnd(Mask a, Mask b)			{ return a && b;	}
+	SR_INLINE static Mask maskOr(Mask a, Mask b)			{ return a || b;	}
+	SR_INLINE static Mask maskAndNot(Mask a, Mask b)		{ return !a && b;	}
+	SR_INLINE static Float select(Mask m, Float a, Float b)	{ return m ? a : b;	}
+
+	typedef SrU32	Int;
+	SR_INLINE static Int loadInt(const SrU32* p)			{ return *p;	}
+	SR_INLINE static void storeInt(SrU32* p, Int a)		{ *p = a;		}
+	SR_INLINE static Int addInt(Int a, Int b)				{ return a + b;	}
+	SR_INLINE static Int xorInt(Int a, Int b)				{ return a ^ b;	}
+	SR_INLINE static Int orInt(Int a, Int b)				{ return a | b;	}
+	SR_INLINE static Int andInt(Int a, Int b)				{ return a & b;	}
+	template<int N> SR_INLINE static Int shlInt(Int a)		{ return a << N;	}
+	template<int N> SR_INLINE static Int shrInt(Int a)		{ return a >> N;	}
+	SR_INLINE static Float toUnit(Int a)					{ return (SrF32)(a >> 8) * (1.0f / 16777216.0f);	}
+	SR_INLINE static Int toInt(Float a)						{ return (SrU32)a;	}
+	SR_INLINE static Float toFloat(Int a)					{ return (SrF32)(SrI32)a;	}
+	};
+
+#if defined(SR_SIMD_SSE)
+/**
+\brief 4 lanes, SSE2.
+*/
+class SrSimdSSE
+	{
+	public:
+	typedef __m128	Float;
+	typedef __m128	Mask;
+	enum { Width = 4 };
+
+	SR_INLINE static Float load(const SrF32* p)				{ return _mm_loadu_ps(p);	}
+	SR_INLINE static void store(SrF32* p, Float a)			{ _mm_storeu_ps(p, a);		}
+#if defined(SR_SIMD_F16C)
+	SR_INLINE static Float load(const SrHalf* p)			{ return _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)p));	}
+	SR_INLINE static void store(SrHalf* p, Float a)			{ _mm_storel_epi64((__m128i*)p, _mm_cvtps_ph(a, _MM_FROUND_TO_NEAREST_INT));	}
+#else
+	SR_INLINE static Float load(const SrHalf* p)			{ return _mm_setr_ps(p[0], p[1], p[2], p[3]);	}
+	SR_INLINE static void store(SrHalf* p, Float a)
+		{
+		SR_ALIGN(16) SrF32 lanes[4];
+		_mm_store_ps(lanes, a);
+		for(int l = 0; l < 4; l++)
+			p[l] = SrHalf(lanes[l]);
+		}
+#endif
+	SR_INLINE static void loadTransposed3(const SrF32* p, SrI32 stride, Float& x, Float& y, Float& z)
+		{
+		Float w;
+		loadTransposed4(p, stride, x, y, z, w);
+		}
+	SR_INLINE static void loadTransposed4(const SrF32* p, SrI32 stride, Float& x, Float& y, Float& z, Float& w)
+		{
+		transpose4(_mm_loadu_ps(p), _mm_loadu_ps(p + stride), _mm_loadu_ps(p + 2 * stride), _mm_loadu_ps(p + 3 * stride), x, y, z, w);
+		}
+	SR_INLINE static void loadTransposed3(const SrHalf* p, SrI32 stride, Float& x, Float& y, Float& z)
+		{
+		Float w;
+		loadTransposed4(p, stride, x, y, z, w);
+		}
+	SR_INLINE static void loadTransposed4(const SrHalf* p, SrI32 stride, Float& x, Float& y, Float& z, Float& w)
+		{
+		transpose4(load(p), load(p + stride), load(p + 2 * stride), load(p + 3 * stride), x, y, z, w);
+		}
+	SR_INLINE static void gatherTransposed4(const SrF32* const* p, SrI32 offset, Float& x, Float& y, Float& z, Float& w)
+		{
+		transpose4(_mm_loadu_ps(p[0] + offset), _mm_loadu_ps(p[1] + offset), _mm_loadu_ps(p[2] + offset), _mm_loadu_ps(p[3] + offset), x, y, z, w);
+		}
+	SR_INLINE static void storeTransposed3(SrF32* p, SrI32 stride, Float x, Float y, Float z)
+		{
+		const __m128 xy01 = _mm_unpacklo_ps(x, y);
+		const __m128 xy23 = _mm_unpackhi_ps(x, y);
+		_mm_storel_pi((__m64*)p, xy01);
+		_mm_store_ss(p + 2, z);
+		_mm_storeh_pi((__m64*)(p + stride), xy01);
+		_mm_store_ss(p + stride + 2, _mm_shuffle_ps(z, z, _MM_SHUFFLE(1,1,1,1)));
+		_mm_storel_pi((__m64*)(p + 2 * stride), xy23);
+		_mm_store_ss(p + 2 * stride + 2, _mm_shuffle_ps(z, z, _MM_SHUFFLE(2,2,2,2)));
+		_mm_storeh_pi((__m64*)(p + 3 * stride), xy23);
+		_mm_store_ss(p + 3 * stride + 2, _mm_shuffle_ps(z, z, _MM_SHUFFLE(3,3,3,3)));
+		}
+	SR_INLINE static void storeTransposed4(SrF32* p, SrI32 stride, Float x, Float y, Float z, Float w)
+		{
+		const __m128 xy01 = _mm_unpacklo_ps(x, y);
+		const __m128 zw01 = _mm_unpacklo_ps(z, w);
+		const __m128 xy23 = _mm_unpackhi_ps(x, y);
+		const __m128 zw23 = _mm_unpackhi_ps(z, w);
+		_mm_storeu_ps(p, _mm_movelh_ps(xy01, zw01));
+		_mm_storeu_ps(p + stride, _mm_movehl_ps(zw01, xy01));
+		_mm_storeu_ps(p + 2 * stride, _mm_movelh_ps(xy23, zw23));
+		_mm_storeu_ps(p + 3 * stride, _mm_movehl_ps(zw23, xy23));
+		}
+	SR_INLINE static Float splat(SrF32 a)					{ return _mm_set1_ps(a);	}
+	SR_INLINE static Float zero()							{ return _mm_setzero_ps();	}
+
+	SR_INLINE static Float add(Float a, Float b)			{ return _mm_add_ps(a, b);	}
+	SR_INLINE static Float sub(Float a, Float b)			{ return _mm_sub_ps(a, b);	}
+	SR_INLINE static Float mul(Float a, Float b)			{ return _mm_mul_ps(a, b);	}
+	SR_INLINE static Float div(Float a, Float b)			{ return _mm_div_ps(a, b);	}
+	SR_INLINE static Float madd(Float a, Float b, Float c)	{ return _mm_add_ps(_mm_mul_ps(a, b), c);	}
+	SR_INLINE static Float nmadd(Float a, Float b, Float c)	{ return _mm_sub_ps(c, _mm_mul_ps(a, b));	}
+	SR_INLINE static Float neg(Float a)						{ return _mm_xor_ps(a, _mm_set1_ps(-0.0f));	}
+	SR_INLINE static Float abs(Float a)						{ return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);	}
+	SR_INLINE static Float sqrt(Float a)					{ return _mm_sqrt_ps(a);	}
+	SR_INLINE static Float min(Float a, Float b)			{ return _mm_min_ps(a, b);	}
+	SR_INLINE static Float max(Float a, Float b)			{ return _mm_max_ps(a, b);	}
+
+	SR_INLINE static Float round(Float a)
+		{
+		//cvtps_epi32 rounds to nearest even, magnitudes of 2^23 and above are integers already.
+		const __m128 r = _mm_cvtepi32_ps(_mm_cvtps_epi32(a));
+		return select(_mm_cmplt_ps(abs(a), _mm_set1_ps(8388608.0f)), r, a);
+		}
+	SR_INLINE static Float floor(Float a)
+		{
+		const __m128 r = round(a);
+		return _mm_sub_ps(r, _mm_and_ps(_mm_cmpgt_ps(r, a), _mm_set1_ps(1.0f)));
+		}
+	SR_INLINE static Float ldexp(Float a, Float n)
+		{
+		//two factors so that the result may be denormal or n may exceed the exponent range.
+		const __m128i e = _mm_cvtps_epi32(n);
+		const __m128i e1 = _mm_srai_epi32(e, 1);
+		const __m128i bias = _mm_set1_epi32(127);
+		const __m128 f1 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(e1, bias), 23));
+		const __m128 f2 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_sub_epi32(e, e1), bias), 23));
+		return _mm_mul_ps(_mm_mul_ps(a, f1), f2);
+		}
+	SR_INLINE static Float frexp(Float a, Float& e)
+		{
+		const __m128i bits = _mm_castps_si128(a);
+		e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x7F800000)), 23), _mm_set1_epi32(126)));
+		return _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32((int)0x807FFFFF)), _mm_set1_epi32(0x3F000000)));
+		}
+
+	SR_INLINE static Mask cmpEq(Float a, Float b)			{ return _mm_cmpeq_ps(a, b);	}
+	SR_INLINE static Mask cmpLt(Float a, Float b)			{ return _mm_cmplt_ps(a, b);	}
+	SR_INLINE static Mask cmpLe(Float a, Float b)			{ return _mm_cmple_ps(a, b);	}
+	SR_INLINE static Mask cmpGt(Float a, Float b)			{ return _mm_cmpgt_ps(a, b);	}
+	SR_INLINE static Mask cmpGe(Float a, Float b)			{ return _mm_cmpge_ps(a, b);	}
+	SR_INLINE static Mask maskAnd(Mask a, Mask b)			{ return _mm_and_ps(a, b);		}
+	SR_INLINE static Mask maskOr(Mask a, Mask b)			{ return _mm_or_ps(a, b);		}
+	SR_INLINE static Mask maskAndNot(Mask a, Mask b)		{ return _mm_andnot_ps(a, b);	}
+	SR_INLINE static Float select(Mask m, Float a, Float b)	{ return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));	}
+
+	typedef __m128i	Int;
+	SR_INLINE static Int loadInt(const SrU32* p)			{ return _mm_loadu_si128((const __m128i*)p);	}
+	SR_INLINE static void storeInt(SrU32* p, Int a)		{ _mm_storeu_si128((__m128i*)p, a);	}
+	SR_INLINE static Int addInt(Int a, Int b)				{ return _mm_add_epi32(a, b);	}
+	SR_INLINE static Int xorInt(Int a, Int b)				{ return _mm_xor_si128(a, b);	}
+	SR_INLINE static Int orInt(Int a, Int b)				{ return _mm_or_si128(a, b);	}
+	SR_INLINE static Int andInt(Int a, Int b)				{ return _mm_and_si128(a, b);	}
+	template<int N> SR_INLINE static Int shlInt(Int a)		{ return _mm_slli_epi32(a, N);	}
+	template<int N> SR_INLINE static Int shrInt(Int a)		{ return _mm_srli_epi32(a, N);	}
+	SR_INLINE static Float toUnit(Int a)					{ return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(a, 8)), _mm_set1_ps(1.0f / 16777216.0f));	}
+	SR_INLINE static Int toInt(Float a)						{ return _mm_cvttps_epi32(a);	}
+	SR_INLINE static Float toFloat(Int a)					{ return _mm_cvtepi32_ps(a);	}
+
+	private:
+	/**
+	\brief the columns of the 4x4 block of rows r0..r3.
+	*/
+	SR_INLINE static void transpose4(__m128 r0, __m128 r1, __m128 r2, __m128 r3, Float& x, Float& y, Float& z, Float& w)
+		{
+		const __m128 t0 = _mm_unpacklo_ps(r0, r1);
+		const __m128 t1 = _mm_unpacklo_ps(r2, r3);
+		const __m128 t2 = _mm_unpackhi_ps(r0, r1);
+		const __m128 t3 = _mm_unpackhi_ps(r2, r3);
+		x = _mm_movelh_ps(t0, t1);
+		y = _mm_movehl_ps(t1, t0);
+		z = _mm_movelh_ps(t2, t3);
+		w = _mm_movehl_ps(t3, t2);
+		}
+	};
+#endif
+
+#if defined(SR_SIMD_AVX2)
+/**
+\brief 8 lanes, AVX2 + FMA3.
+*/
+class SrSimdAVX2
+	{
+	public:
+	typedef __m256	Float;
+	typedef __m256	Mask;
+	enum { Width = 8 };
+
+	SR_INLINE static Float load(const SrF32* p)				{ return _mm256_loadu_ps(p);	}
+	SR_INLINE static void store(SrF32* p, Float a)			{ _mm256_storeu_ps(p, a);		}
+#if defined(SR_SIMD_F16C)
+	SR_INLINE static Float load(const SrHalf* p)			{ return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)p));	}
+	SR_INLINE static void store(SrHalf* p, Float a)			{ _mm_storeu_si128((__m128i*)p, _mm256_cvtps_ph(a, _MM_FROUND_TO_NEAREST_INT));	}
+#else
+	SR_INLINE static Float load(const SrHalf* p)			{ return _mm256_setr_ps(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);	}
+	SR_INLINE static void store(SrHalf* p, Float a)
+		{
+		SR_ALIGN(32) SrF32 lanes[8];
+		_mm256_store_ps(lanes, a);
+		for(int l = 0; l < 8; l++)
+			p[l] = SrHalf(lanes[l]);
+		}
+#endif
+	SR_INLINE static void loadTransposed3(const SrF32* p, SrI32 stride, Float& x, Float& y, Float& z)
+		{
+		Float w;
+		loadTransposed4(p, stride, x, y, z, w);
+		}
+	SR_INLINE static void loadTransposed4(const SrF32* p, SrI32 stride, Float& x, Float& y, Float& z, Float& w)
+		{
+		//records i and i+4 share a register, then the 128 bit halves are transposed independently.
+		const SrF32* q = p + 4 * stride;
+		transpose4(_mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(q), 1),
+				   _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + stride)), _mm_loadu_ps(q + stride), 1),
+				   _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 2 * stride)), _mm_loadu_ps(q + 2 * stride), 1),
+				   _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 3 * stride)), _mm_loadu_ps(q + 3 * stride), 1),
+				   x, y, z, w);
+		}
+	SR_INLINE static void loadTransposed3(const SrHalf* p, SrI32 stride, Float& x, Float& y, Float& z)
+		{
+		Float w;
+		loadTransposed4(p, stride, x, y, z, w);
+		}
+	SR_INLINE static void loadTransposed4(const SrHalf* p, SrI32 stride, Float& x, Float& y, Float& z, Float& w)
+		{
+		const SrI32 q = 4 * stride;
+		transpose4(loadRecords(p, q), loadRecords(p + stride, q), loadRecords(p + 2 * stride, q), loadRecords(p + 3 * stride, q), x, y, z, w);
+		}
+	SR_INLINE static void gatherTransposed4(const SrF32* const* p, SrI32 offset, Float& x, Float& y, Float& z, Float& w)
+		{
+		Float r[4];
+		for(SrI32 k = 0; k < 4; k++)
+			r[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[k] + offset)), _mm_loadu_ps(p[k + 4] + offset), 1);
+		transpose4(r[0], r[1], r[2], r[3], x, y, z, w);
+		}
+	SR_INLINE static void storeTransposed3(SrF32* p, SrI32 stride, Float x, Float y, Float z)
+		{
+		SrSimdSSE::storeTransposed3(p, stride, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+		SrSimdSSE::storeTransposed3(p + 4 * stride, stride, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+		}
+	SR_INLINE static void storeTransposed4(SrF32* p, SrI32 stride, Float x, Float y, Float z, Float w)
+		{
+		const __m256 xy01 = _mm256_unpacklo_ps(x, y);
+		const __m256 zw01 = _mm256_unpacklo_ps(z, w);
+		const __m256 xy23 = _mm256_unpackhi_ps(x, y);
+		const __m256 zw23 = _mm256_unpackhi_ps(z, w);
+		const __m256 r[4] = {	_mm256_shuffle_ps(xy01, zw01, _MM_SHUFFLE(1,0,1,0)), _mm256_shuffle_ps(xy01, zw01, _MM_SHUFFLE(3,2,3,2)),
+								_mm256_shuffle_ps(xy23, zw23, _MM_SHUFFLE(1,0,1,0)), _mm256_shuffle_ps(xy23, zw23, _MM_SHUFFLE(3,2,3,2))	};
+		for(SrI32 k = 0; k < 4; k++)
+			{
+			_mm_storeu_ps(p + k * stride, _mm256_castps256_ps128(r[k]));
+			_mm_storeu_ps(p + (k + 4) * stride, _mm256_extractf128_ps(r[k], 1));
+			}
+		}
+	SR_INLINE static Float splat(SrF32 a)					{ return _mm256_set1_ps(a);		}
+	SR_INLINE static Float zero()							{ return _mm256_setzero_ps();	}
+
+	SR_INLINE static Float add(Float a, Float b)			{ return _mm256_add_ps(a, b);	}
+	SR_INLINE static Float sub(Float a, Float b)			{ return _mm256_sub_ps(a, b);	}
+	SR_INLINE static Float mul(Float a, Float b)			{ return _mm256_mul_ps(a, b);	}
+	SR_INLINE static Float div(Float a, Float b)			{ return _mm256_div_ps(a, b);	}
+#if defined(SR_DETERMINISTIC)
+	SR_INLINE static Float madd(Float a, Float b, Float c)	{ return _mm256_add_ps(_mm256_mul_ps(a, b), c);	}
+	SR_INLINE static Float nmadd(Float a, Float b, Float c)	{ return _mm256_sub_ps(c, _mm256_mul_ps(a, b));	}
+#else
+	SR_INLINE static Float madd(Float a, Float b, Float c)	{ return _mm256_fmadd_ps(a, b, c);	}
+	SR_INLINE static Float nmadd(Float a, Float b, Float c)	{ return _mm256_fnmadd_ps(a, b, c);	}
+#endif
+	SR_INLINE static Float neg(Float a)						{ return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f));	}
+	SR_INLINE static Float abs(Float a)						{ return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);	}
+	SR_INLINE static Float sqrt(Float a)					{ return _mm256_sqrt_ps(a);		}
+	SR_INLINE static Float min(Float a, Float b)			{ return _mm256_min_ps(a, b);	}
+	SR_INLINE static Float max(Float a, Float b)			{ return _mm256_max_ps(a, b);	}
+
+	SR_INLINE static Float round(Float a)					{ return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);	}
+	SR_INLINE static Float floor(Float a)					{ return _mm256_floor_ps(a);	}
+	SR_INLINE static Float ldexp(Float a, Float n)
+		{
+		const __m256i e = _mm256_cvtps_epi32(n);
+		const __m256i e1 = _mm256_srai_epi32(e, 1);
+		const __m256i bias = _mm256_set1_epi32(127);
+		const __m256 f1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(e1, bias), 23));
+		const __m256 f2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_sub_epi32(e, e1), bias), 23));
+		return _mm256_mul_ps(_mm256_mul_ps(a, f1), f2);
+		}
+	SR_INLINE static Float frexp(Float a, Float& e)
+		{
+		const __m256i bits = _mm256_castps_si256(a);
+		e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7F800000)), 23), _mm256_set1_epi32(126)));
+		return _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32((int)0x807FFFFF)), _mm256_set1_epi32(0x3F000000)));
+		}
+
+	SR_INLINE static Mask cmpEq(Float a, Float b)			{ return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);	}
+	SR_INLINE static Mask cmpLt(Float a, Float b)			{ return _mm256_cmp_ps(a, b, _CMP_LT_OQ);	}
+	SR_INLINE static Mask cmpLe(Float a, Float b)			{ return _mm256_cmp_ps(a, b, _CMP_LE_OQ);	}
+	SR_INLINE static Mask cmpGt(Float a, Float b)			{ return _mm256_cmp_ps(a, b, _CMP_GT_OQ);	}
+	SR_INLINE static Mask cmpGe(Float a, Float b)			{ return _mm256_cmp_ps(a, b, _CMP_GE_OQ);	}
+	SR_INLINE static Mask maskAnd(Mask a, Mask b)			{ return _mm256_and_ps(a, b);		}
+	SR_INLINE static Mask maskOr(Mask a, Mask b)			{ return _mm256_or_ps(a, b);		}
+	SR_INLINE static Mask maskAndNot(Mask a, Mask b)		{ return _mm256_andnot_ps(a, b);	}
+	SR_INLINE static Float select(Mask m, Float a, Float b)	{ return _mm256_blendv_ps(b, a, m);	}
+
+	typedef __m256i	Int;
+	SR_INLINE static Int loadInt(const SrU32* p)			{ return _mm256_loadu_si256((const __m256i*)p);	}
+	SR_INLINE static void storeInt(SrU32* p, Int a)		{ _mm256_storeu_si256((__m256i*)p, a);	}
+	SR_INLINE static Int addInt(Int a, Int b)				{ return _mm256_add_epi32(a, b);	}
+	SR_INLINE static Int xorInt(Int a, Int b)				{ return _mm256_xor_si256(a, b);	}
+	SR_INLINE static Int orInt(Int a, Int b)				{ return _mm256_or_si256(a, b);		}
+	SR_INLINE static Int andInt(Int a, Int b)				{ return _mm256_and_si256(a, b);	}
+	template<int N> SR_INLINE static Int shlInt(Int a)		{ return _mm256_slli_epi32(a, N);	}
+	template<int N> SR_INLINE static Int shrInt(Int a)		{ return _mm256_srli_epi32(a, N);	}
+	SR_INLINE static Float toUnit(Int a)					{ return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(a, 8)), _mm256_set1_ps(1.0f / 16777216.0f));	}
+	SR_INLINE static Int toInt(Float a)						{ return _mm256_cvttps_epi32(a);	}
+	SR_INLINE static Float toFloat(Int a)					{ return _mm256_cvtepi32_ps(a);		}
+
+	private:
+	/**
+	\brief the columns of the 4x4 blocks of rows r0..r3 in each 128 bit half.
+	*/
+	SR_INLINE static void transpose4(__m256 r0, __m256 r1, __m256 r2, __m256 r3, Float& x, Float& y, Float& z, Float& w)
+		{
+		const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+		const __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+		const __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+		const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+		x = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1,0,1,0));
+		y = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3,2,3,2));
+		z = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1,0,1,0));
+		w = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3,2,3,2));
+		}
+
+	/**
+	\brief the 4 halves at p and at p + offset, converted into the two 128 bit halves.
+	*/
+	SR_INLINE static __m256 loadRecords(const SrHalf* p, SrI32 offset)
+		{
+#if defined(SR_SIMD_F16C)
+		return _mm256_cvtph_ps(_mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)p), _mm_loadl_epi64((const __m128i*)(p + offset))));
+#else
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(SrSimdSSE::load(p)), SrSimdSSE::load(p + offset), 1);
+#endif
+		}
+	};
+#endif
+
+#if defined(SR_SIMD_AVX512)
+//the GCC intrinsics start many results from _mm512_undefined_ps(), which -Wuninitialized
+//reports through every inlined caller although the values are fully written.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+/**
+\brief 16 lanes, AVX-512F.
+*/
+class SrSimdAVX512
+	{
+	public:
+	typedef __m512		Float;
+	typedef __mmask16	Mask;
+	enum { Width = 16 };
+
+	SR_INLINE static Float load(const SrF32* p)				{ return _mm512_loadu_ps(p);	}
+	SR_INLINE static void store(SrF32* p, Float a)			{ _mm512_storeu_ps(p, a);		}
+	SR_INLINE static Float load(const SrHalf* p)			{ return _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)p));	}
+	SR_INLINE static void store(SrHalf* p, Float a)			{ _mm256_storeu_si256((__m256i*)p, _mm512_cvtps_ph(a, _MM_FROUND_TO_NEAREST_INT));	}
+	SR_INLINE static void loadTransposed3(const SrF32* p, SrI32 stride, Float& x, Float& y, Float& z)
+		{
+		Float w;
+		loadTransposed4(p, stride, x, y, z, w);
+		}
+	SR_INLINE static void loadTransposed4(const SrF32* p, SrI32 stride, Float& x, Float& y, Float& z, Float& w)
+		{
+		//records i, i+4, i+8 and i+12 share a register, then the 128 bit blocks are transposed independently.
+		__m512 r[4];
+		for(SrI32 k = 0; k < 4; k++)
+			{
+			const SrF32* q = p + k * stride;
+			__m512 a = _mm512_castps128_ps512(_mm_loadu_ps(q));
+			a = _mm512_insertf32x4(a, _mm_loadu_ps(q + 4 * stride), 1);
+			a = _mm512_insertf32x4(a, _mm_loadu_ps(q + 8 * stride), 2);
+			r[k] = _mm512_insertf32x4(a, _mm_loadu_ps(q + 12 * stride), 3);
+			}
+		transpose4(r, x, y, z, w);
+		}
+	SR_INLINE static void loadTransposed3(const SrHalf* p, SrI32 stride, Float& x, Float& y, Float& z)
+		{
+		Float w;
+		loadTransposed4(p, stride, x, y, z, w);
+		}
+	SR_INLINE static void loadTransposed4(const SrHalf* p, SrI32 stride, Float& x, Float& y, Float& z, Float& w)
+		{
+		//the same layout, the four records of a register converted at once.
+		__m512 r[4];
+		for(SrI32 k = 0; k < 4; k++)
+			{
+			const SrHalf* q = p + k * stride;
+			const __m128i lo = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)q), _mm_loadl_epi64((const __m128i*)(q + 4 * stride)));
+			const __m128i hi = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)(q + 8 * stride)), _mm_loadl_epi64((const __m128i*)(q + 12 * stride)));
+			r[k] = _mm512_cvtph_ps(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1));
+			}
+		transpose4(r, x, y, z, w);
+		}
+	SR_INLINE static void gatherTransposed4(const SrF32* const* p, SrI32 offset, Float& x, Float& y, Float& z, Float& w)
+		{
+		__m512 r[4];
+		for(SrI32 k = 0; k < 4; k++)
+			{
+			__m512 a = _mm512_castps128_ps512(_mm_loadu_ps(p[k] + offset));
+			a = _mm512_insertf32x4(a, _mm_loadu_ps(p[k + 4] + offset), 1);
+			a = _mm512_insertf32x4(a, _mm_loadu_ps(p[k + 8] + offset), 2);
+			r[k] = _mm512_insertf32x4(a, _mm_loadu_ps(p[k + 12] + offset), 3);
+			}
+		transpose4(r, x, y, z, w);
+		}
+	SR_INLINE static void storeTransposed3(SrF32* p, SrI32 stride, Float x, Float y, Float z)
+		{
+		SrSimdSSE::storeTransposed3(p, stride, _mm512_extractf32x4_ps(x, 0), _mm512_extractf32x4_ps(y, 0), _mm512_extractf32x4_ps(z, 0));
+		SrSimdSSE::storeTransposed3(p + 4 * stride, stride, _mm512_extractf32x4_ps(x, 1), _mm512_extractf32x4_ps(y, 1), _mm512_extractf32x4_ps(z, 1));
+		SrSimdSSE::storeTransposed3(p + 8 * stride, stride, _mm512_extractf32x4_ps(x, 2), _mm512_extractf32x4_ps(y, 2), _mm512_extractf32x4_ps(z, 2));
+		SrSimdSSE::storeTransposed3(p + 12 * stride, stride, _mm512_extractf32x4_ps(x, 3), _mm512_extractf32x4_ps(y, 3), _mm512_extractf32x4_ps(z, 3));
+		}
+	SR_INLINE static void storeTransposed4(SrF32* p, SrI32 stride, Float x, Float y, Float z, Float w)
+		{
+		const __m512 xy01 = _mm512_unpacklo_ps(x, y);
+		const __m512 zw01 = _mm512_unpacklo_ps(z, w);
+		const __m512 xy23 = _mm512_unpackhi_ps(x, y);
+		const __m512 zw23 = _mm512_unpackhi_ps(z, w);
+		const __m512 r[4] = {	_mm512_shuffle_ps(xy01, zw01, _MM_SHUFFLE(1,0,1,0)), _mm512_shuffle_ps(xy01, zw01, _MM_SHUFFLE(3,2,3,2)),
+								_mm512_shuffle_ps(xy23, zw23, _MM_SHUFFLE(1,0,1,0)), _mm512_shuffle_ps(xy23, zw23, _MM_SHUFFLE(3,2,3,2))	};
+		for(SrI32 k = 0; k < 4; k++)
+			{
+			_mm_storeu_ps(p + k * stride, _mm512_extractf32x4_ps(r[k], 0));
+			_mm_storeu_ps(p + (k + 4) * stride, _mm512_extractf32x4_ps(r[k], 1));
+			_mm_storeu_ps(p + (k + 8) * stride, _mm512_extractf32x4_ps(r[k], 2));
+			_mm_storeu_ps(p + (k + 12) * stride, _mm512_extractf32x4_ps(r[k], 3));
+			}
+		}
+	SR_INLINE static Float splat(SrF32 a)					{ return _mm512_set1_ps(a);		}
+	SR_INLINE static Float zero()							{ return _mm512_setzero_ps();	}
+
+	SR_INLINE static Float add(Float a, Float b)			{ return _mm512_add_ps(a, b);	}
+	SR_INLINE static Float sub(Float a, Float b)			{ return _mm512_sub_ps(a, b);	}
+	SR_INLINE static Float mul(Float a, Float b)			{ return _mm512_mul_ps(a, b);	}
+	SR_INLINE static Float div(Float a, Float b)			{ return _mm512_div_ps(a, b);	}
+#if defined(SR_DETERMINISTIC)
+	SR_INLINE static Float madd(Float a, Float b, Float c)	{ return _mm512_add_ps(_mm512_mul_ps(a, b), c);	}
+	SR_INLINE static Float nmadd(Float a, Float b, Float c)	{ return _mm512_sub_ps(c, _mm512_mul_ps(a, b));	}
+#else
+	SR_INLINE static Float madd(Float a, Float b, Float c)	{ return _mm512_fmadd_ps(a, b, c);	}
+	SR_INLINE static Float nmadd(Float a, Float b, Float c)	{ return _mm512_fnmadd_ps(a, b, c);	}
+#endif
+	SR_INLINE static Float neg(Float a)						{ return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32((int)0x80000000)));	}
+	SR_INLINE static Float abs(Float a)						{ return _mm512_abs_ps(a);		}
+	SR_INLINE static Float sqrt(Float a)					{ return _mm512_sqrt_ps(a);	}
+	SR_INLINE static Float min(Float a, Float b)			{ return _mm512_min_ps(a, b);	}
+	SR_INLINE static Float max(Float a, Float b)			{ return _mm512_max_ps(a, b);	}
+
+	SR_INLINE static Float round(Float a)					{ return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);	}
+	SR_INLINE static Float floor(Float a)					{ return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);	}
+	SR_INLINE static Float ldexp(Float a, Float n)			{ return _mm512_scalef_ps(a, n);	}
+	SR_INLINE static Float frexp(Float a, Float& e)
+		{
+		e = _mm512_add_ps(_mm512_getexp_ps(a), _mm512_set1_ps(1.0f));
+		return _mm512_getmant_ps(a, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_src);
+		}
+
+	SR_INLINE static Mask cmpEq(Float a, Float b)			{ return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);	}
+	SR_INLINE static Mask cmpLt(Float a, Float b)			{ return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);	}
+	SR_INLINE static Mask cmpLe(Float a, Float b)			{ return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ);	}
+	SR_INLINE static Mask cmpGt(Float a, Float b)			{ return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);	}
+	SR_INLINE static Mask cmpGe(Float a, Float b)			{ return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ);	}
+	SR_INLINE static Mask maskAnd(Mask a, Mask b)			{ return (Mask)(a & b);		}
+	SR_INLINE static Mask maskOr(Mask a, Mask b)			{ return (Mask)(a | b);		}
+	SR_INLINE static Mask maskAndNot(Mask a, Mask b)		{ return (Mask)(~a & b);	}
+	SR_INLINE static Float select(Mask m, Float a, Float b)	{ return _mm512_mask_blend_ps(m, b, a);	}
+
+	typedef __m512i	Int;
+	SR_INLINE static Int loadInt(const SrU32* p)			{ return _mm512_loadu_si512(p);	}
+	SR_INLINE static void storeInt(SrU32* p, Int a)		{ _mm512_storeu_si512(p, a);	}
+	SR_INLINE static Int addInt(Int a, Int b)				{ return _mm512_add_epi32(a, b);	}
+	SR_INLINE static Int xorInt(Int a, Int b)				{ return _mm512_xor_si512(a, b);	}
+	SR_INLINE static Int orInt(Int a, Int b)				{ return _mm512_or_si512(a, b);		}
+	SR_INLINE static Int andInt(Int a, Int b)				{ return _mm512_and_si512(a, b);	}
+	template<int N> SR_INLINE static Int shlInt(Int a)		{ return _mm512_slli_epi32(a, N);	}
+	template<int N> SR_INLINE static Int shrInt(Int a)		{ return _mm512_srli_epi32(a, N);	}
+	SR_INLINE static Float toUnit(Int a)					{ return _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(a, 8)), _mm512_set1_ps(1.0f / 16777216.0f));	}
+	SR_INLINE static Int toInt(Float a)						{ return _mm512_cvttps_epi32(a);	}
+	SR_INLINE static Float toFloat(Int a)					{ return _mm512_cvtepi32_ps(a);	}
+
+	private:
+	/**
+	\brief the columns of the 4x4 blocks of rows r[0..3] in each 128 bit block.
+	*/
+	SR_INLINE static void transpose4(const __m512 r[4], Float& x, Float& y, Float& z, Float& w)
+		{
+		const __m512 t0 = _mm512_unpacklo_ps(r[0], r[1]);
+		const __m512 t1 = _mm512_unpacklo_ps(r[2], r[3]);
+		const __m512 t2 = _mm512_unpackhi_ps(r[0], r[1]);
+		const __m512 t3 = _mm512_unpackhi_ps(r[2], r[3]);
+		x = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(1,0,1,0));
+		y = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(3,2,3,2));
+		z = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(1,0,1,0));
+		w = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(3,2,3,2));
+		}
+	};
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+/**
+\brief The widest SIMD class enabled at compile time.
+*/
+#if defined(SR_SIMD_AVX512)
+typedef SrSimdAVX512	SrSimdNative;
+#elif defined(SR_SIMD_AVX2)
+typedef SrSimdAVX2		SrSimdNative;
+#elif defined(SR_SIMD_SSE)
+typedef SrSimdSSE		SrSimdNative;
+#else
+typedef SrSimdScalar	SrSimdNative;
+#endif
+
+/** @} */
+#endif
@@ -0,0 +1,126 @@
+/************************************************************************
+\file 	SrSimdDispatch.cpp
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#include <string.h>
+
+#define SR_SIMD_DISPATCH_TABLES(Kernels)								\
+	template class SrSimdKernelTable<Kernels, SR_SIMD_LEVEL_SCALAR>;	\
+	template class SrSimdKernelTable<Kernels, SR_SIMD_LEVEL_SSE>;
+
+#include "SrSimdDispatchTable.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+Compiled with the project flags, provides the scalar and SSE tables and the CPU detection.
+*/
+
+static SrSimdLevel srDetectCpuLevel()
+	{
+#if defined(SR_SIMD_DISABLE) || !defined(SR_SIMD_SSE)
+	return SR_SIMD_LEVEL_SCALAR;
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	const int maxLeaf = info[0];
+	__cpuid(info, 1);
+	const bool fma = (info[2] & (1 << 12)) != 0;
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool f16c = (info[2] & (1 << 29)) != 0;
+	if(maxLeaf < 7 || !fma || !osxsave || !f16c)
+		return SR_SIMD_LEVEL_SSE;
+	//the OS must save the ymm (bits 1-2) and the zmm / opmask state (bits 5-7).
+	const unsigned long long xcr0 = _xgetbv(0);
+	__cpuidex(info, 7, 0);
+	if((xcr0 & 0x6) != 0x6 || (info[1] & (1 << 5)) == 0)
+		return SR_SIMD_LEVEL_SSE;
+	if((xcr0 & 0xE0) != 0xE0 || (info[1] & (1 << 16)) == 0)
+		return SR_SIMD_LEVEL_AVX2;
+	return SR_SIMD_LEVEL_AVX512;
+#else
+	//libgcc checks the OS support through xgetbv as well.
+	__builtin_cpu_init();
+	if(!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma") || !__builtin_cpu_supports("f16c"))
+		return SR_SIMD_LEVEL_SSE;
+	if(!__builtin_cpu_supports("avx512f"))
+		return SR_SIMD_LEVEL_AVX2;
+	return SR_SIMD_LEVEL_AVX512;
+#endif
+	}
+
+static SrSimdLevel srAvailableLevel(SrSimdLevel level)
+	{
+	//the highest level up to level whose table was compiled in, scalar always is.
+	int l = level;
+	while(l > SR_SIMD_LEVEL_SCALAR && !SrSimdDispatch::isCompiled((SrSimdLevel)l))
+		l--;
+	return (SrSimdLevel)l;
+	}
+
+static SrSimdLevel srInitialLevel()
+	{
+	SrSimdLevel level = SrSimdDispatch::getSupportedLevel();
+	const char* env = getenv("SR_SIMD_LEVEL");
+	if(env)
+		{
+		for(int i = SR_SIMD_LEVEL_SCALAR; i < level; i++)
+			{
+			if(strcmp(env, SrSimdDispatch::getName((SrSimdLevel)i)) == 0)
+				level = srAvailableLevel((SrSimdLevel)i);
+			}
+		}
+	return level;
+	}
+
+static SrSimdLevel& srCurrentLevel()
+	{
+	static SrSimdLevel level = srInitialLevel();
+	return level;
+	}
+
+SrSimdLevel SrSimdDispatch::getSupportedLevel()
+	{
+	static const SrSimdLevel supported = srDetectCpuLevel();
+	return srAvailableLevel(supported);
+	}
+
+SrSimdLevel SrSimdDispatch::getLevel()
+	{
+	return srCurrentLevel();
+	}
+
+SrSimdLevel SrSimdDispatch::setLevel(SrSimdLevel level)
+	{
+	const SrSimdLevel supported = getSupportedLevel();
+	srCurrentLevel() = srAvailableLevel(level < supported ? level : supported);
+	return srCurrentLevel();
+	}
+
+const char* SrSimdDispatch::getName(SrSimdLevel level)
+	{
+	switch(level)
+		{
+		case SR_SIMD_LEVEL_SCALAR:	return "scalar";
+		case SR_SIMD_LEVEL_SSE:		return "sse";
+		case SR_SIMD_LEVEL_AVX2:	return "avx2";
+		case SR_SIMD_LEVEL_AVX512:	return "avx512";
+		}
+	return "";
+	}
+
+bool SrSimdDispatch::isCompiled(SrSimdLevel level)
+	{
+	switch(level)
+		{
+		case SR_SIMD_LEVEL_SCALAR:	return true;
+		case SR_SIMD_LEVEL_SSE:		return SrSimdLevelSet<SR_SIMD_LEVEL_SSE>::Compiled;
+		case SR_SIMD_LEVEL_AVX2:	return srSimdCompiledAVX2();
+		case SR_SIMD_LEVEL_AVX512:	return srSimdCompiledAVX512();
+		}
+	return false;
+	}
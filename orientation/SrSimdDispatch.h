@@ -0,0 +1,183 @@
+/************************************************************************
+\file 	SrSimdDispatch.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRSIMDDISPATCH_H_
+#define SR_FOUNDATION_SRSIMDDISPATCH_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include "SrSimd.h"
+#include "SrForward.h"
+
+/*
+Runtime instruction set dispatch for the batch kernels.
+
+Without SR_SIMD_DISPATCH every batch entry point runs its kernel on SrSimdNative, the
+widest set the compiler was told about, and the library stays header only.
+
+With SR_SIMD_DISPATCH defined for the whole project, the entry points call through a
+table of kernels that is picked for the widest instruction set the CPU and the OS
+support. The kernels are then compiled in these files, which must be added to the
+project with their own flags:
+
+	SrSimdDispatch.cpp			project flags, scalar and SSE kernels, CPU detection
+	SrSimdDispatchAVX2.cpp		-mavx2 -mfma -mf16c		(MSVC: no extra flag)
+	SrSimdDispatchAVX512.cpp	-mavx512f -mavx2 -mfma	(MSVC: no extra flag)
+
+The rest of the project must keep the baseline flags, otherwise the compiler is free
+to emit the wider instructions anywhere. With SR_DETERMINISTIC every file, these three
+included, is also built with -ffp-contract=off. The AVX files flatten every kernel into its
+table entry, so no library inline function is emitted from them out of line; GCC and
+clang only do this with optimisation, so the AVX files warn when built without it,
+leave their level out and the dispatch stops at SSE.
+
+Every batch header declares its own table, SrXxxKernels with a nested Table<V> that
+fills it for the set V, and ends with SR_SIMD_KERNEL_TABLES(SrXxxKernels). The dispatch
+files include every batch header through SrSimdDispatchTable.h, where that macro
+instantiates the tables of their levels; a batch header missing there fails to link.
+
+The environment variable SR_SIMD_LEVEL = scalar, sse, avx2 or avx512 lowers the level
+for testing. It cannot raise it above what the CPU supports.
+*/
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SR_SIMD_FLATTEN		__attribute__((flatten))
+#else
+#define SR_SIMD_FLATTEN
+#endif
+
+/**
+\brief The kernel an entry point runs: the entry of the dispatched Kernels table or the
+SrSimdNative instantiation.
+
+native is passed in parentheses when it has template arguments separated by commas.
+*/
+#if defined(SR_SIMD_DISPATCH)
+#define SR_SIMD_KERNEL(Kernels, entry, native)	(SrSimdDispatch::kernels<Kernels>().entry)
+#else
+#define SR_SIMD_KERNEL(Kernels, entry, native)	native
+#endif
+
+/**
+\brief Ends every batch header. Instantiates the Kernels tables of the levels of the
+dispatch file being compiled, nothing anywhere else.
+*/
+#if defined(SR_SIMD_DISPATCH_TABLES)
+#define SR_SIMD_KERNEL_TABLES(Kernels)	SR_SIMD_DISPATCH_TABLES(Kernels)
+#else
+#define SR_SIMD_KERNEL_TABLES(Kernels)
+#endif
+
+/**
+\brief Instruction set levels, in increasing order.
+*/
+enum SrSimdLevel
+	{
+	SR_SIMD_LEVEL_SCALAR,
+	SR_SIMD_LEVEL_SSE,
+	SR_SIMD_LEVEL_AVX2,
+	SR_SIMD_LEVEL_AVX512
+	};
+
+/**
+\brief The Kernels table of the level L, NULL when the level was not compiled in.
+
+Defined in the dispatch file of the level only.
+*/
+template<class Kernels, SrSimdLevel L>
+class SrSimdKernelTable
+	{
+	public:
+	static const Kernels* get();
+	};
+
+/**
+\brief Static class selecting the kernel tables the batch entry points use.
+
+Only available when SrSimdDispatch.cpp is part of the project.
+*/
+class SrSimdDispatch
+	{
+	public:
+	/**
+	\brief The widest level both the CPU and the compiled kernel tables support.
+	*/
+	static SrSimdLevel getSupportedLevel();
+
+	/**
+	\brief The level the entry points currently run at.
+
+	Initialised at the first call to the supported level, lowered by SR_SIMD_LEVEL.
+	*/
+	static SrSimdLevel getLevel();
+
+	/**
+	\brief Forces a level, clamped to getSupportedLevel() and lowered to the next compiled in
+	level. Returns the level set.
+
+	Not thread safe, call it before kernels run on other threads.
+	*/
+	static SrSimdLevel setLevel(SrSimdLevel level);
+
+	/**
+	\brief "scalar", "sse", "avx2" or "avx512".
+	*/
+	static const char* getName(SrSimdLevel level);
+
+	/**
+	\brief true when the tables of the level were compiled in.
+	*/
+	static bool isCompiled(SrSimdLevel level);
+
+	/**
+	\brief The Kernels table of getLevel().
+	*/
+	template<class Kernels>
+	static const Kernels& kernels();
+
+	/**
+	\brief The Kernels table of a level, NULL when it was not compiled in.
+	*/
+	template<class Kernels>
+	static const Kernels* getKernels(SrSimdLevel level);
+	};
+
+/**
+\brief Whether the AVX files compiled their tables, false without optimisation.
+*/
+bool srSimdCompiledAVX2();
+bool srSimdCompiledAVX512();
+
+
+template<class Kernels>
+SR_INLINE const Kernels& SrSimdDispatch::kernels()
+	{
+	static const Kernels* const tables[] =
+		{
+		SrSimdKernelTable<Kernels, SR_SIMD_LEVEL_SCALAR>::get(),
+		SrSimdKernelTable<Kernels, SR_SIMD_LEVEL_SSE>::get(),
+		SrSimdKernelTable<Kernels, SR_SIMD_LEVEL_AVX2>::get(),
+		SrSimdKernelTable<Kernels, SR_SIMD_LEVEL_AVX512>::get()
+		};
+	return *tables[getLevel()];
+	}
+
+template<class Kernels>
+SR_INLINE const Kernels* SrSimdDispatch::getKernels(SrSimdLevel level)
+	{
+	switch(level)
+		{
+		case SR_SIMD_LEVEL_SCALAR:	return SrSimdKernelTable<Kernels, SR_SIMD_LEVEL_SCALAR>::get();
+		case SR_SIMD_LEVEL_SSE:		return SrSimdKernelTable<Kernels, SR_SIMD_LEVEL_SSE>::get();
+		case SR_SIMD_LEVEL_AVX2:	return SrSimdKernelTable<Kernels, SR_SIMD_LEVEL_AVX2>::get();
+		case SR_SIMD_LEVEL_AVX512:	return SrSimdKernelTable<Kernels, SR_SIMD_LEVEL_AVX512>::get();
+		}
+	return NULL;
+	}
+
+/** @} */
+#endif
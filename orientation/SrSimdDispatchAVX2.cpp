@@ -0,0 +1,33 @@
+/************************************************************************
+\file 	SrSimdDispatchAVX2.cpp
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+
+/*
+AVX2 + FMA3 kernel table. Built with -mavx2 -mfma -mf16c on GCC and clang, MSVC needs no
+flag since its intrinsics do not depend on /arch. Without -mf16c the half precision loads
+and stores convert lane by lane.
+*/
+#if defined(_MSC_VER) && !defined(SR_SIMD_DISABLE)
+#define SR_SIMD_AVX2
+#define SR_SIMD_F16C
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__OPTIMIZE__)
+#warning "SrSimdDispatchAVX2.cpp is compiled without optimisation, the AVX2 kernels are left out"
+#endif
+
+#define SR_SIMD_DISPATCH_TABLES(Kernels)	template class SrSimdKernelTable<Kernels, SR_SIMD_LEVEL_AVX2>;
+
+#include "SrSimdDispatchTable.h"
+
+bool srSimdCompiledAVX2()
+	{
+#if !defined(SR_SIMD_AVX2)
+#error "SrSimdDispatchAVX2.cpp must be compiled with -mavx2 -mfma"
+#else
+	return SrSimdLevelSet<SR_SIMD_LEVEL_AVX2>::Compiled;
+#endif
+	}
@@ -0,0 +1,33 @@
+/************************************************************************
+\file 	SrSimdDispatchAVX512.cpp
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+
+/*
+AVX-512 kernel table. Built with -mavx512f -mavx2 -mfma on GCC and clang, MSVC needs no flag
+since its intrinsics do not depend on /arch.
+*/
+#if defined(_MSC_VER) && !defined(SR_SIMD_DISABLE)
+#define SR_SIMD_AVX2
+#define SR_SIMD_AVX512
+#define SR_SIMD_F16C
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__OPTIMIZE__)
+#warning "SrSimdDispatchAVX512.cpp is compiled without optimisation, the AVX512 kernels are left out"
+#endif
+
+#define SR_SIMD_DISPATCH_TABLES(Kernels)	template class SrSimdKernelTable<Kernels, SR_SIMD_LEVEL_AVX512>;
+
+#include "SrSimdDispatchTable.h"
+
+bool srSimdCompiledAVX512()
+	{
+#if !defined(SR_SIMD_AVX512)
+#error "SrSimdDispatchAVX512.cpp must be compiled with -mavx512f -mavx2 -mfma"
+#else
+	return SrSimdLevelSet<SR_SIMD_LEVEL_AVX512>::Compiled;
+#endif
+	}
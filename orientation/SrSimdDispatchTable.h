@@ -0,0 +1,113 @@
+/************************************************************************
+\file 	SrSimdDispatchTable.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRSIMDDISPATCHTABLE_H_
+#define SR_FOUNDATION_SRSIMDDISPATCHTABLE_H_
+/** \addtogroup foundation
+  @{
+*/
+
+/*
+Only included by the SrSimdDispatch*.cpp files. Each defines SR_SIMD_DISPATCH_TABLES(Kernels)
+to the explicit instantiations of SrSimdKernelTable for its levels before including it,
+the batch headers below expand it for their tables.
+*/
+
+#include "SrSimdDispatch.h"
+
+/**
+\brief The SrSimd set of a level in the file being compiled, void when it is not compiled in.
+*/
+template<SrSimdLevel L>
+struct SrSimdLevelSet
+	{
+	typedef void Type;
+	static const bool Compiled = false;
+	};
+
+template<>
+struct SrSimdLevelSet<SR_SIMD_LEVEL_SCALAR>
+	{
+	typedef SrSimdScalar Type;
+	static const bool Compiled = true;
+	};
+
+#if defined(SR_SIMD_SSE)
+template<>
+struct SrSimdLevelSet<SR_SIMD_LEVEL_SSE>
+	{
+	typedef SrSimdSSE Type;
+	static const bool Compiled = true;
+	};
+#endif
+
+//without optimisation the kernels are not flattened into the AVX entries, see SrSimdDispatch.h.
+#if !(defined(__GNUC__) || defined(__clang__)) || defined(__OPTIMIZE__)
+#if defined(SR_SIMD_AVX2)
+template<>
+struct SrSimdLevelSet<SR_SIMD_LEVEL_AVX2>
+	{
+	typedef SrSimdAVX2 Type;
+	static const bool Compiled = true;
+	};
+#endif
+
+#if defined(SR_SIMD_AVX512)
+template<>
+struct SrSimdLevelSet<SR_SIMD_LEVEL_AVX512>
+	{
+	typedef SrSimdAVX512 Type;
+	static const bool Compiled = true;
+	};
+#endif
+#endif
+
+/**
+\brief Builds the Kernels table of the set V once, every entry flattened so the whole kernel
+including its scalar tail is compiled with the instruction set of the file.
+*/
+template<class Kernels, class V>
+struct SrSimdKernelBuild
+	{
+	static const Kernels* get()
+		{
+		static const Kernels table = Kernels::template Table<V>::create();
+		return &table;
+		}
+	};
+
+template<class Kernels>
+struct SrSimdKernelBuild<Kernels, void>
+	{
+	static const Kernels* get()
+		{
+		return NULL;
+		}
+	};
+
+template<class Kernels, SrSimdLevel L>
+const Kernels* SrSimdKernelTable<Kernels, L>::get()
+	{
+	return SrSimdKernelBuild<Kernels, typename SrSimdLevelSet<L>::Type>::get();
+	}
+
+#include "SrQuaternionBatch.h"
+#include "SrMatrix33Batch.h"
+#include "SrMatrix34Batch.h"
+#include "SrHalfBatch.h"
+#include "SrSimdMath.h"
+#include "SrRandomBatch.h"
+#include "SrRotationSampler.h"
+#include "SrRotationIntegrator.h"
+#include "SrQuaternionSpline.h"
+#include "SrAnimationTrack.h"
+#include "SrTrackReducer.h"
+#include "SrQuaternionCodec.h"
+#include "SrSkinning.h"
+#include "SrSkeleton.h"
+
+/** @} */
+#endif
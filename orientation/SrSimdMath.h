@@ -0,0 +1,506 @@
+/************************************************************************
+\file 	SrSimdMath.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRSIMDMATH_H_
+#define SR_FOUNDATION_SRSIMDMATH_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include "SrSimd.h"
+#include "SrSimdDispatch.h"
+#include "SrMath.h"
+
+/**
+\brief Static class with polynomial versions of the SrMath transcendental functions.
+
+The template functions work on a whole SIMD register, one of the SrSimd sets, and never
+call libm. They are meant for the batch kernels. The array functions run them over
+SrSimdNative blocks and the SrSimdScalar instantiation of the same polynomials for the
+tail. There is no double precision SIMD set, the double array versions loop over the
+SrMath functions, so they have their accuracy and with SR_DETERMINISTIC their results.
+
+The polynomials are the single precision cephes ones with Cody-Waite range reduction.
+Errors are the maximum measured against double precision libm over the stated range.
+Arguments out of range behave like SrMath: asin/acos clamp to [-1, 1], exp overflows to
+inf and underflows to 0, logE returns -inf for 0 and NaN for negative arguments.
+
+	function	range				max error
+	sin/cos		|x| <= pi			1.6 ulp
+				|x| <= 8192			2.4 ulp
+				|x| <= 1e6			1.2e-7 absolute
+	asin/acos	[-1, 1]				2.4 ulp
+	atan		all					2.8 ulp
+	atan2		finite				3.3 ulp
+	exp			[-103.9, 88.7]		1.3 ulp
+	logE		(0, inf]			0.8 ulp
+
+The atan2 bound holds for finite arguments, tiny and denormal results included. It was
+measured on 2e7 random pairs of floats, 5e8 pairs with |y| < |x| and every float t in
+[2^-12, 1] as (t, 1), (1, t), (t, -1) and (1, -t). The worst cases are results below
+pi/4, where the rounding of |y| / |x| adds to the 2.8 ulp of atan. Two infinite arguments give NaN, not
+a multiple of pi/4, and y = -0 with x < 0 gives +pi.
+*/
+class SrSimdMath
+	{
+	public:
+	/**
+	\brief sin(x) for |x| <= pi/2, no range reduction.
+
+	Degree 11 odd Taylor polynomial, max error 1.7e-7.
+	*/
+	template<class V>
+	SR_INLINE static typename V::Float sinHalfPi(typename V::Float x);
+
+	/**
+	\brief atan(x) for 0 <= x <= 1.
+
+	Values above tan(pi/8) are reduced with atan(x) = pi/4 + atan((x-1)/(x+1)), then the
+	single precision cephes polynomial is used. Max error 9.4e-8.
+	*/
+	template<class V>
+	SR_INLINE static typename V::Float atanUnit(typename V::Float x);
+
+	/**
+	\brief atan2(y, x) for all quadrants, returns 0 when both arguments are 0.
+
+	Max error 3.3 ulp, 2.7e-7 absolute.
+	*/
+	template<class V>
+	SR_INLINE static typename V::Float atan2(typename V::Float y, typename V::Float x);
+
+	/**
+	\brief register versions of the SrMath functions, see the table above.
+
+	sin and cos are bounded in ulp for |x| <= 8192 only, next to their zeros as well. Past
+	that q * pi/2 is no longer exact in the range reduction and only the absolute error is
+	small, up to about 1e6; larger arguments lose all accuracy.
+	*/
+	template<class V>
+	SR_INLINE static void sinCos(typename V::Float x, typename V::Float& s, typename V::Float& c);
+	template<class V>
+	SR_INLINE static typename V::Float sin(typename V::Float x);
+	template<class V>
+	SR_INLINE static typename V::Float cos(typename V::Float x);
+	template<class V>
+	SR_INLINE static typename V::Float asin(typename V::Float x);
+	template<class V>
+	SR_INLINE static typename V::Float acos(typename V::Float x);
+	template<class V>
+	SR_INLINE static typename V::Float atan(typename V::Float x);
+	template<class V>
+	SR_INLINE static typename V::Float exp(typename V::Float x);
+	template<class V>
+	SR_INLINE static typename V::Float logE(typename V::Float x);
+
+	/**
+	\brief dst[i] = f(src[i]) for the n elements, src and dst may be the same array.
+	*/
+	SR_INLINE static void sin(const SrF32* src, SrF32* dst, SrU32 n);
+	SR_INLINE static void cos(const SrF32* src, SrF32* dst, SrU32 n);
+	SR_INLINE static void asin(const SrF32* src, SrF32* dst, SrU32 n);
+	SR_INLINE static void acos(const SrF32* src, SrF32* dst, SrU32 n);
+	SR_INLINE static void atan(const SrF32* src, SrF32* dst, SrU32 n);
+	SR_INLINE static void exp(const SrF32* src, SrF32* dst, SrU32 n);
+	SR_INLINE static void logE(const SrF32* src, SrF32* dst, SrU32 n);
+	SR_INLINE static void sinCos(const SrF32* src, SrF32* s, SrF32* c, SrU32 n);
+	SR_INLINE static void atan2(const SrF32* y, const SrF32* x, SrF32* dst, SrU32 n);
+
+	SR_INLINE static void sin(const SrF64* src, SrF64* dst, SrU32 n);
+	SR_INLINE static void cos(const SrF64* src, SrF64* dst, SrU32 n);
+	SR_INLINE static void asin(const SrF64* src, SrF64* dst, SrU32 n);
+	SR_INLINE static void acos(const SrF64* src, SrF64* dst, SrU32 n);
+	SR_INLINE static void atan(const SrF64* src, SrF64* dst, SrU32 n);
+	SR_INLINE static void exp(const SrF64* src, SrF64* dst, SrU32 n);
+	SR_INLINE static void logE(const SrF64* src, SrF64* dst, SrU32 n);
+	SR_INLINE static void sinCos(const SrF64* src, SrF64* s, SrF64* c, SrU32 n);
+	SR_INLINE static void atan2(const SrF64* y, const SrF64* x, SrF64* dst, SrU32 n);
+
+	/**
+	\brief array kernels over the set V, Op is one of the Op structs below.
+	*/
+	template<class V, class Op>
+	SR_INLINE static void unaryLanes(const SrF32* src, SrF32* dst, SrU32 n);
+	template<class V>
+	SR_INLINE static void sinCosLanes(const SrF32* src, SrF32* s, SrF32* c, SrU32 n);
+	template<class V>
+	SR_INLINE static void atan2Lanes(const SrF32* y, const SrF32* x, SrF32* dst, SrU32 n);
+
+	struct OpSin	{ template<class V> SR_INLINE static typename V::Float eval(typename V::Float x) { return sin<V>(x);	} };
+	struct OpCos	{ template<class V> SR_INLINE static typename V::Float eval(typename V::Float x) { return cos<V>(x);	} };
+	struct OpAsin	{ template<class V> SR_INLINE static typename V::Float eval(typename V::Float x) { return asin<V>(x);	} };
+	struct OpAcos	{ template<class V> SR_INLINE static typename V::Float eval(typename V::Float x) { return acos<V>(x);	} };
+	struct OpAtan	{ template<class V> SR_INLINE static typename V::Float eval(typename V::Float x) { return atan<V>(x);	} };
+	struct OpExp	{ template<class V> SR_INLINE static typename V::Float eval(typename V::Float x) { return exp<V>(x);	} };
+	struct OpLogE	{ template<class V> SR_INLINE static typename V::Float eval(typename V::Float x) { return logE<V>(x);	} };
+
+	private:
+	template<class V>
+	SR_INLINE static typename V::Float asinPoly(typename V::Float x, typename V::Float z);
+	};
+
+/**
+\brief The SrSimdMath kernels of one SrSimd set, the table SR_SIMD_KERNEL() calls through
+with SR_SIMD_DISPATCH.
+*/
+struct SrSimdMathKernels
+	{
+	void (*mathSin)(const SrF32* src, SrF32* dst, SrU32 n);
+	void (*mathCos)(const SrF32* src, SrF32* dst, SrU32 n);
+	void (*mathAsin)(const SrF32* src, SrF32* dst, SrU32 n);
+	void (*mathAcos)(const SrF32* src, SrF32* dst, SrU32 n);
+	void (*mathAtan)(const SrF32* src, SrF32* dst, SrU32 n);
+	void (*mathExp)(const SrF32* src, SrF32* dst, SrU32 n);
+	void (*mathLogE)(const SrF32* src, SrF32* dst, SrU32 n);
+	void (*mathSinCos)(const SrF32* src, SrF32* s, SrF32* c, SrU32 n);
+	void (*mathAtan2)(const SrF32* y, const SrF32* x, SrF32* dst, SrU32 n);
+
+	/**
+	\brief The table of the set V, see SrSimdDispatch.h.
+	*/
+	template<class V>
+	class Table
+		{
+		public:
+		static SrSimdMathKernels create()
+			{
+			SrSimdMathKernels k;
+			k.mathSin = mathUnary<SrSimdMath::OpSin>;
+			k.mathCos = mathUnary<SrSimdMath::OpCos>;
+			k.mathAsin = mathUnary<SrSimdMath::OpAsin>;
+			k.mathAcos = mathUnary<SrSimdMath::OpAcos>;
+			k.mathAtan = mathUnary<SrSimdMath::OpAtan>;
+			k.mathExp = mathUnary<SrSimdMath::OpExp>;
+			k.mathLogE = mathUnary<SrSimdMath::OpLogE>;
+			k.mathSinCos = mathSinCos;
+			k.mathAtan2 = mathAtan2;
+			return k;
+			}
+
+		private:
+		template<class Op>
+		SR_SIMD_FLATTEN static void mathUnary(const SrF32* src, SrF32* dst, SrU32 n)
+			{
+			SrSimdMath::unaryLanes<V, Op>(src, dst, n);
+			}
+
+		SR_SIMD_FLATTEN static void mathSinCos(const SrF32* src, SrF32* s, SrF32* c, SrU32 n)
+			{
+			SrSimdMath::sinCosLanes<V>(src, s, c, n);
+			}
+
+		SR_SIMD_FLATTEN static void mathAtan2(const SrF32* y, const SrF32* x, SrF32* dst, SrU32 n)
+			{
+			SrSimdMath::atan2Lanes<V>(y, x, dst, n);
+			}
+		};
+	};
+
+
+template<class V>
+SR_INLINE typename V::Float SrSimdMath::sinHalfPi(typename V::Float x)
+	{
+	const typename V::Float x2 = V::mul(x, x);
+	typename V::Float p = V::splat(-2.5052108385e-8f);
+	p = V::madd(p, x2, V::splat(2.7557319224e-6f));
+	p = V::madd(p, x2, V::splat(-1.9841269841e-4f));
+	p = V::madd(p, x2, V::splat(8.3333333333e-3f));
+	p = V::madd(p, x2, V::splat(-1.6666666667e-1f));
+	return V::madd(V::mul(p, x2), x, x);
+	}
+
+template<class V>
+SR_INLINE typename V::Float SrSimdMath::atanUnit(typename V::Float x)
+	{
+	const typename V::Mask reduce = V::cmpGt(x, V::splat(0.4142135623730950f));
+	const typename V::Float one = V::splat(1.0f);
+	x = V::select(reduce, V::div(V::sub(x, one), V::add(x, one)), x);
+
+	const typename V::Float z = V::mul(x, x);
+	typename V::Float p = V::splat(8.05374449538e-2f);
+	p = V::madd(p, z, V::splat(-1.38776856032e-1f));
+	p = V::madd(p, z, V::splat(1.99777106478e-1f));
+	p = V::madd(p, z, V::splat(-3.33329491539e-1f));
+	const typename V::Float r = V::madd(V::mul(p, z), x, x);
+	return V::select(reduce, V::add(r, V::splat(0.25f * SrPiF32)), r);
+	}
+
+template<class V>
+SR_INLINE typename V::Float SrSimdMath::atan2(typename V::Float y, typename V::Float x)
+	{
+	const typename V::Float zero = V::zero();
+	const typename V::Float ax = V::abs(x);
+	const typename V::Float ay = V::abs(y);
+	const typename V::Float mn = V::min(ax, ay);
+	const typename V::Float mx = V::max(ax, ay);
+
+	//fold into the first octant, then unfold with the signs and the larger component.
+	const typename V::Float a = V::select(V::cmpGt(mx, zero), V::div(mn, mx), zero);
+	typename V::Float r = atanUnit<V>(a);
+	r = V::select(V::cmpGt(ay, ax), V::sub(V::splat(SrHalfPiF32), r), r);
+	r = V::select(V::cmpLt(x, zero), V::sub(V::splat(SrPiF32), r), r);
+	r = V::select(V::cmpLt(y, zero), V::neg(r), r);
+	//NaN in, NaN out, min and max would drop it.
+	return V::select(V::maskAnd(V::cmpEq(x, x), V::cmpEq(y, y)), r, V::add(y, x));
+	}
+
+template<class V>
+SR_INLINE void SrSimdMath::sinCos(typename V::Float x, typename V::Float& s, typename V::Float& c)
+	{
+	//x = q*pi/2 + r with |r| <= pi/4, pi/2 split in four parts. q*part is exact for the
+	//first three, which have at most 11 bits; the rounding of the last one times q stays
+	//far below an ulp of r, also next to the zeros of sin and cos.
+	const typename V::Float q = V::round(V::mul(x, V::splat(0.63661977236758134f)));
+	typename V::Float r = V::nmadd(q, V::splat(1.5703125f), x);
+	r = V::nmadd(q, V::splat(4.837512969970703125e-4f), r);
+	r = V::nmadd(q, V::splat(7.54953362047672271729e-8f), r);
+	r = V::nmadd(q, V::splat(2.56334406825708960298e-12f), r);
+	const typename V::Float z = V::mul(r, r);
+
+	typename V::Float ps = V::splat(-1.9515295891e-4f);
+	ps = V::madd(ps, z, V::splat(8.3321608736e-3f));
+	ps = V::madd(ps, z, V::splat(-1.6666654611e-1f));
+	ps = V::madd(V::mul(ps, z), r, r);
+
+	typename V::Float pc = V::splat(2.443315711809948e-5f);
+	pc = V::madd(pc, z, V::splat(-1.388731625493765e-3f));
+	pc = V::madd(pc, z, V::splat(4.166664568298827e-2f));
+	pc = V::madd(V::mul(pc, z), z, V::nmadd(V::splat(0.5f), z, V::splat(1.0f)));
+
+	//quadrant q mod 4:		0		1		2		3
+	//sin					s		c		-s		-c
+	//cos					c		-s		-c		s
+	const typename V::Float q4 = V::nmadd(V::splat(4.0f), V::floor(V::mul(q, V::splat(0.25f))), q);
+	const typename V::Mask q1 = V::cmpEq(q4, V::splat(1.0f));
+	const typename V::Mask q2 = V::cmpEq(q4, V::splat(2.0f));
+	const typename V::Mask q3 = V::cmpEq(q4, V::splat(3.0f));
+	const typename V::Mask swap = V::maskOr(q1, q3);
+	const typename V::Float sr = V::select(swap, pc, ps);
+	const typename V::Float cr = V::select(swap, ps, pc);
+	s = V::select(V::maskOr(q2, q3), V::neg(sr), sr);
+	c = V::select(V::maskOr(q1, q2), V::neg(cr), cr);
+	}
+
+template<class V>
+SR_INLINE typename V::Float SrSimdMath::sin(typename V::Float x)
+	{
+	typename V::Float s, c;
+	sinCos<V>(x, s, c);
+	return s;
+	}
+
+template<class V>
+SR_INLINE typename V::Float SrSimdMath::cos(typename V::Float x)
+	{
+	typename V::Float s, c;
+	sinCos<V>(x, s, c);
+	return c;
+	}
+
+template<class V>
+SR_INLINE typename V::Float SrSimdMath::asinPoly(typename V::Float x, typename V::Float z)
+	{
+	//asin(x) for |x| <= 0.5, z = x*x.
+	typename V::Float p = V::splat(4.2163199048e-2f);
+	p = V::madd(p, z, V::splat(2.4181311049e-2f));
+	p = V::madd(p, z, V::splat(4.5470025998e-2f));
+	p = V::madd(p, z, V::splat(7.4953002686e-2f));
+	p = V::madd(p, z, V::splat(1.6666752422e-1f));
+	return V::madd(V::mul(p, z), x, x);
+	}
+
+template<class V>
+SR_INLINE typename V::Float SrSimdMath::asin(typename V::Float x)
+	{
+	//asin(a) = pi/2 - 2*asin(sqrt((1-a)/2)) above 0.5.
+	const typename V::Float half = V::splat(0.5f);
+	const typename V::Float a = V::min(V::abs(x), V::splat(1.0f));
+	const typename V::Mask big = V::cmpGt(a, half);
+	const typename V::Float zb = V::mul(half, V::sub(V::splat(1.0f), a));
+	const typename V::Float z = V::select(big, zb, V::mul(a, a));
+	const typename V::Float t = V::select(big, V::sqrt(zb), a);
+	const typename V::Float p = asinPoly<V>(t, z);
+	const typename V::Float r = V::select(big, V::nmadd(V::splat(2.0f), p, V::splat(SrHalfPiF32)), p);
+	return V::select(V::cmpLt(x, V::zero()), V::neg(r), r);
+	}
+
+template<class V>
+SR_INLINE typename V::Float SrSimdMath::acos(typename V::Float x)
+	{
+	//acos(x) = 2*asin(sqrt((1-x)/2)) above 0.5, pi - 2*asin(sqrt((1+x)/2)) below -0.5,
+	//pi/2 - asin(x) in between.
+	const typename V::Float half = V::splat(0.5f);
+	const typename V::Float one = V::splat(1.0f);
+	x = V::max(V::min(x, one), V::neg(one));
+	const typename V::Float a = V::abs(x);
+	const typename V::Mask big = V::cmpGt(a, half);
+	const typename V::Float zb = V::mul(half, V::sub(one, a));
+	const typename V::Float z = V::select(big, zb, V::mul(x, x));
+	const typename V::Float t = V::select(big, V::sqrt(zb), x);
+	const typename V::Float p = asinPoly<V>(t, z);
+	const typename V::Float p2 = V::add(p, p);
+	const typename V::Float rb = V::select(V::cmpLt(x, V::zero()), V::sub(V::splat(SrPiF32), p2), p2);
+	return V::select(big, rb, V::sub(V::splat(SrHalfPiF32), p));
+	}
+
+template<class V>
+SR_INLINE typename V::Float SrSimdMath::atan(typename V::Float x)
+	{
+	//atan(a) = pi/2 - atan(1/a) above 1.
+	const typename V::Float one = V::splat(1.0f);
+	const typename V::Float a = V::abs(x);
+	const typename V::Mask inv = V::cmpGt(a, one);
+	typename V::Float r = atanUnit<V>(V::select(inv, V::div(one, a), a));
+	r = V::select(inv, V::sub(V::splat(SrHalfPiF32), r), r);
+	return V::select(V::cmpLt(x, V::zero()), V::neg(r), r);
+	}
+
+template<class V>
+SR_INLINE typename V::Float SrSimdMath::exp(typename V::Float x)
+	{
+	const typename V::Float hi = V::splat(88.72283905206835f);
+	const typename V::Float lo = V::splat(-103.97207708f);
+	const typename V::Float xc = V::max(V::min(x, hi), lo);
+
+	//x = q*ln2 + r, ln2 split in two parts.
+	const typename V::Float q = V::round(V::mul(xc, V::splat(1.44269504088896341f)));
+	typename V::Float r = V::nmadd(q, V::splat(0.693359375f), xc);
+	r = V::nmadd(q, V::splat(-2.12194440e-4f), r);
+	const typename V::Float z = V::mul(r, r);
+
+	typename V::Float p = V::splat(1.9875691500e-4f);
+	p = V::madd(p, r, V::splat(1.3981999507e-3f));
+	p = V::madd(p, r, V::splat(8.3334519073e-3f));
+	p = V::madd(p, r, V::splat(4.1665795894e-2f));
+	p = V::madd(p, r, V::splat(1.6666665459e-1f));
+	p = V::madd(p, r, V::splat(5.0000001201e-1f));
+	p = V::madd(p, z, V::add(r, V::splat(1.0f)));
+	p = V::ldexp(p, q);
+
+	p = V::select(V::cmpGt(x, hi), V::splat(HUGE_VALF), p);
+	p = V::select(V::cmpLt(x, lo), V::zero(), p);
+	//NaN in, NaN out
+	return V::select(V::cmpEq(x, x), p, x);
+	}
+
+template<class V>
+SR_INLINE typename V::Float SrSimdMath::logE(typename V::Float x)
+	{
+	//denormals are scaled up first so that frexp sees a normal number.
+	const typename V::Mask tiny = V::cmpLt(x, V::splat(FLT_MIN));
+	const typename V::Float xs = V::select(tiny, V::mul(x, V::splat(33554432.0f)), x);
+	typename V::Float e;
+	typename V::Float m = V::frexp(xs, e);
+	e = V::select(tiny, V::sub(e, V::splat(25.0f)), e);
+
+	//m in [sqrt(1/2), sqrt(2)) and log(x) = e*ln2 + log(m)
+	const typename V::Mask low = V::cmpLt(m, V::splat(0.707106781186547524f));
+	e = V::select(low, V::sub(e, V::splat(1.0f)), e);
+	m = V::sub(V::select(low, V::add(m, m), m), V::splat(1.0f));
+	const typename V::Float z = V::mul(m, m);
+
+	typename V::Float p = V::splat(7.0376836292e-2f);
+	p = V::madd(p, m, V::splat(-1.1514610310e-1f));
+	p = V::madd(p, m, V::splat(1.1676998740e-1f));
+	p = V::madd(p, m, V::splat(-1.2420140846e-1f));
+	p = V::madd(p, m, V::splat(1.4249322787e-1f));
+	p = V::madd(p, m, V::splat(-1.6668057665e-1f));
+	p = V::madd(p, m, V::splat(2.0000714765e-1f));
+	p = V::madd(p, m, V::splat(-2.4999993993e-1f));
+	p = V::madd(p, m, V::splat(3.3333331174e-1f));
+	typename V::Float y = V::mul(V::mul(p, m), z);
+	y = V::madd(e, V::splat(-2.12194440e-4f), y);
+	y = V::nmadd(V::splat(0.5f), z, y);
+	typename V::Float r = V::madd(e, V::splat(0.693359375f), V::add(m, y));
+
+	const typename V::Float inf = V::splat(HUGE_VALF);
+	r = V::select(V::cmpEq(x, inf), inf, r);
+	r = V::select(V::cmpEq(x, V::zero()), V::neg(inf), r);
+	//negative and NaN arguments
+	return V::select(V::cmpGe(x, V::zero()), r, V::splat(NAN));
+	}
+
+template<class V, class Op>
+SR_INLINE void SrSimdMath::unaryLanes(const SrF32* src, SrF32* dst, SrU32 n)
+	{
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		V::store(dst + i, Op::template eval<V>(V::load(src + i)));
+	for(; i < n; i++)
+		dst[i] = Op::template eval<SrSimdScalar>(src[i]);
+	}
+
+template<class V>
+SR_INLINE void SrSimdMath::sinCosLanes(const SrF32* src, SrF32* s, SrF32* c, SrU32 n)
+	{
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		{
+		typename V::Float vs, vc;
+		sinCos<V>(V::load(src + i), vs, vc);
+		V::store(s + i, vs);
+		V::store(c + i, vc);
+		}
+	for(; i < n; i++)
+		sinCos<SrSimdScalar>(src[i], s[i], c[i]);
+	}
+
+template<class V>
+SR_INLINE void SrSimdMath::atan2Lanes(const SrF32* y, const SrF32* x, SrF32* dst, SrU32 n)
+	{
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		V::store(dst + i, atan2<V>(V::load(y + i), V::load(x + i)));
+	for(; i < n; i++)
+		dst[i] = atan2<SrSimdScalar>(y[i], x[i]);
+	}
+
+SR_INLINE void SrSimdMath::sin(const SrF32* src, SrF32* dst, SrU32 n)		{ SR_SIMD_KERNEL(SrSimdMathKernels, mathSin, (unaryLanes<SrSimdNative, OpSin>))(src, dst, n);	}
+SR_INLINE void SrSimdMath::cos(const SrF32* src, SrF32* dst, SrU32 n)		{ SR_SIMD_KERNEL(SrSimdMathKernels, mathCos, (unaryLanes<SrSimdNative, OpCos>))(src, dst, n);	}
+SR_INLINE void SrSimdMath::asin(const SrF32* src, SrF32* dst, SrU32 n)		{ SR_SIMD_KERNEL(SrSimdMathKernels, mathAsin, (unaryLanes<SrSimdNative, OpAsin>))(src, dst, n);	}
+SR_INLINE void SrSimdMath::acos(const SrF32* src, SrF32* dst, SrU32 n)		{ SR_SIMD_KERNEL(SrSimdMathKernels, mathAcos, (unaryLanes<SrSimdNative, OpAcos>))(src, dst, n);	}
+SR_INLINE void SrSimdMath::atan(const SrF32* src, SrF32* dst, SrU32 n)		{ SR_SIMD_KERNEL(SrSimdMathKernels, mathAtan, (unaryLanes<SrSimdNative, OpAtan>))(src, dst, n);	}
+SR_INLINE void SrSimdMath::exp(const SrF32* src, SrF32* dst, SrU32 n)		{ SR_SIMD_KERNEL(SrSimdMathKernels, mathExp, (unaryLanes<SrSimdNative, OpExp>))(src, dst, n);	}
+SR_INLINE void SrSimdMath::logE(const SrF32* src, SrF32* dst, SrU32 n)		{ SR_SIMD_KERNEL(SrSimdMathKernels, mathLogE, (unaryLanes<SrSimdNative, OpLogE>))(src, dst, n);	}
+
+SR_INLINE void SrSimdMath::sinCos(const SrF32* src, SrF32* s, SrF32* c, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrSimdMathKernels, mathSinCos, sinCosLanes<SrSimdNative>)(src, s, c, n);
+	}
+
+SR_INLINE void SrSimdMath::atan2(const SrF32* y, const SrF32* x, SrF32* dst, SrU32 n)
+	{
+	SR_SIMD_KERNEL(SrSimdMathKernels, mathAtan2, atan2Lanes<SrSimdNative>)(y, x, dst, n);
+	}
+
+SR_INLINE void SrSimdMath::sin(const SrF64* src, SrF64* dst, SrU32 n)		{ for(SrU32 i = 0; i < n; i++) dst[i] = SrMath::sin(src[i]);	}
+SR_INLINE void SrSimdMath::cos(const SrF64* src, SrF64* dst, SrU32 n)		{ for(SrU32 i = 0; i < n; i++) dst[i] = SrMath::cos(src[i]);	}
+SR_INLINE void SrSimdMath::asin(const SrF64* src, SrF64* dst, SrU32 n)		{ for(SrU32 i = 0; i < n; i++) dst[i] = SrMath::asin(src[i]);	}
+SR_INLINE void SrSimdMath::acos(const SrF64* src, SrF64* dst, SrU32 n)		{ for(SrU32 i = 0; i < n; i++) dst[i] = SrMath::acos(src[i]);	}
+SR_INLINE void SrSimdMath::atan(const SrF64* src, SrF64* dst, SrU32 n)		{ for(SrU32 i = 0; i < n; i++) dst[i] = SrMath::atan(src[i]);	}
+SR_INLINE void SrSimdMath::exp(const SrF64* src, SrF64* dst, SrU32 n)		{ for(SrU32 i = 0; i < n; i++) dst[i] = SrMath::exp(src[i]);	}
+SR_INLINE void SrSimdMath::logE(const SrF64* src, SrF64* dst, SrU32 n)		{ for(SrU32 i = 0; i < n; i++) dst[i] = SrMath::logE(src[i]);	}
+
+SR_INLINE void SrSimdMath::sinCos(const SrF64* src, SrF64* s, SrF64* c, SrU32 n)
+	{
+	for(SrU32 i = 0; i < n; i++)
+		SrMath::sinCos(src[i], s[i], c[i]);
+	}
+
+SR_INLINE void SrSimdMath::atan2(const SrF64* y, const SrF64* x, SrF64* dst, SrU32 n)
+	{
+	for(SrU32 i = 0; i < n; i++)
+		dst[i] = SrMath::atan2(y[i], x[i]);
+	}
+
+#if defined(SR_DETERMINISTIC)
+#include "SrMathDeterministic.h"
+#endif
+
+SR_SIMD_KERNEL_TABLES(SrSimdMathKernels)
+
+/** @} */
+#endif
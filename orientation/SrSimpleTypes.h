@@ -11,10 +11,12 @@
 */
 
 
+typedef signed long long	SrI64;
 typedef signed int			SrI32;
 typedef signed short		SrI16;
 typedef signed char			SrI8;
 
+typedef unsigned long long	SrU64;
 typedef unsigned int		SrU32;
 typedef unsigned short		SrU16;
 
@@ -47,6 +49,42 @@ typedef double				SrF64;
 
 #define SR_INLINE			inline
 
+//for the functions that can also be evaluated at compile time. C++20 is required,
+//older standards forbid the uninitialized locals and the runtime-only branches.
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#define SR_CONSTEXPR_ENABLED
+#define SR_CONSTEXPR		constexpr
+#define SR_CONSTANT			constexpr
+#else
+#define SR_CONSTEXPR		inline
+#define SR_CONSTANT			const
+#endif
+
+#if defined(_MSC_VER)
+#define SR_ALIGN(n)			__declspec(align(n))
+#else
+#define SR_ALIGN(n)			__attribute__((aligned(n)))
+#endif
+
+//SR_DETERMINISTIC makes every result bitwise reproducible across compilers and instruction
+//sets, see SrMathDeterministic.h. It needs IEEE single and double arithmetic without
+//excess precision or contraction, so a*b + c must never be fused into an FMA. The headers
+//leave the code generation of the including file alone, the whole project is built with
+//-ffp-contract=off on GCC and clang, and /fp:precise without /fp:contract on MSVC. Only
+//MSVC tells the preprocessor, so the GCC and clang setting is checked at run time by
+//SrMathDeterministic::isContracted().
+#if defined(SR_DETERMINISTIC)
+#if defined(__FAST_MATH__) || defined(_M_FP_FAST)
+#error "SR_DETERMINISTIC cannot be combined with -ffast-math or /fp:fast"
+#endif
+#if defined(_M_FP_CONTRACT)
+#error "SR_DETERMINISTIC cannot be combined with /fp:contract"
+#endif
+#if defined(__FLT_EVAL_METHOD__) && __FLT_EVAL_METHOD__ != 0
+#error "SR_DETERMINISTIC needs SSE arithmetic, FLT_EVAL_METHOD 0"
+#endif
+#endif
+
 
 
 /** @} */
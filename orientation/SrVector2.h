@@ -12,6 +12,7 @@
 
 #include <assert.h>
 #include "SrSimpleTypes.h"
+#include "SrForward.h"
 #include "SrMath.h"
 
 
@@ -31,18 +32,24 @@
 This is a vector class with public data members.
 This is not nice but it has become such a standard that hiding the xy data members
 makes it difficult to reuse external code that assumes that these are public in the library.
-The vector class can be made to use float or double precision by appropriately defining float.
-This has been chosen as a cleaner alternative to a template class.
+The precision is the template parameter, SrVector2T<SrF32> and SrVector2T<SrF64> are
+the SrVector2 and SrVector2F64 typedefs and can be used side by side.
 */
-class SrVector2
+template<class T>
+class SrVector2T
 	{
 	public:
+	/**
+	\brief The scalar type, SrF32 or SrF64.
+	*/
+	typedef T Real;
+
 	//!Constructors
 
 	/**
 	\brief default constructor leaves data uninitialized.
 	*/
-	SR_INLINE SrVector2();
+	SR_CONSTEXPR SrVector2T();
 
 	/**
 	\brief Assigns scalar parameter to all elements.
@@ -51,7 +58,7 @@ class SrVector2
 
 	\param[in] a Value to assign to elements.
 	*/
-	SR_INLINE explicit SrVector2(SrReal a);
+	SR_CONSTEXPR explicit SrVector2T(T a);
 
 	/**
 	\brief Initializes from 2 scalar parameters.
@@ -59,160 +66,166 @@ class SrVector2
 	\param[in] nx Value to initialize X component.
 	\param[in] ny Value to initialize Y component.
 	*/
-	SR_INLINE SrVector2(SrReal nx, SrReal ny);
+	SR_CONSTEXPR SrVector2T(T nx, T ny);
 	
 	/**
 	\brief Initializes from an array of scalar parameters.
 
 	\param[in] v Value to initialize with.
 	*/
-	SR_INLINE SrVector2(const SrReal v[]);
+	SR_CONSTEXPR SrVector2T(const T v[]);
 
 	/**
 	\brief Copy constructor.
 	*/
-	SR_INLINE SrVector2(const SrVector2& v);
+	SR_CONSTEXPR SrVector2T(const SrVector2T& v);
+
+	/**
+	\brief Converts from the other precision.
+	*/
+	template<class U>
+	SR_CONSTEXPR explicit SrVector2T(const SrVector2T<U>& v);
 
 	/**
 	\brief Assignment operator.
 	*/
-	SR_INLINE const SrVector2& operator=(const SrVector2&);
+	SR_CONSTEXPR const SrVector2T& operator=(const SrVector2T&);
 
 	/**
 	\brief Access the data as an array.
 
-	\return Array of 2 floats.
+	\return Array of 2 elements.
 	*/
-	SR_INLINE const SrReal *get() const;
+	SR_INLINE const T *get() const;
 	/**
 	\brief writes out the 2 values to dest.
 
 	\param[out] dest Array to write elements to.
 	*/
-	SR_INLINE void get(SrF32 * dest) const;
+	SR_CONSTEXPR void get(SrF32 * dest) const;
 
 	/**
 	\brief writes out the 2 values to dest.
 	*/
-	SR_INLINE void get(SrF64 * dest) const;
+	SR_CONSTEXPR void get(SrF64 * dest) const;
 
 	/**
 	\brief Access the data as an array.
 
-	\return Array of 2 floats.
+	\return Array of 2 elements.
 	*/
-	SR_INLINE SrReal* get();
+	SR_INLINE T* get();
 
-	SR_INLINE SrReal& operator[](int index);
-	SR_INLINE SrReal  operator[](int index) const;
+	SR_INLINE T& operator[](int index);
+	SR_INLINE T  operator[](int index) const;
 
 	//Operators
 	/**
 	\brief true if all the members are smaller.
 	*/
-	SR_INLINE bool operator< (const SrVector2&) const;
+	SR_CONSTEXPR bool operator< (const SrVector2T&) const;
 	/**
 	\brief returns true if the two vectors are exactly equal.
 
 	use equal() to test with a tolerance.
 	*/
-	SR_INLINE bool operator==(const SrVector2&) const;
+	SR_CONSTEXPR bool operator==(const SrVector2T&) const;
 	/**
 	\brief returns true if the two vectors are exactly unequal.
 
 	use !equal() to test with a tolerance.
 	*/
-	SR_INLINE bool operator!=(const SrVector2&) const;
+	SR_CONSTEXPR bool operator!=(const SrVector2T&) const;
 
 //Methods
 	
 	/**
 	\brief reads 2 consecutive values from the ptr passed
 	*/
-	SR_INLINE void  set(const SrF32 *);
+	SR_CONSTEXPR void  set(const SrF32 *);
 
 	/**
 	\brief reads 2 consecutive values from the ptr passed
 	*/
-	SR_INLINE void  set(const SrF64 *);
-	SR_INLINE void  set(const SrVector2 &);
+	SR_CONSTEXPR void  set(const SrF64 *);
+	SR_CONSTEXPR void  set(const SrVector2T &);
 
 //legacy methods:
-	SR_INLINE void setx(const SrReal & d);
-	SR_INLINE void sety(const SrReal & d);
+	SR_CONSTEXPR void setx(const T & d);
+	SR_CONSTEXPR void sety(const T & d);
 
 	/**
 	\brief this = -a
 	*/
-	SR_INLINE void  setNegative(const SrVector2 &a);
+	SR_CONSTEXPR void  setNegative(const SrVector2T &a);
 
 	/**
 	\brief this = -this
 	*/
-	SR_INLINE void  setNegative();
+	SR_CONSTEXPR void  setNegative();
 
 	/**
 	\brief reads 2 consecutive values from the ptr passed
 	*/
-	SR_INLINE void  set(SrReal, SrReal);
-	SR_INLINE void  set(SrReal);
+	SR_CONSTEXPR void  set(T, T);
+	SR_CONSTEXPR void  set(T);
 
-	SR_INLINE void  zero();
+	SR_CONSTEXPR void  zero();
 	
 	/**
 	\brief tests for exact zero vector
 	*/
-	SR_INLINE bool isZero()	const
+	SR_CONSTEXPR bool isZero()	const
 		{
 		if((x != 0.0f) || (y != 0.0f))	return false;
 		return true;
 		}
 
-	SR_INLINE void  setPlusInfinity();
-	SR_INLINE void  setMinusInfinity();
+	SR_CONSTEXPR void  setPlusInfinity();
+	SR_CONSTEXPR void  setMinusInfinity();
 
 	/**
 	\brief this = element wise min(this,other)
 	*/
-	SR_INLINE void min(const SrVector2 &);
+	SR_CONSTEXPR void min(const SrVector2T &);
 	/**
 	\brief this = element wise max(this,other)
 	*/
-	SR_INLINE void max(const SrVector2 &);
+	SR_CONSTEXPR void max(const SrVector2T &);
 
 	/**
 	\brief this = a + b
 	*/
-	SR_INLINE void  add(const SrVector2 & a, const SrVector2 & b);
+	SR_CONSTEXPR void  add(const SrVector2T & a, const SrVector2T & b);
 	/**
 	\brief this = a - b
 	*/
-	SR_INLINE void  subtract(const SrVector2 &a, const SrVector2 &b);
+	SR_CONSTEXPR void  subtract(const SrVector2T &a, const SrVector2T &b);
 	/**
 	\brief this = s * a;
 	*/
-	SR_INLINE void  multiply(SrReal s,  const SrVector2 & a);
+	SR_CONSTEXPR void  multiply(T s,  const SrVector2T & a);
 
 	/**
 	\brief this[i] = a[i] * b[i], for all i.
 	*/
-	SR_INLINE void  arrayMultiply(const SrVector2 &a, const SrVector2 &b);
+	SR_CONSTEXPR void  arrayMultiply(const SrVector2T &a, const SrVector2T &b);
 
 
 	/**
 	\brief this = s * a + b;
 	*/
-	SR_INLINE void  multiplyAdd(SrReal s, const SrVector2 & a, const SrVector2 & b);
+	SR_CONSTEXPR void  multiplyAdd(T s, const SrVector2T & a, const SrVector2T & b);
 
 	/**
 	\brief normalizes the vector
 	*/
-	SR_INLINE SrReal normalize();
+	SR_CONSTEXPR T normalize();
 
 	/**
 	\brief sets the vector's magnitude
 	*/
-	SR_INLINE void	setMagnitude(SrReal);
+	SR_CONSTEXPR void	setMagnitude(T);
 
 	/**
 	\brief snaps to closest axis
@@ -227,38 +240,38 @@ class SrVector2
 	/**
 	\brief returns the scalar product of this and other.
 	*/
-	SR_INLINE SrReal dot(const SrVector2 &other) const;
+	SR_CONSTEXPR T dot(const SrVector2T &other) const;
 	/**
 	\brief returns the scalar cross product of this and other.
 	*/
-	SR_INLINE SrReal cross(const SrVector2 &other) const;
+	SR_CONSTEXPR T cross(const SrVector2T &other) const;
 
 	/**
 	\brief compares orientations (more readable, user-friendly function)
 	*/
-	SR_INLINE bool sameDirection(const SrVector2 &) const;
+	SR_CONSTEXPR bool sameDirection(const SrVector2T &) const;
 
 	/**
 	\brief returns the magnitude
 	*/
-	SR_INLINE SrReal magnitude() const;
+	SR_CONSTEXPR T magnitude() const;
 
 	/**
 	\brief returns the squared magnitude
 	
 	Avoids calling sqrt()!
 	*/
-	SR_INLINE SrReal magnitudeSquared() const;
+	SR_CONSTEXPR T magnitudeSquared() const;
 
 	/**
 	\brief returns (this - other).magnitude();
 	*/
-	SR_INLINE SrReal distance(const SrVector2 &) const;
+	SR_CONSTEXPR T distance(const SrVector2T &) const;
 
 	/**
 	\brief returns (this - other).magnitudeSquared();
 	*/
-	SR_INLINE SrReal distanceSquared(const SrVector2 &v) const;
+	SR_CONSTEXPR T distanceSquared(const SrVector2T &v) const;
 
 	/**
 	\brief Stuff magic values in the point, marking it as explicitly not used.
@@ -273,82 +286,95 @@ class SrVector2
 	/**
 	\brief returns true if this and arg's elems are within epsilon of each other.
 	*/
-	SR_INLINE bool equals(const SrVector2 &, SrReal epsilon) const;
+	SR_CONSTEXPR bool equals(const SrVector2T &, T epsilon) const;
 
 	/**
 	\brief negation
 	*/
-	SR_INLINE SrVector2 operator -() const;
+	SR_CONSTEXPR SrVector2T operator -() const;
 	/**
 	\brief vector addition
 	*/
-	SR_INLINE SrVector2 operator +(const SrVector2 & v) const;
+	SR_CONSTEXPR SrVector2T operator +(const SrVector2T & v) const;
 	/**
 	\brief vector difference
 	*/
-	SR_INLINE SrVector2 operator -(const SrVector2 & v) const;
+	SR_CONSTEXPR SrVector2T operator -(const SrVector2T & v) const;
 	/**
 	\brief scalar post-multiplication
 	*/
-	SR_INLINE SrVector2 operator *(SrReal f) const;
+	SR_CONSTEXPR SrVector2T operator *(T f) const;
 	/**
 	\brief scalar division
 	*/
-	SR_INLINE SrVector2 operator /(SrReal f) const;
+	SR_CONSTEXPR SrVector2T operator /(T f) const;
 	/**
 	\brief vector addition
 	*/
-	SR_INLINE SrVector2&operator +=(const SrVector2& v);
+	SR_CONSTEXPR SrVector2T&operator +=(const SrVector2T& v);
 	/**
 	\brief vector difference
 	*/
-	SR_INLINE SrVector2&operator -=(const SrVector2& v);
+	SR_CONSTEXPR SrVector2T&operator -=(const SrVector2T& v);
 	/**
 	\brief scalar multiplication
 	*/
-	SR_INLINE SrVector2&operator *=(SrReal f);
+	SR_CONSTEXPR SrVector2T&operator *=(T f);
 	/**
 	\brief scalar division
 	*/
-	SR_INLINE SrVector2&operator /=(SrReal f);
+	SR_CONSTEXPR SrVector2T&operator /=(T f);
 	/**
 	\brief dot product
 	*/
-	SR_INLINE SrReal      operator|(const SrVector2& v) const;
+	SR_CONSTEXPR T      operator|(const SrVector2T& v) const;
 
-	SrReal x,y;
+	T x,y;
 	};
 
 
 /** \endcond */
 
 //implementations:
-SrVector2::SrVector2(SrReal v) : x(v), y(v)
+template<class T>
+SR_CONSTEXPR SrVector2T<T>::SrVector2T(T v) : x(v), y(v)
 	{
 	}
 
-SR_INLINE SrVector2::SrVector2(SrReal _x, SrReal _y) : x(_x), y(_y)
+template<class T>
+SR_CONSTEXPR SrVector2T<T>::SrVector2T(T _x, T _y) : x(_x), y(_y)
 	{
 	}
 
 
-SR_INLINE SrVector2::SrVector2(const SrReal v[]) : x(v[0]), y(v[1])
+template<class T>
+SR_CONSTEXPR SrVector2T<T>::SrVector2T(const T v[]) : x(v[0]), y(v[1])
 	{
 	}
 
 
-SR_INLINE SrVector2::SrVector2(const SrVector2 &v) : x(v.x), y(v.y)
+template<class T>
+SR_CONSTEXPR SrVector2T<T>::SrVector2T(const SrVector2T<T> &v) : x(v.x), y(v.y)
 	{
 	}
 
 
-SR_INLINE SrVector2::SrVector2()
+template<class T>
+template<class U>
+SR_CONSTEXPR SrVector2T<T>::SrVector2T(const SrVector2T<U>& v) : x((T)v.x), y((T)v.y)
+	{
+	}
+
+
+template<class T>
+SR_CONSTEXPR SrVector2T<T>::SrVector2T()
 	{
 	//default constructor leaves data uninitialized.
 	}
 
 
-SR_INLINE const SrVector2& SrVector2::operator=(const SrVector2& v)
+template<class T>
+SR_CONSTEXPR const SrVector2T<T>& SrVector2T<T>::operator=(const SrVector2T<T>& v)
 	{
 	x = v.x;
 	y = v.y;
@@ -358,60 +384,69 @@ SR_INLINE const SrVector2& SrVector2::operator=(const SrVector2& v)
 
 // Access the data as an array.
 
-SR_INLINE const SrReal* SrVector2::get() const
+template<class T>
+SR_INLINE const T* SrVector2T<T>::get() const
 	{
 	return &x;
 	}
 
 
-SR_INLINE SrReal* SrVector2::get()
+template<class T>
+SR_INLINE T* SrVector2T<T>::get()
 	{
 	return &x;
 	}
 
  
-SR_INLINE void  SrVector2::get(SrF32 * v) const
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::get(SrF32 * v) const
 	{
 	v[0] = (SrF32)x;
 	v[1] = (SrF32)y;
 	}
 
  
-SR_INLINE void  SrVector2::get(SrF64 * v) const
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::get(SrF64 * v) const
 	{
 	v[0] = (SrF64)x;
 	v[1] = (SrF64)y;
 	}
 
 
-SR_INLINE SrReal& SrVector2::operator[](int index)
+template<class T>
+SR_INLINE T& SrVector2T<T>::operator[](int index)
 	{
 	SR_ASSERT(index>=0 && index<=1);
 	return (&x)[index];
 	}
 
 
-SR_INLINE SrReal  SrVector2::operator[](int index) const
+template<class T>
+SR_INLINE T  SrVector2T<T>::operator[](int index) const
 	{
 	SR_ASSERT(index>=0 && index<=1);
 	return (&x)[index];
 	}
 
  
-SR_INLINE void SrVector2::setx(const SrReal & d) 
+template<class T>
+SR_CONSTEXPR void SrVector2T<T>::setx(const T & d) 
 	{ 
 	x = d; 
 	}
 
  
-SR_INLINE void SrVector2::sety(const SrReal & d) 
+template<class T>
+SR_CONSTEXPR void SrVector2T<T>::sety(const T & d) 
 	{ 
 	y = d; 
 	}
 
 //Operators
  
-SR_INLINE bool SrVector2::operator < (const SrVector2&v) const
+template<class T>
+SR_CONSTEXPR bool SrVector2T<T>::operator < (const SrVector2T<T>&v) const
 	{
 		if( x < v.x)	return true;
 		if( x > v.x)	return false;
@@ -420,34 +455,39 @@ SR_INLINE bool SrVector2::operator < (const SrVector2&v) const
 	}
 
  
-SR_INLINE bool SrVector2::operator==(const SrVector2& v) const
+template<class T>
+SR_CONSTEXPR bool SrVector2T<T>::operator==(const SrVector2T<T>& v) const
 	{
 	return ((x == v.x)&&(y == v.y));
 	}
 
  
-SR_INLINE bool SrVector2::operator!=(const SrVector2& v) const
+template<class T>
+SR_CONSTEXPR bool SrVector2T<T>::operator!=(const SrVector2T<T>& v) const
 	{
 	return ((x != v.x)||(y != v.y));
 	}
 
 //Methods
  
-SR_INLINE void  SrVector2::set(const SrVector2 & v)
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::set(const SrVector2T<T> & v)
 	{
 	x = v.x;
 	y = v.y;
 	}
 
  
-SR_INLINE void  SrVector2::setNegative(const SrVector2 & v)
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::setNegative(const SrVector2T<T> & v)
 	{
 	x = -v.x;
 	y = -v.y;
 	}
 
  
-SR_INLINE void  SrVector2::setNegative()
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::setNegative()
 	{
 	x = -x;
 	y = -y;
@@ -455,61 +495,70 @@ SR_INLINE void  SrVector2::setNegative()
 
 
  
-SR_INLINE void  SrVector2::set(const SrF32 * v)
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::set(const SrF32 * v)
 	{
-	x = (SrReal)v[0];
-	y = (SrReal)v[1];
+	x = (T)v[0];
+	y = (T)v[1];
 	}
 
  
-SR_INLINE void  SrVector2::set(const SrF64 * v)
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::set(const SrF64 * v)
 	{
-	x = (SrReal)v[0];
-	y = (SrReal)v[1];
+	x = (T)v[0];
+	y = (T)v[1];
 	}
 
 
  
-SR_INLINE void  SrVector2::set(SrReal _x, SrReal _y)
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::set(T _x, T _y)
 	{
 	this->x = _x;
 	this->y = _y;
 	}
 
  
-SR_INLINE void SrVector2::set(SrReal v)
+template<class T>
+SR_CONSTEXPR void SrVector2T<T>::set(T v)
 	{
 	x = v;
 	y = v;
 	}
 
  
-SR_INLINE void  SrVector2::zero()
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::zero()
 	{
 	x = y = 0.0;
 	}
 
  
-SR_INLINE void  SrVector2::setPlusInfinity()
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::setPlusInfinity()
 	{
-	x = y = SR_MAX_F32; //TODO: this may be double too, but here we can't tell!
+	x = y = SrLimits<T>::maxValue();
 	}
 
  
-SR_INLINE void  SrVector2::setMinusInfinity()
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::setMinusInfinity()
 	{
-	x = y = SR_MIN_F32; //TODO: this may be double too, but here we can't tell!
+	x = y = SrLimits<T>::minValue();
 	}
 
  
-SR_INLINE void SrVector2::max(const SrVector2 & v)
+template<class T>
+SR_CONSTEXPR void SrVector2T<T>::max(const SrVector2T<T> & v)
 	{
 		x = x > v.x?x:v.x;
 		y = y > v.y?y:y;
 	}
 
  
-SR_INLINE void SrVector2::min(const SrVector2 & v)
+template<class T>
+SR_CONSTEXPR void SrVector2T<T>::min(const SrVector2T<T> & v)
 	{
 		x = x > v.x?v.x:x;
 		y = y > v.y?v.y:y;
@@ -518,47 +567,53 @@ SR_INLINE void SrVector2::min(const SrVector2 & v)
 
 
 
-SR_INLINE void  SrVector2::add(const SrVector2 & a, const SrVector2 & b)
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::add(const SrVector2T<T> & a, const SrVector2T<T> & b)
 	{
 	x = a.x + b.x;
 	y = a.y + b.y;
 	}
 
 
-SR_INLINE void  SrVector2::subtract(const SrVector2 &a, const SrVector2 &b)
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::subtract(const SrVector2T<T> &a, const SrVector2T<T> &b)
 	{
 	x = a.x - b.x;
 	y = a.y - b.y;
 	}
 
 
-SR_INLINE void  SrVector2::arrayMultiply(const SrVector2 &a, const SrVector2 &b)
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::arrayMultiply(const SrVector2T<T> &a, const SrVector2T<T> &b)
 	{
 	x = a.x * b.x;
 	y = a.y * b.y;
 	}
 
 
-SR_INLINE void  SrVector2::multiply(SrReal s,  const SrVector2 & a)
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::multiply(T s,  const SrVector2T<T> & a)
 	{
 	x = a.x * s;
 	y = a.y * s;
 	}
 
 
-SR_INLINE void  SrVector2::multiplyAdd(SrReal s, const SrVector2 & a, const SrVector2 & b)
+template<class T>
+SR_CONSTEXPR void  SrVector2T<T>::multiplyAdd(T s, const SrVector2T<T> & a, const SrVector2T<T> & b)
 	{
 	x = s * a.x + b.x;
 	y = s * a.y + b.y;
 	}
 
  
-SR_INLINE SrReal SrVector2::normalize()
+template<class T>
+SR_CONSTEXPR T SrVector2T<T>::normalize()
 	{
-	SrReal m = magnitude();
+	T m = magnitude();
 	if (m)
 		{
-		const SrReal il =  SrReal(1.0) / m;
+		const T il =  T(1.0) / m;
 		x *= il;
 		y *= il;
 		}
@@ -566,65 +621,75 @@ SR_INLINE SrReal SrVector2::normalize()
 	}
 
  
-SR_INLINE void SrVector2::setMagnitude(SrReal length)
+template<class T>
+SR_CONSTEXPR void SrVector2T<T>::setMagnitude(T length)
 	{
-	SrReal m = magnitude();
+	T m = magnitude();
 	if(m)
 		{
-		SrReal newLength = length / m;
+		T newLength = length / m;
 		x *= newLength;
 		y *= newLength;
 		}
 	}
-SR_INLINE bool SrVector2::isFinite() const
+template<class T>
+SR_INLINE bool SrVector2T<T>::isFinite() const
 	{
 		return SrMath::isFinite(x) && SrMath::isFinite(y);
 	}
-SR_INLINE SrReal SrVector2::dot(const SrVector2 &v) const
+template<class T>
+SR_CONSTEXPR T SrVector2T<T>::dot(const SrVector2T<T> &v) const
 	{
 		return x * v.x + y * v.y;
 	}
-SR_INLINE SrReal SrVector2::cross(const SrVector2 &other) const
+template<class T>
+SR_CONSTEXPR T SrVector2T<T>::cross(const SrVector2T<T> &other) const
 	{
 		return x*other.y-y*other.x;
 	}
  
-SR_INLINE bool SrVector2::sameDirection(const SrVector2 &v) const
+template<class T>
+SR_CONSTEXPR bool SrVector2T<T>::sameDirection(const SrVector2T<T> &v) const
 	{
 	return x*v.x + y*v.y >= 0.0f;
 	}
 
  
-SR_INLINE SrReal SrVector2::magnitude() const
+template<class T>
+SR_CONSTEXPR T SrVector2T<T>::magnitude() const
 	{
 	return SrMath::sqrt(x * x + y * y);
 	}
 
  
-SR_INLINE SrReal SrVector2::magnitudeSquared() const
+template<class T>
+SR_CONSTEXPR T SrVector2T<T>::magnitudeSquared() const
 	{
 	return x * x + y * y;
 	}
 
  
-SR_INLINE SrReal SrVector2::distance(const SrVector2 & v) const
+template<class T>
+SR_CONSTEXPR T SrVector2T<T>::distance(const SrVector2T<T> & v) const
 	{
-	SrReal dx = x - v.x;
-	SrReal dy = y - v.y;
+	T dx = x - v.x;
+	T dy = y - v.y;
 	return SrMath::sqrt(dx * dx + dy * dy);
 	}
 
  
-SR_INLINE SrReal SrVector2::distanceSquared(const SrVector2 &v) const
+template<class T>
+SR_CONSTEXPR T SrVector2T<T>::distanceSquared(const SrVector2T<T> &v) const
 	{
-	SrReal dx = x - v.x;
-	SrReal dy = y - v.y;
+	T dx = x - v.x;
+	T dy = y - v.y;
 	return dx * dx + dy * dy;
 	}
 
 
  
-SR_INLINE bool SrVector2::equals(const SrVector2 & v, SrReal epsilon) const
+template<class T>
+SR_CONSTEXPR bool SrVector2T<T>::equals(const SrVector2T<T> & v, T epsilon) const
 	{
 	return 
 		SrMath::equals(x, v.x, epsilon) &&
@@ -633,38 +698,44 @@ SR_INLINE bool SrVector2::equals(const SrVector2 & v, SrReal epsilon) const
 
 
  
-SR_INLINE SrVector2 SrVector2::operator -() const
+template<class T>
+SR_CONSTEXPR SrVector2T<T> SrVector2T<T>::operator -() const
 	{
-	return SrVector2(-x, -y);
+	return SrVector2T<T>(-x, -y);
 	}
 
  
-SR_INLINE SrVector2 SrVector2::operator +(const SrVector2 & v) const
+template<class T>
+SR_CONSTEXPR SrVector2T<T> SrVector2T<T>::operator +(const SrVector2T<T> & v) const
 	{
-	return SrVector2(x + v.x, y + v.y);	// RVO version
+	return SrVector2T<T>(x + v.x, y + v.y);	// RVO version
 	}
 
  
-SR_INLINE SrVector2 SrVector2::operator -(const SrVector2 & v) const
+template<class T>
+SR_CONSTEXPR SrVector2T<T> SrVector2T<T>::operator -(const SrVector2T<T> & v) const
 	{
-	return SrVector2(x - v.x, y - v.y);	// RVO version
+	return SrVector2T<T>(x - v.x, y - v.y);	// RVO version
 	}
 
 
 
-SR_INLINE SrVector2 SrVector2::operator *(SrReal f) const
+template<class T>
+SR_CONSTEXPR SrVector2T<T> SrVector2T<T>::operator *(T f) const
 	{
-	return SrVector2(x * f, y * f);	// RVO version
+	return SrVector2T<T>(x * f, y * f);	// RVO version
 	}
 
 
-SR_INLINE SrVector2 SrVector2::operator /(SrReal f) const
+template<class T>
+SR_CONSTEXPR SrVector2T<T> SrVector2T<T>::operator /(T f) const
 	{
-		f = SrReal(1.0) / f; return SrVector2(x * f, y * f);
+		f = T(1.0) / f; return SrVector2T<T>(x * f, y * f);
 	}
 
 
-SR_INLINE SrVector2& SrVector2::operator +=(const SrVector2& v)
+template<class T>
+SR_CONSTEXPR SrVector2T<T>& SrVector2T<T>::operator +=(const SrVector2T<T>& v)
 	{
 	x += v.x;
 	y += v.y;
@@ -672,7 +743,8 @@ SR_INLINE SrVector2& SrVector2::operator +=(const SrVector2& v)
 	}
 
 
-SR_INLINE SrVector2& SrVector2::operator -=(const SrVector2& v)
+template<class T>
+SR_CONSTEXPR SrVector2T<T>& SrVector2T<T>::operator -=(const SrVector2T<T>& v)
 	{
 	x -= v.x;
 	y -= v.y;
@@ -680,7 +752,8 @@ SR_INLINE SrVector2& SrVector2::operator -=(const SrVector2& v)
 	}
 
 
-SR_INLINE SrVector2& SrVector2::operator *=(SrReal f)
+template<class T>
+SR_CONSTEXPR SrVector2T<T>& SrVector2T<T>::operator *=(T f)
 	{
 	x *= f;
 	y *= f;
@@ -689,7 +762,8 @@ SR_INLINE SrVector2& SrVector2::operator *=(SrReal f)
 	}
 
 
-SR_INLINE SrVector2& SrVector2::operator /=(SrReal f)
+template<class T>
+SR_CONSTEXPR SrVector2T<T>& SrVector2T<T>::operator /=(T f)
 	{
 	f = 1.0f/f;
 	x *= f;
@@ -699,7 +773,8 @@ SR_INLINE SrVector2& SrVector2::operator /=(SrReal f)
 	}
 
 
-SR_INLINE SrReal SrVector2::operator|(const SrVector2& v) const
+template<class T>
+SR_CONSTEXPR T SrVector2T<T>::operator|(const SrVector2T<T>& v) const
 	{
 	return x * v.x + y * v.y;
 	}
@@ -707,10 +782,10 @@ SR_INLINE SrReal SrVector2::operator|(const SrVector2& v) const
 /**
 scalar pre-multiplication
 */
-
-SR_INLINE SrVector2 operator *(SrReal f, const SrVector2& v)
+template<class T>
+SR_CONSTEXPR SrVector2T<T> operator *(typename SrVector2T<T>::Real f, const SrVector2T<T>& v)
 	{
-	return SrVector2(f * v.x, f * v.y);
+	return SrVector2T<T>(f * v.x, f * v.y);
 	}
 /** @} */
 #endif
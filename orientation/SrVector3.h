@@ -8,6 +8,7 @@
 #define SR_FOUNDATION_SRVECTOR3_H_
 #include <assert.h>
 #include "SrSimpleTypes.h"
+#include "SrForward.h"
 #include "SrMath.h"
 /** \addtogroup foundation
   @{
@@ -28,18 +29,24 @@
 This is a vector class with public data members.
 This is not nice but it has become such a standard that hiding the xyz data members
 makes it difficult to reuse external code that assumes that these are public in the library.
-The vector class can be made to use float or double precision by appropriately defining float.
-This has been chosen as a cleaner alternative to a template class.
+The precision is the template parameter, SrVector3T<SrF32> and SrVector3T<SrF64> are
+the SrVector3 and SrVector3F64 typedefs and can be used side by side.
 */
-class SrVector3
+template<class T>
+class SrVector3T
 	{
 	public:
+	/**
+	\brief The scalar type, SrF32 or SrF64.
+	*/
+	typedef T Real;
+
 	//!Constructors
 
 	/**
 	\brief default constructor leaves data uninitialized.
 	*/
-	SR_INLINE SrVector3();
+	SR_CONSTEXPR SrVector3T();
 
 	/**
 	\brief Assigns scalar parameter to all elements.
@@ -48,7 +55,7 @@ class SrVector3
 
 	\param[in] a Value to assign to elements.
 	*/
-	SR_INLINE explicit SrVector3(SrReal a);
+	SR_CONSTEXPR explicit SrVector3T(T a);
 
 	/**
 	\brief Initializes from 3 scalar parameters.
@@ -57,161 +64,167 @@ class SrVector3
 	\param[in] ny Value to initialize Y component.
 	\param[in] nz Value to initialize Z component.
 	*/
-	SR_INLINE SrVector3(SrReal nx, SrReal ny, SrReal nz);
+	SR_CONSTEXPR SrVector3T(T nx, T ny, T nz);
 	
 	/**
 	\brief Initializes from an array of scalar parameters.
 
 	\param[in] v Value to initialize with.
 	*/
-	SR_INLINE SrVector3(const SrReal v[]);
+	SR_CONSTEXPR SrVector3T(const T v[]);
 
 	/**
 	\brief Copy constructor.
 	*/
-	SR_INLINE SrVector3(const SrVector3& v);
+	SR_CONSTEXPR SrVector3T(const SrVector3T& v);
+
+	/**
+	\brief Converts from the other precision.
+	*/
+	template<class U>
+	SR_CONSTEXPR explicit SrVector3T(const SrVector3T<U>& v);
 
 	/**
 	\brief Assignment operator.
 	*/
-	SR_INLINE const SrVector3& operator=(const SrVector3&);
+	SR_CONSTEXPR const SrVector3T& operator=(const SrVector3T&);
 
 	/**
 	\brief Access the data as an array.
 
-	\return Array of 3 SrReals.
+	\return Array of 3 elements.
 	*/
-	SR_INLINE const SrReal *get() const;
+	SR_INLINE const T *get() const;
 	/**
 	\brief writes out the 3 values to dest.
 
 	\param[out] dest Array to write elements to.
 	*/
-	SR_INLINE void get(SrF32 * dest) const;
+	SR_CONSTEXPR void get(SrF32 * dest) const;
 
 	/**
 	\brief writes out the 3 values to dest.
 	*/
-	SR_INLINE void get(SrF64 * dest) const;
+	SR_CONSTEXPR void get(SrF64 * dest) const;
 
 	/**
 	\brief Access the data as an array.
 
-	\return Array of 3 SrReals.
+	\return Array of 3 elements.
 	*/
-	SR_INLINE SrReal* get();
+	SR_INLINE T* get();
 
-	SR_INLINE SrReal& operator[](int index);
-	SR_INLINE SrReal  operator[](int index) const;
+	SR_INLINE T& operator[](int index);
+	SR_INLINE T  operator[](int index) const;
 
 	//Operators
 	/**
 	\brief true if all the members are smaller.
 	*/
-	SR_INLINE bool operator< (const SrVector3&) const;
+	SR_CONSTEXPR bool operator< (const SrVector3T&) const;
 	/**
 	\brief returns true if the two vectors are exactly equal.
 
 	use equal() to test with a tolerance.
 	*/
-	SR_INLINE bool operator==(const SrVector3&) const;
+	SR_CONSTEXPR bool operator==(const SrVector3T&) const;
 	/**
 	\brief returns true if the two vectors are exactly unequal.
 
 	use !equal() to test with a tolerance.
 	*/
-	SR_INLINE bool operator!=(const SrVector3&) const;
+	SR_CONSTEXPR bool operator!=(const SrVector3T&) const;
 
 //Methods
 	
 	/**
 	\brief reads 3 consecutive values from the ptr passed
 	*/
-	SR_INLINE void  set(const SrF32 *);
+	SR_CONSTEXPR void  set(const SrF32 *);
 
 	/**
 	\brief reads 3 consecutive values from the ptr passed
 	*/
-	SR_INLINE void  set(const SrF64 *);
-	SR_INLINE void  set(const SrVector3 &);
+	SR_CONSTEXPR void  set(const SrF64 *);
+	SR_CONSTEXPR void  set(const SrVector3T &);
 
 //legacy methods:
-	SR_INLINE void setx(const SrReal & d);
-	SR_INLINE void sety(const SrReal & d);
-	SR_INLINE void setz(const SrReal & d);
+	SR_CONSTEXPR void setx(const T & d);
+	SR_CONSTEXPR void sety(const T & d);
+	SR_CONSTEXPR void setz(const T & d);
 
 	/**
 	\brief this = -a
 	*/
-	SR_INLINE void  setNegative(const SrVector3 &a);
+	SR_CONSTEXPR void  setNegative(const SrVector3T &a);
 
 	/**
 	\brief this = -this
 	*/
-	SR_INLINE void  setNegative();
+	SR_CONSTEXPR void  setNegative();
 
 	/**
 	\brief reads 3 consecutive values from the ptr passed
 	*/
-	SR_INLINE void  set(SrReal, SrReal, SrReal);
-	SR_INLINE void  set(SrReal);
+	SR_CONSTEXPR void  set(T, T, T);
+	SR_CONSTEXPR void  set(T);
 
-	SR_INLINE void  zero();
+	SR_CONSTEXPR void  zero();
 	
 	/**
 	\brief tests for exact zero vector
 	*/
-	SR_INLINE bool isZero()	const
+	SR_CONSTEXPR bool isZero()	const
 		{
 		if((x != 0.0f) || (y != 0.0f) || (z != 0.0f))	return false;
 		return true;
 		}
 
-	SR_INLINE void  setPlusInfinity();
-	SR_INLINE void  setMinusInfinity();
+	SR_CONSTEXPR void  setPlusInfinity();
+	SR_CONSTEXPR void  setMinusInfinity();
 
 	/**
 	\brief this = element wise min(this,other)
 	*/
-	SR_INLINE void min(const SrVector3 &);
+	SR_CONSTEXPR void min(const SrVector3T &);
 	/**
 	\brief this = element wise max(this,other)
 	*/
-	SR_INLINE void max(const SrVector3 &);
+	SR_CONSTEXPR void max(const SrVector3T &);
 
 	/**
 	\brief this = a + b
 	*/
-	SR_INLINE void  add(const SrVector3 & a, const SrVector3 & b);
+	SR_CONSTEXPR void  add(const SrVector3T & a, const SrVector3T & b);
 	/**
 	\brief this = a - b
 	*/
-	SR_INLINE void  subtract(const SrVector3 &a, const SrVector3 &b);
+	SR_CONSTEXPR void  subtract(const SrVector3T &a, const SrVector3T &b);
 	/**
 	\brief this = s * a;
 	*/
-	SR_INLINE void  multiply(SrReal s,  const SrVector3 & a);
+	SR_CONSTEXPR void  multiply(T s,  const SrVector3T & a);
 
 	/**
 	\brief this[i] = a[i] * b[i], for all i.
 	*/
-	SR_INLINE void  arrayMultiply(const SrVector3 &a, const SrVector3 &b);
+	SR_CONSTEXPR void  arrayMultiply(const SrVector3T &a, const SrVector3T &b);
 
 
 	/**
 	\brief this = s * a + b;
 	*/
-	SR_INLINE void  multiplyAdd(SrReal s, const SrVector3 & a, const SrVector3 & b);
+	SR_CONSTEXPR void  multiplyAdd(T s, const SrVector3T & a, const SrVector3T & b);
 
 	/**
 	\brief normalizes the vector
 	*/
-	SR_INLINE SrReal normalize();
+	SR_CONSTEXPR T normalize();
 
 	/**
 	\brief sets the vector's magnitude
 	*/
-	SR_INLINE void	setMagnitude(SrReal);
+	SR_CONSTEXPR void	setMagnitude(T);
 
 	/**
 	\brief snaps to closest axis
@@ -226,39 +239,39 @@ class SrVector3
 	/**
 	\brief returns the scalar product of this and other.
 	*/
-	SR_INLINE SrReal dot(const SrVector3 &other) const;
+	SR_CONSTEXPR T dot(const SrVector3T &other) const;
 
 	/**
 	\brief compares orientations (more readable, user-friendly function)
 	*/
-	SR_INLINE bool sameDirection(const SrVector3 &) const;
+	SR_CONSTEXPR bool sameDirection(const SrVector3T &) const;
 
 	/**
 	\brief returns the magnitude
 	*/
-	SR_INLINE SrReal magnitude() const;
+	SR_CONSTEXPR T magnitude() const;
 
 	/**
 	\brief returns the squared magnitude
 	
 	Avoids calling sqrt()!
 	*/
-	SR_INLINE SrReal magnitudeSquared() const;
+	SR_CONSTEXPR T magnitudeSquared() const;
 
 	/**
 	\brief returns (this - other).magnitude();
 	*/
-	SR_INLINE SrReal distance(const SrVector3 &) const;
+	SR_CONSTEXPR T distance(const SrVector3T &) const;
 
 	/**
 	\brief returns (this - other).magnitudeSquared();
 	*/
-	SR_INLINE SrReal distanceSquared(const SrVector3 &v) const;
+	SR_CONSTEXPR T distanceSquared(const SrVector3T &v) const;
 
 	/**
 	\brief this = left x right
 	*/
-	SR_INLINE void cross(const SrVector3 &left, const SrVector3 & right);
+	SR_CONSTEXPR void cross(const SrVector3T &left, const SrVector3T & right);
 
 	/**
 	\brief Stuff magic values in the point, marking it as explicitly not used.
@@ -273,91 +286,104 @@ class SrVector3
 	/**
 	\brief returns true if this and arg's elems are within epsilon of each other.
 	*/
-	SR_INLINE bool equals(const SrVector3 &, SrReal epsilon) const;
+	SR_CONSTEXPR bool equals(const SrVector3T &, T epsilon) const;
 
 	/**
 	\brief negation
 	*/
-	SR_INLINE SrVector3 operator -() const;
+	SR_CONSTEXPR SrVector3T operator -() const;
 	/**
 	\brief vector addition
 	*/
-	SR_INLINE SrVector3 operator +(const SrVector3 & v) const;
+	SR_CONSTEXPR SrVector3T operator +(const SrVector3T & v) const;
 	/**
 	\brief vector difference
 	*/
-	SR_INLINE SrVector3 operator -(const SrVector3 & v) const;
+	SR_CONSTEXPR SrVector3T operator -(const SrVector3T & v) const;
 	/**
 	\brief scalar post-multiplication
 	*/
-	SR_INLINE SrVector3 operator *(SrReal f) const;
+	SR_CONSTEXPR SrVector3T operator *(T f) const;
 	/**
 	\brief scalar division
 	*/
-	SR_INLINE SrVector3 operator /(SrReal f) const;
+	SR_CONSTEXPR SrVector3T operator /(T f) const;
 	/**
 	\brief vector addition
 	*/
-	SR_INLINE SrVector3&operator +=(const SrVector3& v);
+	SR_CONSTEXPR SrVector3T&operator +=(const SrVector3T& v);
 	/**
 	\brief vector difference
 	*/
-	SR_INLINE SrVector3&operator -=(const SrVector3& v);
+	SR_CONSTEXPR SrVector3T&operator -=(const SrVector3T& v);
 	/**
 	\brief scalar multiplication
 	*/
-	SR_INLINE SrVector3&operator *=(SrReal f);
+	SR_CONSTEXPR SrVector3T&operator *=(T f);
 	/**
 	\brief scalar division
 	*/
-	SR_INLINE SrVector3&operator /=(SrReal f);
+	SR_CONSTEXPR SrVector3T&operator /=(T f);
 	/**
 	\brief cross product
 	*/
-	SR_INLINE SrVector3 cross(const SrVector3& v) const;
+	SR_CONSTEXPR SrVector3T cross(const SrVector3T& v) const;
 
 	/**
 	\brief cross product
 	*/
-	SR_INLINE SrVector3 operator^(const SrVector3& v) const;
+	SR_CONSTEXPR SrVector3T operator^(const SrVector3T& v) const;
 	/**
 	\brief dot product
 	*/
-	SR_INLINE SrReal      operator|(const SrVector3& v) const;
+	SR_CONSTEXPR T      operator|(const SrVector3T& v) const;
 
-	SrReal x,y,z;
+	T x,y,z;
 	};
 
 
 /** \endcond */
 
 //implementations:
-SrVector3::SrVector3(SrReal v) : x(v), y(v), z(v)
+template<class T>
+SR_CONSTEXPR SrVector3T<T>::SrVector3T(T v) : x(v), y(v), z(v)
 	{
 	}
 
-SR_INLINE SrVector3::SrVector3(SrReal _x, SrReal _y, SrReal _z) : x(_x), y(_y), z(_z)
+template<class T>
+SR_CONSTEXPR SrVector3T<T>::SrVector3T(T _x, T _y, T _z) : x(_x), y(_y), z(_z)
 	{
 	}
 
 
-SR_INLINE SrVector3::SrVector3(const SrReal v[]) : x(v[0]), y(v[1]), z(v[2])
+template<class T>
+SR_CONSTEXPR SrVector3T<T>::SrVector3T(const T v[]) : x(v[0]), y(v[1]), z(v[2])
 	{
 	}
 
 
-SR_INLINE SrVector3::SrVector3(const SrVector3 &v) : x(v.x), y(v.y), z(v.z)
+template<class T>
+SR_CONSTEXPR SrVector3T<T>::SrVector3T(const SrVector3T<T> &v) : x(v.x), y(v.y), z(v.z)
 	{
 	}
 
 
-SR_INLINE SrVector3::SrVector3()
+template<class T>
+template<class U>
+SR_CONSTEXPR SrVector3T<T>::SrVector3T(const SrVector3T<U>& v) : x((T)v.x), y((T)v.y), z((T)v.z)
+	{
+	}
+
+
+template<class T>
+SR_CONSTEXPR SrVector3T<T>::SrVector3T()
 	{
 	//default constructor leaves data uninitialized.
 	}
 
 
-SR_INLINE const SrVector3& SrVector3::operator=(const SrVector3& v)
+template<class T>
+SR_CONSTEXPR const SrVector3T<T>& SrVector3T<T>::operator=(const SrVector3T<T>& v)
 	{
 	x = v.x;
 	y = v.y;
@@ -368,19 +394,22 @@ SR_INLINE const SrVector3& SrVector3::operator=(const SrVector3& v)
 
 // Access the data as an array.
 
-SR_INLINE const SrReal* SrVector3::get() const
+template<class T>
+SR_INLINE const T* SrVector3T<T>::get() const
 	{
 	return &x;
 	}
 
 
-SR_INLINE SrReal* SrVector3::get()
+template<class T>
+SR_INLINE T* SrVector3T<T>::get()
 	{
 	return &x;
 	}
 
  
-SR_INLINE void  SrVector3::get(SrF32 * v) const
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::get(SrF32 * v) const
 	{
 	v[0] = (SrF32)x;
 	v[1] = (SrF32)y;
@@ -388,7 +417,8 @@ SR_INLINE void  SrVector3::get(SrF32 * v) const
 	}
 
  
-SR_INLINE void  SrVector3::get(SrF64 * v) const
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::get(SrF64 * v) const
 	{
 	v[0] = (SrF64)x;
 	v[1] = (SrF64)y;
@@ -396,40 +426,46 @@ SR_INLINE void  SrVector3::get(SrF64 * v) const
 	}
 
 
-SR_INLINE SrReal& SrVector3::operator[](int index)
+template<class T>
+SR_INLINE T& SrVector3T<T>::operator[](int index)
 	{
 	SR_ASSERT(index>=0 && index<=2);
 	return (&x)[index];
 	}
 
 
-SR_INLINE SrReal  SrVector3::operator[](int index) const
+template<class T>
+SR_INLINE T  SrVector3T<T>::operator[](int index) const
 	{
 	SR_ASSERT(index>=0 && index<=2);
 	return (&x)[index];
 	}
 
  
-SR_INLINE void SrVector3::setx(const SrReal & d) 
+template<class T>
+SR_CONSTEXPR void SrVector3T<T>::setx(const T & d) 
 	{ 
 	x = d; 
 	}
 
  
-SR_INLINE void SrVector3::sety(const SrReal & d) 
+template<class T>
+SR_CONSTEXPR void SrVector3T<T>::sety(const T & d) 
 	{ 
 	y = d; 
 	}
 
  
-SR_INLINE void SrVector3::setz(const SrReal & d) 
+template<class T>
+SR_CONSTEXPR void SrVector3T<T>::setz(const T & d) 
 	{ 
 	z = d; 
 	}
 
 //Operators
  
-SR_INLINE bool SrVector3::operator< (const SrVector3&v) const
+template<class T>
+SR_CONSTEXPR bool SrVector3T<T>::operator< (const SrVector3T<T>&v) const
 	{
 		if( x < v.x)	return true;
 		if( x > v.x)	return false;
@@ -441,20 +477,23 @@ SR_INLINE bool SrVector3::operator< (const SrVector3&v) const
 	}
 
  
-SR_INLINE bool SrVector3::operator==(const SrVector3& v) const
+template<class T>
+SR_CONSTEXPR bool SrVector3T<T>::operator==(const SrVector3T<T>& v) const
 	{
 	return ((x == v.x)&&(y == v.y)&&(z == v.z));
 	}
 
  
-SR_INLINE bool SrVector3::operator!=(const SrVector3& v) const
+template<class T>
+SR_CONSTEXPR bool SrVector3T<T>::operator!=(const SrVector3T<T>& v) const
 	{
 	return ((x != v.x)||(y != v.y)||(z != v.z));
 	}
 
 //Methods
  
-SR_INLINE void  SrVector3::set(const SrVector3 & v)
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::set(const SrVector3T<T> & v)
 	{
 	x = v.x;
 	y = v.y;
@@ -462,7 +501,8 @@ SR_INLINE void  SrVector3::set(const SrVector3 & v)
 	}
 
  
-SR_INLINE void  SrVector3::setNegative(const SrVector3 & v)
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::setNegative(const SrVector3T<T> & v)
 	{
 	x = -v.x;
 	y = -v.y;
@@ -470,7 +510,8 @@ SR_INLINE void  SrVector3::setNegative(const SrVector3 & v)
 	}
 
  
-SR_INLINE void  SrVector3::setNegative()
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::setNegative()
 	{
 	x = -x;
 	y = -y;
@@ -479,24 +520,27 @@ SR_INLINE void  SrVector3::setNegative()
 
 
  
-SR_INLINE void  SrVector3::set(const SrF32 * v)
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::set(const SrF32 * v)
 	{
-	x = (SrReal)v[0];
-	y = (SrReal)v[1];
-	z = (SrReal)v[2];
+	x = (T)v[0];
+	y = (T)v[1];
+	z = (T)v[2];
 	}
 
  
-SR_INLINE void  SrVector3::set(const SrF64 * v)
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::set(const SrF64 * v)
 	{
-	x = (SrReal)v[0];
-	y = (SrReal)v[1];
-	z = (SrReal)v[2];
+	x = (T)v[0];
+	y = (T)v[1];
+	z = (T)v[2];
 	}
 
 
  
-SR_INLINE void  SrVector3::set(SrReal _x, SrReal _y, SrReal _z)
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::set(T _x, T _y, T _z)
 	{
 	this->x = _x;
 	this->y = _y;
@@ -504,7 +548,8 @@ SR_INLINE void  SrVector3::set(SrReal _x, SrReal _y, SrReal _z)
 	}
 
  
-SR_INLINE void SrVector3::set(SrReal v)
+template<class T>
+SR_CONSTEXPR void SrVector3T<T>::set(T v)
 	{
 	x = v;
 	y = v;
@@ -512,25 +557,29 @@ SR_INLINE void SrVector3::set(SrReal v)
 	}
 
  
-SR_INLINE void  SrVector3::zero()
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::zero()
 	{
 	x = y = z = 0.0;
 	}
 
  
-SR_INLINE void  SrVector3::setPlusInfinity()
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::setPlusInfinity()
 	{
-	x = y = z = SR_MAX_F32; //TODO: this may be double too, but here we can't tell!
+	x = y = z = SrLimits<T>::maxValue();
 	}
 
  
-SR_INLINE void  SrVector3::setMinusInfinity()
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::setMinusInfinity()
 	{
-	x = y = z = SR_MIN_F32; //TODO: this may be double too, but here we can't tell!
+	x = y = z = SrLimits<T>::minValue();
 	}
 
  
-SR_INLINE void SrVector3::max(const SrVector3 & v)
+template<class T>
+SR_CONSTEXPR void SrVector3T<T>::max(const SrVector3T<T> & v)
 	{
 		x = x > v.x?x:v.x;
 		y = y > v.y?y:v.y;
@@ -538,7 +587,8 @@ SR_INLINE void SrVector3::max(const SrVector3 & v)
 	}
 
  
-SR_INLINE void SrVector3::min(const SrVector3 & v)
+template<class T>
+SR_CONSTEXPR void SrVector3T<T>::min(const SrVector3T<T> & v)
 	{
 		x = x > v.x?v.x:x;
 		y = y > v.y?v.y:y;
@@ -548,7 +598,8 @@ SR_INLINE void SrVector3::min(const SrVector3 & v)
 
 
 
-SR_INLINE void  SrVector3::add(const SrVector3 & a, const SrVector3 & b)
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::add(const SrVector3T<T> & a, const SrVector3T<T> & b)
 	{
 	x = a.x + b.x;
 	y = a.y + b.y;
@@ -556,7 +607,8 @@ SR_INLINE void  SrVector3::add(const SrVector3 & a, const SrVector3 & b)
 	}
 
 
-SR_INLINE void  SrVector3::subtract(const SrVector3 &a, const SrVector3 &b)
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::subtract(const SrVector3T<T> &a, const SrVector3T<T> &b)
 	{
 	x = a.x - b.x;
 	y = a.y - b.y;
@@ -564,7 +616,8 @@ SR_INLINE void  SrVector3::subtract(const SrVector3 &a, const SrVector3 &b)
 	}
 
 
-SR_INLINE void  SrVector3::arrayMultiply(const SrVector3 &a, const SrVector3 &b)
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::arrayMultiply(const SrVector3T<T> &a, const SrVector3T<T> &b)
 	{
 	x = a.x * b.x;
 	y = a.y * b.y;
@@ -572,7 +625,8 @@ SR_INLINE void  SrVector3::arrayMultiply(const SrVector3 &a, const SrVector3 &b)
 	}
 
 
-SR_INLINE void  SrVector3::multiply(SrReal s,  const SrVector3 & a)
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::multiply(T s,  const SrVector3T<T> & a)
 	{
 	x = a.x * s;
 	y = a.y * s;
@@ -580,7 +634,8 @@ SR_INLINE void  SrVector3::multiply(SrReal s,  const SrVector3 & a)
 	}
 
 
-SR_INLINE void  SrVector3::multiplyAdd(SrReal s, const SrVector3 & a, const SrVector3 & b)
+template<class T>
+SR_CONSTEXPR void  SrVector3T<T>::multiplyAdd(T s, const SrVector3T<T> & a, const SrVector3T<T> & b)
 	{
 	x = s * a.x + b.x;
 	y = s * a.y + b.y;
@@ -588,12 +643,13 @@ SR_INLINE void  SrVector3::multiplyAdd(SrReal s, const SrVector3 & a, const SrVe
 	}
 
  
-SR_INLINE SrReal SrVector3::normalize()
+template<class T>
+SR_CONSTEXPR T SrVector3T<T>::normalize()
 	{
-	SrReal m = magnitude();
+	T m = magnitude();
 	if (m)
 		{
-		const SrReal il =  SrReal(1.0) / m;
+		const T il =  T(1.0) / m;
 		x *= il;
 		y *= il;
 		z *= il;
@@ -602,69 +658,78 @@ SR_INLINE SrReal SrVector3::normalize()
 	}
 
  
-SR_INLINE void SrVector3::setMagnitude(SrReal length)
+template<class T>
+SR_CONSTEXPR void SrVector3T<T>::setMagnitude(T length)
 	{
-	SrReal m = magnitude();
+	T m = magnitude();
 	if(m)
 		{
-		SrReal newLength = length / m;
+		T newLength = length / m;
 		x *= newLength;
 		y *= newLength;
 		z *= newLength;
 		}
 	}
-SR_INLINE bool SrVector3::isFinite() const
+template<class T>
+SR_INLINE bool SrVector3T<T>::isFinite() const
 	{
 		return SrMath::isFinite(x) && SrMath::isFinite(y) && SrMath::isFinite(z);
 	}
-SR_INLINE SrReal SrVector3::dot(const SrVector3 &v) const
+template<class T>
+SR_CONSTEXPR T SrVector3T<T>::dot(const SrVector3T<T> &v) const
 	{
 	return x * v.x + y * v.y + z * v.z;
 	}
 
  
-SR_INLINE bool SrVector3::sameDirection(const SrVector3 &v) const
+template<class T>
+SR_CONSTEXPR bool SrVector3T<T>::sameDirection(const SrVector3T<T> &v) const
 	{
 	return x*v.x + y*v.y + z*v.z >= 0.0f;
 	}
 
  
-SR_INLINE SrReal SrVector3::magnitude() const
+template<class T>
+SR_CONSTEXPR T SrVector3T<T>::magnitude() const
 	{
 	return SrMath::sqrt(x * x + y * y + z * z);
 	}
 
  
-SR_INLINE SrReal SrVector3::magnitudeSquared() const
+template<class T>
+SR_CONSTEXPR T SrVector3T<T>::magnitudeSquared() const
 	{
 	return x * x + y * y + z * z;
 	}
 
  
-SR_INLINE SrReal SrVector3::distance(const SrVector3 & v) const
+template<class T>
+SR_CONSTEXPR T SrVector3T<T>::distance(const SrVector3T<T> & v) const
 	{
-	SrReal dx = x - v.x;
-	SrReal dy = y - v.y;
-	SrReal dz = z - v.z;
+	T dx = x - v.x;
+	T dy = y - v.y;
+	T dz = z - v.z;
 	return SrMath::sqrt(dx * dx + dy * dy + dz * dz);
 	}
 
  
-SR_INLINE SrReal SrVector3::distanceSquared(const SrVector3 &v) const
+template<class T>
+SR_CONSTEXPR T SrVector3T<T>::distanceSquared(const SrVector3T<T> &v) const
 	{
-	SrReal dx = x - v.x;
-	SrReal dy = y - v.y;
-	SrReal dz = z - v.z;
+	T dx = x - v.x;
+	T dy = y - v.y;
+	T dz = z - v.z;
 	return dx * dx + dy * dy + dz * dz;
 	}
 
  
-SR_INLINE void SrVector3::cross(const SrVector3 &left, const SrVector3 & right)	//prefered version, w/o temp object.
+template<class T>
+SR_CONSTEXPR void SrVector3T<T>::cross(const SrVector3T<T> &left, const SrVector3T<T> & right)	//prefered version, w/o temp object.
 	{
 	// temps needed in case left or right is this.
-	SrReal a = (left.y * right.z) - (left.z * right.y);
-	SrReal b = (left.z * right.x) - (left.x * right.z);
-	SrReal c = (left.x * right.y) - (left.y * right.x);
+	T a = (left.y * right.z) - (left.z * right.y);
+	T b = (left.z * right.x) - (left.x * right.z);
+	T c = (left.x * right.y) - (left.y * right.x);
 
 	x = a;
 	y = b;
@@ -672,7 +737,8 @@ SR_INLINE void SrVector3::cross(const SrVector3 &left, const SrVector3 & right)
 	}
 
  
-SR_INLINE bool SrVector3::equals(const SrVector3 & v, SrReal epsilon) const
+template<class T>
+SR_CONSTEXPR bool SrVector3T<T>::equals(const SrVector3T<T> & v, T epsilon) const
 	{
 	return 
 		SrMath::equals(x, v.x, epsilon) &&
@@ -682,38 +748,44 @@ SR_INLINE bool SrVector3::equals(const SrVector3 & v, SrReal epsilon) const
 
 
  
-SR_INLINE SrVector3 SrVector3::operator -() const
+template<class T>
+SR_CONSTEXPR SrVector3T<T> SrVector3T<T>::operator -() const
 	{
-	return SrVector3(-x, -y, -z);
+	return SrVector3T<T>(-x, -y, -z);
 	}
 
  
-SR_INLINE SrVector3 SrVector3::operator +(const SrVector3 & v) const
+template<class T>
+SR_CONSTEXPR SrVector3T<T> SrVector3T<T>::operator +(const SrVector3T<T> & v) const
 	{
-	return SrVector3(x + v.x, y + v.y, z + v.z);	// RVO version
+	return SrVector3T<T>(x + v.x, y + v.y, z + v.z);	// RVO version
 	}
 
  
-SR_INLINE SrVector3 SrVector3::operator -(const SrVector3 & v) const
+template<class T>
+SR_CONSTEXPR SrVector3T<T> SrVector3T<T>::operator -(const SrVector3T<T> & v) const
 	{
-	return SrVector3(x - v.x, y - v.y, z - v.z);	// RVO version
+	return SrVector3T<T>(x - v.x, y - v.y, z - v.z);	// RVO version
 	}
 
 
 
-SR_INLINE SrVector3 SrVector3::operator *(SrReal f) const
+template<class T>
+SR_CONSTEXPR SrVector3T<T> SrVector3T<T>::operator *(T f) const
 	{
-	return SrVector3(x * f, y * f, z * f);	// RVO version
+	return SrVector3T<T>(x * f, y * f, z * f);	// RVO version
 	}
 
 
-SR_INLINE SrVector3 SrVector3::operator /(SrReal f) const
+template<class T>
+SR_CONSTEXPR SrVector3T<T> SrVector3T<T>::operator /(T f) const
 	{
-		f = SrReal(1.0) / f; return SrVector3(x * f, y * f, z * f);
+		f = T(1.0) / f; return SrVector3T<T>(x * f, y * f, z * f);
 	}
 
 
-SR_INLINE SrVector3& SrVector3::operator +=(const SrVector3& v)
+template<class T>
+SR_CONSTEXPR SrVector3T<T>& SrVector3T<T>::operator +=(const SrVector3T<T>& v)
 	{
 	x += v.x;
 	y += v.y;
@@ -722,7 +794,8 @@ SR_INLINE SrVector3& SrVector3::operator +=(const SrVector3& v)
 	}
 
 
-SR_INLINE SrVector3& SrVector3::operator -=(const SrVector3& v)
+template<class T>
+SR_CONSTEXPR SrVector3T<T>& SrVector3T<T>::operator -=(const SrVector3T<T>& v)
 	{
 	x -= v.x;
 	y -= v.y;
@@ -731,7 +804,8 @@ SR_INLINE SrVector3& SrVector3::operator -=(const SrVector3& v)
 	}
 
 
-SR_INLINE SrVector3& SrVector3::operator *=(SrReal f)
+template<class T>
+SR_CONSTEXPR SrVector3T<T>& SrVector3T<T>::operator *=(T f)
 	{
 	x *= f;
 	y *= f;
@@ -741,7 +815,8 @@ SR_INLINE SrVector3& SrVector3::operator *=(SrReal f)
 	}
 
 
-SR_INLINE SrVector3& SrVector3::operator /=(SrReal f)
+template<class T>
+SR_CONSTEXPR SrVector3T<T>& SrVector3T<T>::operator /=(T f)
 	{
 	f = 1.0f/f;
 	x *= f;
@@ -752,23 +827,26 @@ SR_INLINE SrVector3& SrVector3::operator /=(SrReal f)
 	}
 
 
-SR_INLINE SrVector3 SrVector3::cross(const SrVector3& v) const
+template<class T>
+SR_CONSTEXPR SrVector3T<T> SrVector3T<T>::cross(const SrVector3T<T>& v) const
 	{
-	SrVector3 temp;
+	SrVector3T<T> temp;
 	temp.cross(*this,v);
 	return temp;
 	}
 
 
-SR_INLINE SrVector3 SrVector3::operator^(const SrVector3& v) const
+template<class T>
+SR_CONSTEXPR SrVector3T<T> SrVector3T<T>::operator^(const SrVector3T<T>& v) const
 	{
-	SrVector3 temp;
+	SrVector3T<T> temp;
 	temp.cross(*this,v);
 	return temp;
 	}
 
 
-SR_INLINE SrReal SrVector3::operator|(const SrVector3& v) const
+template<class T>
+SR_CONSTEXPR T SrVector3T<T>::operator|(const SrVector3T<T>& v) const
 	{
 	return x * v.x + y * v.y + z * v.z;
 	}
@@ -776,10 +854,10 @@ SR_INLINE SrReal SrVector3::operator|(const SrVector3& v) const
 /**
 scalar pre-multiplication
 */
-
-SR_INLINE SrVector3 operator *(SrReal f, const SrVector3& v)
+template<class T>
+SR_CONSTEXPR SrVector3T<T> operator *(typename SrVector3T<T>::Real f, const SrVector3T<T>& v)
 	{
-	return SrVector3(f * v.x, f * v.y, f * v.z);
+	return SrVector3T<T>(f * v.x, f * v.y, f * v.z);
 	}
 
 
@@ -0,0 +1,203 @@
+/************************************************************************
+\file 	SrVector3SoA.h
+\link	www.twinklingstar.cn
+\author Twinkling Star
+\date	2013/11/22
+****************************************************************************/
+#ifndef SR_FOUNDATION_SRVECTOR3SOA_H_
+#define SR_FOUNDATION_SRVECTOR3SOA_H_
+/** \addtogroup foundation
+  @{
+*/
+
+#include <string.h>
+#include "SrSimd.h"
+#include "SrVector3.h"
+
+/**
+\brief Structure of arrays container for 3 element vectors.
+
+The components are kept in three separate lanes x[], y[] and z[], each aligned to
+#SR_SIMD_ALIGNMENT bytes and padded to a multiple of 16 elements, so that batch kernels
+can stream full SIMD registers out of them.
+
+Like SrVector3 the lanes are public data members. They are owned by the container and
+are reallocated by #resize().
+*/
+class SrVector3SoA
+	{
+	public:
+	/**
+	\brief Creates an empty container.
+	*/
+	SR_INLINE SrVector3SoA();
+
+	/**
+	\brief Creates a container of n elements, data is left uninitialized.
+	*/
+	SR_INLINE explicit SrVector3SoA(SrU32 n);
+
+	/**
+	\brief Copy constructor, copies all n elements.
+	*/
+	SR_INLINE SrVector3SoA(const SrVector3SoA& other);
+
+	SR_INLINE ~SrVector3SoA();
+
+	/**
+	\brief Assignment operator, copies all n elements.
+	*/
+	SR_INLINE const SrVector3SoA& operator=(const SrVector3SoA& other);
+
+	/**
+	\brief Changes the number of elements. Existing data is kept up to the new size.
+	n must be at most SR_MAX_U32 - 15 and small enough that all lanes fit in a size_t,
+	a larger n is rejected.
+	*/
+	SR_INLINE void resize(SrU32 n);
+
+	/**
+	\brief number of elements.
+	*/
+	SR_INLINE SrU32 size() const;
+
+	/**
+	\brief number of elements allocated per lane, a multiple of 16.
+	*/
+	SR_INLINE SrU32 capacity() const;
+
+	/**
+	\brief writes element i.
+	*/
+	SR_INLINE void set(SrU32 i, const SrVector3& v);
+
+	/**
+	\brief reads element i.
+	*/
+	SR_INLINE SrVector3 get(SrU32 i) const;
+
+	/**
+	\brief resizes to n and scatters the n AoS vectors into the lanes.
+	*/
+	SR_INLINE void setAoS(const SrVector3* src, SrU32 n);
+
+	/**
+	\brief gathers all elements into the AoS array dst, which must hold size() vectors.
+	*/
+	SR_INLINE void getAoS(SrVector3* dst) const;
+
+	/** the lanes */
+	SrF32* x;
+	SrF32* y;
+	SrF32* z;
+
+	private:
+	SrU32 mSize;
+	SrU32 mCapacity;
+	};
+
+
+SR_INLINE SrVector3SoA::SrVector3SoA() : x(NULL), y(NULL), z(NULL), mSize(0), mCapacity(0)
+	{
+	}
+
+SR_INLINE SrVector3SoA::SrVector3SoA(SrU32 n) : x(NULL), y(NULL), z(NULL), mSize(0), mCapacity(0)
+	{
+	resize(n);
+	}
+
+SR_INLINE SrVector3SoA::SrVector3SoA(const SrVector3SoA& other) : x(NULL), y(NULL), z(NULL), mSize(0), mCapacity(0)
+	{
+	*this = other;
+	}
+
+SR_INLINE SrVector3SoA::~SrVector3SoA()
+	{
+	SrAlignedMemory::deallocate(x);
+	}
+
+SR_INLINE const SrVector3SoA& SrVector3SoA::operator=(const SrVector3SoA& other)
+	{
+	if(this != &other)
+		{
+		resize(other.mSize);
+		memcpy(x, other.x, mSize * sizeof(SrF32));
+		memcpy(y, other.y, mSize * sizeof(SrF32));
+		memcpy(z, other.z, mSize * sizeof(SrF32));
+		}
+	return *this;
+	}
+
+SR_INLINE void SrVector3SoA::resize(SrU32 n)
+	{
+	if(n > mCapacity)
+		{
+		//neither the rounded capacity nor the byte count of the block may wrap, a larger n
+		//leaves the container as it is.
+		const bool fits = n <= (SR_MAX_U32 & ~15u) && n <= ((size_t)-1) / (3 * sizeof(SrF32)) - 15;
+		SR_ASSERT(fits);
+		if(!fits)
+			return;
+
+		//one block for all lanes, every lane starts on a SR_SIMD_ALIGNMENT boundary.
+		const SrU32 cap = (n + 15) & ~15u;
+		SrF32* block = (SrF32*)SrAlignedMemory::allocate(3 * (size_t)cap * sizeof(SrF32));
+		SR_ASSERT(block);
+		if(mSize)
+			{
+			memcpy(block, x, mSize * sizeof(SrF32));
+			memcpy(block + cap, y, mSize * sizeof(SrF32));
+			memcpy(block + 2 * cap, z, mSize * sizeof(SrF32));
+			}
+		SrAlignedMemory::deallocate(x);
+		x = block;
+		y = block + cap;
+		z = block + 2 * cap;
+		mCapacity = cap;
+		}
+	mSize = n;
+	}
+
+SR_INLINE SrU32 SrVector3SoA::size() const
+	{
+	return mSize;
+	}
+
+SR_INLINE SrU32 SrVector3SoA::capacity() const
+	{
+	return mCapacity;
+	}
+
+SR_INLINE void SrVector3SoA::set(SrU32 i, const SrVector3& v)
+	{
+	SR_ASSERT(i < mSize);
+	x[i] = v.x;
+	y[i] = v.y;
+	z[i] = v.z;
+	}
+
+SR_INLINE SrVector3 SrVector3SoA::get(SrU32 i) const
+	{
+	SR_ASSERT(i < mSize);
+	return SrVector3(x[i], y[i], z[i]);
+	}
+
+SR_INLINE void SrVector3SoA::setAoS(const SrVector3* src, SrU32 n)
+	{
+	resize(n);
+	for(SrU32 i = 0; i < n; i++)
+		{
+		x[i] = src[i].x;
+		y[i] = src[i].y;
+		z[i] = src[i].z;
+		}
+	}
+
+SR_INLINE void SrVector3SoA::getAoS(SrVector3* dst) const
+	{
+	for(SrU32 i = 0; i < mSize; i++)
+		dst[i].set(x[i], y[i], z[i]);
+	}
+
+/** @} */
+#endif